@@ -68,6 +68,22 @@ static ProceduralLayout *abyssLayout = nullptr, *levelLayout = nullptr;
 typedef priority_queue<ProceduralSample, vector<ProceduralSample>, ProceduralSamplePQCompare> sample_queue;
 
 static sample_queue abyss_sample_queue;
+
+// The last sample taken at each grid cell. The sample queue can hold a cell
+// more than once, and a morph examines it again for every entry, so this
+// lets the later entries at the same depth skip the layouts. Samples are
+// filed by abyss coordinate wrapped to the map size, which is one slot per
+// cell of the current area, so they are still found after the area shifts.
+struct abyss_cached_sample
+{
+    bool valid;
+    coord_def abyss_coord;
+    uint32_t depth;
+    dungeon_feature_type feat;
+    uint32_t changepoint;
+    map_mask_type mask;
+};
+static FixedArray<abyss_cached_sample, GXM, GYM> abyss_sample_cache;
 static vector<dungeon_feature_type> abyssal_features;
 static list<monster*> displaced_monsters;
 
@@ -757,16 +773,11 @@ static void _abyss_move_entities_at(coord_def src, coord_def dst)
 // Move all vaults within the mask by the specified delta.
 static void _abyss_move_masked_vaults_by_delta(const coord_def delta)
 {
-    set<int> vault_indexes;
-    for (rectangle_iterator ri(MAPGEN_BORDER); ri; ++ri)
-    {
-        const int vi = env.level_map_ids(*ri);
-        if (vi != INVALID_MAP_INDEX)
-            vault_indexes.insert(vi);
-    }
-
-    for (auto i : vault_indexes)
+    const vector<bool> on_map = dgn_vaults_on_map();
+    for (int i = 0, size = on_map.size(); i < size; ++i)
     {
+        if (!on_map[i])
+            continue;
         vault_placement &vp(*env.level_vaults[i]);
 #ifdef DEBUG_DIAGNOSTICS
         const coord_def oldp = vp.pos;
@@ -915,8 +926,7 @@ static void _abyss_identify_area_to_shift(coord_def source, int radius,
 
 static void _abyss_invert_mask(map_bitmask *mask)
 {
-    for (rectangle_iterator ri(0); ri; ++ri)
-        mask->set(*ri, !mask->get(*ri));
+    mask->flip();
 }
 
 // Moves everything in the given radius around the player (where radius=0 =>
@@ -1107,14 +1117,46 @@ const static RiverLayout rivers(1800, baseLayout);
 // This one is not fixed: [0] is a level pulled from the current game
 static vector<const ProceduralLayout*> complex_vec(2);
 
+static void _reset_abyss_samples()
+{
+    abyss_sample_queue = sample_queue(ProceduralSamplePQCompare());
+    abyss_sample_cache.init(abyss_cached_sample());
+}
+
+static abyss_cached_sample &_abyss_cached_sample_at(const coord_def &pt)
+{
+    const coord_def slot((pt.x % GXM + GXM) % GXM, (pt.y % GYM + GYM) % GYM);
+    return abyss_sample_cache(slot);
+}
+
+// Queue a fresh sample for its next change, and remember it.
+static void _push_abyss_sample(const ProceduralSample &sample)
+{
+    abyss_sample_queue.push(sample);
+    abyss_cached_sample &cached = _abyss_cached_sample_at(sample.coord());
+    cached = { true, sample.coord(), abyssal_state.depth, sample.feat(),
+               sample.changepoint(), sample.mask() };
+}
+
 static ProceduralSample _abyss_grid(const coord_def &p)
 {
     const coord_def pt = p + abyssal_state.major_coord;
 
+    // Sampling is deterministic, and the first time this cell was sampled
+    // at this depth already queued the result, which can't come due until
+    // the depth increases.
+    const abyss_cached_sample &cached = _abyss_cached_sample_at(pt);
+    if (cached.valid && cached.abyss_coord == pt
+        && cached.depth == abyssal_state.depth)
+    {
+        return ProceduralSample(pt, cached.feat, cached.changepoint,
+                                cached.mask);
+    }
+
     if (_in_wastes(pt))
     {
         ProceduralSample sample = wastes(pt, abyssal_state.depth);
-        abyss_sample_queue.push(sample);
+        _push_abyss_sample(sample);
         return sample;
     }
 
@@ -1130,7 +1172,7 @@ static ProceduralSample _abyss_grid(const coord_def &p)
     const ProceduralSample sample = (*abyssLayout)(pt, abyssal_state.depth);
     ASSERT(sample.feat() > DNGN_UNSEEN);
 
-    abyss_sample_queue.push(sample);
+    _push_abyss_sample(sample);
     return sample;
 }
 
@@ -1432,7 +1474,7 @@ static void _initialize_abyss_state()
     abyssal_state.depth = get_uint32() & 0x7FFFFFFF;
     abyssal_state.destroy_all_terrain = false;
     abyssal_state.level = _get_random_level();
-    abyss_sample_queue = sample_queue(ProceduralSamplePQCompare());
+    _reset_abyss_samples();
 }
 
 void set_abyss_state(coord_def coord, uint32_t depth)
@@ -1442,7 +1484,7 @@ void set_abyss_state(coord_def coord, uint32_t depth)
     abyssal_state.seed = get_uint32() & 0x7FFFFFFF;
     abyssal_state.phase = 0.0;
     abyssal_state.destroy_all_terrain = true;
-    abyss_sample_queue = sample_queue(ProceduralSamplePQCompare());
+    _reset_abyss_samples();
     you.moveto(ABYSS_CENTRE);
     map_bitmask abyss_genlevel_mask(true);
     _abyss_apply_terrain(abyss_genlevel_mask, true, true);
@@ -1493,6 +1535,7 @@ void destroy_abyss()
         delete levelLayout;
         levelLayout = nullptr;
     }
+    _reset_abyss_samples();
 }
 
 static colour_t _roll_abyss_floor_colour()
@@ -454,32 +454,35 @@ static skill_type _acquirement_weapon_skill(bool divine)
     return skill;
 }
 
-static int _acquirement_weapon_subtype(bool divine, int & /*quantity*/)
+// A weapon acquirement may be rerolled many times, but the parts of each
+// subtype's weight that don't depend on the randomly rounded skills stay the
+// same throughout, so acquirement_create_item() works them out only once.
+struct acq_weapon_choice
 {
-    const skill_type skill = _acquirement_weapon_skill(divine);
+    int sub_type;
+    int weight;
+    bool two_handed;
+    bool seen;
+};
 
-    int best_sk = 0;
-    for (int i = SK_FIRST_WEAPON; i <= SK_LAST_WEAPON; i++)
-        best_sk = max(best_sk, _skill_rdiv((skill_type)i));
-    best_sk = max(best_sk, _skill_rdiv(SK_UNARMED_COMBAT));
+struct acq_weapon_table
+{
+    bool built[SK_LAST_WEAPON + 1] = { };
+    vector<acq_weapon_choice> choices[SK_LAST_WEAPON + 1];
+};
 
-    // Now choose a subtype which uses that skill.
-    int result = OBJ_RANDOM;
-    int count = 0;
+static acq_weapon_table *_weapon_table = nullptr;
+
+/**
+ * The weapon subtypes that acquirement might choose for a weapon skill, in
+ * subtype order, with their weights before the shield adjustment.
+ */
+static vector<acq_weapon_choice> _acquirement_weapon_choices(skill_type skill,
+                                                             bool divine)
+{
+    vector<acq_weapon_choice> choices;
     item_def item_considered;
     item_considered.base_type = OBJ_WEAPONS;
-    // Let's guess the percentage of shield use the player did, this is
-    // based on empirical data where pure-shield MDs get skills like 17 sh
-    // 25 m&f and pure-shield Spriggans 7 sh 18 m&f. Pretend formicid
-    // shield skill is 0 so they always weight towards 2H.
-    const int shield_sk = you.species == SP_FORMICID
-        ? 0
-        : _skill_rdiv(SK_SHIELDS) * species_apt_factor(SK_SHIELDS);
-    const int want_shield = min(2 * shield_sk, best_sk) + 10;
-    const int dont_shield = max(best_sk - shield_sk, 0) + 10;
-    // At XL 10, weapons of the handedness you want get weight *2, those of
-    // opposite handedness 1/2, assuming your shields usage is respectively
-    // 0% or 100% in the above formula. At skill 25 that's *3.5 .
     for (int i = 0; i < NUM_WEAPONS; ++i)
     {
         const int wskill = item_attack_skill(OBJ_WEAPONS, i);
@@ -513,17 +516,66 @@ static int _acquirement_weapon_subtype(bool divine, int & /*quantity*/)
             acqweight *= damage / property(item_considered, PWPN_SPEED);
         }
 
-        if (two_handed)
+        choices.push_back({ i, acqweight, two_handed,
+                            static_cast<bool>(you.seen_weapon[i]) });
+    }
+    return choices;
+}
+
+static int _acquirement_weapon_subtype(bool divine, int & /*quantity*/)
+{
+    const skill_type skill = _acquirement_weapon_skill(divine);
+
+    int best_sk = 0;
+    for (int i = SK_FIRST_WEAPON; i <= SK_LAST_WEAPON; i++)
+        best_sk = max(best_sk, _skill_rdiv((skill_type)i));
+    best_sk = max(best_sk, _skill_rdiv(SK_UNARMED_COMBAT));
+
+    // Now choose a subtype which uses that skill.
+    int result = OBJ_RANDOM;
+    int count = 0;
+    // Let's guess the percentage of shield use the player did, this is
+    // based on empirical data where pure-shield MDs get skills like 17 sh
+    // 25 m&f and pure-shield Spriggans 7 sh 18 m&f. Pretend formicid
+    // shield skill is 0 so they always weight towards 2H.
+    const int shield_sk = you.species == SP_FORMICID
+        ? 0
+        : _skill_rdiv(SK_SHIELDS) * species_apt_factor(SK_SHIELDS);
+    const int want_shield = min(2 * shield_sk, best_sk) + 10;
+    const int dont_shield = max(best_sk - shield_sk, 0) + 10;
+
+    vector<acq_weapon_choice> uncached;
+    const vector<acq_weapon_choice> *choices = &uncached;
+    if (_weapon_table)
+    {
+        if (!_weapon_table->built[skill])
+        {
+            _weapon_table->choices[skill]
+                = _acquirement_weapon_choices(skill, divine);
+            _weapon_table->built[skill] = true;
+        }
+        choices = &_weapon_table->choices[skill];
+    }
+    else
+        uncached = _acquirement_weapon_choices(skill, divine);
+
+    // At XL 10, weapons of the handedness you want get weight *2, those of
+    // opposite handedness 1/2, assuming your shields usage is respectively
+    // 0% or 100% in the above formula. At skill 25 that's *3.5 .
+    for (const acq_weapon_choice &choice : *choices)
+    {
+        int acqweight = choice.weight;
+        if (choice.two_handed)
             acqweight = acqweight * dont_shield / want_shield;
         else
             acqweight = acqweight * want_shield / dont_shield;
 
-        if (!you.seen_weapon[i])
+        if (!choice.seen)
             acqweight *= 5; // strong emphasis on type variety, brands go only second
 
         // reservoir sampling
         if (x_chance_in_y(acqweight, count += acqweight))
-            result = i;
+            result = choice.sub_type;
     }
     return result;
 }
@@ -1238,6 +1290,8 @@ int acquirement_create_item(object_class_type class_wanted,
                          || agent == GOD_TROG || agent == GOD_PAKELLAS);
     int thing_created = NON_ITEM;
     int quant = 1;
+    acq_weapon_table weapon_table;
+    unwind_var<acq_weapon_table *> table(_weapon_table, &weapon_table);
 #define MAX_ACQ_TRIES 40
     for (int item_tries = 0; item_tries < MAX_ACQ_TRIES; item_tries++)
     {
@@ -2,12 +2,39 @@
 
 #include "act-iter.h"
 
+#include "coordit.h"
 #include "env.h"
 #include "losglobal.h"
 
+// Find the monsters that are within LOS range of c. Monsters always occupy
+// their cell in the monster grid, so a scan of the surrounding square is
+// enough; only LOS_NONE, which sees the whole level, needs every slot.
+static void _gather_candidates(const coord_def& c, los_type los,
+                               monster_slot_set &candidates)
+{
+    candidates.reset();
+
+    if (los == LOS_NONE)
+    {
+        candidates.init(true);
+        return;
+    }
+
+    if (!map_bounds(c))
+        return;
+
+    for (rectangle_iterator ri(c, LOS_RADIUS, true); ri; ++ri)
+    {
+        const unsigned short m = mgrd(*ri);
+        if (m < MAX_MONSTERS)
+            candidates.set(m);
+    }
+}
+
 actor_near_iterator::actor_near_iterator(coord_def c, los_type los)
     : center(c), _los(los), viewer(nullptr), i(-1)
 {
+    _gather_candidates(center, _los, candidates);
     if (!valid(&you))
         advance();
 }
@@ -15,6 +42,7 @@ actor_near_iterator::actor_near_iterator(coord_def c, los_type los)
 actor_near_iterator::actor_near_iterator(const actor* a, los_type los)
     : center(a->pos()), _los(los), viewer(a), i(-1)
 {
+    _gather_candidates(center, _los, candidates);
     if (!valid(&you))
         advance();
 }
@@ -66,7 +94,7 @@ void actor_near_iterator::advance()
     do
          if (++i >= MAX_MONSTERS)
              return;
-    while (!valid(**this));
+    while (!candidates.get(i) || !valid(**this));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -74,7 +102,8 @@ void actor_near_iterator::advance()
 monster_near_iterator::monster_near_iterator(coord_def c, los_type los)
     : center(c), _los(los), viewer(nullptr), i(0)
 {
-    if (!valid(&menv[0]))
+    _gather_candidates(center, _los, candidates);
+    if (!candidates.get(0) || !valid(&menv[0]))
         advance();
     begin_point = i;
 }
@@ -82,7 +111,8 @@ monster_near_iterator::monster_near_iterator(coord_def c, los_type los)
 monster_near_iterator::monster_near_iterator(const actor *a, los_type los)
     : center(a->pos()), _los(los), viewer(a), i(0)
 {
-    if (!valid(&menv[0]))
+    _gather_candidates(center, _los, candidates);
+    if (!candidates.get(0) || !valid(&menv[0]))
         advance();
     begin_point = i;
 }
@@ -156,7 +186,7 @@ void monster_near_iterator::advance()
     do
          if (++i >= MAX_MONSTERS)
              return;
-    while (!valid(**this));
+    while (!candidates.get(i) || !valid(**this));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -164,13 +194,13 @@ void monster_near_iterator::advance()
 monster_iterator::monster_iterator()
     : i(0)
 {
-    while (i < MAX_MONSTERS && !menv[i].alive())
+    while (i < env.mons_used && !menv[i].alive())
         i++;
 }
 
 monster_iterator::operator bool() const
 {
-    return i < MAX_MONSTERS && (*this)->alive();
+    return i < env.mons_used && (*this)->alive();
 }
 
 monster* monster_iterator::operator*() const
@@ -188,7 +218,7 @@ monster* monster_iterator::operator->() const
 
 monster_iterator& monster_iterator::operator++()
 {
-    while (++i < MAX_MONSTERS)
+    while (++i < env.mons_used)
         if (menv[i].alive())
             break;
     return *this;
@@ -204,7 +234,68 @@ monster_iterator monster_iterator::operator++(int)
 void monster_iterator::advance()
 {
     do
-         if (++i >= MAX_MONSTERS)
+         if (++i >= env.mons_used)
              return;
     while (!(*this)->alive());
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+template<class F>
+static void _scan_shape(const circle_def &shape, los_type los,
+                        bool exclude_center, F add)
+{
+    const coord_def c = shape.get_center();
+    for (rectangle_iterator ri = shape.get_bbox().iter(); ri; ++ri)
+    {
+        const coord_def p = *ri;
+        const unsigned short m = mgrd(p);
+        monster* mons = m < MAX_MONSTERS && menv[m].alive() ? &menv[m]
+                                                             : nullptr;
+        const bool has_you = p == you.pos();
+        if (!mons && !has_you)
+            continue;
+        if (exclude_center && p == c
+            || !shape.contains(p)
+            || los != LOS_NONE && !cell_see_cell(c, p, los))
+        {
+            continue;
+        }
+        add(has_you, mons);
+    }
+}
+
+vector<actor*> actors_in_shape(const circle_def &shape, los_type los,
+                               bool exclude_center)
+{
+    vector<actor*> actors;
+    _scan_shape(shape, los, exclude_center,
+                [&actors](bool has_you, monster *mons)
+                {
+                    if (has_you)
+                        actors.push_back(&you);
+                    if (mons)
+                        actors.push_back(mons);
+                });
+    return actors;
+}
+
+vector<monster*> monsters_in_shape(const circle_def &shape, los_type los,
+                                   bool exclude_center)
+{
+    vector<monster*> monsters;
+    _scan_shape(shape, los, exclude_center,
+                [&monsters](bool, monster *mons)
+                {
+                    if (mons)
+                        monsters.push_back(mons);
+                });
+    return monsters;
+}
+
+vector<actor*> actors_in_los(const coord_def &c, los_type los,
+                             bool exclude_center)
+{
+    return actors_in_shape(circle_def(c, LOS_RADIUS, C_SQUARE), los,
+                           exclude_center);
+}
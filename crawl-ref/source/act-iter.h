@@ -5,8 +5,15 @@
 
 #pragma once
 
+#include "bitary.h"
+#include "coord-circle.h"
 #include "los-type.h"
 
+// The monster slots that might be in range of a near iterator's centre,
+// gathered from the monster grid so that iteration need not touch every
+// monster object on the level.
+typedef FixedBitVector<MAX_MONSTERS> monster_slot_set;
+
 class actor_near_iterator
 {
 public:
@@ -24,6 +31,7 @@ protected:
     los_type _los;
     const actor* viewer;
     int i;
+    monster_slot_set candidates;
 
     bool valid(const actor* a) const;
     void advance();
@@ -51,6 +59,7 @@ protected:
     const actor* viewer;
     int i;
     int begin_point;
+    monster_slot_set candidates;
 
     bool valid(const monster* a) const;
     void advance();
@@ -71,3 +80,16 @@ protected:
     int i;
     void advance();
 };
+
+// The live actors inside shape that can be seen from its centre through los
+// (LOS_NONE for no restriction), read off the monster grid in row order.
+// Effects that only touch actors should walk these rather than probing every
+// cell of the area. The player comes before a monster sharing their cell.
+vector<actor*> actors_in_shape(const circle_def &shape, los_type los = LOS_NONE,
+                               bool exclude_center = false);
+vector<monster*> monsters_in_shape(const circle_def &shape,
+                                   los_type los = LOS_NONE,
+                                   bool exclude_center = false);
+// The same, for everything within los of c.
+vector<actor*> actors_in_los(const coord_def &c, los_type los,
+                             bool exclude_center = false);
@@ -0,0 +1,184 @@
+/**
+ * @file
+ * @brief Heap use per subsystem, for builds with TRACK_ALLOCATIONS.
+ *
+ * The replacement operator new puts a small header in front of each block
+ * recording its size and the tag that was current when it was allocated,
+ * so operator delete can take it off the right tag's count again.
+**/
+
+#include "AppHdr.h"
+
+#include "alloc-tag.h"
+
+#ifdef TRACK_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <unistd.h>
+#endif
+
+#include "message.h"
+
+#ifdef TRACK_ALLOCATIONS
+
+static const char *alloc_tag_names[] =
+{
+    "other", "builder", "lua", "travel", "stash", "messages", "tiles",
+};
+COMPILE_CHECK(ARRAYSZ(alloc_tag_names) == NUM_ALLOC_TAGS);
+
+// Statics of these types are zero before any constructor runs, which
+// matters because operator new is called before main().
+static atomic<int> _current_tag;
+static atomic<int64_t> _bytes[NUM_ALLOC_TAGS];
+static atomic<int64_t> _peak_bytes[NUM_ALLOC_TAGS];
+
+struct alloc_header
+{
+    size_t size;
+    alloc_tag_type tag;
+};
+
+// Enough to keep the block after it aligned for anything.
+static const size_t ALLOC_HEADER_SIZE = 16;
+COMPILE_CHECK(sizeof(alloc_header) <= ALLOC_HEADER_SIZE);
+
+alloc_tag_scope::alloc_tag_scope(alloc_tag_type tag)
+    : prev(static_cast<alloc_tag_type>(_current_tag.exchange(tag)))
+{
+}
+
+alloc_tag_scope::~alloc_tag_scope()
+{
+    _current_tag = prev;
+}
+
+void alloc_tag_adjust(alloc_tag_type tag, int64_t bytes)
+{
+    const int64_t now = _bytes[tag] += bytes;
+    int64_t peak = _peak_bytes[tag];
+    while (now > peak && !_peak_bytes[tag].compare_exchange_weak(peak, now))
+        ;
+}
+
+static void *_tracked_alloc(size_t size)
+{
+    char *block = static_cast<char *>(malloc(size + ALLOC_HEADER_SIZE));
+    if (!block)
+        return nullptr;
+
+    alloc_header *header = reinterpret_cast<alloc_header *>(block);
+    header->size = size;
+    header->tag = static_cast<alloc_tag_type>(_current_tag.load());
+    alloc_tag_adjust(header->tag, size);
+    return block + ALLOC_HEADER_SIZE;
+}
+
+static void _tracked_free(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    char *block = static_cast<char *>(ptr) - ALLOC_HEADER_SIZE;
+    const alloc_header *header = reinterpret_cast<alloc_header *>(block);
+    alloc_tag_adjust(header->tag, -static_cast<int64_t>(header->size));
+    free(block);
+}
+
+void *operator new(size_t size)
+{
+    if (void *ptr = _tracked_alloc(size))
+        return ptr;
+    throw bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const nothrow_t&) noexcept
+{
+    return _tracked_alloc(size);
+}
+
+void *operator new[](size_t size, const nothrow_t&) noexcept
+{
+    return _tracked_alloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    _tracked_free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    _tracked_free(ptr);
+}
+
+void operator delete(void *ptr, const nothrow_t&) noexcept
+{
+    _tracked_free(ptr);
+}
+
+void operator delete[](void *ptr, const nothrow_t&) noexcept
+{
+    _tracked_free(ptr);
+}
+
+static int _format_tag_line(char *buf, size_t len, int tag)
+{
+    return snprintf(buf, len, "%-9s %10" PRId64 " kB now, %10" PRId64
+                              " kB peak",
+                    alloc_tag_names[tag], _bytes[tag].load() / 1024,
+                    _peak_bytes[tag].load() / 1024);
+}
+
+/// Show the current and peak heap use of each tag.
+void alloc_tag_report()
+{
+    char buf[80];
+    for (int i = 0; i < NUM_ALLOC_TAGS; ++i)
+    {
+        _format_tag_line(buf, sizeof(buf), i);
+        mprf(MSGCH_DIAGNOSTICS, "%s", buf);
+    }
+}
+
+/**
+ * The same report on stderr, for a signal handler: the game may be waiting
+ * for a key, so this can't wait for the next message to be shown. The
+ * counters are lock-free, and nothing here allocates.
+ */
+void alloc_tag_signal(int /*sig*/)
+{
+    char buf[80];
+    for (int i = 0; i < NUM_ALLOC_TAGS; ++i)
+    {
+        const int len = min<int>(_format_tag_line(buf, sizeof(buf), i),
+                                 sizeof(buf) - 2);
+        buf[len] = '\n';
+        const ssize_t written = write(STDERR_FILENO, buf, len + 1);
+        UNUSED(written);
+    }
+}
+
+#else
+
+void alloc_tag_adjust(alloc_tag_type /*tag*/, int64_t /*bytes*/)
+{
+}
+
+void alloc_tag_report()
+{
+    mprf(MSGCH_DIAGNOSTICS, "Heap use isn't tracked in this build; rebuild "
+                            "with TRACK_ALLOCATIONS to see it.");
+}
+
+void alloc_tag_signal(int /*sig*/)
+{
+}
+
+#endif
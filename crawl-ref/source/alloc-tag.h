@@ -0,0 +1,43 @@
+/**
+ * @file
+ * @brief Heap use per subsystem, for builds with TRACK_ALLOCATIONS.
+**/
+
+#pragma once
+
+enum alloc_tag_type
+{
+    ALLOC_OTHER,
+    ALLOC_BUILDER,   // builder()
+    ALLOC_LUA,       // the clua allocator
+    ALLOC_TRAVEL,    // travel cache updates
+    ALLOC_STASH,     // stash tracker updates
+    ALLOC_MESSAGES,  // the message history
+    ALLOC_TILES,     // tiles redraws
+    NUM_ALLOC_TAGS
+};
+
+// Blocks allocated with operator new while one of these is alive count
+// against its tag, wherever they are freed. Without TRACK_ALLOCATIONS it
+// does nothing at all.
+class alloc_tag_scope
+{
+public:
+#ifdef TRACK_ALLOCATIONS
+    explicit alloc_tag_scope(alloc_tag_type tag);
+    ~alloc_tag_scope();
+#else
+    explicit alloc_tag_scope(alloc_tag_type) { }
+#endif
+
+    alloc_tag_scope(const alloc_tag_scope&) = delete;
+    alloc_tag_scope& operator=(const alloc_tag_scope&) = delete;
+#ifdef TRACK_ALLOCATIONS
+private:
+    alloc_tag_type prev;
+#endif
+};
+
+void alloc_tag_adjust(alloc_tag_type tag, int64_t bytes);
+void alloc_tag_report();
+void alloc_tag_signal(int sig);
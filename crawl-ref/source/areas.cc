@@ -60,11 +60,58 @@ static propgrid_t _agrid;
 static bool _agrid_valid = false;
 static bool no_areas = false;
 
+// The areas an actor's move can take back: silence, halo and umbra. Each
+// cell counts the sources covering it, so one source leaving doesn't clear
+// a flag that another (or sunlight) still puts there.
+static const int NUM_MOVING_AREAS = 3;
+static const areaprop _moving_props[NUM_MOVING_AREAS] =
+    { areaprop::silence, areaprop::halo, areaprop::umbra };
+
+struct moving_area_counts
+{
+    uint16_t n[NUM_MOVING_AREAS];
+};
+static FixedArray<moving_area_counts, GXM, GYM> _agrid_counts;
+
+// What one actor added to the grid at the last rebuild.
+struct actor_area_source
+{
+    const actor *who;
+    mid_t mid;
+    coord_def pos;
+    int radius[NUM_MOVING_AREAS];
+    int centre[NUM_MOVING_AREAS];   // index into _agrid_centres
+    vector<coord_def> cells[NUM_MOVING_AREAS];
+};
+
+// The area actors in the order _update_agrid() met them, and what the rest
+// of the grid was built from, so _move_actor_areas() can tell whether a
+// rebuild would find anything else different.
+static vector<actor_area_source> _agrid_sources;
+static bool _agrid_has_liquid = false;
+static coord_def _agrid_you_pos;
+static bool _agrid_had_orb = false;
+static bool _agrid_had_quad = false;
+static bool _agrid_had_disjunction = false;
+
 static void _set_agrid_flag(const coord_def& p, areaprop f)
 {
     _agrid(p) |= f;
 }
 
+static void _add_moving_area(const coord_def& p, int which)
+{
+    ++_agrid_counts(p).n[which];
+    _set_agrid_flag(p, _moving_props[which]);
+}
+
+static void _remove_moving_area(const coord_def& p, int which)
+{
+    ASSERT(_agrid_counts(p).n[which]);
+    if (!--_agrid_counts(p).n[which])
+        _agrid(p) &= ~_moving_props[which];
+}
+
 static bool _check_agrid_flag(const coord_def& p, areaprop f)
 {
     return bool(_agrid(p) & f);
@@ -77,6 +124,112 @@ void invalidate_agrid(bool recheck_new)
         no_areas = false;
 }
 
+static void _moving_area_radii(const actor *a, int radius[NUM_MOVING_AREAS])
+{
+    radius[0] = a->silence_radius();
+    radius[1] = a->halo_radius();
+    radius[2] = a->umbra_radius();
+}
+
+// Silence goes through walls; halos and umbras don't.
+static void _find_moving_area_cells(const coord_def &c, int which, int r,
+                                    vector<coord_def> &cells)
+{
+    cells.clear();
+    if (which == 0)
+    {
+        for (radius_iterator ri(c, r, C_SQUARE); ri; ++ri)
+            cells.push_back(*ri);
+    }
+    else
+    {
+        for (radius_iterator ri(c, r, C_SQUARE, LOS_DEFAULT); ri; ++ri)
+            cells.push_back(*ri);
+    }
+}
+
+/**
+ * Move one actor's silence, halo and umbra on a valid grid, if a rebuild
+ * would find nothing else different.
+ *
+ * That holds when every other area actor is where it was at the last
+ * rebuild, with the same radii, and no player-centred area has moved. Any
+ * liquefaction forces a rebuild, since it also depends on the terrain.
+ *
+ * @param act       The actor that moved.
+ * @param oldpos    Where it was.
+ * @return          Whether the grid was updated; if not, the caller should
+ *                  invalidate it.
+ */
+static bool _move_actor_areas(const actor *act, const coord_def &oldpos)
+{
+    if (!_agrid_valid || no_areas || act->is_player() || _agrid_has_liquid)
+        return false;
+
+    if (you.pos() != _agrid_you_pos
+        || player_has_orb() != _agrid_had_orb
+        || bool(you.duration[DUR_QUAD_DAMAGE]) != _agrid_had_quad
+        || bool(you.duration[DUR_DISJUNCTION]) != _agrid_had_disjunction)
+    {
+        return false;
+    }
+
+    // Check that a rebuild would meet the same sources in the same order.
+    actor_area_source *moved = nullptr;
+    size_t next = 0;
+    auto same_source = [&](const actor *a) -> bool
+    {
+        int radius[NUM_MOVING_AREAS];
+        _moving_area_radii(a, radius);
+        const bool source = a->liquefying_radius() >= 0
+                            || radius[0] >= 0 || radius[1] >= 0
+                            || radius[2] >= 0;
+        if (!source)
+            return true;
+
+        if (next >= _agrid_sources.size() || a->liquefying_radius() >= 0)
+            return false;
+
+        actor_area_source &src = _agrid_sources[next++];
+        if (src.who != a || src.mid != a->mid
+            || src.pos != (a == act ? oldpos : a->pos()))
+        {
+            return false;
+        }
+        for (int i = 0; i < NUM_MOVING_AREAS; ++i)
+            if (src.radius[i] != radius[i])
+                return false;
+
+        if (a == act)
+            moved = &src;
+        return true;
+    };
+
+    if (!same_source(&you))
+        return false;
+    for (monster_iterator mi; mi; ++mi)
+        if (!same_source(*mi))
+            return false;
+    if (next != _agrid_sources.size() || !moved)
+        return false;
+
+    for (int i = 0; i < NUM_MOVING_AREAS; ++i)
+    {
+        if (moved->radius[i] < 0)
+            continue;
+
+        for (const coord_def &c : moved->cells[i])
+            _remove_moving_area(c, i);
+        _find_moving_area_cells(act->pos(), i, moved->radius[i],
+                                moved->cells[i]);
+        for (const coord_def &c : moved->cells[i])
+            _add_moving_area(c, i);
+        _agrid_centres[moved->centre[i]].centre = act->pos();
+    }
+    moved->pos = act->pos();
+    return true;
+}
+
 void areas_actor_moved(const actor* act, const coord_def& oldpos)
 {
     if (act->alive() &&
@@ -84,6 +237,11 @@ void areas_actor_moved(const actor* act, const coord_def& oldpos)
          || act->halo_radius() > -1 || act->silence_radius() > -1
          || act->liquefying_radius() > -1 || act->umbra_radius() > -1))
     {
+        // A monster carrying a halo or silence around doesn't need the
+        // whole grid rebuilt for each step.
+        if (!you.entering_level && _move_actor_areas(act, oldpos))
+            return;
+
         // Not necessarily new, but certainly potentially interesting.
         invalidate_agrid(true);
     }
@@ -93,22 +251,35 @@ static void _actor_areas(actor *a)
 {
     int r;
 
-    if ((r = a->silence_radius()) >= 0)
+    actor_area_source src;
+    src.who = a;
+    src.mid = a->mid;
+    src.pos = a->pos();
+    _moving_area_radii(a, src.radius);
+    bool any = false;
+
+    if ((r = src.radius[0]) >= 0)
     {
+        src.centre[0] = _agrid_centres.size();
         _agrid_centres.emplace_back(AREA_SILENCE, a->pos(), r);
 
-        for (radius_iterator ri(a->pos(), r, C_SQUARE); ri; ++ri)
-            _set_agrid_flag(*ri, areaprop::silence);
+        _find_moving_area_cells(a->pos(), 0, r, src.cells[0]);
+        for (const coord_def &c : src.cells[0])
+            _add_moving_area(c, 0);
         no_areas = false;
+        any = true;
     }
 
-    if ((r = a->halo_radius()) >= 0)
+    if ((r = src.radius[1]) >= 0)
     {
+        src.centre[1] = _agrid_centres.size();
         _agrid_centres.emplace_back(AREA_HALO, a->pos(), r);
 
-        for (radius_iterator ri(a->pos(), r, C_SQUARE, LOS_DEFAULT); ri; ++ri)
-            _set_agrid_flag(*ri, areaprop::halo);
+        _find_moving_area_cells(a->pos(), 1, r, src.cells[1]);
+        for (const coord_def &c : src.cells[1])
+            _add_moving_area(c, 1);
         no_areas = false;
+        any = true;
     }
 
     if ((r = a->liquefying_radius()) >= 0)
@@ -125,16 +296,23 @@ static void _actor_areas(actor *a)
                 _set_agrid_flag(*ri, areaprop::actual_liquid);
         }
         no_areas = false;
+        _agrid_has_liquid = true;
     }
 
-    if ((r = a->umbra_radius()) >= 0)
+    if ((r = src.radius[2]) >= 0)
     {
+        src.centre[2] = _agrid_centres.size();
         _agrid_centres.emplace_back(AREA_UMBRA, a->pos(), r);
 
-        for (radius_iterator ri(a->pos(), r, C_SQUARE, LOS_DEFAULT); ri; ++ri)
-            _set_agrid_flag(*ri, areaprop::umbra);
+        _find_moving_area_cells(a->pos(), 2, r, src.cells[2]);
+        for (const coord_def &c : src.cells[2])
+            _add_moving_area(c, 2);
         no_areas = false;
+        any = true;
     }
+
+    if (any)
+        _agrid_sources.push_back(move(src));
 }
 
 /**
@@ -152,7 +330,14 @@ static void _update_agrid()
     }
 
     _agrid.init(areaprops());
+    _agrid_counts.init(moving_area_counts());
     _agrid_centres.clear();
+    _agrid_sources.clear();
+    _agrid_has_liquid = false;
+    _agrid_you_pos = you.pos();
+    _agrid_had_orb = player_has_orb();
+    _agrid_had_quad = you.duration[DUR_QUAD_DAMAGE];
+    _agrid_had_disjunction = you.duration[DUR_DISJUNCTION];
 
     no_areas = true;
 
@@ -198,7 +383,7 @@ static void _update_agrid()
     if (!env.sunlight.empty())
     {
         for (const auto &entry : env.sunlight)
-            _set_agrid_flag(entry.first, areaprop::halo);
+            _add_moving_area(entry.first, 1);
         no_areas = false;
     }
 
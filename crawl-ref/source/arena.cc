@@ -119,6 +119,10 @@ namespace arena
 
     static bool miscasts            = false;
 
+    // Run rounds back to back with no drawing, messages or delays, and
+    // record each one in csv_file.
+    static bool headless            = false;
+
     static int  summon_throttle     = INT_MAX;
 
     static vector<monster_type> uniques_list;
@@ -139,6 +143,7 @@ namespace arena
     static uint32_t cycle_random_pos = 0;
 
     static FILE *file = nullptr;
+    static FILE *csv_file = nullptr;
     static level_id place(BRANCH_DEPTHS, 1);
 
     static void adjust_spells(monster* mons, bool no_summons, bool no_animate)
@@ -339,9 +344,11 @@ namespace arena
         cycle_random   = strip_tag(spec, "cycle_random");
         name_monsters  = strip_tag(spec, "names");
         random_uniques = strip_tag(spec, "random_uniques");
+        headless       = strip_tag(spec, "headless");
 
         const int ntrials = strip_number_tag(spec, "t:");
-        if (ntrials != TAG_UNFOUND && ntrials >= 1 && ntrials <= 99
+        if (ntrials != TAG_UNFOUND && ntrials >= 1
+            && ntrials <= (headless ? 1000000 : 99)
             && !total_trials)
         {
             total_trials = ntrials;
@@ -353,7 +360,9 @@ namespace arena
             arena_type = "default";
 
         const int arena_delay = strip_number_tag(spec, "delay:");
-        if (arena_delay >= 0 && arena_delay < 2000)
+        if (headless)
+            Options.view_delay = 0;
+        else if (arena_delay >= 0 && arena_delay < 2000)
             Options.view_delay = arena_delay;
 
         string arena_place = strip_tag_prefix(spec, "arena_place:");
@@ -438,6 +447,9 @@ namespace arena
 
     static void show_fight_banner(bool after_fight = false)
     {
+        if (headless)
+            return;
+
         int line = 1;
 
         cgotoxy(1, line++, GOTO_STAT);
@@ -784,7 +796,11 @@ namespace arena
 
     static void do_fight()
     {
-        viewwindow();
+        // Messages are only kept in headless mode if they're to be dumped.
+        no_messages mx(headless && !Options.arena_dump_msgs);
+
+        if (!headless)
+            viewwindow();
         clear_messages(true);
         {
             cursor_control coff(false);
@@ -808,7 +824,8 @@ namespace arena
                 if ((turns++ % 100) == 0)
                     count_foes();
 
-                viewwindow();
+                if (!headless)
+                    viewwindow();
                 you.time_taken = 10;
                 // Make sure we don't starve.
                 you.hunger = HUNGER_MAXIMUM;
@@ -818,12 +835,14 @@ namespace arena
                 do_respawn(faction_a);
                 do_respawn(faction_b);
                 balance_spawners();
-                delay(Options.view_delay);
+                if (!headless)
+                    delay(Options.view_delay);
                 clear_messages();
                 dump_messages();
                 ASSERT(you.pet_target == MHITNOT);
             }
-            viewwindow();
+            if (!headless)
+                viewwindow();
         }
 
         clear_messages();
@@ -880,6 +899,14 @@ namespace arena
         else if (faction_a.won)
             team_a_wins++;
 
+        if (csv_file != nullptr)
+        {
+            fprintf(csv_file, "%d,%s,%d,%d,%d\n", trials_done,
+                    was_tied ? "tie" : faction_a.won ? "a" : "b",
+                    turns, faction_a.active_members,
+                    faction_b.active_members);
+        }
+
         show_fight_banner(true);
 
         string msg;
@@ -940,6 +967,13 @@ namespace arena
                 fprintf(file, "========================================\n");
         }
 
+        if (headless)
+        {
+            csv_file = fopen("arena.csv", "w");
+            if (csv_file != nullptr)
+                fprintf(csv_file, "round,winner,turns,a_left,b_left\n");
+        }
+
         expand_mlist(5);
 
         for (monster_type i = MONS_0; i < NUM_MONSTERS; ++i)
@@ -956,8 +990,11 @@ namespace arena
     {
         if (file != nullptr)
             fclose(file);
+        if (csv_file != nullptr)
+            fclose(csv_file);
 
         file = nullptr;
+        csv_file = nullptr;
     }
 
     static void write_results()
@@ -1000,7 +1037,7 @@ namespace arena
             }
             do_fight();
 
-            if (trials_done < total_trials)
+            if (trials_done < total_trials && !headless)
                 delay(Options.view_delay * 5);
         }
         while (!contest_cancelled && trials_done < total_trials);
@@ -1012,7 +1049,8 @@ namespace arena
                  faction_b.desc.c_str(), trials_done - team_a_wins - ties,
                  ties);
         }
-        delay(Options.view_delay * 5);
+        if (!headless)
+            delay(Options.view_delay * 5);
 
         write_results();
     }
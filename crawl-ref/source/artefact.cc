@@ -984,10 +984,11 @@ void artefact_properties(const item_def &item,
                          artefact_known_props_t &known)
 {
     ASSERT(is_artefact(item));
-    if (!item.props.exists(KNOWN_PROPS_KEY))
+    const CrawlStoreValue *known_props = item.props.find_value(KNOWN_PROPS_KEY);
+    if (!known_props)
         return;
 
-    const CrawlStoreValue &_val = item.props[KNOWN_PROPS_KEY];
+    const CrawlStoreValue &_val = *known_props;
     ASSERT(_val.get_type() == SV_VEC);
     const CrawlVector &known_vec = _val.get_vector();
     ASSERT(known_vec.get_type()     == SV_BOOL);
@@ -1005,10 +1006,9 @@ void artefact_properties(const item_def &item,
             known[i] = known_vec[i];
     }
 
-    if (item.props.exists(ARTEFACT_PROPS_KEY))
+    if (const CrawlStoreValue *rap = item.props.find_value(ARTEFACT_PROPS_KEY))
     {
-        const CrawlVector &rap_vec =
-            item.props[ARTEFACT_PROPS_KEY].get_vector();
+        const CrawlVector &rap_vec = rap->get_vector();
         ASSERT(rap_vec.get_type()     == SV_SHORT);
         ASSERT(rap_vec.size()         == ART_PROPERTIES);
         ASSERT(rap_vec.get_max_size() == ART_PROPERTIES);
@@ -1038,15 +1038,26 @@ void artefact_properties(const item_def &item,
 int artefact_property(const item_def &item, artefact_prop_type prop,
                       bool &_known)
 {
-    artefact_properties_t  proprt;
-    artefact_known_props_t known;
-    proprt.init(0);
-    known.init(0);
+    ASSERT(is_artefact(item));
+    // The player's properties are summed from this over every equipped
+    // artefact, so look up the one property wanted rather than unpacking
+    // them all as artefact_properties() does.
+    _known = false;
+    const CrawlStoreValue *known_props = item.props.find_value(KNOWN_PROPS_KEY);
+    if (!known_props)
+        return 0;
 
-    artefact_properties(item, proprt, known);
+    _known = item_ident(item, ISFLAG_KNOW_PROPERTIES)
+             || known_props->get_vector()[prop].get_bool();
 
-    _known = known[prop];
+    if (const CrawlStoreValue *rap = item.props.find_value(ARTEFACT_PROPS_KEY))
+        return rap->get_vector()[prop].get_short();
+    else if (is_unrandom_artefact(item))
+        return static_cast<short>(_seekunrandart(item)->prpty[prop]);
 
+    artefact_properties_t proprt;
+    proprt.init(0);
+    _get_randart_properties(item, proprt);
     return proprt[prop];
 }
 
@@ -1059,17 +1070,10 @@ int artefact_property(const item_def &item, artefact_prop_type prop)
 
 int artefact_known_property(const item_def &item, artefact_prop_type prop)
 {
-    artefact_properties_t  proprt;
-    artefact_known_props_t known;
-    proprt.init(0);
-    known.init(0);
-
-    artefact_properties(item, proprt, known);
+    bool known;
+    const int val = artefact_property(item, prop, known);
 
-    if (known[prop])
-        return proprt[prop];
-    else
-        return 0;
+    return known ? val : 0;
 }
 
 static int _artefact_num_props(const artefact_properties_t &proprt)
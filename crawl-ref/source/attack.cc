@@ -471,13 +471,21 @@ bool attack::distortion_affects_defender()
     switch (choice)
     {
     case SMALL_DMG:
-        special_damage_message = make_stringf("Space bends around %s.",
-                                              defender_name(false).c_str());
+        if (attacker_visible || defender_visible)
+        {
+            special_damage_message =
+                make_stringf("Space bends around %s.",
+                             defender_name(false).c_str());
+        }
         special_damage += 1 + random2avg(7, 2);
         break;
     case BIG_DMG:
-        special_damage_message = make_stringf("Space warps horribly around %s!",
-                                              defender_name(false).c_str());
+        if (attacker_visible || defender_visible)
+        {
+            special_damage_message =
+                make_stringf("Space warps horribly around %s!",
+                             defender_name(false).c_str());
+        }
         special_damage += 3 + random2avg(24, 2);
         break;
     case BLINK:
@@ -1517,11 +1525,14 @@ bool attack::apply_damage_brand(const char *what)
             break;
         else if (one_chance_in(3))
         {
-            special_damage_message =
-                defender->is_player()?
-                   "You are electrocuted!"
-                :  make_stringf("Lightning courses through %s!",
-                                defender->name(DESC_THE).c_str());
+            if (attacker_visible || defender_visible)
+            {
+                special_damage_message =
+                    defender->is_player()?
+                       "You are electrocuted!"
+                    :  make_stringf("Lightning courses through %s!",
+                                    defender->name(DESC_THE).c_str());
+            }
             special_damage = 8 + random2(13);
             special_damage_flavour = BEAM_ELECTRICITY;
             defender->expose_to_element(BEAM_ELECTRICITY, 2);
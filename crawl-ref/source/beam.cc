@@ -1049,6 +1049,9 @@ void bolt::fire()
 {
     path_taken.clear();
 
+    if (!is_tracer)
+        invalidate_tracer_memo();
+
     if (special_explosion)
         special_explosion->is_tracer = is_tracer;
 
@@ -2041,6 +2044,92 @@ int silver_damages_victim(actor* victim, int damage, string &dmg_msg)
     return ret;
 }
 
+struct tracer_memo_entry
+{
+    bolt input;
+    bool explode_only;
+    bool explosion_hole;
+    bolt result;
+};
+
+static vector<tracer_memo_entry> _tracer_memo;
+static int _tracer_memo_depth = 0;
+
+tracer_memo_scope::tracer_memo_scope()
+{
+    if (!_tracer_memo_depth++)
+        _tracer_memo.clear();
+}
+
+tracer_memo_scope::~tracer_memo_scope()
+{
+    if (!--_tracer_memo_depth)
+        _tracer_memo.clear();
+}
+
+void invalidate_tracer_memo()
+{
+    _tracer_memo.clear();
+}
+
+// Would tracing these two beams give the same result, all else being equal?
+// This has to cover everything a caller may have set before the trace.
+static bool _same_tracer_input(const bolt &a, const bolt &b)
+{
+    return a.origin_spell == b.origin_spell
+           && a.range == b.range
+           && a.glyph == b.glyph
+           && a.colour == b.colour
+           && a.flavour == b.flavour
+           && a.real_flavour == b.real_flavour
+           && a.drop_item == b.drop_item
+           && a.item == b.item
+           && a.source == b.source
+           && a.target == b.target
+           && a.damage.num == b.damage.num
+           && a.damage.size == b.damage.size
+           && a.ench_power == b.ench_power
+           && a.hit == b.hit
+           && a.thrower == b.thrower
+           && a.ex_size == b.ex_size
+           && a.source_id == b.source_id
+           && a.source_name == b.source_name
+           && a.name == b.name
+           && a.short_name == b.short_name
+           && a.hit_verb == b.hit_verb
+           && a.loudness == b.loudness
+           && a.hit_noise_msg == b.hit_noise_msg
+           && a.explode_noise_msg == b.explode_noise_msg
+           && a.pierce == b.pierce
+           && a.is_explosion == b.is_explosion
+           && a.aimed_at_spot == b.aimed_at_spot
+           && a.aux_source == b.aux_source
+           && a.affects_nothing == b.affects_nothing
+           && a.effect_known == b.effect_known
+           && a.effect_wanton == b.effect_wanton
+           && a.was_missile == b.was_missile
+           && a.ac_rule == b.ac_rule
+           && a.obvious_effect == b.obvious_effect
+           && a.seen == b.seen
+           && a.heard == b.heard
+           && a.is_targeting == b.is_targeting
+           && a.aimed_at_feet == b.aimed_at_feet
+           && a.msg_generated == b.msg_generated
+           && a.noise_generated == b.noise_generated
+           && a.passed_target == b.passed_target
+           && a.attitude == b.attitude
+           && a.foe_ratio == b.foe_ratio
+           && a.hit_count == b.hit_count
+           && a.foe_info.dont_stop == b.foe_info.dont_stop
+           && a.friend_info.dont_stop == b.friend_info.dont_stop
+           && a.beam_cancelled == b.beam_cancelled
+           && a.dont_stop_player == b.dont_stop_player
+           && a.dont_stop_trees == b.dont_stop_trees
+           && a.reflector == b.reflector
+           && a.use_target_as_pos == b.use_target_as_pos
+           && a.auto_hit == b.auto_hit;
+}
+
 //  Used by monsters in "planning" which spell to cast. Fires off a "tracer"
 //  which tells the monster what it'll hit if it breathes/casts etc.
 //
@@ -2085,6 +2174,25 @@ void fire_tracer(const monster* mons, bolt &pbolt, bool explode_only,
 
     pbolt.in_explosion_phase = false;
 
+    // Beams carrying their own explosion or a preselected ray have state
+    // we can't compare, so always trace those.
+    const bool memoise = _tracer_memo_depth
+                         && !pbolt.special_explosion && !pbolt.chose_ray;
+    if (memoise)
+    {
+        for (const tracer_memo_entry &entry : _tracer_memo)
+        {
+            if (entry.explode_only == explode_only
+                && entry.explosion_hole == explosion_hole
+                && _same_tracer_input(entry.input, pbolt))
+            {
+                pbolt = entry.result;
+                return;
+            }
+        }
+    }
+    const bolt input = memoise ? pbolt : bolt();
+
     // Fire!
     if (explode_only)
         pbolt.explode(false, explosion_hole);
@@ -2093,6 +2201,9 @@ void fire_tracer(const monster* mons, bolt &pbolt, bool explode_only,
 
     // Unset tracer flag (convenience).
     pbolt.is_tracer = false;
+
+    if (memoise)
+        _tracer_memo.push_back({input, explode_only, explosion_hole, pbolt});
 }
 
 static coord_def _random_point_hittable_from(const coord_def &c,
@@ -5778,6 +5889,9 @@ bool bolt::explode(bool show_more, bool hole_in_the_middle)
     ASSERT(!in_explosion_phase);
     ASSERT(ex_size >= 0);
 
+    if (!is_tracer)
+        invalidate_tracer_memo();
+
     // explode() can be called manually without setting real_flavour.
     // FIXME: The entire flavour/real_flavour thing needs some
     // rewriting!
@@ -5943,10 +6057,124 @@ void bolt::explosion_affect_cell(const coord_def& p)
     target = orig_pos;
 }
 
-// Uses DFS
+// Fills m with the cost of the cheapest way the explosion can reach each
+// cell (INT_MAX if it can't). Moving outwards costs 5, circling the centre
+// is free and turning back on yourself (around a wall, say) costs 17;
+// nothing costing more than 10*r is reached.
+//
+// Every step cost depends only on the cells involved, so this is a plain
+// shortest-path search. Costs are small integers, so the search keeps one
+// bucket of cells per cost and settles each cell just once, working out
+// whether the explosion can enter it the first time it's reached.
 void bolt::determine_affected_cells(explosion_map& m, const coord_def& delta,
                                     int count, int r,
                                     bool stop_at_statues, bool stop_at_walls)
+{
+    const coord_def centre(9,9);
+    const int max_count = 10 * r;
+    if (count > max_count)
+        return;
+
+    // If we were at a wall, we only move to squares the caster can see.
+    const actor *caster = actor_by_mid(source_id);
+    const coord_def caster_pos = caster ? caster->pos() : you.pos();
+
+    enum cell_state : uint8_t { UNKNOWN, BLOCKED, OPEN, AT_WALL, SETTLED };
+    FixedArray<uint8_t, 19, 19> state;
+    state.init(UNKNOWN);
+
+    vector<vector<coord_def>> buckets(max_count + 1);
+    buckets[count].push_back(delta);
+
+    for (int cost = count; cost <= max_count; ++cost)
+    {
+        // Free moves append to the bucket we're walking, so index it.
+        for (size_t i = 0; i < buckets[cost].size(); ++i)
+        {
+            const coord_def d = buckets[cost][i];
+            uint8_t &st = state(d + centre);
+            if (st == SETTLED || st == BLOCKED)
+                continue;
+
+            const coord_def loc = pos() + d;
+            if (st == UNKNOWN)
+            {
+                st = OPEN;
+                const dungeon_feature_type feat =
+                    map_bounds(loc) ? grd(loc) : DNGN_UNSEEN;
+
+                if (d.rdist() > centre.rdist()
+                    || d.rdist() > r
+                    || !map_bounds(loc)
+                    || is_sanctuary(loc) && flavour != BEAM_VISUAL)
+                {
+                    st = BLOCKED;
+                }
+                else if (feat_is_wall(feat) || feat_is_closed_door(feat))
+                {
+                    // Special case: explosion originates from rock/statue
+                    // (e.g. Lee's Rapid Deconstruction) - in this case,
+                    // ignore solid cells at the center of the explosion.
+                    if (stop_at_walls && !(d.origin() && can_affect_wall(loc)))
+                        st = BLOCKED;
+                    else
+                        st = AT_WALL;
+                }
+
+                if (st != BLOCKED && stop_at_statues
+                    && feat_is_solid(feat) && !feat_is_wall(feat)
+                    && !can_affect_wall(loc))
+                {
+                    st = BLOCKED;
+                }
+
+                if (st == BLOCKED)
+                    continue;
+            }
+
+            const bool at_wall = st == AT_WALL;
+            st = SETTLED;
+            m(d + centre) = min(cost, m(d + centre));
+
+            for (int j = 0; j < 8; ++j)
+            {
+                const coord_def new_delta = d + Compass[j];
+
+                if (new_delta.rdist() > centre.rdist())
+                    continue;
+
+                // Is that cell already covered?
+                if (m(new_delta + centre) <= cost)
+                    continue;
+
+                if (at_wall
+                    && !cell_see_cell(caster_pos, loc + Compass[j],
+                                      LOS_NO_TRANS))
+                {
+                    continue;
+                }
+
+                int cadd = 5;
+                // Circling around the center is always free.
+                if (d.rdist() == 1 && new_delta.rdist() == 1)
+                    cadd = 0;
+                // Otherwise changing direction (e.g. looking around a wall)
+                // costs more.
+                else if (d.x * Compass[j].x < 0 || d.y * Compass[j].y < 0)
+                    cadd = 17;
+
+                if (cost + cadd <= max_count)
+                    buckets[cost + cadd].push_back(new_delta);
+            }
+        }
+    }
+}
+
+#ifdef DEBUG_TESTS
+// The original recursive search, kept to check the one above against.
+void bolt::determine_affected_cells_dfs(explosion_map& m, const coord_def& delta,
+                                    int count, int r,
+                                    bool stop_at_statues, bool stop_at_walls)
 {
     const coord_def centre(9,9);
     const coord_def loc = pos() + delta;
@@ -6014,11 +6242,45 @@ void bolt::determine_affected_cells(explosion_map& m, const coord_def& delta,
         else if (delta.x * Compass[i].x < 0 || delta.y * Compass[i].y < 0)
             cadd = 17;
 
-        determine_affected_cells(m, new_delta, count + cadd, r,
-                                 stop_at_statues, stop_at_walls);
+        determine_affected_cells_dfs(m, new_delta, count + cadd, r,
+                                     stop_at_statues, stop_at_walls);
     }
 }
 
+// Check the explosion search against the recursive one for an explosion of
+// radius r centred on c, for each of the ways callers stop it.
+bool explosion_matches_dfs(const coord_def &c, int r)
+{
+    bolt beam;
+    beam.source = beam.target = c;
+    beam.flavour = beam.real_flavour = BEAM_FIRE;
+    beam.use_target_as_pos = true;
+
+    for (int stop = 0; stop < 4; ++stop)
+    {
+        const bool statues = stop & 1, walls = stop & 2;
+        explosion_map fast, dfs;
+        fast.init(INT_MAX);
+        dfs.init(INT_MAX);
+        beam.determine_affected_cells(fast, coord_def(), 0, r,
+                                      statues, walls);
+        beam.determine_affected_cells_dfs(dfs, coord_def(), 0, r,
+                                          statues, walls);
+        for (rectangle_iterator ri(coord_def(0, 0), coord_def(18, 18)); ri;
+             ++ri)
+        {
+            if (fast(*ri) != dfs(*ri))
+            {
+                dprf("explosion at (%d,%d) r%d stop %d: %d != %d at (%d,%d)",
+                     c.x, c.y, r, stop, fast(*ri), dfs(*ri), ri->x, ri->y);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+#endif
+
 // Returns true if the beam is harmful ((mostly) ignoring monster
 // resists) -- mon is given for 'special' cases where,
 // for example, "Heal" might actually hurt undead, or
@@ -200,6 +200,12 @@ public:
     void determine_affected_cells(explosion_map& m, const coord_def& delta,
                                   int count, int r,
                                   bool stop_at_statues, bool stop_at_walls);
+#ifdef DEBUG_TESTS
+    void determine_affected_cells_dfs(explosion_map& m, const coord_def& delta,
+                                      int count, int r,
+                                      bool stop_at_statues,
+                                      bool stop_at_walls);
+#endif
 
     // Setup.
     void fake_flavour();
@@ -319,6 +325,20 @@ bool curare_actor(actor* source, actor* target, int levels, string name,
 int silver_damages_victim(actor* victim, int damage, string &dmg_msg);
 void fire_tracer(const monster* mons, bolt &pbolt,
                   bool explode_only = false, bool explosion_hole = false);
+#ifdef DEBUG_TESTS
+bool explosion_matches_dfs(const coord_def &c, int r);
+#endif
+
+// While one of these is alive, fire_tracer() remembers its results and
+// replays them for an identical tracer instead of tracing it again. Any
+// actor moving or any real beam being fired forgets them.
+class tracer_memo_scope
+{
+public:
+    tracer_memo_scope();
+    ~tracer_memo_scope();
+};
+void invalidate_tracer_memo();
 bool imb_can_splash(coord_def origin, coord_def center,
                     vector<coord_def> path_taken, coord_def target);
 spret_type zapping(zap_type ztype, int power, bolt &pbolt,
@@ -175,6 +175,12 @@ public:
         return set(i.x, i.y, value);
     }
 
+    // Inverts every bit, a word at a time.
+    void flip()
+    {
+        data.flip();
+    }
+
     inline FixedBitArray<SIZEX, SIZEY>& operator|=(const FixedBitArray<SIZEX, SIZEY>&x)
     {
         data |= x.data;
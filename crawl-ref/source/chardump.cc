@@ -47,6 +47,7 @@
 #include "spl-util.h"
 #include "state.h"
 #include "stringutil.h"
+#include "tiles-build-specific.h"
 #include "transform.h"
 #include "travel.h"
 #include "unicode.h"
@@ -88,8 +89,8 @@ static void _sdump_separator(dump_params &);
 #ifdef CLUA_BINDINGS
 static void _sdump_lua(dump_params &);
 #endif
-static bool _write_dump(const string &fname, const dump_params &,
-                        bool print_dump_path = false);
+static bool _write_dump(const string &fname, bool full_id,
+                        const scorefile_entry *se, bool quiet);
 
 struct dump_section_handler
 {
@@ -167,8 +168,11 @@ static void dump_section(dump_params &par)
     }
 }
 
+// If out is set, each section is written to it as soon as it's done and
+// dropped, so the whole dump is never held in memory.
 static dump_params _get_dump(bool full_id = false,
-                             const scorefile_entry *se = nullptr)
+                             const scorefile_entry *se = nullptr,
+                             FILE *out = nullptr)
 {
     dump_params par("", full_id, se);
 
@@ -176,6 +180,11 @@ static dump_params _get_dump(bool full_id = false,
     {
         par.section = section;
         dump_section(par);
+        if (out)
+        {
+            fputs(OUTS(par.text), out);
+            par.text.clear();
+        }
     }
 
     // Hopefully we get RVO so we don't have to copy the text.
@@ -185,7 +194,7 @@ static dump_params _get_dump(bool full_id = false,
 bool dump_char(const string &fname, bool quiet, bool full_id,
                const scorefile_entry *se)
 {
-    return _write_dump(fname, _get_dump(full_id, se), quiet);
+    return _write_dump(fname, full_id, se, quiet);
 }
 
 static void _sdump_header(dump_params &par)
@@ -1560,34 +1569,40 @@ void dump_map(const char* fname, bool debug, bool dist)
     fclose(fp);
 }
 
-static bool _write_dump(const string &fname, const dump_params &par, bool quiet)
+static bool _write_dump(const string &fname, bool full_id,
+                        const scorefile_entry *se, bool quiet)
 {
     bool succeeded = false;
 
-    string file_name = morgue_directory();
+    const string base_name = morgue_directory()
+                             + strip_filename_unsafe_chars(fname);
+
+    // Write the dump first, so that its sections see the game as it was
+    // before the stash list updates corpses.
+    const string file_name = base_name + ".txt";
+    FILE *handle = fopen_replace(file_name.c_str());
+
+    dprf("File name: %s", file_name.c_str());
 
-    file_name += strip_filename_unsafe_chars(fname);
+    if (handle != nullptr)
+    {
+        _get_dump(full_id, se, handle);
+        fclose(handle);
+        succeeded = true;
+    }
 
     StashTrack.update_corpses();
 
     string stash_file_name;
-    stash_file_name = file_name;
+    stash_file_name = base_name;
     stash_file_name += ".lst";
-    StashTrack.dump(stash_file_name.c_str(), par.full_id);
+    StashTrack.dump(stash_file_name.c_str(), full_id);
 
-    string map_file_name = file_name + ".map";
+    string map_file_name = base_name + ".map";
     dump_map(map_file_name.c_str());
 
-    file_name += ".txt";
-    FILE *handle = fopen_replace(file_name.c_str());
-
-    dprf("File name: %s", file_name.c_str());
-
-    if (handle != nullptr)
+    if (succeeded)
     {
-        fputs(OUTS(par.text), handle);
-        fclose(handle);
-        succeeded = true;
         if (!quiet)
 #ifdef DGAMELAUNCH
             mpr("Char dumped successfully.");
@@ -1658,14 +1673,20 @@ void whereis_record(const char *status)
                              + strip_filename_unsafe_chars(you.your_name)
                              + string(".where");
 
+    const string line = make_stringf("%s:status=%s",
+                                     xlog_status_line().c_str(),
+                                     status? status : "");
+
     if (FILE *handle = fopen_replace(file_name.c_str()))
     {
         // no need to bother with supporting ancient charsets for DGL
-        fprintf(handle, "%s:status=%s\n",
-                xlog_status_line().c_str(),
-                status? status : "");
+        fprintf(handle, "%s\n", line.c_str());
         fclose(handle);
     }
+
+#ifdef USE_TILE_WEB
+    tiles.send_game_event("where", line);
+#endif
 }
 #endif
 
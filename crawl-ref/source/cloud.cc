@@ -39,9 +39,60 @@
 #include "tiledef-main.h"
 #include "unwind.h"
 
+cloud_grid::cloud_grid()
+{
+    slot.init(NO_CLOUD);
+}
+
+cloud_struct *cloud_grid::find(const coord_def &p)
+{
+    if (!map_bounds(p) || slot(p) == NO_CLOUD)
+        return nullptr;
+    return &clouds[slot(p)].second;
+}
+
+const cloud_struct *cloud_grid::find(const coord_def &p) const
+{
+    if (!map_bounds(p) || slot(p) == NO_CLOUD)
+        return nullptr;
+    return &clouds[slot(p)].second;
+}
+
+cloud_struct &cloud_grid::operator[](const coord_def &p)
+{
+    ASSERT_IN_BOUNDS(p);
+    if (slot(p) == NO_CLOUD)
+    {
+        slot(p) = clouds.size();
+        clouds.emplace_back(p, cloud_struct());
+    }
+    return clouds[slot(p)].second;
+}
+
+void cloud_grid::erase(const coord_def &p)
+{
+    if (!map_bounds(p) || slot(p) == NO_CLOUD)
+        return;
+
+    const int i = slot(p);
+    slot(p) = NO_CLOUD;
+    if (i != (int) clouds.size() - 1)
+    {
+        clouds[i] = clouds.back();
+        slot(clouds[i].first) = i;
+    }
+    clouds.pop_back();
+}
+
+void cloud_grid::clear()
+{
+    slot.init(NO_CLOUD);
+    clouds.clear();
+}
+
 cloud_struct* cloud_at(coord_def pos)
 {
-    return map_find(env.cloud, pos);
+    return env.cloud.find(pos);
 }
 
 /// damage = base + random2avg(random, random/15 + 1)
@@ -563,15 +614,16 @@ static void _handle_spectral_cloud(const cloud_struct& cloud)
 
 void manage_clouds()
 {
-    // We can't iterate over env.cloud directly because _dissipate_cloud
-    // will remove this cloud and invalidate our iterator.
-    vector<cloud_struct *> cloud_ptrs;
-    for (auto& entry : env.cloud)
-        cloud_ptrs.push_back(&entry.second);
-
-    for (auto ptr : cloud_ptrs)
+    // Walk the clouds from the back: _dissipate_cloud may remove the
+    // current cloud, which moves the last one (already handled, or new this
+    // turn) into its slot, and clouds spread this turn are only ever added
+    // past the ones we have yet to visit.
+    for (int i = env.cloud.size() - 1; i >= 0; --i)
     {
-        cloud_struct& cloud = *ptr;
+        if (i >= (int) env.cloud.size())
+            continue;
+
+        cloud_struct& cloud = env.cloud.at_index(i).second;
 
 #ifdef ASSERTS
         if (cell_is_solid(cloud.pos))
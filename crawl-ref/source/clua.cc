@@ -3,7 +3,9 @@
 #include "clua.h"
 
 #include <algorithm>
+#include <chrono>
 
+#include "alloc-tag.h"
 #include "cluautil.h"
 #include "dlua.h"
 #include "end.h"
@@ -56,8 +58,8 @@ CLua::CLua(bool managed)
       throttle_sleep_ms(0), throttle_sleep_start(2),
       throttle_sleep_end(800), n_throttle_sleeps(0), mixed_call_depth(0),
       lua_call_depth(0), max_mixed_call_depth(8),
-      max_lua_call_depth(100), memory_used(0),
-      _state(nullptr), sourced_files(), uniqindex(0)
+      max_lua_call_depth(100), memory_used(0), memory_allocated(0),
+      _state(nullptr), sourced_files(), uniqindex(0), gc_idle_kb(0)
 {
 }
 
@@ -126,6 +128,43 @@ void CLua::gc()
     lua_gc(state(), LUA_GCCOLLECT, 0);
 }
 
+// Sets the incremental collector's pause and step multiplier, as percentages
+// (see the Lua manual). Values of zero leave the current setting alone.
+void CLua::tune_gc(int pause, int stepmul)
+{
+    if (pause > 0)
+        lua_gc(state(), LUA_GCSETPAUSE, pause);
+    if (stepmul > 0)
+        lua_gc(state(), LUA_GCSETSTEPMUL, stepmul);
+}
+
+// Runs the incremental collector for up to max_ms while nothing else is
+// happening, so that less of its work lands inside per-turn callbacks.
+// Does nothing unless the heap has grown noticeably since the last cycle
+// finished here.
+void CLua::idle_gc(int max_ms)
+{
+    if (!_state || max_ms <= 0 || mixed_call_depth)
+        return;
+
+    const int kb = lua_gc(_state, LUA_GCCOUNT, 0);
+    // The regular collector may have got there first.
+    gc_idle_kb = min(gc_idle_kb, kb);
+    if (kb < gc_idle_kb + max(64, gc_idle_kb / 4))
+        return;
+
+    const auto start = chrono::steady_clock::now();
+    const auto budget = chrono::milliseconds(max_ms);
+    while (chrono::steady_clock::now() - start < budget)
+    {
+        if (lua_gc(_state, LUA_GCSTEP, 0))
+        {
+            gc_idle_kb = lua_gc(_state, LUA_GCCOUNT, 0);
+            break;
+        }
+    }
+}
+
 void CLua::save(writer &outf)
 {
     if (!_state)
@@ -1073,6 +1112,8 @@ static void *_clua_allocator(void *ud, void *ptr, size_t osize, size_t nsize)
 {
     CLua *cl = static_cast<CLua *>(ud);
     cl->memory_used += nsize - osize;
+    if (nsize > osize)
+        cl->memory_allocated += nsize - osize;
 
     if (nsize > osize && cl->memory_used >= CLUA_MAX_MEMORY_USE * 1024
         && cl->mixed_call_depth)
@@ -1080,6 +1121,8 @@ static void *_clua_allocator(void *ud, void *ptr, size_t osize, size_t nsize)
         return nullptr;
     }
 
+    alloc_tag_adjust(ALLOC_LUA, static_cast<int64_t>(nsize) - osize);
+
     if (!nsize)
     {
         free(ptr);
@@ -102,6 +102,8 @@ public:
     void save_persist();
     void load_persist();
     void gc();
+    void tune_gc(int pause, int stepmul);
+    void idle_gc(int max_ms);
 
     void setglobal(const char *name);
     void getglobal(const char *name);
@@ -161,6 +163,9 @@ public:
     int max_lua_call_depth;
 
     long memory_used;
+    // Total bytes ever allocated, so callers can see how much a stretch of
+    // Lua allocated. Only counted for managed VMs.
+    long memory_allocated;
 
     static const int MAX_THROTTLE_SLEEPS = 100;
 
@@ -170,6 +175,9 @@ private:
     sfset sourced_files;
     unsigned int uniqindex;
 
+    // Heap size in KB when idle_gc() last finished a cycle.
+    int gc_idle_kb;
+
     vector<lua_shutdown_listener*> shutdown_listeners;
 
 private:
@@ -21,9 +21,10 @@ static map<string, element_colour_calc*> element_colours_str;
 
 typedef vector< pair<int, int> > random_colour_map;
 typedef int (*randomized_element_colour_calculator)(int, const coord_def&,
-                                                    random_colour_map);
+                                                    const random_colour_map &);
 
-static int _randomized_element_colour(int, const coord_def&, random_colour_map);
+static int _randomized_element_colour(int, const coord_def&,
+                                      const random_colour_map &);
 
 struct random_element_colour_calc : public element_colour_calc
 {
@@ -122,7 +123,7 @@ static bool _is_element_colour(int col)
 }
 
 static int _randomized_element_colour(int rand, const coord_def&,
-                                      random_colour_map rand_vals)
+                                      const random_colour_map &rand_vals)
 {
     int accum = 0;
     for (const auto &entry : rand_vals)
@@ -32,3 +32,4 @@ int show_keyhelp_menu(const vector<formatted_string> &lines,
 
 // XXX: Actually defined in main.cc; we may want to move this to command.cc.
 void process_command(command_type cmd);
+void replay_input();
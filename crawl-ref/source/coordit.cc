@@ -167,22 +167,77 @@ void random_rectangle_iterator::operator++(int)
 /*
  *  radius iterator
  */
+
+static int _radius_credit(int r, circle_type ctype)
+{
+    switch (ctype)
+    {
+    case C_CIRCLE: return r;
+    case C_POINTY: return r * r;
+    case C_ROUND:  return r * r + 1;
+    case C_SQUARE: return r;
+    }
+    return r;
+}
+
+/**
+ * The offsets of every cell in a circle or square, in the order
+ * radius_iterator has always returned them: rows outward from the centre,
+ * and in each row, cells outward through the SE, NE, SW and NW quadrants.
+ * Each shape is worked out the first time it's asked for.
+ *
+ * @param credit    the squared radius of a circle, or a square's radius.
+ * @param is_square whether the shape is a square.
+ */
+static const vector<coord_def> &_radius_offsets(int credit, bool is_square)
+{
+    static vector<unique_ptr<vector<coord_def>>> offset_tables[2];
+
+    // Anything bigger than this has the same cells inside the map; a
+    // negative credit still has its centre.
+    credit = max(0, min(credit, is_square ? max(GXM, GYM)
+                                          : GXM * GXM + GYM * GYM));
+
+    auto &table = offset_tables[is_square];
+    if ((int)table.size() <= credit)
+        table.resize(credit + 1);
+    if (table[credit])
+        return *table[credit];
+
+    table[credit].reset(new vector<coord_def>);
+    vector<coord_def> &offsets = *table[credit];
+
+    const int base_cost = is_square ? 1 : -1;
+    const int inc_cost = is_square ? 0 : 2;
+    int cost_y = base_cost;
+    for (int y = 0, credit_y = credit; credit_y >= 0;
+         y++, credit_y -= (cost_y += inc_cost))
+    {
+        int cost_x = base_cost;
+        for (int x = 0, credit_x = (is_square ? credit : credit_y);
+             credit_x >= 0; x++, credit_x -= (cost_x += inc_cost))
+        {
+            offsets.emplace_back(x, y);
+            if (y)
+                offsets.emplace_back(x, -y);
+            if (x)
+                offsets.emplace_back(-x, y);
+            if (x && y)
+                offsets.emplace_back(-x, -y);
+        }
+    }
+    return offsets;
+}
+
 radius_iterator::radius_iterator(const coord_def _center, int r,
                                  circle_type ctype,
                                  bool _exclude_center)
-    : state(RI_START),
+    : offsets(&_radius_offsets(_radius_credit(r, ctype), ctype == C_SQUARE)),
+      idx(-1),
       center(_center),
       los(LOS_NONE)
 {
     ASSERT(map_bounds(_center));
-    switch (ctype)
-    {
-    case C_CIRCLE: credit = r; break;
-    case C_POINTY: credit = r * r; break;
-    case C_ROUND:  credit = r * r + 1; break;
-    case C_SQUARE: credit = r; break;
-    }
-    is_square = (ctype == C_SQUARE);
     ++(*this);
     if (_exclude_center)
         ++(*this);
@@ -191,13 +246,12 @@ radius_iterator::radius_iterator(const coord_def _center, int r,
 radius_iterator::radius_iterator(const coord_def _center,
                                  los_type _los,
                                  bool _exclude_center)
-    : state(RI_START),
+    : offsets(&_radius_offsets(get_los_radius(), true)),
+      idx(-1),
       center(_center),
       los(_los)
 {
     ASSERT(map_bounds(_center));
-    credit = get_los_radius();
-    is_square = true;
     ++(*this);
     if (_exclude_center)
         ++(*this);
@@ -208,19 +262,12 @@ radius_iterator::radius_iterator(const coord_def _center,
                                  circle_type ctype,
                                  los_type _los,
                                  bool _exclude_center)
-    : state(RI_START),
+    : offsets(&_radius_offsets(_radius_credit(r, ctype), ctype == C_SQUARE)),
+      idx(-1),
       center(_center),
       los(_los)
 {
     ASSERT(map_bounds(_center));
-    switch (ctype)
-    {
-    case C_CIRCLE: credit = r; break;
-    case C_POINTY: credit = r * r; break;
-    case C_ROUND:  credit = r * r + 1; break;
-    case C_SQUARE: credit = r; break;
-    }
-    is_square = (ctype == C_SQUARE);
     ++(*this);
     if (_exclude_center)
         ++(*this);
@@ -228,7 +275,7 @@ radius_iterator::radius_iterator(const coord_def _center,
 
 radius_iterator::operator bool() const
 {
-    return state;
+    return idx < (int)offsets->size();
 }
 
 coord_def radius_iterator::operator *() const
@@ -241,59 +288,19 @@ const coord_def* radius_iterator::operator->() const
     return &current;
 }
 
-#define coreturn(id) { state = id; return; case id:; }
-#define cobegin(id)  switch (state) { case id:
-#define coend(id)    coreturn(id); }
-#define ret_coord(dx, dy, id) do                                \
-    {                                                           \
-        current.x = center.x + (dx);                            \
-        current.y = center.y + (dy);                            \
-        if (!los || cell_see_cell(center, current, los))        \
-            coreturn(id);                                       \
-    } while (0)
-
 void radius_iterator::operator++()
 {
-    cobegin(RI_START);
-
-    base_cost = is_square ? 1 : -1;
-    inc_cost = is_square ? 0 : 2;
-
-    y = 0;
-    cost_y = base_cost;
-    credit_y = credit;
-
-    do
+    const int size = offsets->size();
+    while (++idx < size)
     {
-        x = 0;
-        cost_x = base_cost;
-        credit_x = (is_square ? credit : credit_y);
-
-        do
+        current = center + (*offsets)[idx];
+        if (current.x >= 0 && current.x < GXM
+            && current.y >= 0 && current.y < GYM
+            && (!los || cell_see_cell(center, current, los)))
         {
-            if (x + center.x < GXM)
-            {
-                if (y + center.y < GYM)
-                    ret_coord( x,  y, RI_SE);
-                if (y && y <= center.y)
-                    ret_coord( x, -y, RI_NE);
-            }
-            if (x && x <= center.x)
-            {
-                if (y + center.y < GYM)
-                    ret_coord(-x,  y, RI_SW);
-                if (y && y <= center.y)
-                    ret_coord(-x, -y, RI_NW);
-            }
-            x++;
-            credit_x -= (cost_x += inc_cost);
-        } while (credit_x >= 0);
-
-        y++;
-        credit_y -= (cost_y += inc_cost);
-    } while (credit_y >= 0);
-
-    coend(RI_DONE);
+            return;
+        }
+    }
 }
 
 void radius_iterator::operator++(int)
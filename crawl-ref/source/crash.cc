@@ -69,6 +69,12 @@ template <typename TO, typename FROM> TO nasty_cast(FROM f)
 
 #endif // BACKTRACE_SUPPORTED
 
+#if defined(BACKTRACE_SUPPORTED) && defined(USE_UNIX_SIGNALS) \
+    && defined(DEBUG) && !defined(TARGET_OS_MACOSX)
+#define SAMPLING_PROFILER_SUPPORTED
+#include <fcntl.h>
+#endif
+
 // Support Yama LSM ptrace restrictions
 #ifdef TARGET_OS_LINUX
 #   include <sys/prctl.h>
@@ -390,6 +396,179 @@ void write_stack_trace(FILE* file, int ignore_count)
 }
 #endif
 
+#ifdef SAMPLING_PROFILER_SUPPORTED
+/////////////////////////////////////////////////////////////////////////////
+// Sampling profiler: SIGPROF takes a backtrace every few milliseconds of CPU
+// time. The handler can't allocate, so each sample is appended raw to a
+// scratch file with a single write(); the stacks are only symbolised and
+// folded when profiling stops.
+/////////////////////////////////////////////////////////////////////////////
+
+static const int PROFILE_MAX_FRAMES = 64;
+static const int PROFILE_INTERVAL_USEC = 5000;
+// The handler itself and the kernel's signal trampoline.
+static const int PROFILE_SKIP_FRAMES = 2;
+
+static int _profile_fd = -1;
+static string _profile_file;
+
+static void _profile_signal_handler(int)
+{
+    const int saved_errno = errno;
+    // frames[0] holds the number of frames that follow.
+    void *frames[PROFILE_MAX_FRAMES + 1];
+    const int n = backtrace(frames + 1, PROFILE_MAX_FRAMES);
+    frames[0] = reinterpret_cast<void*>(static_cast<intptr_t>(n));
+    const ssize_t written = write(_profile_fd, frames,
+                                  (n + 1) * sizeof(frames[0]));
+    UNUSED(written);
+    errno = saved_errno;
+}
+
+static string _profile_raw_file()
+{
+    return _profile_file + ".raw";
+}
+
+// The function containing addr, demangled, or its address if it has no
+// symbol.
+static string _profile_symbol(void *addr)
+{
+    string name;
+    char **symbols = backtrace_symbols(&addr, 1);
+    if (symbols)
+    {
+        char *firstparen = ::strchr(symbols[0], '(');
+        char *plus = firstparen ? ::strchr(firstparen, '+') : nullptr;
+        if (firstparen && plus && plus > firstparen + 1)
+        {
+            *plus = '\0';
+            int status;
+            char *realname = abi::__cxa_demangle(firstparen + 1, 0, 0,
+                                                 &status);
+            name = realname ? realname : firstparen + 1;
+            free(realname);
+        }
+        free(symbols);
+    }
+    if (name.empty())
+        name = make_stringf("%p", addr);
+    // ';' separates frames in the folded format.
+    replace(name.begin(), name.end(), ';', ':');
+    return name;
+}
+#endif
+
+bool start_sampling_profiler(const string &folded_file)
+{
+#ifdef SAMPLING_PROFILER_SUPPORTED
+    if (_profile_fd != -1)
+        return false;
+
+    _profile_file = folded_file;
+    _profile_fd = open(_profile_raw_file().c_str(),
+                       O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (_profile_fd == -1)
+        return false;
+
+    // The first backtrace() may load libgcc, which allocates; get that
+    // done here rather than in the handler.
+    void *warmup[1];
+    backtrace(warmup, 1);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = _profile_signal_handler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGPROF, &sa, nullptr);
+
+    struct itimerval t;
+    t.it_interval.tv_sec = 0;
+    t.it_interval.tv_usec = PROFILE_INTERVAL_USEC;
+    t.it_value = t.it_interval;
+    setitimer(ITIMER_PROF, &t, 0);
+    return true;
+#else
+    UNUSED(folded_file);
+    return false;
+#endif
+}
+
+/**
+ * Stop sampling, and write the samples as folded stacks: one line per
+ * distinct call stack, outermost frame first and separated by ';', then the
+ * number of samples. That is the input format of flamegraph.pl.
+ */
+void stop_sampling_profiler()
+{
+#ifdef SAMPLING_PROFILER_SUPPORTED
+    if (_profile_fd == -1)
+        return;
+
+    struct itimerval t;
+    memset(&t, 0, sizeof(t));
+    setitimer(ITIMER_PROF, &t, 0);
+    signal(SIGPROF, SIG_IGN);
+    close(_profile_fd);
+    _profile_fd = -1;
+
+    const string raw_file = _profile_raw_file();
+    FILE *raw = fopen_u(raw_file.c_str(), "rb");
+    if (!raw)
+        return;
+
+    map<vector<void*>, int> by_address;
+    void *frames[PROFILE_MAX_FRAMES];
+    void *count;
+    while (fread(&count, sizeof(count), 1, raw) == 1)
+    {
+        const intptr_t n = reinterpret_cast<intptr_t>(count);
+        if (n < 0 || n > PROFILE_MAX_FRAMES
+            || fread(frames, sizeof(frames[0]), n, raw) != (size_t)n)
+        {
+            break;
+        }
+        if (n > PROFILE_SKIP_FRAMES)
+        {
+            ++by_address[vector<void*>(frames + PROFILE_SKIP_FRAMES,
+                                       frames + n)];
+        }
+    }
+    fclose(raw);
+    unlink_u(raw_file.c_str());
+
+    // Different return addresses in one function fold together.
+    map<void*, string> symbols;
+    map<string, int> folded;
+    for (const auto &entry : by_address)
+    {
+        string stack;
+        for (auto it = entry.first.rbegin(); it != entry.first.rend(); ++it)
+        {
+            auto sym = symbols.find(*it);
+            if (sym == symbols.end())
+                sym = symbols.emplace(*it, _profile_symbol(*it)).first;
+            if (!stack.empty())
+                stack += ";";
+            stack += sym->second;
+        }
+        folded[stack] += entry.second;
+    }
+
+    FILE *outf = fopen_u(_profile_file.c_str(), "w");
+    if (!outf)
+    {
+        fprintf(stderr, "Couldn't write profile to %s\n",
+                _profile_file.c_str());
+        return;
+    }
+    for (const auto &entry : folded)
+        fprintf(outf, "%s %d\n", entry.first.c_str(), entry.second);
+    fclose(outf);
+#endif
+}
+
 void call_gdb(FILE *file)
 {
 #ifndef TARGET_OS_WINDOWS
@@ -14,4 +14,7 @@ void call_gdb(FILE *file);
 void disable_other_crashes();
 void do_crash_dump();
 
+bool start_sampling_profiler(const string &folded_file);
+void stop_sampling_profiler();
+
 void watchdog();
@@ -185,7 +185,10 @@ end
 -- address the map with function calls such as name(), tags(), etc.
 --
 -- This function caches the environments it creates, so that successive runs
--- of Lua chunks from the same map will use the same environment.
+-- of Lua chunks from the same map will use the same environment. The
+-- wrappers for the functions in tab are only made the first time each is
+-- looked up in an environment, and call through to whichever map the
+-- environment was last wrapped around, so rewrapping is cheap.
 function dgn_map_meta_wrap(map, tab)
    if not dgn._map_envs then
       dgn._map_envs = { }
@@ -197,23 +200,31 @@ function dgn_map_meta_wrap(map, tab)
    if not meta then
       meta = { }
       dgn_init_hook_tables(meta)
-      local meta_meta = { __index = _G }
+      local meta_meta = {
+        __index = function (env, fn)
+          if tab[fn] == nil then
+            return _G[fn]
+          end
+          local wrapper = function (...)
+                            return crawl.err_trace(tab[fn],
+                                                   rawget(env,
+                                                          'wrapped_instance'),
+                                                   ...)
+                          end
+          rawset(env, fn, wrapper)
+          return wrapper
+        end
+      }
       setmetatable(meta, meta_meta)
       dgn._map_envs[name] = meta
    end
 
-   -- We must set this each time - the map may have the same name, but
-   -- be a different C++ object.
-   for fn, val in pairs(tab) do
-      meta[fn] = function (...)
-                    return crawl.err_trace(val, map, ...)
-                 end
-   end
-
    -- Convenience global variable, e.g. mapgrd[x][y] = 'x'
    meta['mapgrd'] = dgn.mapgrd_table(map)
 
    meta['_G'] = meta
+   -- We must set this each time - the map may have the same name, but
+   -- be a different C++ object.
    meta.wrapped_instance = map
    return meta
 end
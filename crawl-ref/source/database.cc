@@ -39,6 +39,7 @@ public:
     void init();
     void shutdown(bool recursive = false);
     DBM* get() { return _db; }
+    const vector<pair<string, string>> &entries();
 
     // Make it easier to migrate from raw DBM* to TextDB
     operator bool() const { return _db != 0; }
@@ -55,6 +56,9 @@ public:
     vector<string> _input_files;
     DBM* _db;
     string timestamp;
+    // Every key and body, read in the first time something searches them.
+    vector<pair<string, string>> _entries;
+    bool _entries_loaded;
     TextDB *_parent;
     const char* lang() { return _parent ? Options.lang_name : 0; }
 public:
@@ -165,7 +169,8 @@ static string _db_cache_path(string db, const char *lang)
 
 TextDB::TextDB(const char* db_name, const char* dir, ...)
     : _db_name(db_name), _directory(dir),
-      _db(nullptr), timestamp(""), _parent(0), translation(0)
+      _db(nullptr), timestamp(""), _entries_loaded(false), _parent(0),
+      translation(0)
 {
     va_list args;
     va_start(args, dir);
@@ -187,7 +192,8 @@ TextDB::TextDB(TextDB *parent)
     : _db_name(parent->_db_name),
       _directory(parent->_directory + Options.lang_name + "/"),
       _input_files(parent->_input_files), // FIXME: pointless copy
-      _db(nullptr), timestamp(""), _parent(parent), translation(nullptr)
+      _db(nullptr), timestamp(""), _entries_loaded(false), _parent(parent),
+      translation(nullptr)
 {
 }
 
@@ -231,6 +237,8 @@ void TextDB::init()
 
 void TextDB::shutdown(bool recursive)
 {
+    _entries.clear();
+    _entries_loaded = false;
     if (_db)
     {
         dbm_close(_db);
@@ -240,6 +248,27 @@ void TextDB::shutdown(bool recursive)
         translation->shutdown(recursive);
 }
 
+/**
+ * Every key in the db with its body. Searches used to fetch each body with
+ * its own query, every time; the db can't change while it's open, so read
+ * it all once and let later searches scan memory.
+ */
+const vector<pair<string, string>> &TextDB::entries()
+{
+    if (_entries_loaded || !_db)
+        return _entries;
+
+    _entries_loaded = true;
+    for (datum dbKey = dbm_firstkey(_db); dbKey.dptr != nullptr;
+         dbKey = dbm_nextkey(_db))
+    {
+        datum dbBody = dbm_fetch(_db, dbKey);
+        _entries.emplace_back(string((const char *)dbKey.dptr, dbKey.dsize),
+                              string((const char *)dbBody.dptr, dbBody.dsize));
+    }
+    return _entries;
+}
+
 bool TextDB::_needs_update() const
 {
     string ts;
@@ -365,7 +394,7 @@ static datum _database_fetch(DBM *database, const string &key)
     return result;
 }
 
-static vector<string> _database_find_keys(DBM *database,
+static vector<string> _database_find_keys(TextDB &db,
                                           const string &regex,
                                           bool ignore_case,
                                           db_find_filter filter = nullptr)
@@ -373,11 +402,9 @@ static vector<string> _database_find_keys(DBM *database,
     text_pattern             tpat(regex, ignore_case);
     vector<string> matches;
 
-    datum dbKey = dbm_firstkey(database);
-
-    while (dbKey.dptr != nullptr)
+    for (const auto &entry : db.entries())
     {
-        string key((const char *)dbKey.dptr, dbKey.dsize);
+        const string &key = entry.first;
 
         if (tpat.matches(key)
             && key.find("__") == string::npos
@@ -385,14 +412,12 @@ static vector<string> _database_find_keys(DBM *database,
         {
             matches.push_back(key);
         }
-
-        dbKey = dbm_nextkey(database);
     }
 
     return matches;
 }
 
-static vector<string> _database_find_bodies(DBM *database,
+static vector<string> _database_find_bodies(TextDB &db,
                                             const string &regex,
                                             bool ignore_case,
                                             db_find_filter filter = nullptr)
@@ -400,14 +425,10 @@ static vector<string> _database_find_bodies(DBM *database,
     text_pattern             tpat(regex, ignore_case);
     vector<string> matches;
 
-    datum dbKey = dbm_firstkey(database);
-
-    while (dbKey.dptr != nullptr)
+    for (const auto &entry : db.entries())
     {
-        string key((const char *)dbKey.dptr, dbKey.dsize);
-
-        datum dbBody = dbm_fetch(database, dbKey);
-        string body((const char *)dbBody.dptr, dbBody.dsize);
+        const string &key = entry.first;
+        const string &body = entry.second;
 
         if (tpat.matches(body)
             && key.find("__") == string::npos
@@ -415,8 +436,6 @@ static vector<string> _database_find_bodies(DBM *database,
         {
             matches.push_back(key);
         }
-
-        dbKey = dbm_nextkey(database);
     }
 
     return matches;
@@ -529,10 +548,25 @@ static void _store_text_db(const string &in, DBM *db)
     _parse_text_db(inf, db);
 }
 
-static string _chooseStrByWeight(string entry, int fixed_weight = -1)
+// An entry split into its alternatives, with the running total of their
+// weights; or the complaint to return instead, if the entry is malformed.
+struct weighted_strings
 {
     vector<string> parts;
     vector<int>    weights;
+    string         error;
+};
+
+#define WEIGHTED_CACHE_CEILING 1024
+
+// Parsed entries, keyed by their text, so they never go stale however the
+// dbs are reopened. Speech, shouts and random names pick from the same few
+// hundred entries over and over.
+static unordered_map<string, weighted_strings> weighted_cache;
+
+static weighted_strings _parse_weighted_strings(const string &entry)
+{
+    weighted_strings table;
 
     vector<string> lines = split_string("\n", entry, false, true);
 
@@ -554,7 +588,10 @@ static string _chooseStrByWeight(string entry, int fixed_weight = -1)
         {
             i++;
             if (i == size)
-                return "BUG, WEIGHT AT END OF ENTRY";
+            {
+                table.error = "BUG, WEIGHT AT END OF ENTRY";
+                return table;
+            }
         }
         else
             weight = 10;
@@ -568,22 +605,41 @@ static string _chooseStrByWeight(string entry, int fixed_weight = -1)
         }
         trim_string(part);
 
-        parts.push_back(part);
-        weights.push_back(total_weight);
+        table.parts.push_back(part);
+        table.weights.push_back(total_weight);
+    }
+
+    if (table.parts.empty())
+        table.error = "BUG, EMPTY ENTRY";
+
+    return table;
+}
+
+static string _chooseStrByWeight(const string &entry, int fixed_weight = -1)
+{
+    auto cached = weighted_cache.find(entry);
+    if (cached == weighted_cache.end())
+    {
+        if (weighted_cache.size() >= WEIGHTED_CACHE_CEILING)
+            weighted_cache.clear();
+        cached = weighted_cache.emplace(entry,
+                                        _parse_weighted_strings(entry)).first;
     }
+    const weighted_strings &table = cached->second;
 
-    if (parts.empty())
-        return "BUG, EMPTY ENTRY";
+    if (!table.error.empty())
+        return table.error;
 
+    const int total_weight = table.weights.back();
     int choice = 0;
     if (fixed_weight != -1)
         choice = fixed_weight % total_weight;
     else
         choice = random2(total_weight);
 
-    for (int i = 0, size = parts.size(); i < size; i++)
-        if (choice < weights[i])
-            return parts[i];
+    for (int i = 0, size = table.parts.size(); i < size; i++)
+        if (choice < table.weights[i])
+            return table.parts[i];
 
     return "BUG, NO STRING CHOSEN";
 }
@@ -768,7 +824,7 @@ vector<string> getLongDescKeysByRegex(const string &regex,
 
     // FIXME: need to match regex against translated keys, which can't
     // be done by db only.
-    return _database_find_keys(DescriptionDB.get(), regex, true, filter);
+    return _database_find_keys(DescriptionDB, regex, true, filter);
 }
 
 vector<string> getLongDescBodiesByRegex(const string &regex,
@@ -784,9 +840,9 @@ vector<string> getLongDescBodiesByRegex(const string &regex,
     // Not good, but otherwise we'd have to check hundreds of keys, with
     // two queries for each.
     // SQL can do this in one go, DBM can't.
-    DBM *database = DescriptionDB.translation ?
-        DescriptionDB.translation->get() : DescriptionDB.get();
-    return _database_find_bodies(database, regex, true, filter);
+    TextDB &db = DescriptionDB.translation ? *DescriptionDB.translation
+                                           : DescriptionDB;
+    return _database_find_bodies(db, regex, true, filter);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -850,7 +906,7 @@ vector<string> getAllFAQKeys()
         return empty;
     }
 
-    return _database_find_keys(FAQDB.get(), "^q.+", false);
+    return _database_find_keys(FAQDB, "^q.+", false);
 }
 
 string getFAQ_Question(const string &key)
@@ -7,6 +7,7 @@
 
 #include <cerrno>
 #include <csignal>
+#include <sys/stat.h>
 
 #include "abyss.h"
 #include "chardump.h"
@@ -583,6 +584,33 @@ static void _dump_options(FILE *file)
     fprintf(file, "\n\n");
 }
 
+#ifndef TARGET_OS_WINDOWS
+// When a bad build makes every game on a server crash at once, attaching
+// gdb to each of them can stall the whole host. Only the first crash in
+// this many seconds runs it; the others still get the stack trace.
+static const int GDB_MIN_INTERVAL = 60;
+
+// Note a gdb run in a stamp file in dir, unless one was noted there in
+// the last GDB_MIN_INTERVAL seconds, in which case return false.
+static bool _claim_gdb_run(const string &dir, time_t now)
+{
+    string stamp = dir;
+    if (!stamp.empty() && stamp.back() != FILE_SEPARATOR)
+        stamp += FILE_SEPARATOR;
+    stamp += ".crash-gdb-stamp";
+    struct stat st;
+    if (stat(stamp.c_str(), &st) == 0 && st.st_mtime <= now
+        && now - st.st_mtime < GDB_MIN_INTERVAL)
+    {
+        return false;
+    }
+
+    if (FILE *f = fopen(stamp.c_str(), "w"))
+        fclose(f);
+    return true;
+}
+#endif
+
 // Defined in stuff.cc. Not a part of crawl_state, since that's a
 // global C++ instance which is free'd by exit() hooks when exit()
 // is called, and we don't want to reference free'd memory.
@@ -673,7 +701,19 @@ void do_crash_dump()
     write_stack_trace(file, 0);
     fprintf(file, "\n");
 
-    call_gdb(file);
+#ifndef TARGET_OS_WINDOWS
+    // The stamp goes where every game on the server can see it, rather
+    // than in a per-player morgue.
+    if (!crawl_state.no_gdb && !crawl_state.test
+        && !_claim_gdb_run(SysEnv.crawl_dir.empty() ? dir : SysEnv.crawl_dir,
+                           t))
+    {
+        fprintf(file, "Not running gdb: another crash ran it in the last "
+                      "%d seconds.\n", GDB_MIN_INTERVAL);
+    }
+    else
+#endif
+        call_gdb(file);
     fprintf(file, "\n");
 
     // Next information on how the binary was compiled
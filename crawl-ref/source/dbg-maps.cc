@@ -7,21 +7,38 @@
 
 #include "dbg-maps.h"
 
+#ifndef TARGET_OS_WINDOWS
+# include <cerrno>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+
+#include "act-iter.h"
 #include "branch.h"
 #include "chardump.h"
+#include "clua.h"
+#include "coordit.h"
 #include "crash.h"
 #include "dbg-objstat.h"
+#include "dbg-statmerge.h"
+#include "dlua.h"
 #include "dungeon.h"
 #include "env.h"
+#include "exclude.h"
 #include "initfile.h"
 #include "libutil.h"
 #include "maps.h"
 #include "message.h"
 #include "ng-init.h"
+#include "options.h"
 #include "player.h"
+#include "random.h"
 #include "shopping.h"
 #include "state.h"
 #include "stringutil.h"
+#include "terrain.h"
+#include "traps.h"
+#include "travel.h"
 #include "view.h"
 
 #ifdef DEBUG_STATISTICS
@@ -46,6 +63,130 @@ static int build_attempts = 0, level_vetoes = 0;
 // Map from message to counts.
 static map<string, int> veto_messages;
 
+// Set in forked -jobs workers, which leave the console to the parent.
+static bool stat_worker = false;
+
+// -mapstat-profile counters. Map Lua is keyed by "map name (phase)", level
+// builds by the layout types of the level.
+static map<string, int> lua_calls;
+static map<string, double> lua_ms;
+static map<string, double> lua_kinstructions;
+static map<string, pair<int,int> > layout_builds;
+static map<string, double> layout_ms;
+static map<string, int> layout_veto_messages;
+
+// The instruction count hook fires once per this many Lua instructions.
+static const int LUA_PROFILE_INTERVAL = 1000;
+static int64_t lua_instruction_ticks = 0;
+static const int MAX_PROFILE_LINES = 100;
+
+// -travel-bench counters, keyed by "level\tphase".
+static map<string, int> bench_runs;
+static map<string, double> bench_ms;
+static map<string, double> bench_steps;
+static map<string, double> bench_pathfinds;
+static map<string, double> bench_cells;
+
+// No single walk in the benchmark may take more steps than this.
+static const int MAX_BENCH_STEPS = 5000;
+
+// -genlevel-bench: the builder phase being timed, when it started, and the
+// time charged to each phase in the current build.
+static const char *genlevel_phase_names[] =
+{
+    "other", "layout", "primary vault", "extra vaults", "minivaults",
+    "connectivity", "monsters", "items", "postprocess",
+};
+COMPILE_CHECK(ARRAYSZ(genlevel_phase_names) == NUM_GENLEVEL_PHASES);
+
+static bool genlevel_benching = false;
+static genlevel_phase_type genlevel_phase = GENLEVEL_PHASE_OTHER;
+static chrono::steady_clock::time_point genlevel_phase_start;
+static double genlevel_phase_ms[NUM_GENLEVEL_PHASES];
+
+// The slowest seeds the benchmark reports on the console.
+static const int GENLEVEL_BENCH_SLOWEST = 10;
+
+static void _count_lua_instructions(lua_State *, lua_Debug *)
+{
+    ++lua_instruction_ticks;
+}
+
+static double _ms_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now()
+                                           - start).count();
+}
+
+static string _current_layout()
+{
+    if (env.level_layout_types.empty())
+        return "unknown layout";
+    return comma_separated_line(env.level_layout_types.begin(),
+                                env.level_layout_types.end(), ", ");
+}
+
+mapstat_lua_timer::mapstat_lua_timer(const map_def &_map, const char *_phase)
+    : map(_map), phase(_phase), active(crawl_state.map_stat_profile)
+{
+    if (!active)
+        return;
+    start = chrono::steady_clock::now();
+    start_ticks = lua_instruction_ticks;
+}
+
+mapstat_lua_timer::~mapstat_lua_timer()
+{
+    if (!active)
+        return;
+    const string key = make_stringf("%s (%s)", map.name.c_str(), phase);
+    ++lua_calls[key];
+    lua_ms[key] += _ms_since(start);
+    lua_kinstructions[key] += lua_instruction_ticks - start_ticks;
+}
+
+mapstat_build_timer::mapstat_build_timer()
+    : active(crawl_state.map_stat_profile)
+{
+    if (active)
+        start = chrono::steady_clock::now();
+}
+
+mapstat_build_timer::~mapstat_build_timer()
+{
+    if (!active)
+        return;
+    const string key = layout.empty() ? _current_layout() : layout;
+    ++layout_builds[key].first;
+    layout_ms[key] += _ms_since(start);
+}
+
+// Charge the time since the last phase change to the current phase.
+static void _charge_genlevel_phase()
+{
+    const auto now = chrono::steady_clock::now();
+    genlevel_phase_ms[genlevel_phase] +=
+        chrono::duration<double, milli>(now - genlevel_phase_start).count();
+    genlevel_phase_start = now;
+}
+
+genlevel_phase_timer::genlevel_phase_timer(genlevel_phase_type phase)
+    : outer(genlevel_phase), active(genlevel_benching)
+{
+    if (!active)
+        return;
+    _charge_genlevel_phase();
+    genlevel_phase = phase;
+}
+
+genlevel_phase_timer::~genlevel_phase_timer()
+{
+    if (!active)
+        return;
+    _charge_genlevel_phase();
+    genlevel_phase = outer;
+}
+
 void mapstat_report_map_build_start()
 {
     build_attempts++;
@@ -57,6 +198,161 @@ void mapstat_report_map_veto(const string &message)
     level_vetoes++;
     ++veto_messages[message];
     map_builds[level_id::current()].second++;
+    if (crawl_state.map_stat_profile)
+    {
+        const string layout = _current_layout();
+        ++layout_builds[layout].second;
+        ++layout_veto_messages[layout + ": " + message];
+    }
+}
+
+// Mark everything the player can see as seen, much as viewwindow does but
+// without the notes and automap side effects.
+static void _bench_reveal()
+{
+    for (radius_iterator ri(you.pos(), LOS_DEFAULT); ri; ++ri)
+    {
+        const dungeon_feature_type feat = grd(*ri);
+        map_cell &cell = env.map_knowledge(*ri);
+        cell.set_feature(feat, 0, feat_is_trap(feat) ? get_trap_type(*ri)
+                                                     : TRAP_UNASSIGNED);
+        cell.flags |= MAP_SEEN_FLAG;
+    }
+}
+
+// Walk to dest one travel step at a time, pathfinding again before every
+// step just as travel does. Returns the number of steps taken.
+static int _bench_walk_to(const coord_def &dest, bool reveal)
+{
+    int steps = 0;
+    while (you.pos() != dest && steps < MAX_BENCH_STEPS)
+    {
+        travel_pathfind tp;
+        tp.set_src_dst(you.pos(), dest);
+        const coord_def next = tp.pathfind(RMODE_TRAVEL);
+        if (next.origin() || next == you.pos())
+            break;
+        you.moveto(next);
+        if (reveal)
+            _bench_reveal();
+        ++steps;
+    }
+    return steps;
+}
+
+// The known square farthest from the player by travel distance.
+static coord_def _bench_farthest_square()
+{
+    find_travel_pos(you.pos(), nullptr, nullptr, nullptr);
+    coord_def best = you.pos();
+    int best_dist = 0;
+    for (rectangle_iterator ri(1); ri; ++ri)
+    {
+        const int dist = travel_point_distance[ri->x][ri->y];
+        if (dist > best_dist)
+        {
+            best = *ri;
+            best_dist = dist;
+        }
+    }
+    return best;
+}
+
+class travel_bench_phase
+{
+public:
+    explicit travel_bench_phase(const char *_phase)
+        : steps(0),
+          key(level_id::current().describe() + "\t" + _phase),
+          start(chrono::steady_clock::now()),
+          start_calls(travel_pathfind_calls),
+          start_cells(travel_cells_examined)
+    {
+    }
+
+    ~travel_bench_phase()
+    {
+        ++bench_runs[key];
+        bench_ms[key] += _ms_since(start);
+        bench_steps[key] += steps;
+        bench_pathfinds[key] += travel_pathfind_calls - start_calls;
+        bench_cells[key] += travel_cells_examined - start_cells;
+    }
+
+    int steps;
+
+private:
+    string key;
+    chrono::steady_clock::time_point start;
+    int start_calls, start_cells;
+};
+
+/**
+ * Autoexplore the level just built from scratch, then travel back and forth
+ * between its two most distant known squares, with and without exclusions
+ * around every monster.
+ */
+static void _travel_bench_level()
+{
+    unwind_bool saved_need_save(crawl_state.need_save, true);
+
+    coord_def start;
+    for (rectangle_iterator ri(1); ri; ++ri)
+    {
+        if (feat_stair_direction(grd(*ri)) == CMD_GO_UPSTAIRS)
+        {
+            start = *ri;
+            break;
+        }
+        if (start.origin() && grd(*ri) == DNGN_FLOOR)
+            start = *ri;
+    }
+    if (start.origin())
+        return;
+
+    env.map_knowledge.init(map_cell());
+    you.moveto(start);
+    _bench_reveal();
+
+    {
+        travel_bench_phase phase("explore");
+        while (phase.steps < MAX_BENCH_STEPS)
+        {
+            travel_pathfind tp;
+            tp.set_floodseed(you.pos(), true);
+            const coord_def target = tp.pathfind(RMODE_EXPLORE);
+            if (target.origin() || target == you.pos())
+                break;
+            const int steps = _bench_walk_to(target, true);
+            if (!steps)
+                break;
+            phase.steps += steps;
+        }
+    }
+
+    const coord_def one_end = _bench_farthest_square();
+    you.moveto(one_end);
+    const coord_def other_end = _bench_farthest_square();
+    if (one_end == other_end)
+        return;
+
+    {
+        travel_bench_phase phase("travel");
+        phase.steps += _bench_walk_to(other_end, false);
+        phase.steps += _bench_walk_to(one_end, false);
+    }
+
+    for (monster_iterator mi; mi; ++mi)
+        if (env.map_knowledge(mi->pos()).seen())
+            set_exclude(mi->pos(), 2);
+
+    {
+        travel_bench_phase phase("excluded");
+        phase.steps += _bench_walk_to(other_end, false);
+        phase.steps += _bench_walk_to(one_end, false);
+    }
+
+    clear_excludes();
 }
 
 static bool _is_disconnected_level()
@@ -73,19 +369,22 @@ static bool _is_disconnected_level()
 
 static bool _do_build_level()
 {
-    clear_messages();
-    mprf("On %s; %d g, %d fail, %u err%s, %u uniq, "
-         "%d try, %d (%.2f%%) vetos",
-         level_id::current().describe().c_str(), levels_tried, levels_failed,
-         (unsigned int)errors.size(), last_error.empty() ? ""
-         : (" (" + last_error + ")").c_str(), (unsigned int) use_count.size(),
-         build_attempts, level_vetoes,
-         build_attempts ? level_vetoes * 100.0 / build_attempts : 0.0);
+    if (!stat_worker)
+    {
+        clear_messages();
+        mprf("On %s; %d g, %d fail, %u err%s, %u uniq, "
+             "%d try, %d (%.2f%%) vetos",
+             level_id::current().describe().c_str(), levels_tried,
+             levels_failed, (unsigned int)errors.size(), last_error.empty()
+             ? "" : (" (" + last_error + ")").c_str(),
+             (unsigned int) use_count.size(), build_attempts, level_vetoes,
+             build_attempts ? level_vetoes * 100.0 / build_attempts : 0.0);
+    }
 
     watchdog();
 
     no_messages mx;
-    if (kbhit() && key_is_escape(getchk()))
+    if (!stat_worker && kbhit() && key_is_escape(getchk()))
     {
         mprf(MSGCH_WARN, "User requested cancel");
         return false;
@@ -171,6 +470,9 @@ static bool _do_build_level()
 
         return false;
     }
+
+    if (crawl_state.map_stat_travel_bench)
+        _travel_bench_level();
     return true;
 }
 
@@ -223,11 +525,219 @@ static bool _build_dungeon()
     return true;
 }
 
+// Build iterations [first, first + count) of the generated levels.
+static bool _build_iterations(int first, int count)
+{
+    for (int i = first; i < first + count; ++i)
+    {
+        if (!stat_worker)
+        {
+            clear_messages();
+            mprf("On %d of %d; %d g, %d fail, %u err%s, %u uniq, "
+                 "%d try, %d (%.2f%%) vetoes",
+                 i, SysEnv.map_gen_iters, levels_tried, levels_failed,
+                 (unsigned int)errors.size(),
+                 last_error.empty() ? "" : (" (" + last_error + ")").c_str(),
+                 (unsigned int)use_count.size(), build_attempts, level_vetoes,
+                 build_attempts ? level_vetoes * 100.0 / build_attempts : 0.0);
+        }
+        printf("%d..", i + 1);
+        fflush(stdout);
+        dlua.callfn("dgn_clear_data", "");
+        you.uniq_map_tags.clear();
+        you.uniq_map_names.clear();
+        you.unique_creatures.reset();
+        initialise_branch_depths();
+        init_level_connectivity();
+        if (!_build_dungeon())
+            return false;
+        if (crawl_state.obj_stat_gen)
+            objstat_iteration_stats();
+    }
+    return true;
+}
+
+#ifndef TARGET_OS_WINDOWS
+static void _save_counters(writer &th)
+{
+    stat_marshall(th, try_count);
+    stat_marshall(th, use_count);
+    stat_marshall(th, success_count);
+    stat_marshall(th, level_mapcounts);
+    stat_marshall(th, map_builds);
+    stat_marshall(th, level_mapsused);
+    stat_marshall(th, map_levelsused);
+    stat_marshall(th, errors);
+    stat_marshall(th, last_error);
+    stat_marshall(th, levels_tried);
+    stat_marshall(th, levels_failed);
+    stat_marshall(th, build_attempts);
+    stat_marshall(th, level_vetoes);
+    stat_marshall(th, veto_messages);
+    if (crawl_state.map_stat_profile)
+    {
+        stat_marshall(th, lua_calls);
+        stat_marshall(th, lua_ms);
+        stat_marshall(th, lua_kinstructions);
+        stat_marshall(th, layout_builds);
+        stat_marshall(th, layout_ms);
+        stat_marshall(th, layout_veto_messages);
+    }
+    if (crawl_state.map_stat_travel_bench)
+    {
+        stat_marshall(th, bench_runs);
+        stat_marshall(th, bench_ms);
+        stat_marshall(th, bench_steps);
+        stat_marshall(th, bench_pathfinds);
+        stat_marshall(th, bench_cells);
+    }
+    if (crawl_state.obj_stat_gen)
+        objstat_save_counters(th);
+}
+
+static void _merge_counters(reader &th)
+{
+    stat_merge(th, try_count);
+    stat_merge(th, use_count);
+    stat_merge(th, success_count);
+    stat_merge(th, level_mapcounts);
+    stat_merge(th, map_builds);
+    stat_merge(th, level_mapsused);
+    stat_merge(th, map_levelsused);
+    stat_merge(th, errors);
+    stat_merge(th, last_error);
+    stat_merge(th, levels_tried);
+    stat_merge(th, levels_failed);
+    stat_merge(th, build_attempts);
+    stat_merge(th, level_vetoes);
+    stat_merge(th, veto_messages);
+    if (crawl_state.map_stat_profile)
+    {
+        stat_merge(th, lua_calls);
+        stat_merge(th, lua_ms);
+        stat_merge(th, lua_kinstructions);
+        stat_merge(th, layout_builds);
+        stat_merge(th, layout_ms);
+        stat_merge(th, layout_veto_messages);
+    }
+    if (crawl_state.map_stat_travel_bench)
+    {
+        stat_merge(th, bench_runs);
+        stat_merge(th, bench_ms);
+        stat_merge(th, bench_steps);
+        stat_merge(th, bench_pathfinds);
+        stat_merge(th, bench_cells);
+    }
+    if (crawl_state.obj_stat_gen)
+        objstat_merge_counters(th);
+}
+
+/**
+ * Body of a forked -jobs worker: build our share of the iterations from a
+ * seed of our own and write the resulting counters to counter_file.
+ *
+ * @returns True if every iteration built and the counters were saved.
+ */
+static bool _run_stat_worker(int job, int first, int count,
+                             const string &counter_file)
+{
+    stat_worker = true;
+    // A fixed -seed still gives reproducible runs, but every worker needs a
+    // different stream or they would all build the same dungeons.
+    if (Options.seed)
+        seed_rng(Options.seed + job);
+    else
+        seed_rng();
+
+    const bool built = _build_iterations(first, count);
+
+    FILE *outf = fopen(counter_file.c_str(), "wb");
+    if (!outf)
+    {
+        fprintf(stderr, "Couldn't write %s: %s\n", counter_file.c_str(),
+                strerror(errno));
+        return false;
+    }
+    writer th(counter_file, outf);
+    _save_counters(th);
+    fclose(outf);
+    return built;
+}
+
+/**
+ * Split the iterations between SysEnv.map_gen_jobs forked workers and merge
+ * what they record into this process's counters.
+ *
+ * Level generation leans on a great deal of global state, so each worker is
+ * a full copy of this process taken after the maps and preludes are loaded.
+ */
+static bool _build_iterations_parallel()
+{
+    const int jobs = min(SysEnv.map_gen_jobs, SysEnv.map_gen_iters);
+    vector<pid_t> workers;
+    vector<string> counter_files;
+    bool ok = true;
+
+    for (int job = 0; job < jobs; ++job)
+    {
+        const int first = SysEnv.map_gen_iters * job / jobs;
+        const int count = SysEnv.map_gen_iters * (job + 1) / jobs - first;
+        const string counter_file =
+            make_stringf("mapstat-%d-%d.tmp", (int) getpid(), job);
+
+        // Don't let the workers inherit and re-flush our pending output.
+        fflush(stdout);
+        fflush(stderr);
+        const pid_t pid = fork();
+        if (pid == -1)
+        {
+            fprintf(stderr, "Couldn't fork: %s\n", strerror(errno));
+            ok = false;
+            break;
+        }
+        if (pid == 0)
+        {
+            const bool worker_ok =
+                _run_stat_worker(job, first, count, counter_file);
+            fflush(stdout);
+            _exit(worker_ok ? 0 : 1);
+        }
+        workers.push_back(pid);
+        counter_files.push_back(counter_file);
+    }
+
+    for (unsigned int i = 0; i < workers.size(); ++i)
+    {
+        int status = 0;
+        if (waitpid(workers[i], &status, 0) == -1
+            || !WIFEXITED(status) || WEXITSTATUS(status))
+        {
+            ok = false;
+        }
+
+        // A worker that stopped early may still have useful counters.
+        FILE *inf = fopen(counter_files[i].c_str(), "rb");
+        if (!inf)
+        {
+            fprintf(stderr, "Worker %u left no counters.\n", i);
+            ok = false;
+            continue;
+        }
+        reader th(inf);
+        _merge_counters(th);
+        fclose(inf);
+        unlink(counter_files[i].c_str());
+    }
+    return ok;
+}
+#endif
+
 /**
  * Build dungeon levels for mapstat or objstat.
  *
  * The exact branches/levels built and number of build iterations is set by the
- * command-line options for mapstat/objstat.
+ * command-line options for mapstat/objstat. With -jobs, the iterations are
+ * shared between worker processes and their counters merged afterwards.
 
  * @returns True if all iterations built successfully. For mapstat, this can
  * return false if an iteration produced a disconnected level, since for
@@ -242,29 +752,15 @@ bool mapstat_build_levels()
         _dungeon_places();
     printf("Iteration: ");
     fflush(stdout);
-    for (int i = 0; i < SysEnv.map_gen_iters; ++i)
-    {
-        clear_messages();
-        mprf("On %d of %d; %d g, %d fail, %u err%s, %u uniq, "
-             "%d try, %d (%.2f%%) vetoes",
-             i, SysEnv.map_gen_iters, levels_tried, levels_failed,
-             (unsigned int)errors.size(),
-             last_error.empty() ? "" : (" (" + last_error + ")").c_str(),
-             (unsigned int)use_count.size(), build_attempts, level_vetoes,
-             build_attempts ? level_vetoes * 100.0 / build_attempts : 0.0);
-        printf("%d..", i + 1);
-        fflush(stdout);
-        dlua.callfn("dgn_clear_data", "");
-        you.uniq_map_tags.clear();
-        you.uniq_map_names.clear();
-        you.unique_creatures.reset();
-        initialise_branch_depths();
-        init_level_connectivity();
-        if (!_build_dungeon())
-            return false;
-        if (crawl_state.obj_stat_gen)
-            objstat_iteration_stats();
-    }
+#ifndef TARGET_OS_WINDOWS
+    const bool built = SysEnv.map_gen_jobs > 1
+                       ? _build_iterations_parallel()
+                       : _build_iterations(0, SysEnv.map_gen_iters);
+#else
+    const bool built = _build_iterations(0, SysEnv.map_gen_iters);
+#endif
+    if (!built)
+        return false;
     printf("Finished.\n");
     fflush(stdout);
     return true;
@@ -479,6 +975,208 @@ static void _write_map_stats()
     printf("\n");
 }
 
+static void _write_map_profile()
+{
+    const char *out_file = "mapstat-profile.log";
+    FILE *outf = fopen(out_file, "w");
+    if (!outf)
+    {
+        fprintf(stderr, "Couldn't write %s\n", out_file);
+        return;
+    }
+    printf("Writing map profile to %s...", out_file);
+    fflush(stdout);
+    fprintf(outf, "Map Generation Profile\n\n");
+
+    fprintf(outf, "Map Lua by total time (total ms, calls, ms per call, "
+                  "thousands of Lua instructions):\n\n");
+    multimap<double, string> sorted_lua;
+    for (const auto &entry : lua_ms)
+        sorted_lua.insert(make_pair(entry.second, entry.first));
+
+    int count = 0;
+    for (auto i = sorted_lua.rbegin();
+         i != sorted_lua.rend() && count < MAX_PROFILE_LINES; ++i)
+    {
+        const int calls = lookup(lua_calls, i->second, 0);
+        fprintf(outf, "%3d) %10.2f, %7d, %8.3f, %10.0f: %s\n", ++count,
+                i->first, calls, calls ? i->first / calls : 0.0,
+                lookup(lua_kinstructions, i->second, 0.0),
+                i->second.c_str());
+    }
+
+    fprintf(outf, "\n\nLayouts by total build time (total ms, attempts, "
+                  "vetoed, ms per attempt):\n\n");
+    multimap<double, string> sorted_layouts;
+    for (const auto &entry : layout_ms)
+        sorted_layouts.insert(make_pair(entry.second, entry.first));
+
+    count = 0;
+    for (auto i = sorted_layouts.rbegin(); i != sorted_layouts.rend(); ++i)
+    {
+        const pair<int, int> builds = lookup(layout_builds, i->second,
+                                             make_pair(0, 0));
+        fprintf(outf, "%3d) %10.2f, %7d, %7d, %8.3f: %s\n", ++count,
+                i->first, builds.first, builds.second,
+                builds.first ? i->first / builds.first : 0.0,
+                i->second.c_str());
+    }
+
+    if (!layout_veto_messages.empty())
+    {
+        fprintf(outf, "\n\nVeto reasons by layout:\n\n");
+        multimap<int, string> sorted_reasons;
+        for (const auto &entry : layout_veto_messages)
+            sorted_reasons.insert(make_pair(entry.second, entry.first));
+
+        count = 0;
+        for (auto i = sorted_reasons.rbegin();
+             i != sorted_reasons.rend() && count < MAX_PROFILE_LINES; ++i)
+        {
+            fprintf(outf, "%3d) %6d: %s\n", ++count, i->first,
+                    i->second.c_str());
+        }
+    }
+
+    fclose(outf);
+    printf("\n");
+}
+
+// One tab-separated line per level and phase, totalled over all iterations,
+// so that runs from different versions can be compared mechanically.
+static void _write_travel_bench()
+{
+    const char *out_file = "travel-bench.log";
+    FILE *outf = fopen(out_file, "w");
+    if (!outf)
+    {
+        fprintf(stderr, "Couldn't write %s\n", out_file);
+        return;
+    }
+    printf("Writing travel benchmark to %s...", out_file);
+    fflush(stdout);
+
+    fprintf(outf, "level\tphase\truns\tms\tsteps\tpathfinds\tcells\n");
+    for (const auto &entry : bench_runs)
+    {
+        fprintf(outf, "%s\t%d\t%.3f\t%.0f\t%.0f\t%.0f\n",
+                entry.first.c_str(), entry.second,
+                lookup(bench_ms, entry.first, 0.0),
+                lookup(bench_steps, entry.first, 0.0),
+                lookup(bench_pathfinds, entry.first, 0.0),
+                lookup(bench_cells, entry.first, 0.0));
+    }
+
+    fclose(outf);
+    printf("\n");
+}
+
+/**
+ * Build one level once for each seed in the -genlevel-bench range, and write
+ * one tab-separated line per seed with the build attempts it took and the
+ * time spent in each builder phase, over all attempts.
+ *
+ * Every seed starts from the same player state, so a seed's results repeat
+ * from run to run and builder changes can be timed on identical work.
+ */
+static void _genlevel_bench()
+{
+    const level_id place =
+        level_id::parse_level_id(SysEnv.map_gen_bench_place);
+    const uint32_t first = SysEnv.map_gen_bench_first_seed;
+    const uint32_t last = SysEnv.map_gen_bench_last_seed;
+
+    const char *out_file = "genlevel-bench.log";
+    FILE *outf = fopen(out_file, "w");
+    if (!outf)
+    {
+        fprintf(stderr, "Couldn't write %s\n", out_file);
+        return;
+    }
+
+    printf("Building %s for seeds %x to %x.\n", place.describe().c_str(),
+           first, last);
+    fflush(stdout);
+
+    fprintf(outf, "seed\tbuilt\tattempts\tvetoes\tms");
+    for (const char *name : genlevel_phase_names)
+        fprintf(outf, "\t%s", name);
+    fprintf(outf, "\n");
+
+    const auto unique_items = you.unique_items;
+    const CrawlHashTable props = you.props;
+
+    double phase_totals[NUM_GENLEVEL_PHASES] = {};
+    double total_ms = 0;
+    int total_attempts = 0;
+    int seeds = 0;
+    multimap<double, uint32_t> by_time;
+
+    unwind_bool benching(genlevel_benching, true);
+    no_messages mx;
+    for (uint32_t seed = first; ; ++seed)
+    {
+        watchdog();
+
+        you.unique_items = unique_items;
+        you.props = props;
+        dlua.callfn("dgn_clear_data", "");
+        you.uniq_map_tags.clear();
+        you.uniq_map_names.clear();
+        you.unique_creatures.reset();
+        init_level_connectivity();
+        you.where_are_you = place.branch;
+        you.depth = place.depth;
+
+        for (double &ms : genlevel_phase_ms)
+            ms = 0;
+        const int attempts = build_attempts;
+        const int vetoes = level_vetoes;
+
+        seed_rng(seed);
+        const auto start = chrono::steady_clock::now();
+        genlevel_phase = GENLEVEL_PHASE_OTHER;
+        genlevel_phase_start = start;
+        const bool built = builder();
+        _charge_genlevel_phase();
+        const double ms = _ms_since(start);
+
+        fprintf(outf, "%x\t%d\t%d\t%d\t%.3f", seed, built,
+                build_attempts - attempts, level_vetoes - vetoes, ms);
+        for (int i = 0; i < NUM_GENLEVEL_PHASES; ++i)
+        {
+            fprintf(outf, "\t%.3f", genlevel_phase_ms[i]);
+            phase_totals[i] += genlevel_phase_ms[i];
+        }
+        fprintf(outf, "\n");
+
+        total_ms += ms;
+        total_attempts += build_attempts - attempts;
+        ++seeds;
+        by_time.insert(make_pair(ms, seed));
+
+        if (seed == last)
+            break;
+    }
+    fclose(outf);
+
+    printf("%d seed(s), %d attempt(s), %.3f ms per seed:\n", seeds,
+           total_attempts, total_ms / seeds);
+    for (int i = 0; i < NUM_GENLEVEL_PHASES; ++i)
+    {
+        printf("  %-14s %10.3f ms per seed\n", genlevel_phase_names[i],
+               phase_totals[i] / seeds);
+    }
+    printf("Slowest seeds:\n");
+    int count = 0;
+    for (auto i = by_time.rbegin();
+         i != by_time.rend() && count < GENLEVEL_BENCH_SLOWEST; ++i, ++count)
+    {
+        printf("  %x: %.3f ms\n", i->second, i->first);
+    }
+    printf("Wrote %s.\n", out_file);
+}
+
 bool mapstat_find_forced_map()
 {
     const map_def *map = find_map_by_name(crawl_state.force_map);
@@ -516,18 +1214,36 @@ void mapstat_generate_stats()
     run_map_global_preludes();
     run_map_local_preludes();
 
+    if (!SysEnv.map_gen_bench_place.empty())
+    {
+        _genlevel_bench();
+        return;
+    }
+
     _dungeon_places();
 
+    if (crawl_state.map_stat_profile)
+    {
+        lua_sethook(dlua, _count_lua_instructions, LUA_MASKCOUNT,
+                    LUA_PROFILE_INTERVAL);
+    }
+
     clear_messages();
     mpr("Generating dungeon map stats");
     printf("Generating map stats for %d iteration(s) of %d level(s) over "
            "%d branch(es).\n", SysEnv.map_gen_iters,
            (int) generated_levels.size(), branch_count);
+    if (SysEnv.map_gen_jobs > 1)
+        printf("Using %d worker processes.\n", SysEnv.map_gen_jobs);
     fflush(stdout);
 
     mapstat_build_levels();
 
     _write_map_stats();
+    if (crawl_state.map_stat_profile)
+        _write_map_profile();
+    if (crawl_state.map_stat_travel_bench)
+        _write_travel_bench();
     printf("Map stats complete.\n");
 }
 
@@ -7,6 +7,8 @@
 
 #ifdef DEBUG_STATISTICS
 
+#include <chrono>
+
 class map_def;
 void mapstat_report_map_try(const map_def &map);
 void mapstat_report_map_use(const map_def &map);
@@ -17,4 +19,67 @@ void mapstat_report_map_veto(const string &message);
 void mapstat_generate_stats();
 bool mapstat_build_levels();
 bool mapstat_find_forced_map();
+
+// Under -mapstat-profile, times the Lua a map runs while in scope, along
+// with the number of Lua instructions it executes.
+class mapstat_lua_timer
+{
+public:
+    mapstat_lua_timer(const map_def &map, const char *phase);
+    ~mapstat_lua_timer();
+
+private:
+    const map_def &map;
+    const char *phase;
+    bool active;
+    chrono::steady_clock::time_point start;
+    int64_t start_ticks;
+};
+
+// Under -mapstat-profile, times one level build attempt, which is charged
+// to the level's layout types when the timer goes out of scope.
+class mapstat_build_timer
+{
+public:
+    mapstat_build_timer();
+    ~mapstat_build_timer();
+
+    // The layout to charge, if known before the level's layout types are
+    // cleared.
+    string layout;
+
+private:
+    bool active;
+    chrono::steady_clock::time_point start;
+};
+
+enum genlevel_phase_type
+{
+    GENLEVEL_PHASE_OTHER,        // anything not in a phase below
+    GENLEVEL_PHASE_LAYOUT,       // _builder_by_type(), less the primary vault
+    GENLEVEL_PHASE_PRIMARY_VAULT,
+    GENLEVEL_PHASE_EXTRA_VAULTS, // chance vaults and extra vaults
+    GENLEVEL_PHASE_MINIVAULTS,
+    GENLEVEL_PHASE_CONNECTIVITY, // connectivity checks and fixups
+    GENLEVEL_PHASE_MONSTERS,
+    GENLEVEL_PHASE_ITEMS,
+    GENLEVEL_PHASE_POSTPROCESS,  // _dgn_postprocess_level()
+    NUM_GENLEVEL_PHASES
+};
+
+// Under -genlevel-bench, charges the time until it goes out of scope to
+// one builder phase. Phases may nest; time in an inner phase is not
+// charged to the outer one as well.
+class genlevel_phase_timer
+{
+public:
+    explicit genlevel_phase_timer(genlevel_phase_type phase);
+    ~genlevel_phase_timer();
+
+    genlevel_phase_timer(const genlevel_phase_timer&) = delete;
+    genlevel_phase_timer& operator=(const genlevel_phase_timer&) = delete;
+private:
+    genlevel_phase_type outer;
+    bool active;
+};
 #endif
@@ -18,6 +18,7 @@
 #include "coord.h"
 #include "coordit.h"
 #include "dbg-maps.h"
+#include "dbg-statmerge.h"
 #include "dbg-util.h"
 #include "dungeon.h"
 #include "end.h"
@@ -839,6 +840,29 @@ void objstat_iteration_stats()
     }
 }
 
+/**
+ * Write this process's accumulated item and monster records, for a parallel
+ * objstat worker to hand back to its parent.
+ */
+void objstat_save_counters(writer &th)
+{
+    stat_marshall(th, item_recs);
+    stat_marshall(th, weapon_brands);
+    stat_marshall(th, armour_brands);
+    stat_marshall(th, missile_brands);
+    stat_marshall(th, monster_recs);
+}
+
+/// Fold the records written by objstat_save_counters() into our own.
+void objstat_merge_counters(reader &th)
+{
+    stat_merge(th, item_recs);
+    stat_merge(th, weapon_brands);
+    stat_merge(th, armour_brands);
+    stat_merge(th, missile_brands);
+    stat_merge(th, monster_recs);
+}
+
 static void _write_stat_headers(const vector<string> &fields, bool items = true)
 {
     fprintf(stat_outf, "%s\tLevel", items ? "Item" : "Monster");
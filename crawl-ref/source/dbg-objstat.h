@@ -10,4 +10,9 @@ void objstat_record_item(const item_def &item);
 void objstat_generate_stats();
 void objstat_record_monster(const monster *mons);
 void objstat_iteration_stats();
+
+class reader;
+class writer;
+void objstat_save_counters(writer &th);
+void objstat_merge_counters(reader &th);
 #endif
@@ -368,6 +368,7 @@ void debug_mons_scan()
             continue;
 
         ASSERT(m->mid > 0);
+        ASSERT(i < env.mons_used);
         coord_def pos = m->pos();
 
         if (invalid_monster_type(m->type))
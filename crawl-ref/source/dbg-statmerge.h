@@ -0,0 +1,194 @@
+/**
+ * @file
+ * @brief Marshalling and merging of mapstat/objstat counters between
+ *        worker processes.
+**/
+
+#pragma once
+
+#ifdef DEBUG_STATISTICS
+
+#include <cstring>
+
+#include "stringutil.h"
+#include "tags.h"
+
+// Each worker writes its counters with stat_marshall() and the parent folds
+// them into its own containers with stat_merge(). Plain counts are summed,
+// sets are unioned, and double-valued fields whose name ends in Min or Max
+// keep the extreme value.
+
+static inline void stat_marshall_key(writer &th, const level_id &lev)
+{
+    marshall_level_id(th, lev);
+}
+
+static inline void stat_marshall_key(writer &th, int key)
+{
+    marshallInt(th, key);
+}
+
+static inline void stat_marshall_key(writer &th, const string &key)
+{
+    marshallString(th, key);
+}
+
+static inline void stat_unmarshall_key(reader &th, level_id &lev)
+{
+    lev = unmarshall_level_id(th);
+}
+
+static inline void stat_unmarshall_key(reader &th, int &key)
+{
+    key = unmarshallInt(th);
+}
+
+static inline void stat_unmarshall_key(reader &th, string &key)
+{
+    key = unmarshallString(th);
+}
+
+static inline void stat_marshall(writer &th, int count)
+{
+    marshallInt(th, count);
+}
+
+static inline void stat_merge(reader &th, int &count)
+{
+    count += unmarshallInt(th);
+}
+
+// The first worker to report a string (e.g. an error message) wins.
+static inline void stat_marshall(writer &th, const string &s)
+{
+    marshallString(th, s);
+}
+
+static inline void stat_merge(reader &th, string &s)
+{
+    const string other = unmarshallString(th);
+    if (s.empty())
+        s = other;
+}
+
+static inline void stat_marshall(writer &th, const pair<int, int> &counts)
+{
+    marshallInt(th, counts.first);
+    marshallInt(th, counts.second);
+}
+
+static inline void stat_merge(reader &th, pair<int, int> &counts)
+{
+    counts.first += unmarshallInt(th);
+    counts.second += unmarshallInt(th);
+}
+
+static inline void stat_marshall_double(writer &th, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    marshallUnsigned(th, bits);
+}
+
+static inline double stat_unmarshall_double(reader &th)
+{
+    const uint64_t bits = unmarshallUnsigned(th);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline void stat_marshall(writer &th, const map<string, double> &stats)
+{
+    marshallInt(th, stats.size());
+    for (const auto &entry : stats)
+    {
+        marshallString(th, entry.first);
+        stat_marshall_double(th, entry.second);
+    }
+}
+
+static inline void stat_merge(reader &th, map<string, double> &stats)
+{
+    const int num = unmarshallInt(th);
+    for (int i = 0; i < num; ++i)
+    {
+        const string field = unmarshallString(th);
+        const double value = stat_unmarshall_double(th);
+        auto it = stats.find(field);
+        if (it == stats.end())
+            stats[field] = value;
+        else if (ends_with(field, "Min"))
+            it->second = min(it->second, value);
+        else if (ends_with(field, "Max"))
+            it->second = max(it->second, value);
+        else
+            it->second += value;
+    }
+}
+
+template<typename T>
+static void stat_marshall(writer &th, const set<T> &s)
+{
+    marshallInt(th, s.size());
+    for (const T &elt : s)
+        stat_marshall_key(th, elt);
+}
+
+template<typename T>
+static void stat_merge(reader &th, set<T> &s)
+{
+    const int num = unmarshallInt(th);
+    for (int i = 0; i < num; ++i)
+    {
+        T elt;
+        stat_unmarshall_key(th, elt);
+        s.insert(elt);
+    }
+}
+
+// Vectors are preallocated to the same shape in every process before the
+// workers fork, so only their contents need merging.
+template<typename T>
+static void stat_marshall(writer &th, const vector<T> &v)
+{
+    marshallInt(th, v.size());
+    for (const T &elt : v)
+        stat_marshall(th, elt);
+}
+
+template<typename T>
+static void stat_merge(reader &th, vector<T> &v)
+{
+    const int num = unmarshallInt(th);
+    if (v.empty())
+        v.resize(num);
+    ASSERT(num == (int) v.size());
+    for (T &elt : v)
+        stat_merge(th, elt);
+}
+
+template<typename K, typename V>
+static void stat_marshall(writer &th, const map<K, V> &m)
+{
+    marshallInt(th, m.size());
+    for (const auto &entry : m)
+    {
+        stat_marshall_key(th, entry.first);
+        stat_marshall(th, entry.second);
+    }
+}
+
+template<typename K, typename V>
+static void stat_merge(reader &th, map<K, V> &m)
+{
+    const int num = unmarshallInt(th);
+    for (int i = 0; i < num; ++i)
+    {
+        K key;
+        stat_unmarshall_key(th, key);
+        stat_merge(th, m[key]);
+    }
+}
+
+#endif
@@ -11,7 +11,10 @@
 #include "directn.h"
 #include "dungeon.h"
 #include "libutil.h"
+#include "losglobal.h"
 #include "macro.h"
+#include "mon-act.h"
+#include "mon-pathfind.h"
 #include "message.h"
 #include "options.h"
 #include "religion.h"
@@ -433,6 +436,52 @@ void debug_list_vacant_keys()
     mpr(message);
 }
 
+static string _percent_str(uint64_t part, uint64_t total)
+{
+    if (!total)
+        return "n/a";
+    return make_stringf("%.1f%%", 100.0 * part / total);
+}
+
+/// Print counters from the various caches, so their effect can be checked.
+void debug_list_cache_stats()
+{
+    const globallos_stats &los = get_globallos_stats();
+    mprf(MSGCH_DIAGNOSTICS,
+         "LOS cache: %" PRIu64 " hits, %" PRIu64 " misses (%s hit rate); "
+         "%" PRIu64 " invalidations forgot %" PRIu64 " pairs; "
+         "%" PRIu64 " full resets.",
+         los.hits, los.misses,
+         _percent_str(los.hits, los.hits + los.misses).c_str(),
+         los.invalidations, los.pairs_invalidated, los.full_invalidations);
+
+    const pathfield_stats &pf = get_pathfield_stats();
+    mprf(MSGCH_DIAGNOSTICS,
+         "Shared monster paths: %" PRIu64 " hits, %" PRIu64 " misses; "
+         "%" PRIu64 " fields built.",
+         pf.hits, pf.misses, pf.builds);
+
+    const monster_turn_stats &mt = get_monster_turn_stats();
+    vector<pair<int64_t, monster_type>> by_time;
+    for (const auto &entry : mt.time_by_type)
+        by_time.emplace_back(entry.second, entry.first);
+    sort(by_time.rbegin(), by_time.rend());
+
+    string slowest;
+    for (unsigned int i = 0; i < by_time.size() && i < 5; ++i)
+    {
+        slowest += make_stringf("%s%s: %" PRId64 "us",
+                                i ? ", " : "",
+                                mons_type_name(by_time[i].second,
+                                               DESC_PLAIN).c_str(),
+                                by_time[i].first);
+    }
+    mprf(MSGCH_DIAGNOSTICS,
+         "Last monster turn: %d actions, %d requeues, %d idle monsters.%s%s",
+         mt.actions, mt.requeues, mt.idle,
+         slowest.empty() ? "" : " Slowest: ", slowest.c_str());
+}
+
 #ifdef DEBUG
 static FILE *debugf = 0;
 
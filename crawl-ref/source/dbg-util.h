@@ -29,3 +29,4 @@ string debug_mon_str(const monster* mon);
 
 void wizard_toggle_dprf();
 void debug_list_vacant_keys();
+void debug_list_cache_stats();
@@ -1731,7 +1731,7 @@ static void _summon_dancing_weapon(int power, deck_rarity_type rarity)
     ghost_demon newstats;
     newstats.init_dancing_weapon(wpn, power / 4);
 
-    mon->set_ghost(newstats);
+    mon->set_ghost(move(newstats));
     mon->ghost_demon_init();
 }
 
@@ -300,6 +300,30 @@ shared_ptr<Delay> current_delay()
                              : nullptr;
 }
 
+/**
+ * Can drawing the view be left out for now? That's so in the middle turns
+ * of a timed multi-turn action such as taking off armour, while nothing is
+ * in sight and nothing new has been said. Anything that interrupts the
+ * action stops it before the view is drawn, and its last timed turn is
+ * drawn as usual, so the player never sees a stale view.
+ *
+ * Runs (rest, travel, explore) have their own options for this.
+ */
+bool delay_hides_view()
+{
+    if (!you_are_delayed())
+        return false;
+
+    const shared_ptr<Delay> delay = current_delay();
+    if (delay->is_run() || delay->is_macro() || delay->is_parent()
+        || delay->duration <= 0)
+    {
+        return false;
+    }
+
+    return !any_messages() && !there_are_monsters_nearby(false, true, false);
+}
+
 bool is_being_drained(const item_def &item)
 {
     if (!you_are_delayed())
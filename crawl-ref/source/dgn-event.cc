@@ -17,6 +17,7 @@ dgn_event_dispatcher dungeon_events;
 void dgn_event_dispatcher::clear()
 {
     global_event_mask = 0;
+    position_event_mask = 0;
     listeners.clear();
     for (int y = 0; y < GYM; ++y)
         for (int x = 0; x < GXM; ++x)
@@ -43,6 +44,8 @@ bool dgn_event_dispatcher::has_listeners_at(const coord_def &pos) const
 bool dgn_event_dispatcher::fire_vetoable_position_event(
     dgn_event_type et, const coord_def &pos)
 {
+    if (!(position_event_mask & et))
+        return true;
     const dgn_event event(et, pos);
     return fire_vetoable_position_event(event, pos);
 }
@@ -64,6 +67,8 @@ bool dgn_event_dispatcher::fire_vetoable_position_event(
 void dgn_event_dispatcher::fire_position_event(
     dgn_event_type event, const coord_def &pos)
 {
+    if (!(position_event_mask & event))
+        return;
     const dgn_event et(event, pos);
     fire_position_event(et, pos);
 }
@@ -93,6 +98,8 @@ void dgn_event_dispatcher::fire_event(const dgn_event &e)
 
 void dgn_event_dispatcher::fire_event(dgn_event_type et)
 {
+    if (!(global_event_mask & et))
+        return;
     fire_event(dgn_event(et));
 }
 
@@ -126,6 +133,7 @@ void dgn_event_dispatcher::register_listener_at(unsigned mask,
 
     dgn_square_alarm *alarm = grid_triggers[c.x][c.y].get();
     alarm->eventmask |= mask;
+    position_event_mask |= mask;
     if (find(alarm->listeners.begin(), alarm->listeners.end(), listener)
         == alarm->listeners.end())
     {
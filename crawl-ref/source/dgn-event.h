@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include <list>
+#include <vector>
 
 #include "player.h"
 
@@ -76,7 +76,7 @@ struct dgn_square_alarm
     dgn_square_alarm() : eventmask(0), listeners() { }
 
     unsigned eventmask;
-    list<dgn_event_listener*> listeners;
+    vector<dgn_event_listener*> listeners;
 };
 
 struct dgn_listener_def
@@ -96,7 +96,8 @@ struct dgn_listener_def
 class dgn_event_dispatcher
 {
 public:
-    dgn_event_dispatcher() : global_event_mask(0), grid_triggers()
+    dgn_event_dispatcher() : global_event_mask(0), position_event_mask(0),
+                             grid_triggers()
     {
     }
 
@@ -128,8 +129,12 @@ private:
 
 private:
     unsigned global_event_mask;
+    // Every event anything has registered for on any square since the
+    // last clear(), so most position events are turned away without
+    // looking at the square. Listeners being removed don't clear bits.
+    unsigned position_event_mask;
     unique_ptr<dgn_square_alarm> grid_triggers[GXM][GYM];
-    list<dgn_listener_def> listeners;
+    vector<dgn_listener_def> listeners;
 };
 
 extern dgn_event_dispatcher dungeon_events;
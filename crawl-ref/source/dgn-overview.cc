@@ -385,18 +385,13 @@ static string _print_altars_for_gods(const vector<god_type>& gods,
     char const *colour;
     const int columns = 4;
 
+    FixedBitVector<NUM_GODS> seen_altars;
+    for (const auto &entry : altars_present)
+        seen_altars.set(entry.second);
+
     for (const god_type god : gods)
     {
-        // for each god, look through the notable altars list for a match
-        bool has_altar_been_seen = false;
-        for (const auto &entry : altars_present)
-        {
-            if (entry.second == god)
-            {
-                has_altar_been_seen = true;
-                break;
-            }
-        }
+        const bool has_altar_been_seen = seen_altars[god];
 
         // If dumping, only laundry list the seen gods
         if (!display)
@@ -23,6 +23,7 @@
 #include "mon-place.h"
 #include "state.h"
 #include "stringutil.h"
+#include "terrain.h"
 #include "traps.h"
 #include "view.h"
 
@@ -909,6 +910,10 @@ static vector<coord_def> _shoals_extra_tide_seeds()
 
 static void _shoals_apply_tide(int tide, bool incremental_tide)
 {
+    // The tide only swaps floor and shallow water, which doesn't change
+    // what anyone can see, so LOS is updated once for the whole tide.
+    terrain_change_batch batch;
+
     vector<coord_def> pages[2];
     int current_page = 0;
 
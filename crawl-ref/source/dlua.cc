@@ -24,8 +24,7 @@ static int dlua_compiled_chunk_writer(lua_State *ls, const void *p,
 // dlua_chunk
 
 dlua_chunk::dlua_chunk(const string &_context)
-    : file(), chunk(), compiled(), context(_context), first(-1),
-      last(-1), error()
+    : file(), code(), context(_context), first(-1), last(-1), error()
 {
     clear();
 }
@@ -33,7 +32,7 @@ dlua_chunk::dlua_chunk(const string &_context)
 // Initialises a chunk from the function on the top of stack.
 // This function must not be a closure, i.e. must not have any upvalues.
 dlua_chunk::dlua_chunk(lua_State *ls)
-    : file(), chunk(), compiled(), context(), first(-1), last(-1), error()
+    : file(), code(), context(), first(-1), last(-1), error()
 {
     clear();
 
@@ -45,25 +44,69 @@ dlua_chunk::dlua_chunk(lua_State *ls)
         const char *e = lua_tostring(ls, -1);
         error = e? e : "Unknown error compiling chunk";
     }
-    compiled = out.str();
+    own_code().compiled = out.str();
 }
 
 dlua_chunk dlua_chunk::precompiled(const string &_chunk)
 {
     dlua_chunk dchunk;
-    dchunk.compiled = _chunk;
+    dchunk.own_code().compiled = _chunk;
     return dchunk;
 }
 
+// The code for this chunk alone, for changing its source.
+dlua_chunk::chunk_code &dlua_chunk::own_code()
+{
+    if (!code)
+        code = make_shared<chunk_code>();
+    else if (!code.unique())
+        code = make_shared<chunk_code>(*code);
+    return *code;
+}
+
+const string &dlua_chunk::source() const
+{
+    static const string none;
+    return code ? code->source : none;
+}
+
+const string &dlua_chunk::compiled_chunk() const
+{
+    static const string none;
+    return code ? code->compiled : none;
+}
+
 string dlua_chunk::describe(const string &name) const
 {
-    if (chunk.empty())
+    if (source().empty())
         return "";
     return make_stringf("function %s()\n%s\nend\n",
-                        name.c_str(), chunk.c_str());
+                        name.c_str(), source().c_str());
+}
+
+// Bytecode is only valid for the Lua it was dumped by; LuaJIT claims the
+// same version as the reference 5.1 but has its own format.
+static string _lua_bytecode_version()
+{
+#ifdef USE_LUAJIT
+    return LUA_VERSION " (LuaJIT)";
+#else
+    return LUA_VERSION;
+#endif
 }
 
-void dlua_chunk::write(writer& outf) const
+static string _compile_chunk(const string &chunk, const string &context)
+{
+    lua_stack_cleaner cln(dlua);
+    if (dlua.loadstring(chunk.c_str(), context.c_str()))
+        return "";
+    ostringstream out;
+    if (lua_dump(dlua, dlua_compiled_chunk_writer, &out))
+        return "";
+    return out.str();
+}
+
+void dlua_chunk::write(writer& outf, bool with_bytecode) const
 {
     if (empty())
     {
@@ -71,7 +114,20 @@ void dlua_chunk::write(writer& outf) const
         return;
     }
 
-    if (!compiled.empty())
+    const string &chunk = source();
+    const string &compiled = compiled_chunk();
+    const string bytecode = !with_bytecode || chunk.empty() ? ""
+                            : !compiled.empty() ? compiled
+                            : _compile_chunk(chunk, context);
+
+    if (!bytecode.empty())
+    {
+        marshallByte(outf, CT_SOURCE_COMPILED);
+        marshallString4(outf, chunk);
+        marshallString(outf, _lua_bytecode_version());
+        marshallString4(outf, bytecode);
+    }
+    else if (!compiled.empty())
     {
         marshallByte(outf, CT_COMPILED);
         marshallString4(outf, compiled);
@@ -95,11 +151,21 @@ void dlua_chunk::read(reader& inf)
     case CT_EMPTY:
         return;
     case CT_SOURCE:
-        unmarshallString4(inf, chunk);
+        unmarshallString4(inf, own_code().source);
         break;
     case CT_COMPILED:
-        unmarshallString4(inf, compiled);
+        unmarshallString4(inf, own_code().compiled);
         break;
+    case CT_SOURCE_COMPILED:
+    {
+        chunk_code &own = own_code();
+        unmarshallString4(inf, own.source);
+        const string version = unmarshallString(inf);
+        unmarshallString4(inf, own.compiled);
+        if (version != _lua_bytecode_version())
+            own.compiled.clear();
+        break;
+    }
     }
     unmarshallString4(inf, file);
     first = unmarshallInt(inf);
@@ -108,10 +174,9 @@ void dlua_chunk::read(reader& inf)
 void dlua_chunk::clear()
 {
     file.clear();
-    chunk.clear();
+    code.reset();
     first = last = -1;
     error.clear();
-    compiled.clear();
 }
 
 void dlua_chunk::set_file(const string &s)
@@ -124,6 +189,7 @@ void dlua_chunk::add(int line, const string &s)
     if (first == -1)
         first = line;
 
+    string &chunk = own_code().source;
     if (line != last && last != -1)
     {
         while (last++ < line)
@@ -137,7 +203,7 @@ void dlua_chunk::add(int line, const string &s)
 
 void dlua_chunk::set_chunk(const string &s)
 {
-    chunk = s;
+    own_code().source = s;
 }
 
 int dlua_chunk::check_op(CLua &interp, int err)
@@ -148,21 +214,30 @@ int dlua_chunk::check_op(CLua &interp, int err)
 
 int dlua_chunk::load(CLua &interp)
 {
-    if (!compiled.empty())
+    // Compiling doesn't change what the chunk does, so the bytecode goes
+    // into the shared code, where every copy of this chunk can reuse it.
+    if (!compiled_chunk().empty())
     {
-        return check_op(interp,
-                         interp.loadbuffer(compiled.c_str(), compiled.length(),
-                                           context.c_str()));
+        const string &compiled = code->compiled;
+        const int err = check_op(interp,
+                                 interp.loadbuffer(compiled.c_str(),
+                                                   compiled.length(),
+                                                   context.c_str()));
+        // Cached bytecode that this Lua refuses is recompiled from the
+        // source, if we have it.
+        if (!err || source().empty())
+            return err;
+        code->compiled.clear();
     }
 
     if (empty())
     {
-        chunk.clear();
+        code.reset();
         return E_CHUNK_LOAD_FAILURE;
     }
 
     int err = check_op(interp,
-                        interp.loadstring(chunk.c_str(), context.c_str()));
+                        interp.loadstring(source().c_str(), context.c_str()));
     if (err)
         return err;
     ostringstream out;
@@ -173,7 +248,7 @@ int dlua_chunk::load(CLua &interp)
         error = e? e : "Unknown error compiling chunk";
         lua_pop(interp, 2);
     }
-    compiled = out.str();
+    code->compiled = out.str();
     return err;
 }
 
@@ -205,7 +280,7 @@ string dlua_chunk::orig_error() const
 
 bool dlua_chunk::empty() const
 {
-    return compiled.empty() && trimmed_string(chunk).empty();
+    return compiled_chunk().empty() && trimmed_string(source()).empty();
 }
 
 bool dlua_chunk::rewrite_chunk_errors(string &s) const
@@ -23,9 +23,18 @@ class writer;
 class dlua_chunk
 {
 private:
+    // The source and its bytecode. A map_def, and so its chunks, is copied
+    // for every placement attempt; the copies share one of these until one
+    // of them changes its source, and bytecode compiled by any of them is
+    // kept for all.
+    struct chunk_code
+    {
+        string source;
+        string compiled;
+    };
+
     string file;
-    string chunk;
-    string compiled;
+    shared_ptr<chunk_code> code;
     string context;
     int first, last;     // First and last lines of the original source.
 
@@ -33,10 +42,14 @@ private:
     {
         CT_EMPTY,
         CT_SOURCE,
-        CT_COMPILED
+        CT_COMPILED,
+        CT_SOURCE_COMPILED, // source, plus bytecode for this Lua build
     };
 
 private:
+    chunk_code &own_code();
+    const string &source() const;
+
     int check_op(CLua &, int);
     string rewrite_chunk_prefix(const string &line, bool skip_body = false) const;
     string get_chunk_prefix(const string &s) const;
@@ -60,15 +73,17 @@ public:
     int load_call(CLua &interp, const char *function);
     void set_file(const string &s);
 
-    const string &lua_string() const { return chunk; }
+    const string &lua_string() const { return source(); }
     string orig_error() const;
     bool rewrite_chunk_errors(string &err) const;
 
     bool empty() const;
 
-    const string &compiled_chunk() const { return compiled; }
+    const string &compiled_chunk() const;
 
-    void write(writer&) const;
+    // with_bytecode is used for the des cache: keep the source, but store
+    // its bytecode as well so that later processes skip the compiler.
+    void write(writer&, bool with_bytecode = false) const;
     void read(reader&);
 };
 
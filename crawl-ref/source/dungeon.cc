@@ -20,6 +20,7 @@
 #include "abyss.h"
 #include "acquire.h"
 #include "act-iter.h"
+#include "alloc-tag.h"
 #include "artefact.h"
 #include "attitude-change.h"
 #include "branch.h"
@@ -282,6 +283,8 @@ static void _count_gold()
  *********************************************************************/
 bool builder(bool enable_random_maps, dungeon_feature_type dest_stairs_type)
 {
+    alloc_tag_scope tag(ALLOC_BUILDER);
+
     // Re-check whether we're in a valid place, it leads to obscure errors
     // otherwise.
     ASSERT_RANGE(you.where_are_you, 0, NUM_BRANCHES);
@@ -352,6 +355,7 @@ static bool _build_level_vetoable(bool enable_random_maps,
 {
 #ifdef DEBUG_STATISTICS
     mapstat_report_map_build_start();
+    mapstat_build_timer build_timer;
 #endif
 
     dgn_reset_level(enable_random_maps);
@@ -397,6 +401,9 @@ static bool _build_level_vetoable(bool enable_random_maps,
     string level_layout_type = comma_separated_line(
         env.level_layout_types.begin(),
         env.level_layout_types.end(), ", ");
+#ifdef DEBUG_STATISTICS
+    build_timer.layout = level_layout_type;
+#endif
 
     // Save information in the level's properties hash table
     // so we can include it in crash reports.
@@ -540,6 +547,9 @@ bool dgn_make_transporters_from_markers()
 // fixups.
 static void _dgn_postprocess_level()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_POSTPROCESS);
+#endif
     shoals_postprocess_level();
     _builder_assertions();
     _calc_density();
@@ -551,24 +561,31 @@ void dgn_clear_vault_placements()
     env.level_vaults.clear();
 }
 
-// Removes vaults that are not referenced in the map index mask from
-// the level_vaults array.
-void dgn_erase_unused_vault_placements()
+// Which of the level_vaults are still referenced in the map index mask.
+vector<bool> dgn_vaults_on_map()
 {
-    set<int> referenced_vault_indexes;
+    vector<bool> on_map(env.level_vaults.size(), false);
     for (rectangle_iterator ri(MAPGEN_BORDER); ri; ++ri)
     {
         const int map_index = env.level_map_ids(*ri);
-        if (map_index != INVALID_MAP_INDEX)
-            referenced_vault_indexes.insert(map_index);
+        if (map_index >= 0 && map_index < (int)on_map.size())
+            on_map[map_index] = true;
     }
+    return on_map;
+}
+
+// Removes vaults that are not referenced in the map index mask from
+// the level_vaults array.
+void dgn_erase_unused_vault_placements()
+{
+    const vector<bool> referenced = dgn_vaults_on_map();
 
     // Walk backwards and toss unused vaults.
     map<int, int> new_vault_index_map;
     const int nvaults = env.level_vaults.size();
     for (int i = nvaults - 1; i >= 0; --i)
     {
-        if (!referenced_vault_indexes.count(i))
+        if (!referenced[i])
         {
             {
                 auto &vp = env.level_vaults[i];
@@ -760,7 +777,7 @@ static bool _dgn_fill_zone(
     bool (*iswanted)(const coord_def &) = nullptr)
 {
     bool ret = false;
-    list<coord_def> points[2];
+    vector<coord_def> points[2];
     int cur = 0;
 
     // No bounds checks, assuming the level has at least one layer of
@@ -910,6 +927,10 @@ static int _process_disconnected_zones(int x1, int y1, int x2, int y2,
     memset(travel_point_distance, 0, sizeof(travel_distance_grid_t));
     int nzones = 0;
     int ngood = 0;
+    // The squares of the zone being filled, so that filling it in doesn't
+    // need another pass over the whole area for each zone.
+    vector<coord_def> zone;
+    auto record_zone = [&zone](const coord_def &c) { zone.push_back(c); };
     for (int y = y1; y <= y2 ; ++y)
     {
         for (int x = x1; x <= x2; ++x)
@@ -921,13 +942,18 @@ static int _process_disconnected_zones(int x1, int y1, int x2, int y2,
                 continue;
             }
 
+            zone.clear();
+            zone.emplace_back(x, y);
+            bool (*iswanted)(const coord_def &) =
+                choose_stairless ? (at_branch_bottom() ?
+                                    _is_upwards_exit_stair :
+                                    _is_exit_stair) : nullptr;
             const bool found_exit_stair =
-                _dgn_fill_zone(coord_def(x, y), ++nzones,
-                               _dgn_point_record_stub,
-                               _dgn_square_is_passable,
-                               choose_stairless ? (at_branch_bottom() ?
-                                                   _is_upwards_exit_stair :
-                                                   _is_exit_stair) : nullptr);
+                fill ? _dgn_fill_zone(coord_def(x, y), ++nzones, record_zone,
+                                      _dgn_square_is_passable, iswanted)
+                     : _dgn_fill_zone(coord_def(x, y), ++nzones,
+                                      _dgn_point_record_stub,
+                                      _dgn_square_is_passable, iswanted);
 
             // If we want only stairless zones, screen out zones that did
             // have stairs.
@@ -941,23 +967,16 @@ static int _process_disconnected_zones(int x1, int y1, int x2, int y2,
                 // vetoed later on.
                 bool veto = false;
                 vector<coord_def> coords;
-                for (int fy = y1; fy <= y2 ; ++fy)
+                for (const coord_def &c : zone)
                 {
-                    for (int fx = x1; fx <= x2; ++fx)
+                    if (c.x < x1 || c.x > x2 || c.y < y1 || c.y > y2)
+                        continue;
+                    if (map_masked(c, MMT_VAULT))
                     {
-                        if (travel_point_distance[fx][fy] == nzones)
-                        {
-                            if (map_masked(coord_def(fx, fy), MMT_VAULT))
-                            {
-                                veto = true;
-                                break;
-                            }
-                            else
-                                coords.emplace_back(fx, fy);
-                        }
-                    }
-                    if (veto)
+                        veto = true;
                         break;
+                    }
+                    coords.push_back(c);
                 }
                 if (!veto)
                 {
@@ -1193,6 +1212,9 @@ static bool _is_level_stair_connected(dungeon_feature_type feat)
 
 static bool _valid_dungeon_level()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_CONNECTIVITY);
+#endif
     // D:1 only.
     // Also, what's the point of this check?  Regular connectivity should
     // do that already.
@@ -1953,6 +1975,9 @@ static bool _branch_needs_stairs()
 
 static void _dgn_verify_connectivity(unsigned nvaults)
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_CONNECTIVITY);
+#endif
     // After placing vaults, make sure parts of the level have not been
     // disconnected.
     if (dgn_zones && nvaults != env.level_vaults.size())
@@ -2665,6 +2690,9 @@ static bool _pan_level()
 // to place more vaults after this
 static bool _builder_by_type()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_LAYOUT);
+#endif
     if (player_in_branch(BRANCH_LABYRINTH))
     {
         dgn_build_labyrinth_level();
@@ -2969,6 +2997,9 @@ struct label_match
 // obstructed by slime wall adjacent squares
 static void _slime_connectivity_fixup()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_CONNECTIVITY);
+#endif
     // Generate a connectivity map considering any non wall, non vault square
     // passable
     FixedArray<int, GXM, GYM> connectivity_map;
@@ -3099,6 +3130,9 @@ static void _slime_connectivity_fixup()
 // Place vaults with CHANCE: that want to be placed on this level.
 static void _place_chance_vaults()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_EXTRA_VAULTS);
+#endif
     const level_id &lid(level_id::current());
     mapref_vector maps = random_chance_maps_in_depth(lid);
     // [ds] If there are multiple CHANCE maps that share an luniq_ or
@@ -3136,6 +3170,9 @@ static void _place_chance_vaults()
 
 static void _place_minivaults()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_MINIVAULTS);
+#endif
     const map_def *vault = nullptr;
     // First place the vault requested with &P
     if (you.props.exists("force_minivault")
@@ -3445,6 +3482,9 @@ static bool _place_vault_by_tag(const string &tag)
 
 static void _place_branch_entrances(bool use_vaults)
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_EXTRA_VAULTS);
+#endif
     // Find what branch entrances are already placed, and what branch
     // entrances could be placed here.
     bool branch_entrance_placed[NUM_BRANCHES];
@@ -3530,6 +3570,9 @@ static void _place_branch_entrances(bool use_vaults)
 
 static void _place_extra_vaults()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_EXTRA_VAULTS);
+#endif
     int tries = 0;
     while (true)
     {
@@ -3560,6 +3603,9 @@ static void _place_extra_vaults()
 // Return the number of uniques placed.
 static int _place_uniques()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_MONSTERS);
+#endif
 #ifdef DEBUG_UNIQUE_PLACEMENT
     FILE *ostat = fopen("unique_placement.log", "a");
     fprintf(ostat, "--- Looking to place uniques on %s\n",
@@ -3758,6 +3804,9 @@ bool door_vetoed(const coord_def pos)
 
 static void _builder_monsters()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_MONSTERS);
+#endif
     if (player_in_branch(BRANCH_TEMPLE))
         return;
 
@@ -3773,6 +3822,7 @@ static void _builder_monsters()
     const dungeon_feature_type preferred_grid_feature =
         in_shoals ? DNGN_FLOOR : DNGN_UNSEEN;
 
+    monster_placement_batch batch;
     dprf(DIAG_DNGN, "_builder_monsters: Generating %d monsters", mon_wanted);
     for (int i = 0; i < mon_wanted; i++)
     {
@@ -3836,6 +3886,9 @@ static void _randomly_place_item(int item)
  */
 static void _builder_items()
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_ITEMS);
+#endif
     int i = 0;
     object_class_type specif_type = OBJ_RANDOM;
     int items_levels = env.absdepth0;
@@ -4121,6 +4174,9 @@ static const vault_placement *_build_secondary_vault(const map_def *vault,
 //
 static const vault_placement *_build_primary_vault(const map_def *vault)
 {
+#ifdef DEBUG_STATISTICS
+    genlevel_phase_timer phase_timer(GENLEVEL_PHASE_PRIMARY_VAULT);
+#endif
     return _build_vault_impl(vault);
 }
 
@@ -198,6 +198,7 @@ bool builder(bool enable_random_maps = true,
              dungeon_feature_type dest_stairs_type = NUM_FEATURES);
 
 void dgn_clear_vault_placements();
+vector<bool> dgn_vaults_on_map();
 void dgn_erase_unused_vault_placements();
 void dgn_flush_map_memory();
 
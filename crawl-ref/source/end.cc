@@ -18,6 +18,7 @@
 #include "dungeon.h"
 #include "god-passive.h"
 #include "hints.h"
+#include "hiscores.h"
 #include "invent.h"
 #include "item-prop.h"
 #include "los.h"
@@ -28,6 +29,7 @@
 #include "religion.h"
 #include "state.h"
 #include "stringutil.h"
+#include "turn-profile.h"
 #include "view.h"
 #include "xom.h"
 
@@ -137,6 +139,7 @@ NORETURN void end(int exit_code, bool print_error, const char *format, ...)
 {
     bool need_pause = true;
     disable_other_crashes();
+    flush_milestones();
 
     // Let "error" go out of scope for valgrind's sake.
     {
@@ -178,6 +181,13 @@ NORETURN void end(int exit_code, bool print_error, const char *format, ...)
 #ifdef DEBUG_PROPS
         dump_prop_accesses();
 #endif
+        if (!crawl_state.turn_profile_file.empty()
+            && !turn_profile_write(crawl_state.turn_profile_file))
+        {
+            fprintf(stderr, "Couldn't write turn profile to %s\n",
+                    crawl_state.turn_profile_file.c_str());
+        }
+        stop_sampling_profiler();
 
         if (!error.empty())
         {
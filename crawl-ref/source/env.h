@@ -18,6 +18,43 @@ typedef vector<unique_ptr<vault_placement>> vault_placement_refv;
 
 typedef FixedArray< map_cell, GXM, GYM > MapKnowledge;
 
+// The clouds on a level: a dense grid of indices into a compact store of
+// (position, cloud) pairs, so looking up a cell is a single array read.
+// Adding a cloud never moves the others; erasing one moves the last cloud
+// into its slot.
+class cloud_grid
+{
+public:
+    typedef pair<coord_def, cloud_struct> value_type;
+    typedef deque<value_type>::iterator iterator;
+    typedef deque<value_type>::const_iterator const_iterator;
+
+    cloud_grid();
+
+    cloud_struct *find(const coord_def &p);
+    const cloud_struct *find(const coord_def &p) const;
+
+    // Like map::operator[], adds an empty cloud at p if there isn't one.
+    cloud_struct &operator[](const coord_def &p);
+    void erase(const coord_def &p);
+    void clear();
+
+    size_t size() const { return clouds.size(); }
+    bool empty() const { return clouds.empty(); }
+    value_type &at_index(size_t i) { return clouds[i]; }
+
+    iterator begin() { return clouds.begin(); }
+    iterator end() { return clouds.end(); }
+    const_iterator begin() const { return clouds.begin(); }
+    const_iterator end() const { return clouds.end(); }
+
+private:
+    static const int NO_CLOUD = -1;
+
+    FixedArray<int, GXM, GYM> slot;
+    deque<value_type> clouds;
+};
+
 class final_effect;
 struct crawl_environment
 {
@@ -26,6 +63,12 @@ struct crawl_environment
 
     FixedVector< item_def, MAX_ITEMS >       item;  // item list
     FixedVector< monster, MAX_MONSTERS+2 >   mons;  // monster list, plus anon
+    // Every monster slot from here on has been empty since the level's
+    // monsters were last reset, so loops over live monsters can stop early.
+    int                                      mons_used;
+    // Every monster slot below this one is in use, so looking for a free
+    // slot can start here. Lowered whenever a slot is reset.
+    int                                      mons_free_from;
 
     feature_grid                             grid;  // terrain grid
     FixedArray<terrain_property_t, GXM, GYM> pgrid; // terrain properties
@@ -71,7 +114,7 @@ struct crawl_environment
     tile_flavour tile_default;
     vector<string> tile_names;
 
-    map<coord_def, cloud_struct> cloud;
+    cloud_grid cloud;
 
     map<coord_def, shop_struct> shop; // shop list
     map<coord_def, trap_def> trap; // trap list
@@ -151,6 +194,17 @@ static const struct menv_range_proxy
     monster *end()   const { return &menv[MAX_MONSTERS]; }
 } menv_real;
 
+/**
+ * Range proxy over the menv slots that have held a monster since the level's
+ * monsters were reset; every live monster is among them.
+ */
+static const struct menv_used_range_proxy
+{
+    menv_used_range_proxy() {}
+    monster *begin() const { return &menv[0]; }
+    monster *end()   const { return &menv[env.mons_used]; }
+} menv_used;
+
 /**
  * Look up a property of a coordinate in the player's map_knowledge grid.
  *
@@ -150,6 +150,16 @@ void travel_exclude::set_los()
         los.set_bounds(circle_def(radius, C_SQUARE));
         los.update();
     }
+
+    points.reset();
+    if (radius == 0)
+    {
+        points.set(pos);
+        return;
+    }
+    for (radius_iterator ri(pos, radius, C_SQUARE); ri; ++ri)
+        if (affects(*ri))
+            points.set(*ri);
 }
 
 bool travel_exclude::affects(const coord_def& p) const
@@ -183,7 +193,7 @@ exclude_set::exclude_set()
 void exclude_set::clear()
 {
     exclude_roots.clear();
-    exclude_points.clear();
+    exclude_points.reset();
 }
 
 void exclude_set::erase(const coord_def &p)
@@ -215,30 +225,22 @@ void exclude_set::add_exclude(const coord_def &p, int radius,
 
 void exclude_set::add_exclude_points(travel_exclude& ex)
 {
-    if (ex.radius == 0)
-    {
-        exclude_points.insert(ex.pos);
-        return;
-    }
-
     if (!ex.uptodate)
         ex.set_los();
-    else
-        ex.los.update();
 
-    for (radius_iterator ri(ex.pos, ex.radius, C_SQUARE); ri; ++ri)
-        if (ex.affects(*ri))
-            exclude_points.insert(*ri);
+    exclude_points |= ex.points;
 }
 
-void exclude_set::update_excluded_points(bool recompute_los)
+// Only exclusions whose LOS has been invalidated are recomputed; the rest
+// keep the points they already have.
+void exclude_set::update_excluded_points()
 {
     for (iterator it = exclude_roots.begin(); it != exclude_roots.end(); ++it)
     {
         travel_exclude &ex = it->second;
         if (!ex.uptodate)
         {
-            recompute_excluded_points(recompute_los);
+            recompute_excluded_points();
             return;
         }
     }
@@ -246,7 +248,7 @@ void exclude_set::update_excluded_points(bool recompute_los)
 
 void exclude_set::recompute_excluded_points(bool recompute_los)
 {
-    exclude_points.clear();
+    exclude_points.reset();
     for (iterator it = exclude_roots.begin(); it != exclude_roots.end(); ++it)
     {
         travel_exclude &ex = it->second;
@@ -258,7 +260,7 @@ void exclude_set::recompute_excluded_points(bool recompute_los)
 
 bool exclude_set::is_excluded(const coord_def &p) const
 {
-    return exclude_points.count(p);
+    return map_bounds(p) && exclude_points(p);
 }
 
 bool exclude_set::is_exclude_root(const coord_def &p) const
@@ -331,7 +333,7 @@ void update_exclusion_los(vector<coord_def> changed)
     for (coord_def c : changed)
         _mark_excludes_non_updated(c);
 
-    curr_excludes.update_excluded_points(true);
+    curr_excludes.update_excluded_points();
 }
 
 bool is_excluded(const coord_def &p, const exclude_set &exc)
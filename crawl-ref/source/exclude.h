@@ -30,6 +30,7 @@ public:
     bool          autoex;       // Was set automatically.
     string        desc;         // Exclusion description.
     bool          vault;        // Is this exclusion set by a vault?
+    map_bitmask   points;       // Cells affected, as of the last set_los().
 
     travel_exclude(const coord_def &p, int r = LOS_RADIUS,
                    bool autoex = false, string desc = "",
@@ -65,7 +66,7 @@ public:
                      string desc = "",
                      bool vaultexcl = false);
 
-    void update_excluded_points(bool recompute_los = false);
+    void update_excluded_points();
     void recompute_excluded_points(bool recompute_los = false);
 
     travel_exclude* get_exclude_root(const coord_def &p);
@@ -84,10 +85,11 @@ public:
     iterator  end();
 
 private:
-    typedef set<coord_def> exclset;
-
     exclmap exclude_roots;
-    exclset exclude_points;
+
+    // The union of the points of every exclusion, so that travel floods can
+    // check a square without looking at each exclusion in turn.
+    map_bitmask exclude_points;
 
 private:
     void add_exclude_points(travel_exclude& ex);
@@ -826,6 +826,7 @@ public:
     void move_marker(map_marker *marker, const coord_def &to);
     vector<map_marker*> get_all(map_marker_type type = MAT_ANY);
     vector<map_marker*> get_all(const string &key, const string &val = "");
+    vector<map_marker*> get_all_by_cell() const;
     vector<map_marker*> get_markers_at(const coord_def &c);
     string property_at(const coord_def &c, map_marker_type type,
                        const string &key);
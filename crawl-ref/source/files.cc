@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <list>
 #include <string>
 #include <fcntl.h>
 #include <sys/stat.h>
@@ -24,6 +25,10 @@
 #ifdef UNIX
 #include <unistd.h>
 #endif
+#ifndef TARGET_OS_WINDOWS
+#include <csignal>
+#include <sys/wait.h>
+#endif
 
 #include "abyss.h"
 #include "act-iter.h"
@@ -36,6 +41,7 @@
 #include "dactions.h"
 #include "dgn-overview.h"
 #include "directn.h"
+#include "dlua.h"
 #include "dungeon.h"
 #include "end.h"
 #include "errors.h"
@@ -61,9 +67,11 @@
 #include "mon-death.h"
 #include "mon-place.h"
 #include "notes.h"
+#include "options.h"
 #include "output.h"
 #include "place.h"
 #include "prompt.h"
+#include "random.h"
 #include "species.h"
 #include "spl-summoning.h"
 #include "stash.h"  // for fedhas_rot_all_corpses
@@ -94,11 +102,16 @@
 #endif
 
 static void _save_level(const level_id& lid);
+static void _restore_level(const string &name);
+static bool _level_chunk_exists(const string &name);
 
 static bool _ghost_version_compatible(reader &ghost_reader);
 
 static bool _restore_tagged_chunk(package *save, const string &name,
                                   tag_type tag, const char* complaint);
+static bool _restore_tagged_reader(reader &inf, const string &name,
+                                   tag_type tag, const char* complaint);
+static bool _tagged_chunk_version_compatible(reader &inf, string* reason);
 static bool _read_char_chunk(package *save);
 
 static bool _convert_obsolete_species();
@@ -633,6 +646,185 @@ static void _fill_player_doll(player_save_info &p, package *save)
  * current user.
  */
 
+#ifndef DISABLE_SAVEGAME_LISTS
+// Each save directory keeps an index of the player_save_info of its saves,
+// so that listing them doesn't need to open and decompress every save.
+// Entries are trusted only while the save's mtime and size still match.
+#define SAVE_INDEX_FILE "saves.idx"
+#define SAVE_INDEX_VERSION 1
+
+struct save_index_entry
+{
+    int64_t mtime;
+    int64_t size;
+    bool has_doll;
+    player_save_info info;
+};
+
+typedef map<string, save_index_entry> save_index;
+
+static bool _stat_save(const string &path, int64_t &mtime, int64_t &size)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st))
+        return false;
+    mtime = st.st_mtime;
+    size = st.st_size;
+    return true;
+}
+
+static void _marshall_save_index_entry(writer &th, const save_index_entry &e)
+{
+    const player_save_info &p = e.info;
+    marshallSigned(th, e.mtime);
+    marshallSigned(th, e.size);
+    marshallString(th, p.name);
+    marshallInt(th, p.experience);
+    marshallInt(th, p.experience_level);
+    marshallBoolean(th, p.wizard);
+    marshallShort(th, p.species);
+    marshallString(th, p.species_name);
+    marshallString(th, p.class_name);
+    marshallShort(th, p.religion);
+    marshallString(th, p.god_name);
+    marshallString(th, p.jiyva_second_name);
+    marshallByte(th, p.saved_game_type);
+    marshallBoolean(th, p.save_loadable);
+#ifdef USE_TILE
+    marshallBoolean(th, e.has_doll);
+    if (e.has_doll)
+    {
+        marshallShort(th, TILEP_PART_MAX);
+        for (int i = 0; i < TILEP_PART_MAX; ++i)
+            marshallInt(th, p.doll.parts[i]);
+    }
+#else
+    marshallBoolean(th, false);
+#endif
+}
+
+static save_index_entry _unmarshall_save_index_entry(reader &th)
+{
+    save_index_entry e;
+    player_save_info &p = e.info;
+    e.mtime              = unmarshallSigned(th);
+    e.size               = unmarshallSigned(th);
+    p.name               = unmarshallString(th);
+    p.experience         = unmarshallInt(th);
+    p.experience_level   = unmarshallInt(th);
+    p.wizard             = unmarshallBoolean(th);
+    p.species            = static_cast<species_type>(unmarshallShort(th));
+    p.species_name       = unmarshallString(th);
+    p.class_name         = unmarshallString(th);
+    p.religion           = static_cast<god_type>(unmarshallShort(th));
+    p.god_name           = unmarshallString(th);
+    p.jiyva_second_name  = unmarshallString(th);
+    p.saved_game_type    = static_cast<game_type>(unmarshallByte(th));
+    p.save_loadable      = unmarshallBoolean(th);
+    e.has_doll           = unmarshallBoolean(th);
+    if (e.has_doll)
+    {
+        // Written by a tiles build; other builds just skip the doll.
+        const int parts = unmarshallShort(th);
+        for (int i = 0; i < parts; ++i)
+        {
+            const int part = unmarshallInt(th);
+#ifdef USE_TILE
+            if (i < TILEP_PART_MAX)
+                p.doll.parts[i] = part;
+#else
+            UNUSED(part);
+#endif
+        }
+#ifdef USE_TILE
+        e.has_doll = parts == TILEP_PART_MAX;
+#else
+        e.has_doll = false;
+#endif
+    }
+    return e;
+}
+
+// A missing, unreadable or foreign index is simply empty.
+static save_index _read_save_index(const string &dir)
+{
+    save_index index;
+    reader th(dir + SAVE_INDEX_FILE);
+    if (!th.valid())
+        return index;
+    th.set_safe_read(true);
+
+    try
+    {
+        if (unmarshallUByte(th) != SAVE_INDEX_VERSION
+            || unmarshallString(th) != Version::Long)
+        {
+            return index;
+        }
+        const int count = unmarshallInt(th);
+        for (int i = 0; i < count; ++i)
+        {
+            const string filename = unmarshallString(th);
+            index[filename] = _unmarshall_save_index_entry(th);
+        }
+    }
+    catch (short_read_exception &E)
+    {
+        index.clear();
+    }
+    return index;
+}
+
+// Replace the index atomically, so that concurrent readers see either the
+// old or the new one. Failure only costs the next scan some time.
+static void _write_save_index(const string &dir, const save_index &index)
+{
+    const string filename = dir + SAVE_INDEX_FILE;
+#ifdef UNIX
+    const string tmpname = make_stringf("%s.%d.tmp", filename.c_str(),
+                                        (int) getpid());
+#else
+    const string tmpname = filename + ".tmp";
+#endif
+    FILE *f = fopen_u(tmpname.c_str(), "wb");
+    if (!f)
+        return;
+
+    bool ok;
+    {
+        writer th(tmpname, f, true);
+        marshallUByte(th, SAVE_INDEX_VERSION);
+        marshallString(th, Version::Long);
+        marshallInt(th, index.size());
+        for (const auto &entry : index)
+        {
+            marshallString(th, entry.first);
+            _marshall_save_index_entry(th, entry.second);
+        }
+        ok = th.succeeded();
+    }
+    ok = !fclose(f) && ok;
+
+    if (!ok || rename_u(tmpname.c_str(), filename.c_str()))
+        unlink_u(tmpname.c_str());
+}
+
+// Record the save that was just written and closed.
+static void _update_save_index(const player_save_info &info, bool has_doll)
+{
+    const string dir = _get_savefile_directory();
+    save_index_entry e;
+    if (!_stat_save(dir + info.filename, e.mtime, e.size))
+        return;
+    e.info = info;
+    e.has_doll = has_doll;
+
+    save_index index = _read_save_index(dir);
+    index[info.filename] = e;
+    _write_save_index(dir, index);
+}
+#endif // !DISABLE_SAVEGAME_LISTS
+
 static vector<player_save_info> _find_saved_characters()
 {
     vector<player_save_info> chars;
@@ -646,22 +838,54 @@ static vector<player_save_info> _find_saved_characters()
     if (searchpath.empty())
         searchpath = ".";
 
+    const save_index old_index = _read_save_index(_get_savefile_directory());
+    save_index index;
+    bool changed = false;
+#ifdef USE_TILE
+    const bool want_doll = Options.tile_menu_icons;
+#else
+    const bool want_doll = false;
+#endif
+
     for (const string &filename : get_dir_files(searchpath))
     {
         if (is_save_file_name(filename))
         {
+            const string path = _get_savedir_path(filename);
+            save_index_entry e;
+            if (!_stat_save(path, e.mtime, e.size))
+                continue;
+
+            const save_index_entry *old = map_find(old_index, filename);
+            if (old && old->mtime == e.mtime && old->size == e.size
+                && (old->has_doll || !want_doll))
+            {
+                player_save_info p = old->info;
+                p.filename = filename;
+                chars.push_back(p);
+                index[filename] = *old;
+                continue;
+            }
+
+            changed = true;
             try
             {
-                package save(_get_savedir_path(filename).c_str(), false);
+                package save(path.c_str(), false);
                 player_save_info p = _read_character_info(&save);
                 if (!p.name.empty())
                 {
                     p.filename = filename;
+                    e.has_doll = false;
 #ifdef USE_TILE
                     if (Options.tile_menu_icons && save.has_chunk("tdl"))
+                    {
                         _fill_player_doll(p, &save);
+                        e.has_doll = true;
+                    }
 #endif
                     chars.push_back(p);
+                    e.info = p;
+                    index[filename] = e;
                 }
             }
             catch (ext_fail_exception &E)
@@ -672,6 +896,9 @@ static vector<player_save_info> _find_saved_characters()
 
     }
 
+    if (changed || index.size() != old_index.size())
+        _write_save_index(_get_savefile_directory(), index);
+
     sort(chars.begin(), chars.end());
 #endif // !DISABLE_SAVEGAME_LISTS
     return chars;
@@ -1139,6 +1366,300 @@ static bool _leave_level(dungeon_feature_type stair_taken,
 }
 
 
+#define LEVELGEN_COUNT_KEY "levelgen_count"
+
+/**
+ * Build the current level for the first time (or again, if it was deleted).
+ *
+ * Generation draws on a stream seeded from the game seed, the level and how
+ * often it has been built, rather than on the gameplay RNG, so the result
+ * depends only on the state recorded by _marshall_levelgen_inputs(). That is
+ * what lets a helper process build the level ahead of time.
+ *
+ * @param stair_type    The stair the player will arrive on.
+ */
+static void _build_new_level(dungeon_feature_type stair_type)
+{
+    const level_id lid = level_id::current();
+    CrawlHashTable &counts = you.props[LEVELGEN_COUNT_KEY].get_table();
+    const int count = counts.exists(lid.describe())
+                      ? counts[lid.describe()].get_int() : 0;
+    counts[lid.describe()] = count + 1;
+
+    uint64_t seed[] = { static_cast<uint64_t>(you.where_are_you ^ you.game_seed),
+                        static_cast<uint64_t>(you.depth),
+                        static_cast<uint64_t>(count) };
+    rng_override level_rng(seed, ARRAYSZ(seed));
+
+    tile_init_default_flavour();
+    tile_clear_flavour();
+    env.tile_names.clear();
+
+    _clear_env_map();
+    builder(true, stair_type);
+}
+
+// Player state that building a level may change. A pregeneration helper
+// hands its copy back along with the level, so this must cover every side
+// effect of _build_new_level() outside env.
+static void _marshall_levelgen_results(writer &th)
+{
+    marshallInt(th, you.last_mid);
+    for (int i = 0; i < NUM_MONSTERS; ++i)
+        marshallBoolean(th, you.unique_creatures[i]);
+    for (int i = 0; i < MAX_UNRANDARTS; ++i)
+        marshallByte(th, you.unique_items[i]);
+    marshallInt(th, you.uniq_map_tags.size());
+    for (const string &tag : you.uniq_map_tags)
+        marshallString(th, tag);
+    marshallInt(th, you.uniq_map_names.size());
+    for (const string &name : you.uniq_map_names)
+        marshallString(th, name);
+    you.props.write(th);
+    if (!dlua.callfn("dgn_save_data", "u", &th))
+        mprf(MSGCH_ERROR, "Failed to save Lua data: %s", dlua.error.c_str());
+}
+
+static void _unmarshall_levelgen_results(reader &th)
+{
+    you.last_mid = unmarshallInt(th);
+    for (int i = 0; i < NUM_MONSTERS; ++i)
+        you.unique_creatures.set(i, unmarshallBoolean(th));
+    for (int i = 0; i < MAX_UNRANDARTS; ++i)
+    {
+        you.unique_items[i] =
+            static_cast<unique_item_status_type>(unmarshallByte(th));
+    }
+    you.uniq_map_tags.clear();
+    for (int i = unmarshallInt(th); i > 0; --i)
+        you.uniq_map_tags.insert(unmarshallString(th));
+    you.uniq_map_names.clear();
+    for (int i = unmarshallInt(th); i > 0; --i)
+        you.uniq_map_names.insert(unmarshallString(th));
+    you.props.clear();
+    you.props.read(th);
+    if (!dlua.callfn("dgn_load_data", "u", &th))
+        mprf(MSGCH_ERROR, "Failed to load Lua data: %s", dlua.error.c_str());
+}
+
+// Everything building lid may depend on. A pregenerated level can stand in
+// for a freshly built one only if this hasn't changed since it was started.
+static void _marshall_levelgen_inputs(writer &th, const level_id &lid,
+                                      dungeon_feature_type stair_type)
+{
+    marshall_level_id(th, lid);
+    marshallShort(th, stair_type);
+    marshallByte(th, you.chapter);
+    marshallByte(th, you.species);
+    marshallByte(th, you.religion);
+    marshallByte(th, you.experience_level);
+    _marshall_levelgen_results(th);
+}
+
+#ifndef TARGET_OS_WINDOWS
+static struct
+{
+    pid_t pid = 0;
+    level_id level;
+    dungeon_feature_type stair_type = DNGN_UNSEEN;
+    vector<unsigned char> inputs; // _marshall_levelgen_inputs() at fork time
+} pregen;
+
+static string _pregen_filename()
+{
+    return get_savedir_filename(you.your_name) + ".pregen";
+}
+
+/**
+ * Body of the pregeneration helper: build lid as if the player had just
+ * arrived by stair_type, and write it out with the changed player state.
+ * This runs in a forked copy of the game and must not touch the save.
+ */
+static bool _pregenerate_level(const level_id &lid,
+                               dungeon_feature_type stair_type)
+{
+    no_messages mx;
+
+    you.where_are_you = lid.branch;
+    you.depth = lid.depth;
+    env.turns_on_level = -1;
+    _build_new_level(stair_type);
+    fix_item_coordinates();
+
+    const string filename = _pregen_filename();
+    FILE *outf = fopen(filename.c_str(), "wb");
+    if (!outf)
+        return false;
+    writer th(filename, outf);
+    marshallUByte(th, TAG_MAJOR_VERSION);
+    marshallUByte(th, TAG_MINOR_VERSION);
+    _marshall_levelgen_results(th);
+    tag_write(TAG_LEVEL, th);
+    fclose(outf);
+    return true;
+}
+
+static void _start_pregeneration(const level_id &lid,
+                                 dungeon_feature_type stair_taken)
+{
+    cancel_level_pregeneration();
+
+    bool dummy;
+    const dungeon_feature_type stair_type = static_cast<dungeon_feature_type>(
+        _get_dest_stair_type(you.where_are_you, stair_taken, dummy));
+
+    vector<unsigned char> inputs;
+    {
+        writer th(&inputs);
+        _marshall_levelgen_inputs(th, lid, stair_type);
+    }
+
+    // Don't let the helper inherit and re-flush our pending output.
+    fflush(stdout);
+    fflush(stderr);
+    const pid_t pid = fork();
+    if (pid == -1)
+    {
+        dprf("Couldn't fork level pregeneration: %s", strerror(errno));
+        return;
+    }
+    if (pid == 0)
+        _exit(_pregenerate_level(lid, stair_type) ? 0 : 1);
+
+    dprf("Pregenerating %s.", lid.describe().c_str());
+    pregen.pid = pid;
+    pregen.level = lid;
+    pregen.stair_type = stair_type;
+    pregen.inputs = move(inputs);
+}
+
+/**
+ * Replace the current (cleared) level with the pregenerated one, if there is
+ * one for it and nothing it depended on has changed since it was started.
+ * Waits for the helper to finish if need be.
+ *
+ * @return Whether the level was adopted.
+ */
+static bool _adopt_pregenerated_level(dungeon_feature_type stair_type)
+{
+    if (!pregen.pid)
+        return false;
+
+    vector<unsigned char> inputs;
+    {
+        writer th(&inputs);
+        _marshall_levelgen_inputs(th, level_id::current(), stair_type);
+    }
+    if (inputs != pregen.inputs)
+    {
+        dprf("Discarding stale pregenerated level.");
+        cancel_level_pregeneration();
+        return false;
+    }
+
+    int status = 0;
+    const bool built = waitpid(pregen.pid, &status, 0) == pregen.pid
+                       && WIFEXITED(status) && !WEXITSTATUS(status);
+    pregen.pid = 0;
+    pregen.inputs.clear();
+
+    const string filename = _pregen_filename();
+    FILE *inf = built ? fopen(filename.c_str(), "rb") : nullptr;
+    if (!inf)
+    {
+        unlink(filename.c_str());
+        return false;
+    }
+
+    reader th(inf);
+    string reason;
+    if (!_tagged_chunk_version_compatible(th, &reason))
+    {
+        dprf("Pregenerated level unusable: %s", reason.c_str());
+        fclose(inf);
+        unlink(filename.c_str());
+        return false;
+    }
+
+    // A fresh level doesn't remember any previous visit; keep it that way.
+    unwind_var<int> elapsed(env.elapsed_time);
+    unwind_var<coord_def> old_pos(env.old_player_pos);
+
+    crawl_state.minor_version = th.getMinorVersion();
+    _unmarshall_levelgen_results(th);
+    tag_read(th, TAG_LEVEL);
+    fclose(inf);
+    unlink(filename.c_str());
+    dprf("Adopted pregenerated %s.", level_id::current().describe().c_str());
+    return true;
+}
+#endif
+
+/**
+ * Kill any level pregeneration in progress and discard its result.
+ */
+void cancel_level_pregeneration()
+{
+#ifndef TARGET_OS_WINDOWS
+    if (!pregen.pid)
+        return;
+    kill(pregen.pid, SIGKILL);
+    waitpid(pregen.pid, nullptr, 0);
+    pregen.pid = 0;
+    pregen.inputs.clear();
+    unlink(_pregen_filename().c_str());
+#endif
+}
+
+/**
+ * Start building the level below a stone downstair the player is standing
+ * on, next to, or travelling to, if it hasn't been visited yet.
+ *
+ * Only does anything with the pregen_levels option.
+ */
+void maybe_pregenerate_level()
+{
+#ifndef TARGET_OS_WINDOWS
+    if (!Options.pregen_levels
+        || !player_in_connected_branch()
+        || you.chapter == CHAPTER_POCKET_ABYSS
+        || you.depth >= brdepth[you.where_are_you]
+        || crawl_state.game_is_arena())
+    {
+        return;
+    }
+
+    const level_id dest(you.where_are_you, you.depth + 1);
+    if (is_existing_level(dest))
+        return;
+
+    vector<coord_def> near;
+    for (radius_iterator ri(you.pos(), 1, C_SQUARE); ri; ++ri)
+        near.push_back(*ri);
+    if (you.running.is_any_travel())
+        near.emplace_back(you.travel_x, you.travel_y);
+
+    for (const coord_def &p : near)
+    {
+        if (!in_bounds(p) || !feat_is_stone_stair_down(grd(p)))
+            continue;
+
+        // Arriving by a different stair may place different mimics, so a
+        // helper already working on this level via another stair is
+        // restarted.
+        bool dummy;
+        if (pregen.pid && pregen.level == dest
+            && pregen.stair_type == _get_dest_stair_type(you.where_are_you,
+                                                         grd(p), dummy))
+        {
+            return;
+        }
+        _start_pregeneration(dest, grd(p));
+        return;
+    }
+#endif
+}
+
 /**
  * Generate a new level.
  *
@@ -1163,10 +1684,6 @@ static void _make_level(dungeon_feature_type stair_taken,
         you.chapter = CHAPTER_ORB_HUNTING;
     }
 
-    tile_init_default_flavour();
-    tile_clear_flavour();
-    env.tile_names.clear();
-
     // XXX: This is ugly.
     bool dummy;
     dungeon_feature_type stair_type = static_cast<dungeon_feature_type>(
@@ -1174,8 +1691,10 @@ static void _make_level(dungeon_feature_type stair_taken,
                              static_cast<dungeon_feature_type>(stair_taken),
                              dummy));
 
-    _clear_env_map();
-    builder(true, stair_type);
+#ifndef TARGET_OS_WINDOWS
+    if (!_adopt_pregenerated_level(stair_type))
+#endif
+        _build_new_level(stair_type);
 
     if (ghost_demon::ghost_eligible() && one_chance_in(3))
         load_ghosts(ghost_demon::max_ghosts_per_level(env.absdepth0), true);
@@ -1343,7 +1862,7 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
     bool just_created_level = false;
 
     // GENERATE new level when the file can't be opened:
-    if (!you.save->has_chunk(level_name))
+    if (!_level_chunk_exists(level_name))
     {
         ASSERT(load_mode != LOAD_VISITOR);
         dprf("Generating new level for '%s'.", level_name.c_str());
@@ -1353,7 +1872,7 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
     else
     {
         dprf("Loading old level '%s'.", level_name.c_str());
-        _restore_tagged_chunk(you.save, level_name, TAG_LEVEL, "Level file is invalid.");
+        _restore_level(level_name);
 
         _redraw_all();
     }
@@ -1561,6 +2080,70 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
     return just_created_level;
 }
 
+// Recently left levels, serialised but not compressed. A level saved on
+// the way out is only written to the package when the game is committed
+// (or when it drops out of the cache), so going back and forth between
+// levels, or on a level_excursion, skips compression and decompression.
+#define LEVEL_CACHE_SIZE 8
+
+struct cached_level
+{
+    string name;
+    vector<unsigned char> data;
+    bool dirty; // not yet written to the package
+};
+
+static list<cached_level> level_cache;
+
+static void _write_cached_level(cached_level &level)
+{
+    if (!level.dirty)
+        return;
+    writer outf(you.save, level.name);
+    outf.write(level.data.data(), level.data.size());
+    level.dirty = false;
+}
+
+// The cache entry for a level, moved to the front; or nullptr.
+static cached_level *_find_cached_level(const string &name)
+{
+    for (auto i = level_cache.begin(); i != level_cache.end(); ++i)
+        if (i->name == name)
+        {
+            level_cache.splice(level_cache.begin(), level_cache, i);
+            return &level_cache.front();
+        }
+    return nullptr;
+}
+
+static void _forget_cached_level(const string &name)
+{
+    level_cache.remove_if([&name](const cached_level &level)
+                          { return level.name == name; });
+}
+
+// Write all levels that only exist in the cache to the package.
+static void _flush_level_cache()
+{
+    for (cached_level &level : level_cache)
+        _write_cached_level(level);
+}
+
+// Whether a level has been saved, either to the package or to the cache.
+static bool _level_chunk_exists(const string &name)
+{
+    if (!you.save)
+        return false;
+    return you.save->has_chunk(name)
+           || any_of(level_cache.begin(), level_cache.end(),
+                     [&name](const cached_level &l) { return l.name == name; });
+}
+
+void reset_level_cache()
+{
+    level_cache.clear();
+}
+
 static void _save_level(const level_id& lid)
 {
     travel_cache.get_level_info(lid).update();
@@ -1568,7 +2151,38 @@ static void _save_level(const level_id& lid)
     // Nail all items to the ground.
     fix_item_coordinates();
 
-    _write_tagged_chunk(lid.describe(), TAG_LEVEL);
+    const string name = lid.describe();
+    _forget_cached_level(name);
+    level_cache.push_front(cached_level());
+    cached_level &level = level_cache.front();
+    level.name = name;
+    level.dirty = true;
+    {
+        writer outf(&level.data);
+        marshallUByte(outf, TAG_MAJOR_VERSION);
+        marshallUByte(outf, TAG_MINOR_VERSION);
+        tag_write(TAG_LEVEL, outf);
+    }
+
+    if (level_cache.size() > LEVEL_CACHE_SIZE)
+    {
+        _write_cached_level(level_cache.back());
+        level_cache.pop_back();
+    }
+}
+
+static void _restore_level(const string &name)
+{
+    if (cached_level *level = _find_cached_level(name))
+    {
+        reader inf(level->data);
+        _restore_tagged_reader(inf, name, TAG_LEVEL, "Level file is invalid.");
+    }
+    else
+    {
+        _restore_tagged_chunk(you.save, name, TAG_LEVEL,
+                              "Level file is invalid.");
+    }
 }
 
 #if TAG_MAJOR_VERSION == 34
@@ -1577,15 +2191,56 @@ static void _save_level(const level_id& lid)
 # define CHUNK(short, long) long
 #endif
 
-#define SAVEFILE(short, long, savefn)           \
-    do                                          \
-    {                                           \
-        writer w(you.save, CHUNK(short, long)); \
-        savefn(w);                              \
-    } while (false)
+// What each chunk written by _save_game_base() held when it was last
+// written, so that saves can skip the ones that haven't changed. Tracked
+// subsystems also record their change generation, which lets an unchanged
+// one skip even being serialised.
+struct saved_chunk
+{
+    int generation;
+    vector<unsigned char> data;
+};
+static map<string, saved_chunk> saved_chunks;
+
+#define UNTRACKED_GENERATION -1
+
+template<typename F>
+static void _save_chunk_if_changed(const string &name, F savefn,
+                                   int generation)
+{
+    saved_chunk *last = map_find(saved_chunks, name);
+    const bool on_disk = last && you.save->has_chunk(name);
+    if (on_disk && generation != UNTRACKED_GENERATION
+        && last->generation == generation)
+    {
+        return;
+    }
+
+    vector<unsigned char> data;
+    {
+        writer w(&data);
+        savefn(w);
+    }
+
+    if (!on_disk || data != last->data)
+    {
+        writer w(you.save, name);
+        w.write(data.data(), data.size());
+    }
+
+    saved_chunk &saved = saved_chunks[name];
+    saved.generation = generation;
+    saved.data.swap(data);
+}
+
+#define SAVEFILE_TRACKED(short, long, savefn, generation)       \
+    _save_chunk_if_changed(CHUNK(short, long),                  \
+                           [](writer &w) { savefn(w); },        \
+                           generation)
+
+#define SAVEFILE(short, long, savefn) \
+    SAVEFILE_TRACKED(short, long, savefn, UNTRACKED_GENERATION)
 
-// Stack allocated string's go in separate function, so Valgrind doesn't
-// complain.
 static void _save_game_base()
 {
     /* Stashes */
@@ -1597,13 +2252,13 @@ static void _save_game_base()
 #endif
 
     /* kills */
-    SAVEFILE("kil", "kills", you.kills.save);
+    SAVEFILE_TRACKED("kil", "kills", you.kills.save, you.kills.generation());
 
     /* travel cache */
     SAVEFILE("tc", "travel_cache", travel_cache.save);
 
     /* notes */
-    SAVEFILE("nts", "notes", save_notes);
+    SAVEFILE_TRACKED("nts", "notes", save_notes, notes_generation());
 
     /* tutorial/hints mode */
     if (crawl_state.game_is_hints_tutorial())
@@ -1639,6 +2294,7 @@ static void _save_game_exit()
     // Must be exiting -- save level & goodbye!
     if (!you.entering_level)
         _save_level(level_id::current());
+    _flush_level_cache();
 
     clrscr();
 
@@ -1680,14 +2336,39 @@ void save_game(bool leave_game, const char *farewellmsg)
     if (!leave_game)
     {
         if (!crawl_state.disables[DIS_SAVE_CHECKPOINTS])
+        {
+            _flush_level_cache();
             you.save->commit();
+        }
         return;
     }
 
+    cancel_level_pregeneration();
+
+#ifndef DISABLE_SAVEGAME_LISTS
+    player_save_info info;
+    info = you;
+    info.save_loadable = true;
+    info.filename = get_save_filename(you.your_name);
+    bool has_doll = false;
+#ifdef USE_TILE
+    if (Options.tile_menu_icons && you.save->has_chunk("tdl"))
+    {
+        _fill_player_doll(info, you.save);
+        has_doll = true;
+    }
+#endif
+#endif
+
     // Stack allocated string's go in separate function,
     // so Valgrind doesn't complain.
     _save_game_exit();
 
+#ifndef DISABLE_SAVEGAME_LISTS
+    if (!Options.no_save)
+        _update_save_index(info, has_doll);
+#endif
+
     // TODO: just call game_ended?
     if (crawl_should_restart(game_exit::save) && !crawl_state.seen_hups)
         throw game_ended_condition(game_exit::save);
@@ -1712,6 +2393,29 @@ static string _make_ghost_filename()
 
 #define BONES_DIAGNOSTICS (defined(WIZARD) || defined(DEBUG_BONES) | defined(DEBUG_DIAGNOSTICS))
 
+// Bones for a place live in the slots <place>_0 ... <place>_(GHOST_LIMIT-1),
+// so finding them means probing those names rather than listing the whole
+// (shared, and often large) bones directory. Writers publish a complete
+// file into a free slot in one step, and readers claim a file by renaming
+// it away before reading it, so two processes never get the same ghosts
+// and neither has to wait on a lock.
+static string _bones_slot_filename(const string &bonefile_dir, int slot)
+{
+    return make_stringf("%s%s_%d", bonefile_dir.c_str(),
+                        _make_ghost_filename().c_str(), slot);
+}
+
+// A name no other process will use for its temporary or claimed files.
+static string _bones_private_filename(const string &filename,
+                                      const char *what)
+{
+#ifdef UNIX
+    return make_stringf("%s.%s.%d", filename.c_str(), what, (int) getpid());
+#else
+    return filename + "." + what;
+#endif
+}
+
 /**
  * Lists all bonefiles for the current level.
  *
@@ -1719,17 +2423,18 @@ static string _make_ghost_filename()
  */
 static vector<string> _list_bones()
 {
-    string bonefile_dir = _get_bonefile_directory();
-    string base_filename = _make_ghost_filename();
-    string underscored_filename = base_filename + "_";
+    const string bonefile_dir = _get_bonefile_directory();
 
-    vector<string> filenames = get_dir_files(bonefile_dir);
     vector<string> bonefiles;
-    for (const auto &filename : filenames)
-        if (starts_with(filename, underscored_filename))
-            bonefiles.push_back(bonefile_dir + filename);
+    for (int i = 0; i < GHOST_LIMIT; i++)
+    {
+        const string filename = _bones_slot_filename(bonefile_dir, i);
+        if (access(filename.c_str(), F_OK) == 0)
+            bonefiles.push_back(filename);
+    }
 
-    string old_bonefile = _get_old_bonefile_directory() + base_filename;
+    string old_bonefile = _get_old_bonefile_directory()
+                          + _make_ghost_filename();
     if (access(old_bonefile.c_str(), F_OK) == 0)
     {
         dprf("Found old bonefile %s", old_bonefile.c_str());
@@ -1740,23 +2445,36 @@ static vector<string> _list_bones()
 }
 
 /**
- * Attempts to find a file containing ghost(s) appropriate for the player.
+ * Attempts to claim a file containing ghost(s) appropriate for the player,
+ * moving it out of the way of other processes.
  *
- * @return The filename of an appropriate bones file; may be "".
+ * @return The filename of the claimed bones file; may be "".
  */
-static string _find_ghost_file()
+static string _claim_ghost_file()
 {
-    vector<string> bonefiles = _list_bones();
+    const vector<string> bonefiles = _list_bones();
     if (bonefiles.empty())
         return "";
-    return bonefiles[ui_random(bonefiles.size())];
+    // Start at a random file, without touching the gameplay RNG.
+    const int start = ui_random(bonefiles.size());
+    for (size_t i = 0; i < bonefiles.size(); i++)
+    {
+        const string &bonefile = bonefiles[(start + i) % bonefiles.size()];
+        const string claimed = _bones_private_filename(bonefile, "claimed");
+        // Whoever renames the file first gets it; anyone else just finds
+        // it gone.
+        if (!rename_u(bonefile.c_str(), claimed.c_str()))
+            return claimed;
+        dprf("Bones file %s was claimed by someone else", bonefile.c_str());
+    }
+    return "";
 }
 
 static vector<ghost_demon> _load_ghost_vec(bool creating_level, bool wiz_cmd)
 {
     vector<ghost_demon> result;
 
-    const string ghost_filename = _find_ghost_file();
+    const string ghost_filename = _claim_ghost_file();
     if (ghost_filename.empty())
     {
         if (wiz_cmd && !creating_level)
@@ -1869,7 +2587,7 @@ bool load_ghosts(int max_ghosts, bool creating_level)
             break;
 
         mons->set_new_monster_id();
-        mons->set_ghost(loaded_ghosts[0]);
+        mons->set_ghost(move(loaded_ghosts[0]));
         mons->type = MONS_PLAYER_GHOST;
         mons->ghost_init();
 
@@ -1928,6 +2646,10 @@ static bool _restore_game(const string& filename)
     clear_message_store();
 
     you.save = new package((_get_savefile_directory() + filename).c_str(), true);
+    saved_chunks.clear();
+    reset_level_cache();
+    you.save->set_codec(Options.save_compression,
+                        Options.save_compression_level);
 
     if (!_read_char_chunk(you.save))
     {
@@ -2057,7 +2779,7 @@ static void _load_level(const level_id &level)
 // in this game.
 bool is_existing_level(const level_id &level)
 {
-    return you.save && you.save->has_chunk(level.describe());
+    return _level_chunk_exists(level.describe());
 }
 
 void delete_level(const level_id &level)
@@ -2069,6 +2791,7 @@ void delete_level(const level_id &level)
     clear_level_exclusion_annotation(level);
     clear_level_annotations(level);
 
+    _forget_cached_level(level.describe());
     if (you.save)
         you.save->delete_chunk(level.describe());
     if (level.branch == BRANCH_ABYSS)
@@ -2288,6 +3011,12 @@ static bool _restore_tagged_chunk(package *save, const string &name,
                                   tag_type tag, const char* complaint)
 {
     reader inf(save, name);
+    return _restore_tagged_reader(inf, name, tag, complaint);
+}
+
+static bool _restore_tagged_reader(reader &inf, const string &name,
+                                   tag_type tag, const char* complaint)
+{
     string reason;
     if (!_tagged_chunk_version_compatible(inf, &reason))
     {
@@ -2350,36 +3079,37 @@ static bool _ghost_version_compatible(reader &inf)
 }
 
 /**
- * Attempt to open a new bones file for saving ghosts.
+ * Move a finished bones file into the first free slot for this level.
  *
- * @param[out] return_gfilename     The name of the file created, if any.
- * @return                          A FILE object, or nullptr.
+ * @param tmp_filename  The complete bones file to publish.
+ * @return              The slot's filename, or "" if all slots are taken.
  **/
-static FILE* _make_bones_file(string * return_gfilename)
+static string _publish_bones_file(const string &tmp_filename)
 {
-
     const string bone_dir = _get_bonefile_directory();
-    const string base_filename = _make_ghost_filename();
     for (int i = 0; i < GHOST_LIMIT; i++)
     {
-        const string g_file_name = make_stringf("%s%s_%d", bone_dir.c_str(),
-                                                base_filename.c_str(), i);
-        FILE *gfil = lk_open_exclusive(g_file_name);
-        // need to check file size, so can't open 'wb' - would truncate!
-
-        if (!gfil)
+        const string g_file_name = _bones_slot_filename(bone_dir, i);
+#ifdef UNIX
+        // link() fails if the slot exists, so this can't clobber bones
+        // another process published at the same moment.
+        if (!link(tmp_filename.c_str(), g_file_name.c_str()))
         {
-            dprf("Could not open %s", g_file_name.c_str());
-            continue;
+            unlink_u(tmp_filename.c_str());
+            return g_file_name;
         }
-
-        dprf("found %s", g_file_name.c_str());
-
-        *return_gfilename = g_file_name;
-        return gfil;
+#else
+        if (access(g_file_name.c_str(), F_OK) != 0
+            && !rename_u(tmp_filename.c_str(), g_file_name.c_str()))
+        {
+            return g_file_name;
+        }
+#endif
+        dprf("Bones slot %s is taken", g_file_name.c_str());
     }
 
-    return nullptr;
+    unlink_u(tmp_filename.c_str());
+    return "";
 }
 
 /**
@@ -2426,8 +3156,11 @@ void save_ghosts(const vector<ghost_demon> &ghosts, bool force)
         return;
     }
 
-    string g_file_name = "";
-    FILE* ghost_file = _make_bones_file(&g_file_name);
+    // Write the whole file under a private name first, so that nobody can
+    // claim it half-written.
+    const string tmp_filename = _bones_private_filename(
+        _bones_slot_filename(_get_bonefile_directory(), 0), "tmp");
+    FILE* ghost_file = fopen_u(tmp_filename.c_str(), "wb");
 
     if (!ghost_file)
     {
@@ -2438,12 +3171,26 @@ void save_ghosts(const vector<ghost_demon> &ghosts, bool force)
         return;
     }
 
-    writer outw(g_file_name, ghost_file);
-
-    _write_ghost_version(outw);
-    tag_write_ghosts(outw, ghosts);
+    bool written;
+    {
+        writer outw(tmp_filename, ghost_file, true);
+        _write_ghost_version(outw);
+        tag_write_ghosts(outw, ghosts);
+        written = outw.succeeded();
+    }
+    written = !fclose(ghost_file) && written;
 
-    lk_close(ghost_file, g_file_name);
+    const string g_file_name = written ? _publish_bones_file(tmp_filename)
+                                       : "";
+    if (g_file_name.empty())
+    {
+        unlink_u(tmp_filename.c_str());
+#ifdef BONES_DIAGNOSTICS
+        if (do_diagnostics)
+            mprf(MSGCH_DIAGNOSTICS, "Could not save ghosts.");
+#endif
+        return;
+    }
 
 #ifdef BONES_DIAGNOSTICS
     if (do_diagnostics)
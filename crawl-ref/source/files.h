@@ -83,6 +83,9 @@ bool load_level(dungeon_feature_type stair_taken, load_mode_type load_mode,
                 const level_id& old_level);
 void delete_level(const level_id &level);
 
+void maybe_pregenerate_level();
+void cancel_level_pregeneration();
+
 void save_game(bool leave_game, const char *bye = nullptr);
 
 // Save game without exiting (used when changing levels).
@@ -94,6 +97,8 @@ bool save_exists(const string& filename);
 bool restore_game(const string& filename);
 
 bool is_existing_level(const level_id &level);
+// Drop the in-memory copies of recently left levels; for a new save.
+void reset_level_cache();
 
 class level_excursion
 {
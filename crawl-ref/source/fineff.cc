@@ -8,6 +8,8 @@
 
 #include "fineff.h"
 
+#include <typeinfo>
+
 #include "act-iter.h"
 #include "bloodspatter.h"
 #include "coordit.h"
@@ -32,11 +34,53 @@
 #include "view.h"
 #include "viewchar.h"
 
+// Freed effects are kept for reuse, in buckets by size rounded up to the
+// grain, so that a fight full of on-hit triggers doesn't go back to the
+// allocator for every one. The pool only grows to the most effects that
+// were ever queued at once.
+static const size_t FINEFF_POOL_GRAIN = 16;
+static const int FINEFF_POOL_BUCKETS = 16;
+static vector<void *> _fineff_pool[FINEFF_POOL_BUCKETS];
+
+static int _fineff_pool_bucket(size_t size)
+{
+    return (size + FINEFF_POOL_GRAIN - 1) / FINEFF_POOL_GRAIN - 1;
+}
+
+/*static*/ void *final_effect::operator new(size_t size)
+{
+    const int bucket = _fineff_pool_bucket(size);
+    if (bucket >= FINEFF_POOL_BUCKETS)
+        return ::operator new(size);
+
+    vector<void *> &pool = _fineff_pool[bucket];
+    if (pool.empty())
+        return ::operator new((bucket + 1) * FINEFF_POOL_GRAIN);
+
+    void *block = pool.back();
+    pool.pop_back();
+    return block;
+}
+
+/*static*/ void final_effect::operator delete(void *ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    const int bucket = _fineff_pool_bucket(size);
+    if (bucket >= FINEFF_POOL_BUCKETS)
+        ::operator delete(ptr);
+    else
+        _fineff_pool[bucket].push_back(ptr);
+}
+
 /*static*/ void final_effect::schedule(final_effect *eff)
 {
     for (auto fe : env.final_effects)
     {
-        if (fe->mergeable(*eff))
+        // Only effects of the same class ever merge; checking that first
+        // spares a dynamic_cast for every queued effect of another kind.
+        if (typeid(*fe) == typeid(*eff) && fe->mergeable(*eff))
         {
             fe->merge(*eff);
             delete eff;
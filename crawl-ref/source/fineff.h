@@ -21,6 +21,10 @@ public:
 
     virtual void fire() = 0;
 
+    // Effects are taken from and returned to a pool of blocks by size.
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
 protected:
     static void schedule(final_effect *eff);
 
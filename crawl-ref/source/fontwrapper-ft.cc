@@ -61,6 +61,8 @@ FontWrapper* FontWrapper::create()
 
 FTFontWrapper::FTFontWrapper() :
     m_atlas(nullptr),
+    m_atlas_used(0),
+    m_atlas_clock(0),
     m_max_advance(0, 0),
     m_min_offset(0),
     charsz(1,1),
@@ -145,6 +147,8 @@ bool FTFontWrapper::configure_font()
 
     for (int i = 0; i < MAX_GLYPHS; i++)
         m_atlas[i] = FontAtlasEntry();
+    m_atlas_used = 0;
+    m_atlas_clock = 0;
 
     // atlas[0] always contains a full-white block (never evicted)
     // this is currently used by colour_bar
@@ -207,8 +211,6 @@ bool FTFontWrapper::load_font(const char *font_name, unsigned int font_size)
     }
 
     m_atlas = new FontAtlasEntry[MAX_GLYPHS];
-    m_atlas_lru.clear();
-    m_atlas_lru.reserve(MAX_GLYPHS);
 
     return configure_font();
 }
@@ -243,6 +245,7 @@ FTFontWrapper::GlyphInfo& FTFontWrapper::get_glyph_info(char32_t ch)
         glyph.width = bmp->width;
         glyph.renderable = !!bmp->buffer;
         glyph.valid = true;
+        glyph.atlas_slot = 0;
     }
     return glyph;
 }
@@ -315,27 +318,32 @@ unsigned int FTFontWrapper::map_unicode(char *ch)
 
 unsigned int FTFontWrapper::map_unicode(char32_t uchar)
 {
-    unsigned int c = MAX_GLYPHS;
-    for (unsigned int i = 1; i < MAX_GLYPHS; i++)
-        if (m_atlas[i].uchar == uchar)
+    // This runs for every glyph drawn, so the slot is looked up through
+    // the glyph info rather than by searching the atlas.
+    GlyphInfo &glyph = get_glyph_info(uchar);
+    unsigned int c = glyph.atlas_slot;
+
+    if (!c) // not found: need to load into atlas
+    {
+        if (m_atlas_used < MAX_GLYPHS - 1)
+            c = ++m_atlas_used;
+        else
         {
-            c = i;
-            break;
+            // Evict the least recently drawn glyph.
+            c = 1;
+            for (unsigned int i = 2; i < MAX_GLYPHS; i++)
+                if (m_atlas[i].last_use < m_atlas[c].last_use)
+                    c = i;
+            m_glyphs[m_atlas[c].uchar].atlas_slot = 0;
         }
 
-    if (c == MAX_GLYPHS) // not found: need to load into atlas
-    {
-        bool atlas_full = m_atlas_lru.size() == MAX_GLYPHS-1;
-        c = atlas_full ? m_atlas_lru[0] : m_atlas_lru.size()+1;
         m_atlas[c].uchar = uchar;
+        glyph.atlas_slot = c;
         load_glyph(c, uchar);
         n_subst++;
     }
 
-    auto it = find(m_atlas_lru.begin(), m_atlas_lru.end(), (uint8_t)c);
-    if (it != m_atlas_lru.end())
-        m_atlas_lru.erase(it);
-    m_atlas_lru.push_back(c);
+    m_atlas[c].last_use = ++m_atlas_clock;
 
     return c;
 }
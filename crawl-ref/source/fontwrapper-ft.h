@@ -110,16 +110,24 @@ protected:
         // does glyph have any pixels?
         bool renderable;
         bool valid;
+        // slot in the atlas texture, or 0 if not currently loaded
+        uint16_t atlas_slot;
     };
     vector<GlyphInfo> m_glyphs;
     GlyphInfo& get_glyph_info(char32_t ch);
 
     struct FontAtlasEntry
     {
+        FontAtlasEntry() : uchar(0), last_use(0) {}
+
         char32_t uchar;
+        // value of m_atlas_clock when this slot was last drawn from
+        unsigned int last_use;
     };
     FontAtlasEntry *m_atlas;
-    vector<char32_t> m_atlas_lru;
+    // number of atlas slots in use, not counting the white block in slot 0
+    unsigned int m_atlas_used;
+    unsigned int m_atlas_clock;
 
     // count of glyph loads in the current text block
     int n_subst;
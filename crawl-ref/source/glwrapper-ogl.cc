@@ -22,6 +22,7 @@
 #   include <SDL.h>
 #   include <GLES/gl.h>
 #  else
+#   include <SDL2/SDL.h>
 #   include <SDL2/SDL_opengl.h>
 #   if defined(__MACOSX__)
 #    include <OpenGL/glu.h>
@@ -76,9 +77,7 @@ OGLStateManager::OGLStateManager()
     glClearColor(0.0, 0.0, 0.0, 1.0f);
     glDepthFunc(GL_LEQUAL);
 
-#ifdef __ANDROID__
     m_last_tex = 0;
-#endif
     m_window_height = 0;
 }
 
@@ -275,6 +274,11 @@ void OGLStateManager::pixelstore_unpack_alignment(unsigned int bpp)
 
 void OGLStateManager::delete_textures(size_t count, unsigned int *textures)
 {
+    // Deleting the bound texture reverts the binding to zero.
+    for (size_t i = 0; i < count; i++)
+        if (textures[i] == m_last_tex)
+            m_last_tex = 0;
+
     glDeleteTextures(count, (GLuint*)textures);
     glDebug("glDeleteTextures");
 }
@@ -287,11 +291,15 @@ void OGLStateManager::generate_textures(size_t count, unsigned int *textures)
 
 void OGLStateManager::bind_texture(unsigned int texture)
 {
+    // The dungeon view alternates between only a handful of textures, so
+    // most binds in a frame would be for the texture already in place.
+    if (texture == m_last_tex)
+        return;
+
     glBindTexture(GL_TEXTURE_2D, texture);
     glDebug("glBindTexture");
-#ifdef __ANDROID__
     m_last_tex = texture;
-#endif
+    gl_frame_stats.texture_binds++;
 }
 
 void OGLStateManager::load_texture(unsigned char *pixels, unsigned int width,
@@ -465,15 +473,74 @@ void OGLStateManager::glDebug(const char* msg)
         __android_log_print(ANDROID_LOG_INFO, "Crawl.gl", "ERROR %x: %s",e,msg);
 #endif
 }
+/////////////////////////////////////////////////////////////////////////////
+// Buffer objects
+//
+// These are core in GLES 1.1, but only arrived with OpenGL 1.5, so on the
+// desktop they have to be looked up at run time. Without them, shape
+// buffers are drawn from client-side arrays as before.
+
+#if defined(USE_GLES) || defined(__ANDROID__)
+static bool _have_vbos() { return true; }
+# define gl_gen_buffers glGenBuffers
+# define gl_delete_buffers glDeleteBuffers
+# define gl_bind_buffer glBindBuffer
+# define gl_buffer_data glBufferData
+# define gl_buffer_sub_data glBufferSubData
+#else
+static PFNGLGENBUFFERSPROC gl_gen_buffers = nullptr;
+static PFNGLDELETEBUFFERSPROC gl_delete_buffers = nullptr;
+static PFNGLBINDBUFFERPROC gl_bind_buffer = nullptr;
+static PFNGLBUFFERDATAPROC gl_buffer_data = nullptr;
+static PFNGLBUFFERSUBDATAPROC gl_buffer_sub_data = nullptr;
+
+// Needs a current context, so this waits for the first draw.
+static bool _have_vbos()
+{
+    static bool looked_up = false;
+    if (!looked_up)
+    {
+        looked_up = true;
+        gl_gen_buffers = (PFNGLGENBUFFERSPROC)
+            SDL_GL_GetProcAddress("glGenBuffers");
+        gl_delete_buffers = (PFNGLDELETEBUFFERSPROC)
+            SDL_GL_GetProcAddress("glDeleteBuffers");
+        gl_bind_buffer = (PFNGLBINDBUFFERPROC)
+            SDL_GL_GetProcAddress("glBindBuffer");
+        gl_buffer_data = (PFNGLBUFFERDATAPROC)
+            SDL_GL_GetProcAddress("glBufferData");
+        gl_buffer_sub_data = (PFNGLBUFFERSUBDATAPROC)
+            SDL_GL_GetProcAddress("glBufferSubData");
+
+        if (!gl_gen_buffers || !gl_delete_buffers || !gl_bind_buffer
+            || !gl_buffer_data || !gl_buffer_sub_data)
+        {
+            gl_gen_buffers = nullptr;
+        }
+    }
+    return gl_gen_buffers != nullptr;
+}
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 // OGLShapeBuffer
 
 OGLShapeBuffer::OGLShapeBuffer(bool texture, bool colour, drawing_modes prim) :
     m_prim_type(prim),
     m_texture_verts(texture),
-    m_colour_verts(colour)
+    m_colour_verts(colour),
+    m_changed(true)
 {
     ASSERT(prim == GLW_RECTANGLE || prim == GLW_LINES);
+    for (unsigned int &vbo : m_vbos)
+        vbo = 0;
+}
+
+OGLShapeBuffer::~OGLShapeBuffer()
+{
+    // Once the state manager is gone, so may be the context.
+    if (m_vbos[0] && glmanager)
+        gl_delete_buffers(NUM_VERTEX_BUFFERS, (GLuint*)m_vbos);
 }
 
 const char *OGLShapeBuffer::print_statistics() const
@@ -488,6 +555,7 @@ unsigned int OGLShapeBuffer::size() const
 
 void OGLShapeBuffer::add(const GLWPrim &rect)
 {
+    m_changed = true;
     switch (m_prim_type)
     {
     case GLW_RECTANGLE:
@@ -604,22 +672,39 @@ void OGLShapeBuffer::draw(const GLState &state)
 
     glmanager->set(state);
 
-    glVertexPointer(3, GL_FLOAT, 0, &m_position_buffer[0]);
+    // With buffer objects, the pointers are offsets into them.
+    const bool vbo = upload_buffers();
+
+    if (vbo)
+        gl_bind_buffer(GL_ARRAY_BUFFER, m_vbos[VB_POSITION]);
+    glVertexPointer(3, GL_FLOAT, 0, vbo ? nullptr : &m_position_buffer[0]);
     glDebug("glVertexPointer");
 
     if (state.array_texcoord && m_texture_verts)
-        glTexCoordPointer(2, GL_FLOAT, 0, &m_texture_buffer[0]);
+    {
+        if (vbo)
+            gl_bind_buffer(GL_ARRAY_BUFFER, m_vbos[VB_TEXTURE]);
+        glTexCoordPointer(2, GL_FLOAT, 0,
+                          vbo ? nullptr : &m_texture_buffer[0]);
+    }
     glDebug("glTexCoordPointer");
 
     if (state.array_colour && m_colour_verts)
-        glColorPointer(4, GL_UNSIGNED_BYTE, 0, &m_colour_buffer[0]);
+    {
+        if (vbo)
+            gl_bind_buffer(GL_ARRAY_BUFFER, m_vbos[VB_COLOUR]);
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0,
+                       vbo ? nullptr : &m_colour_buffer[0]);
+    }
     glDebug("glColorPointer");
 
     switch (m_prim_type)
     {
     case GLW_RECTANGLE:
+        if (vbo)
+            gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, m_vbos[VB_INDEX]);
         glDrawElements(GL_TRIANGLE_STRIP, m_ind_buffer.size(),
-                       GL_UNSIGNED_SHORT, &m_ind_buffer[0]);
+                       GL_UNSIGNED_SHORT, vbo ? nullptr : &m_ind_buffer[0]);
         break;
     case GLW_LINES:
         glDrawArrays(GL_LINES, 0, m_position_buffer.size());
@@ -629,10 +714,93 @@ void OGLShapeBuffer::draw(const GLState &state)
         break;
     }
     glDebug("glDrawElements");
+
+    gl_frame_stats.draw_calls++;
+    gl_frame_stats.vertices += m_position_buffer.size();
+
+    if (vbo)
+    {
+        gl_bind_buffer(GL_ARRAY_BUFFER, 0);
+        gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+}
+
+// Bring the buffer objects up to date, if there are any. Returns whether
+// they should be drawn from.
+bool OGLShapeBuffer::upload_buffers()
+{
+    if (!_have_vbos())
+        return false;
+
+    if (!m_vbos[0])
+    {
+        gl_gen_buffers(NUM_VERTEX_BUFFERS, (GLuint*)m_vbos);
+        glDebug("glGenBuffers");
+        m_changed = true;
+    }
+
+    if (!m_changed)
+        return true;
+
+    upload_buffer(VB_POSITION, &m_position_buffer[0],
+                  m_position_buffer.size() * sizeof(GLW_3VF));
+    if (m_texture_verts && !m_texture_buffer.empty())
+    {
+        upload_buffer(VB_TEXTURE, &m_texture_buffer[0],
+                      m_texture_buffer.size() * sizeof(GLW_2VF));
+    }
+    if (m_colour_verts && !m_colour_buffer.empty())
+    {
+        upload_buffer(VB_COLOUR, &m_colour_buffer[0],
+                      m_colour_buffer.size() * sizeof(VColour));
+    }
+    if (!m_ind_buffer.empty())
+    {
+        upload_buffer(VB_INDEX, &m_ind_buffer[0],
+                      m_ind_buffer.size() * sizeof(unsigned short int));
+    }
+
+    m_changed = false;
+    return true;
+}
+
+// Send the part of data that differs from what the buffer object holds.
+void OGLShapeBuffer::upload_buffer(vertex_buffer_type type, const void *data,
+                                   size_t bytes)
+{
+    const GLenum target = type == VB_INDEX ? GL_ELEMENT_ARRAY_BUFFER
+                                           : GL_ARRAY_BUFFER;
+    const unsigned char *src = (const unsigned char *) data;
+    vector<unsigned char> &old = m_uploaded[type];
+
+    gl_bind_buffer(target, m_vbos[type]);
+    if (old.size() != bytes)
+    {
+        gl_buffer_data(target, bytes, src, GL_DYNAMIC_DRAW);
+        glDebug("glBufferData");
+        old.assign(src, src + bytes);
+    }
+    else
+    {
+        size_t first = 0;
+        while (first < bytes && old[first] == src[first])
+            ++first;
+        if (first < bytes)
+        {
+            size_t last = bytes;
+            while (old[last - 1] == src[last - 1])
+                --last;
+            gl_buffer_sub_data(target, first, last - first, src + first);
+            glDebug("glBufferSubData");
+            memcpy(&old[first], src + first, last - first);
+        }
+    }
+    gl_bind_buffer(target, 0);
 }
 
 void OGLShapeBuffer::clear()
 {
+    m_changed = true;
     m_position_buffer.clear();
     m_ind_buffer.clear();
     m_texture_buffer.clear();
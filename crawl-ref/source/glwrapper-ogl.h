@@ -38,9 +38,8 @@ public:
     int device_to_logical(int n, bool round=true) const override;
 protected:
     GLState m_current_state;
-#ifdef __ANDROID__
-    GLint m_last_tex;
-#endif
+    // The texture currently bound, so that redundant binds can be skipped.
+    unsigned int m_last_tex;
     int m_window_height;
 
 private:
@@ -52,6 +51,7 @@ class OGLShapeBuffer : public GLShapeBuffer
 public:
     OGLShapeBuffer(bool texture = false, bool colour = false,
                    drawing_modes prim = GLW_RECTANGLE);
+    virtual ~OGLShapeBuffer();
 
     virtual const char *print_statistics() const override;
     virtual unsigned int size() const override;
@@ -74,6 +74,25 @@ protected:
     vector<VColour> m_colour_buffer;
     vector<unsigned short int> m_ind_buffer;
 
+    // Buffer objects holding what was last drawn, when the GL has them.
+    // Redrawing an unchanged buffer uploads nothing, and after a repack
+    // only the range that differs from the last upload is sent.
+    enum vertex_buffer_type
+    {
+        VB_POSITION,
+        VB_TEXTURE,
+        VB_COLOUR,
+        VB_INDEX,
+        NUM_VERTEX_BUFFERS
+    };
+    unsigned int m_vbos[NUM_VERTEX_BUFFERS];
+    vector<unsigned char> m_uploaded[NUM_VERTEX_BUFFERS];
+    bool m_changed;
+
+    bool upload_buffers();
+    void upload_buffer(vertex_buffer_type type, const void *data,
+                       size_t bytes);
+
 private:
     void glDebug(const char* msg);
 };
@@ -11,6 +11,8 @@ VColour VColour::white(255, 255, 255, 255);
 VColour VColour::black(0, 0, 0, 255);
 VColour VColour::transparent(0, 0, 0, 0);
 
+GLFrameStats gl_frame_stats;
+
 bool VColour::operator==(const VColour &vc) const
 {
     return r == vc.r && g == vc.g && b == vc.b && a == vc.a;
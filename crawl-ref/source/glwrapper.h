@@ -195,4 +195,17 @@ public:
 // Main interface for GL functions
 extern GLStateManager *glmanager;
 
+// Running totals of GL work, for the frame statistics reported by the tiles
+// framework.
+struct GLFrameStats
+{
+    GLFrameStats() { reset(); }
+    void reset() { draw_calls = vertices = texture_binds = 0; }
+
+    unsigned int draw_calls;
+    unsigned int vertices;
+    unsigned int texture_binds;
+};
+extern GLFrameStats gl_frame_stats;
+
 #endif // use_tile
@@ -3643,7 +3643,7 @@ static int _slouch_monsters(coord_def where)
 
 bool cheibriados_slouch()
 {
-    int count = apply_area_visible(_slouchable, you.pos());
+    int count = apply_area_visible_actors(_slouchable, you.pos());
     if (!count)
         if (!yesno("There's no one hasty visible. Invoke Slouch anyway?",
                    true, 'n'))
@@ -3659,7 +3659,7 @@ bool cheibriados_slouch()
     mpr("You can feel time thicken for a moment.");
     dprf("your speed is %d", player_movement_speed());
 
-    apply_area_visible(_slouch_monsters, you.pos());
+    apply_area_visible_actors(_slouch_monsters, you.pos());
     return true;
 }
 
@@ -6431,7 +6431,7 @@ static int _apply_apocalypse(coord_def where)
 
 bool ru_apocalypse()
 {
-    int count = apply_area_visible(cell_has_valid_target, you.pos());
+    int count = apply_area_visible_actors(cell_has_valid_target, you.pos());
     if (!count)
     {
         if (!yesno("There are no visible enemies. Unleash your apocalypse anyway?",
@@ -6442,7 +6442,7 @@ bool ru_apocalypse()
     }
     mpr("You reveal the great annihilating truth to your foes!");
     noisy(30, you.pos());
-    apply_area_visible(_apply_apocalypse, you.pos());
+    apply_area_visible_actors(_apply_apocalypse, you.pos());
     drain_player(100, false, true);
     return true;
 }
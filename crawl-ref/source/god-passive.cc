@@ -3,6 +3,7 @@
 #include "god-passive.h"
 
 #include <algorithm>
+#include <bitset>
 #include <cmath>
 
 #include "act-iter.h"
@@ -428,16 +429,39 @@ static const vector<god_passive> god_passives[] =
 };
 COMPILE_CHECK(ARRAYSZ(god_passives) == NUM_GODS);
 
+typedef bitset<static_cast<size_t>(passive_t::NUM_PASSIVES)> passive_set;
+
+// have_passive() is asked about all the time, so remember which passives
+// the current god, piety rank and penance give, and only search
+// god_passives again when one of those has changed.
+static const passive_set &_active_passives()
+{
+    static god_type cached_god = NUM_GODS;
+    static int cached_rank = -1;
+    static bool cached_penance = false;
+    static passive_set active;
+
+    const int rank = piety_rank();
+    const bool penance = player_under_penance();
+    if (you.religion == cached_god && rank == cached_rank
+        && penance == cached_penance)
+    {
+        return active;
+    }
+
+    cached_god = you.religion;
+    cached_rank = rank;
+    cached_penance = penance;
+    active.reset();
+    for (const god_passive &p : god_passives[you.religion])
+        if (rank >= p.rank && (!penance || p.rank < 0))
+            active.set(static_cast<size_t>(p.pasv));
+    return active;
+}
+
 bool have_passive(passive_t passive)
 {
-    const auto &pasvec = god_passives[you.religion];
-    return any_of(begin(pasvec), end(pasvec),
-                  [passive] (const god_passive &p) -> bool
-                  {
-                      return p.pasv == passive
-                          && piety_rank() >= p.rank
-                          && (!player_under_penance() || p.rank < 0);
-                  });
+    return _active_passives().test(static_cast<size_t>(passive));
 }
 
 bool will_have_passive(passive_t passive)
@@ -1884,11 +1908,12 @@ static int _prepare_audience(coord_def where)
  */
 void uskayaw_prepares_audience()
 {
-    int count = apply_area_visible(_check_for_uskayaw_targets, you.pos());
+    int count = apply_area_visible_actors(_check_for_uskayaw_targets,
+                                          you.pos());
     if (count > 0)
     {
         simple_god_message(" prepares the audience for your solo!");
-        apply_area_visible(_prepare_audience, you.pos());
+        apply_area_visible_actors(_prepare_audience, you.pos());
 
         // Increment a delay timer to prevent players from spamming this ability
         // via piety loss and gain. Timer is in AUT.
@@ -1921,11 +1946,12 @@ static int _bond_audience(coord_def where)
  */
 void uskayaw_bonds_audience()
 {
-    int count = apply_area_visible(_check_for_uskayaw_targets, you.pos());
+    int count = apply_area_visible_actors(_check_for_uskayaw_targets,
+                                          you.pos());
     if (count > 1)
     {
         simple_god_message(" links your audience in an emotional bond!");
-        apply_area_visible(_bond_audience, you.pos());
+        apply_area_visible_actors(_bond_audience, you.pos());
 
         // Increment a delay timer to prevent players from spamming this ability
         // via piety loss and gain. Timer is in AUT.
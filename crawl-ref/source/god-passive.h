@@ -256,6 +256,9 @@ enum class passive_t
     wu_jian_lunge,
     wu_jian_whirlwind,
     wu_jian_wall_jump,
+
+    /// Not a passive: how many there are.
+    NUM_PASSIVES
 };
 
 enum ru_interference
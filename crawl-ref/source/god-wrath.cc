@@ -846,7 +846,7 @@ static bool _beogh_retribution()
                 newstats.init_dancing_weapon(wpn,
                                              you.experience_level * 50 / 9);
 
-                mon->set_ghost(newstats);
+                mon->set_ghost(move(newstats));
                 mon->ghost_demon_init();
 
                 num_created++;
@@ -1616,7 +1616,7 @@ static int _wu_jian_summon_weapons()
             ghost_demon newstats;
             newstats.init_dancing_weapon(wpn, you.experience_level * 50 / 9);
 
-            mon->set_ghost(newstats);
+            mon->set_ghost(move(newstats));
             mon->ghost_demon_init();
 
             created++;
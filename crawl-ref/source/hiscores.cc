@@ -48,6 +48,7 @@
 #include "state.h"
 #include "status.h"
 #include "stringutil.h"
+#include "tiles-build-specific.h"
 #ifdef USE_TILE
  #include "tilepick.h"
 #endif
@@ -64,7 +65,9 @@ static unique_ptr<scorefile_entry> hs_list[SCORE_FILE_ENTRIES];
 
 static FILE *_hs_open(const char *mode, const string &filename);
 static void  _hs_close(FILE *handle, const string &filename);
+static bool  _hs_read_line(FILE *scores, string &line);
 static bool  _hs_read(FILE *scores, scorefile_entry &dest);
+static int   _scoreline_score(const string &line);
 static void  _hs_write(FILE *scores, scorefile_entry &entry);
 static time_t _parse_time(const string &st);
 static string _xlog_escape(const string &s);
@@ -96,7 +99,6 @@ int hiscores_new_entry(const scorefile_entry &ne)
     unwind_bool score_update(crawl_state.updating_scores, true);
 
     FILE *scores;
-    int i, total_entries;
     bool inserted = false;
     int newest_entry = -1;
 
@@ -111,39 +113,33 @@ int hiscores_new_entry(const scorefile_entry &ne)
     // we're at the end of the file, seek back to beginning.
     fseek(scores, 0, SEEK_SET);
 
-    // read highscore file, inserting new entry at appropriate point,
-    for (i = 0; i < SCORE_FILE_ENTRIES; i++)
+    // Read the highscore file, inserting the new entry at the appropriate
+    // point. Only the scores are needed to place it, and the lines are
+    // written back as they were, so don't parse the rest of each entry.
+    const string new_line = ne.raw_string();
+    vector<string> lines;
+    string line;
+    while (lines.size() < SCORE_FILE_ENTRIES && _hs_read_line(scores, line))
     {
-        hs_list[i].reset(new scorefile_entry);
-        if (_hs_read(scores, *hs_list[i]) == false)
-            break;
-
         // compare points..
-        if (!inserted && ne.get_score() >= hs_list[i]->get_score())
+        if (!inserted && ne.get_score() >= _scoreline_score(line))
         {
-            newest_entry = i;           // for later printing
+            newest_entry = lines.size();    // for later printing
             inserted = true;
-            // copy read entry to i+1th position
-            // Fixed a nasty overflow bug here -- Sharp
-            if (i+1 < SCORE_FILE_ENTRIES)
-            {
-                hs_list[i + 1] = move(hs_list[i]);
-                hs_list[i].reset(new scorefile_entry(ne));
-                i++;
-            }
-            else
-                *hs_list[i] = ne; // copy new entry to current position
+            lines.push_back(new_line);
+            // The new entry takes the last place from the one read.
+            if (lines.size() == SCORE_FILE_ENTRIES)
+                break;
         }
+        lines.push_back(line);
     }
 
     // special case: lowest score, with room
-    if (!inserted && i < SCORE_FILE_ENTRIES)
+    if (!inserted && lines.size() < SCORE_FILE_ENTRIES)
     {
-        newest_entry = i;
+        newest_entry = lines.size();
         inserted = true;
-        // copy new entry
-        hs_list[i].reset(new scorefile_entry(ne));
-        i++;
+        lines.push_back(new_line);
     }
 
     // If we've still not inserted it, it's not a highscore.
@@ -153,8 +149,6 @@ int hiscores_new_entry(const scorefile_entry &ne)
         return -1;
     }
 
-    total_entries = i;
-
     // The old code closed and reopened the score file, leading to a
     // race condition where one Crawl process could overwrite the
     // other's highscore. Now we truncate and rewrite the file without
@@ -165,11 +159,8 @@ int hiscores_new_entry(const scorefile_entry &ne)
     rewind(scores);
 
     // write scorefile entries.
-    for (i = 0; i < total_entries; i++)
-    {
-        _hs_write(scores, *hs_list[i]);
-        hs_list[i].reset(nullptr);
-    }
+    for (const string &entry : lines)
+        fprintf(scores, "%s", entry.c_str());
 
     // close scorefile.
     _hs_close(scores, _score_file_name());
@@ -564,19 +555,43 @@ static void _hs_close(FILE *handle, const string &scores)
     lk_close(handle, scores);
 }
 
-static bool _hs_read(FILE *scores, scorefile_entry &dest)
+// Reads the next line of the scorefile, failing at the end or at a line in
+// a format we no longer read.
+static bool _hs_read_line(FILE *scores, string &line)
 {
     char inbuf[1300];
     if (!scores || feof(scores))
         return false;
 
     memset(inbuf, 0, sizeof inbuf);
-    dest.reset();
 
     if (!fgets(inbuf, sizeof inbuf, scores))
         return false;
 
-    return dest.parse(inbuf);
+    line = inbuf;
+    if (line[0] == ':')
+    {
+        dprf("Corrupted xlog-line: %s", line.c_str());
+        return false;
+    }
+    return true;
+}
+
+static bool _hs_read(FILE *scores, scorefile_entry &dest)
+{
+    string line;
+    dest.reset();
+    return _hs_read_line(scores, line) && dest.parse(line);
+}
+
+// The score on a scorefile line, read as init_with_fields() would.
+static int _scoreline_score(const string &line)
+{
+    string score;
+    for (const string &field : _xlog_split_fields(line))
+        if (!field.compare(0, 3, "sc="))
+            score = _xlog_unescape(field.substr(3));
+    return atoi(score.c_str());
 }
 
 static int _val_char(char digit)
@@ -2869,6 +2884,13 @@ string xlog_fields::xlog_line() const
 ///////////////////////////////////////////////////////////////////////////////
 // Milestones
 
+#ifdef DGL_MILESTONES
+// Milestones not yet appended to the milestone file, which is locked and
+// opened once for all of them at the start of the next command.
+static vector<string> _pending_milestones;
+static string _pending_milestone_file;
+#endif
+
 /**
  * @brief Record the player reaching a milestone, if ::DGL_MILESTONES is defined.
  * @callergraph
@@ -2918,12 +2940,36 @@ void mark_milestone(const string &type, const string &milestone,
     xl.add_field("type", "%s", type.c_str());
     xl.add_field("milestone", "%s", milestone.c_str());
     const string xlog_line = xl.xlog_line();
-    if (FILE *fp = lk_open("a", milestone_file))
+
+    if (milestone_file != _pending_milestone_file)
+        flush_milestones();
+    _pending_milestone_file = milestone_file;
+    _pending_milestones.push_back(xlog_line);
+    // We may not get as far as the next command.
+    if (type == "crash")
+        flush_milestones();
+
+#ifdef USE_TILE_WEB
+    tiles.send_game_event("milestone", xlog_line);
+#endif
+#endif // DGL_MILESTONES
+}
+
+/// Append any milestones marked since the last flush to the milestone file.
+void flush_milestones()
+{
+#ifdef DGL_MILESTONES
+    if (_pending_milestones.empty())
+        return;
+
+    if (FILE *fp = lk_open("a", _pending_milestone_file))
     {
-        fprintf(fp, "%s\n", xlog_line.c_str());
-        lk_close(fp, milestone_file);
+        for (const string &line : _pending_milestones)
+            fprintf(fp, "%s\n", line.c_str());
+        lk_close(fp, _pending_milestone_file);
     }
-#endif // DGL_MILESTONES
+    _pending_milestones.clear();
+#endif
 }
 
 #ifdef DGL_WHEREIS
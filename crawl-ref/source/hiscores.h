@@ -25,6 +25,7 @@ string hiscores_format_single_long(const scorefile_entry &se,
 
 void mark_milestone(const string &type, const string &milestone,
                     const string &origin_level = "", time_t t = 0);
+void flush_milestones();
 
 #ifdef DGL_WHEREIS
 string xlog_status_line();
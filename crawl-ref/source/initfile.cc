@@ -24,6 +24,7 @@
 #include "clua.h"
 #include "colour.h"
 #include "confirm-butcher-type.h"
+#include "crash.h"
 #include "defines.h"
 #include "delay.h"
 #include "directn.h"
@@ -58,6 +59,7 @@
 #include "tags.h"
 #include "throw.h"
 #include "travel.h"
+#include "turn-profile.h"
 #include "unwind.h"
 #include "version.h"
 #include "viewchar.h"
@@ -191,6 +193,7 @@ const vector<GameOption*> game_options::build_options_list()
         new BoolGameOption(SIMPLE_NAME(small_more), false),
         new BoolGameOption(SIMPLE_NAME(pickup_thrown), true),
         new BoolGameOption(SIMPLE_NAME(show_travel_trail), USING_DGL),
+        new BoolGameOption(SIMPLE_NAME(pregen_levels), false),
         new BoolGameOption(SIMPLE_NAME(use_fake_cursor), USING_UNIX ),
         new BoolGameOption(SIMPLE_NAME(use_fake_player_cursor), true),
         new BoolGameOption(SIMPLE_NAME(show_player_species), false),
@@ -243,6 +246,9 @@ const vector<GameOption*> game_options::build_options_list()
         new IntGameOption(SIMPLE_NAME(hp_warning), 30, 0, 100),
         new IntGameOption(magic_point_warning, {"mp_warning"}, 0, 0, 100),
         new IntGameOption(SIMPLE_NAME(autofight_warning), 0, 0, 1000),
+        new IntGameOption(SIMPLE_NAME(lua_gc_pause), 200, 50, 1000),
+        new IntGameOption(SIMPLE_NAME(lua_gc_stepmul), 200, 100, 1000),
+        new IntGameOption(SIMPLE_NAME(lua_idle_gc_ms), 2, 0, 100),
         // These need to be odd, hence allow +1.
         new IntGameOption(SIMPLE_NAME(view_max_width),
                       max(VIEW_BASE_WIDTH, VIEW_MIN_WIDTH),
@@ -363,12 +369,15 @@ const vector<GameOption*> game_options::build_options_list()
         new StringGameOption(SIMPLE_NAME(tile_font_stat_file), MONOSPACED_FONT),
         new StringGameOption(SIMPLE_NAME(tile_font_tip_file), MONOSPACED_FONT),
         new StringGameOption(SIMPLE_NAME(tile_font_lbl_file), PROPORTIONAL_FONT),
+        new BoolGameOption(SIMPLE_NAME(tile_show_frame_stats), false),
+        new StringGameOption(SIMPLE_NAME(tile_frame_log), ""),
 #endif
 #ifdef USE_TILE_WEB
         new BoolGameOption(SIMPLE_NAME(tile_realtime_anim), false),
         new BoolGameOption(SIMPLE_NAME(tile_level_map_hide_messages), true),
         new BoolGameOption(SIMPLE_NAME(tile_level_map_hide_sidebar), false),
         new BoolGameOption(SIMPLE_NAME(tile_web_mouse_control), true),
+        new IntGameOption(SIMPLE_NAME(tile_web_flush_rate), 30, 0, INT_MAX),
         new StringGameOption(SIMPLE_NAME(tile_font_crt_family), "monospace"),
         new StringGameOption(SIMPLE_NAME(tile_font_msg_family), "monospace"),
         new StringGameOption(SIMPLE_NAME(tile_font_stat_family), "monospace"),
@@ -384,6 +393,7 @@ const vector<GameOption*> game_options::build_options_list()
         new StringGameOption(SIMPLE_NAME(fsim_mode), ""),
         new StringGameOption(SIMPLE_NAME(fsim_mons), ""),
         new IntGameOption(SIMPLE_NAME(fsim_rounds), 4000, 1000, 500000),
+        new IntGameOption(SIMPLE_NAME(fsim_jobs), 1, 1, 256),
 #endif
 #if !defined(DGAMELAUNCH) || defined(DGL_REMEMBER_NAME)
         new BoolGameOption(SIMPLE_NAME(remember_name), true),
@@ -949,12 +959,15 @@ static string _get_save_path(string subdir)
 
 void game_options::reset_options()
 {
-    // XXX: do we really need to rebuild the list and map every time?
-    // Will they ever change within a single execution of Crawl?
-    // GameOption::value's value will change of course, but not the reference.
-    deleteAll(option_behaviour);
-    option_behaviour = build_options_list();
-    options_by_name = build_options_map(option_behaviour);
+    // The option list only holds references into this object, so it never
+    // changes within a single execution of Crawl; build it (and the name
+    // map) once and just reset the values on every later call. rc files are
+    // read several times during startup, so this is not free.
+    if (option_behaviour.empty())
+    {
+        option_behaviour = build_options_list();
+        options_by_name = build_options_map(option_behaviour);
+    }
     for (GameOption* option : option_behaviour)
         option->reset();
 
@@ -1029,6 +1042,8 @@ void game_options::reset_options()
     auto_butcher           = HS_VERY_HUNGRY;
     easy_confirm           = CONFIRM_SAFE_EASY;
     allow_self_target      = CONFIRM_PROMPT;
+    save_compression       = SAVE_CODEC_ZLIB;
+    save_compression_level = 0;
     skill_focus            = SKM_FOCUS_ON;
 
     user_note_prefix       = "";
@@ -2425,6 +2440,28 @@ static bool _is_autopickup_ban(pair<text_pattern, bool> entry)
     return !entry.second;
 }
 
+// Parse "codec[:level]", e.g. "zstd:3". Fails for codecs this build
+// cannot write.
+static bool _parse_save_compression(const string &spec, save_codec &codec,
+                                    int &level)
+{
+    const vector<string> parts = split_string(":", spec);
+    if (parts.empty() || parts.size() > 2)
+        return false;
+
+    for (int i = 0; i < NUM_SAVE_CODECS; ++i)
+    {
+        const save_codec c = static_cast<save_codec>(i);
+        if (parts[0] == save_codec_name(c) && save_codec_supported(c))
+        {
+            codec = c;
+            level = parts.size() > 1 ? atoi(parts[1].c_str()) : 0;
+            return true;
+        }
+    }
+    return false;
+}
+
 void game_options::read_option_line(const string &str, bool runscript)
 {
 #define NEWGAME_OPTION(_opt, _conv, _type)                                     \
@@ -2621,6 +2658,15 @@ void game_options::read_option_line(const string &str, bool runscript)
         else if (field == "all")
             easy_confirm = CONFIRM_ALL_EASY;
     }
+    else if (key == "save_compression")
+    {
+        if (!_parse_save_compression(field, save_compression,
+                                     save_compression_level))
+        {
+            report_error("Unknown or unsupported save_compression: %s",
+                         field.c_str());
+        }
+    }
     else if (key == "allow_self_target")
     {
         if (field == "yes")
@@ -3772,8 +3818,12 @@ enum commandline_option_type
     CLO_MACRO,
     CLO_MAPSTAT,
     CLO_MAPSTAT_DUMP_DISCONNECT,
+    CLO_MAPSTAT_PROFILE,
+    CLO_TRAVEL_BENCH,
+    CLO_GENLEVEL_BENCH,
     CLO_OBJSTAT,
     CLO_ITERATIONS,
+    CLO_JOBS,
     CLO_FORCE_MAP,
     CLO_ARENA,
     CLO_DUMP_MAPS,
@@ -3799,10 +3849,14 @@ enum commandline_option_type
     CLO_THROTTLE,
     CLO_NO_THROTTLE,
     CLO_PLAYABLE_JSON, // JSON metadata for species, jobs, combos.
+    CLO_TURN_PROFILE,
+    CLO_SAMPLE_PROFILE,
+    CLO_STARTUP_PROFILE,
 #ifdef USE_TILE_WEB
     CLO_WEBTILES_SOCKET,
     CLO_AWAIT_CONNECTION,
     CLO_PRINT_WEBTILES_OPTIONS,
+    CLO_WEBTILES_RECORD,
 #endif
 
     CLO_NOPS
@@ -3812,13 +3866,16 @@ static const char *cmd_ops[] =
 {
     "scores", "name", "species", "background", "dir", "rc", "rcdir", "tscores",
     "vscores", "scorefile", "morgue", "macro", "mapstat", "dump-disconnect",
-    "objstat", "iters", "force-map", "arena", "dump-maps", "test", "script",
+    "mapstat-profile", "travel-bench", "genlevel-bench", "objstat", "iters",
+    "jobs", "force-map", "arena", "dump-maps", "test", "script",
     "builddb", "help", "version", "seed", "save-version", "sprint",
     "extra-opt-first", "extra-opt-last", "sprint-map", "edit-save",
     "print-charset", "tutorial", "wizard", "explore", "no-save", "gdb",
     "no-gdb", "nogdb", "throttle", "no-throttle", "playable-json",
+    "turn-profile", "sample-profile", "startup-profile",
 #ifdef USE_TILE_WEB
     "webtiles-socket", "await-connection", "print-webtiles-options",
+    "webtiles-record",
 #endif
 };
 
@@ -3908,7 +3965,7 @@ static struct es_command
     { ES_GET,     "get",     false, 1, 2, },
     { ES_PUT,     "put",     true,  1, 2, },
     { ES_RM,      "rm",      true,  1, 1, },
-    { ES_REPACK,  "repack",  false, 0, 0, },
+    { ES_REPACK,  "repack",  false, 0, 1, },
     { ES_INFO,    "info",    false, 0, 0, },
 };
 
@@ -3923,7 +3980,9 @@ static void _edit_save(int argc, char **argv)
                "  put <chunk> [<chunkfile>]   import a chunk from <chunkfile>\n"
                "     <chunkfile> defaults to \"chunk\"; use \"-\" for stdout/stdin\n"
                "  rm <chunk>                  delete a chunk\n"
-               "  repack                      defrag and reclaim unused space\n"
+               "  repack [<codec>[:<level>]]  defrag and reclaim unused space,\n"
+               "                              recompressing with <codec> if given\n"
+               "  info                        list chunk sizes and compression\n"
              );
         return;
     }
@@ -4026,7 +4085,13 @@ static void _edit_save(int argc, char **argv)
         }
         else if (cmd == ES_REPACK)
         {
+            save_codec codec = SAVE_CODEC_ZLIB;
+            int level = 0;
+            if (argc == 3 && !_parse_save_compression(argv[2], codec, level))
+                FAIL("Unknown or unsupported codec \"%s\".\n", argv[2]);
+
             package save2((filename + ".tmp").c_str(), true, true);
+            save2.set_codec(codec, level);
             for (const string &chunk : save.list_chunks())
             {
                 char buf[16384];
@@ -4049,7 +4114,10 @@ static void _edit_save(int argc, char **argv)
             plen_t frag = save.get_chunk_fragmentation("");
             plen_t flen = save.get_size();
             plen_t slack = save.get_slack();
-            printf("Chunks: (size compressed/uncompressed, fragments, name)\n");
+            printf("Chunks: (size compressed/uncompressed, ratio, codec, "
+                   "fragments, name)\n");
+            plen_t codec_clen[NUM_SAVE_CODECS] = { 0 };
+            plen_t codec_len[NUM_SAVE_CODECS] = { 0 };
             for (const string &chunk : list)
             {
                 int cfrag = save.get_chunk_fragmentation(chunk);
@@ -4058,10 +4126,24 @@ static void _edit_save(int argc, char **argv)
 
                 char buf[16384];
                 chunk_reader in(&save, chunk);
+                const save_codec codec = in.get_codec();
                 plen_t clen = 0;
                 while (plen_t s = in.read(buf, sizeof(buf)))
                     clen += s;
-                printf("%7d/%7d %3u %s\n", cclen, clen, cfrag, chunk.c_str());
+                codec_clen[codec] += cclen;
+                codec_len[codec] += clen;
+                printf("%7d/%7d %5.2f %-4s %3u %s\n", cclen, clen,
+                       cclen ? (float)clen / cclen : 0.0, save_codec_name(codec),
+                       cfrag, chunk.c_str());
+            }
+            for (int i = 0; i < NUM_SAVE_CODECS; ++i)
+            {
+                if (!codec_clen[i])
+                    continue;
+                printf("Total for %-6s %u/%u (%4.2f)\n",
+                       save_codec_name(static_cast<save_codec>(i)),
+                       codec_clen[i], codec_len[i],
+                       (float)codec_len[i] / codec_clen[i]);
             }
             // the directory is not a chunk visible from the outside
             printf("Fragmentation:    %u/%u (%4.2f)\n", frag, nchunks + 1,
@@ -4257,6 +4339,9 @@ bool parse_args(int argc, char **argv, bool rc_only)
 
     SysEnv.rcdirs.clear();
     SysEnv.map_gen_iters = 0;
+    SysEnv.map_gen_jobs = 1;
+    SysEnv.map_gen_bench_place.clear();
+    SysEnv.map_gen_bench_first_seed = SysEnv.map_gen_bench_last_seed = 0;
 
     if (argc < 2)           // no args!
         return true;
@@ -4419,6 +4504,72 @@ bool parse_args(int argc, char **argv, bool rc_only)
             fprintf(stderr, "%s", dbg_stat_err);
             end(1);
 #endif
+            break;
+
+        case CLO_MAPSTAT_PROFILE:
+#ifdef DEBUG_STATISTICS
+            crawl_state.map_stat_profile = true;
+#else
+            fprintf(stderr, "%s", dbg_stat_err);
+            end(1);
+#endif
+            break;
+
+        case CLO_TRAVEL_BENCH:
+#ifdef DEBUG_STATISTICS
+            crawl_state.map_stat_travel_bench = true;
+#else
+            fprintf(stderr, "%s", dbg_stat_err);
+            end(1);
+#endif
+            break;
+
+        case CLO_GENLEVEL_BENCH:
+#ifdef DEBUG_STATISTICS
+        {
+            if (!next_is_param || current + 2 >= argc)
+            {
+                fprintf(stderr, "-%s needs a place and a seed or seed range\n",
+                        arg);
+                end(1);
+            }
+            try
+            {
+                level_id::parse_level_id(next_arg);
+            }
+            catch (const bad_level_id &err)
+            {
+                fprintf(stderr, "Error parsing place: %s\n", err.what());
+                end(1);
+            }
+
+            // Seeds are in hex, as for -seed.
+            unsigned int first, last;
+            const int nseeds = sscanf(argv[current + 2], "%x-%x", &first,
+                                      &last);
+            if (nseeds < 1 || nseeds == 2 && last < first)
+            {
+                fprintf(stderr, "Bad seed range '%s'\n", argv[current + 2]);
+                end(1);
+            }
+            SysEnv.map_gen_bench_place = next_arg;
+            SysEnv.map_gen_bench_first_seed = first;
+            SysEnv.map_gen_bench_last_seed = nseeds == 2 ? last : first;
+
+            crawl_state.map_stat_gen = true;
+#ifdef USE_TILE_LOCAL
+            crawl_state.tiles_disabled = true;
+#endif
+            nextUsed = true;
+            // And the seed range.
+            current++;
+        }
+#else
+            fprintf(stderr, "%s", dbg_stat_err);
+            end(1);
+#endif
+            break;
+
         case CLO_ITERATIONS:
 #ifdef DEBUG_STATISTICS
             if (!next_is_param || !isadigit(*next_arg))
@@ -4441,6 +4592,29 @@ bool parse_args(int argc, char **argv, bool rc_only)
 #endif
             break;
 
+        case CLO_JOBS:
+#ifdef DEBUG_STATISTICS
+            if (!next_is_param || !isadigit(*next_arg))
+            {
+                fprintf(stderr, "Integer argument required for -%s\n", arg);
+                end(1);
+            }
+            else
+            {
+#ifdef TARGET_OS_WINDOWS
+                fprintf(stderr, "-%s is not supported on Windows; building "
+                        "levels in a single process.\n", arg);
+#else
+                SysEnv.map_gen_jobs = max(1, min(atoi(next_arg), 256));
+#endif
+                nextUsed = true;
+            }
+#else
+            fprintf(stderr, "%s", dbg_stat_err);
+            end(1);
+#endif
+            break;
+
         case CLO_FORCE_MAP:
 #ifdef DEBUG_STATISTICS
             if (!next_is_param)
@@ -4515,6 +4689,15 @@ bool parse_args(int argc, char **argv, bool rc_only)
 #endif
             break;
 
+        case CLO_STARTUP_PROFILE:
+            if (next_is_param)
+                return false;
+            crawl_state.startup_profile = true;
+#ifdef USE_TILE_LOCAL
+            crawl_state.tiles_disabled = true;
+#endif
+            break;
+
         case CLO_GDB:
             crawl_state.no_gdb = 0;
             break;
@@ -4633,6 +4816,31 @@ bool parse_args(int argc, char **argv, bool rc_only)
                 Options.game.type = GAME_TYPE_SPRINT;
             break;
 
+        case CLO_TURN_PROFILE:
+            if (!next_is_param)
+                return false;
+
+            nextUsed = true;
+            if (!rc_only)
+            {
+                crawl_state.turn_profile_file = next_arg;
+                turn_profile_start();
+            }
+            break;
+
+        case CLO_SAMPLE_PROFILE:
+            if (!next_is_param)
+                return false;
+
+            nextUsed = true;
+            if (!rc_only && !start_sampling_profiler(next_arg))
+            {
+                end(1, false, "Couldn't start sampling to %s: this needs a "
+                              "debug or profile build on a Unix system.",
+                    next_arg);
+            }
+            break;
+
         case CLO_SPRINT_MAP:
             if (!next_is_param)
                 return false;
@@ -4676,6 +4884,11 @@ bool parse_args(int argc, char **argv, bool rc_only)
             tiles.m_await_connection = true;
             break;
 
+        case CLO_WEBTILES_RECORD:
+            nextUsed            = true;
+            tiles.m_record_name = next_arg;
+            break;
+
         case CLO_PRINT_WEBTILES_OPTIONS:
             if (!rc_only)
             {
@@ -58,7 +58,10 @@ public:
     vector<string> cmd_args;
 
     int map_gen_iters;
+    int map_gen_jobs;              // Worker processes for mapstat/objstat.
     unique_ptr<depth_ranges> map_gen_range;
+    string map_gen_bench_place;    // The level -genlevel-bench builds.
+    uint32_t map_gen_bench_first_seed, map_gen_bench_last_seed;
 
     vector<string> extra_opts_first;
     vector<string> extra_opts_last;
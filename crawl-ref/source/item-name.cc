@@ -133,10 +133,109 @@ static string _item_inscription(const item_def &item)
                                              ", ").c_str());
 }
 
+// What an item's name is built from, other than the arguments and the
+// player's state. A cached name is only reused if none of it has changed.
+struct item_name_fingerprint
+{
+    object_class_type base_type;
+    uint8_t sub_type;
+    short plus, plus2;
+    int special;
+    uint8_t rnd;
+    short quantity;
+    iflags_t flags;
+    coord_def pos;
+    short link;
+    string inscription;
+    unsigned int nprops;
+    int id_epoch;
+
+    bool operator==(const item_name_fingerprint &o) const
+    {
+        return base_type == o.base_type && sub_type == o.sub_type
+               && plus == o.plus && plus2 == o.plus2
+               && special == o.special && rnd == o.rnd
+               && quantity == o.quantity && flags == o.flags
+               && pos == o.pos && link == o.link
+               && nprops == o.nprops && id_epoch == o.id_epoch
+               && inscription == o.inscription;
+    }
+};
+
+struct cached_item_name
+{
+    item_name_fingerprint fingerprint;
+    string name;
+};
+
+typedef tuple<const item_def*, unsigned int, iflags_t> item_name_cache_key;
+static map<item_name_cache_key, cached_item_name> _item_name_cache;
+static int _item_name_cache_depth = 0;
+static bool _item_name_cache_filling = false;
+// Bumped whenever an item type is (un)identified, which renames every item
+// of that type at once.
+static int _item_id_epoch = 0;
+
+item_name_cache_scope::item_name_cache_scope()
+{
+    if (!_item_name_cache_depth++)
+        _item_name_cache.clear();
+}
+
+item_name_cache_scope::~item_name_cache_scope()
+{
+    if (!--_item_name_cache_depth)
+        _item_name_cache.clear();
+}
+
+static item_name_fingerprint _item_name_fingerprint(const item_def &item)
+{
+    return { item.base_type, item.sub_type, item.plus, item.plus2,
+             item.special, item.rnd, item.quantity, item.flags, item.pos,
+             item.link, item.inscription,
+             static_cast<unsigned int>(item.props.size()), _item_id_epoch };
+}
+
+// Only items with a fixed home can be cached by address; a temporary copy
+// could reuse the address of a differently-named one.
+static bool _item_name_cacheable(const item_def &item)
+{
+    return &item >= &mitm[0] && &item < &mitm[0] + MAX_ITEMS
+           || &item >= &you.inv[0] && &item < &you.inv[0] + ENDOFPACK;
+}
+
 string item_def::name(description_level_type descrip, bool terse, bool ident,
                       bool with_inscription, bool quantity_in_words,
                       iflags_t ignore_flags) const
 {
+    if (_item_name_cache_depth && !_item_name_cache_filling
+        && _item_name_cacheable(*this))
+    {
+        const item_name_cache_key key(this,
+                                      descrip << 4 | terse << 3 | ident << 2
+                                      | with_inscription << 1
+                                      | quantity_in_words,
+                                      ignore_flags);
+        const item_name_fingerprint fingerprint
+            = _item_name_fingerprint(*this);
+
+        auto it = _item_name_cache.find(key);
+        if (it != _item_name_cache.end()
+            && it->second.fingerprint == fingerprint)
+        {
+            return it->second.name;
+        }
+
+        string built;
+        {
+            unwind_bool filling(_item_name_cache_filling, true);
+            built = name(descrip, terse, ident, with_inscription,
+                         quantity_in_words, ignore_flags);
+        }
+        _item_name_cache[key] = { fingerprint, built };
+        return built;
+    }
+
     if (crawl_state.game_is_arena())
     {
         ignore_flags |= ISFLAG_KNOW_PLUSES | ISFLAG_KNOW_CURSE
@@ -2206,6 +2305,7 @@ bool set_ident_type(object_class_type basetype, int subtype, bool identify)
         return false;
 
     you.type_ids[basetype][subtype] = identify;
+    _item_id_epoch++;
     request_autoinscribe();
 
     // Our item knowledge changed in a way that could possibly affect shop
@@ -141,6 +141,17 @@ string menu_colour_item_name(const item_def &item,
                                    description_level_type desc);
 
 void            init_item_name_cache();
+
+// While one of these is alive, item_def::name() remembers what it built for
+// items on the floor or in the pack, so asking again with the same arguments
+// is free. Only hold one over code that looks at items without changing how
+// they are described: a redraw, or matching rules against a name.
+class item_name_cache_scope
+{
+public:
+    item_name_cache_scope();
+    ~item_name_cache_scope();
+};
 item_kind item_kind_by_name(const string &name);
 
 vector<string> item_name_list_for_glyph(char32_t glyph);
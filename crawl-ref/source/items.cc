@@ -2030,6 +2030,8 @@ item_def *auto_assign_item_slot(item_def& item)
 
     int newslot = -1;
     bool overwrite = true;
+    // Every rule is matched against the same few names.
+    item_name_cache_scope item_names;
     // check to see whether we've chosen an automatic label:
     for (auto& mapping : Options.auto_item_letters)
     {
@@ -2790,6 +2792,9 @@ static void _autoinscribe_item(item_def& item)
     // for automatically generated inscriptions
     if (!item.inscription.empty())
         return;
+    // Nothing can match without any rules, so don't build the name.
+    if (Options.autoinscriptions.empty())
+        return;
     const string old_inscription = item.inscription;
     item.inscription.clear();
 
@@ -2903,8 +2908,6 @@ static int _autopickup_subtype(const item_def &item)
 
 static bool _is_option_autopickup(const item_def &item, bool ignore_force)
 {
-    string iname = _autopickup_item_name(item);
-
     if (item.base_type < NUM_OBJECT_CLASSES)
     {
         const int force = you.force_autopickup[item.base_type][_autopickup_subtype(item)];
@@ -2914,6 +2917,10 @@ static bool _is_option_autopickup(const item_def &item, bool ignore_force)
     else
         return false;
 
+    // Only build the name once the \ settings haven't decided: this is
+    // called for every item travel and the tile view look at.
+    const string iname = _autopickup_item_name(item);
+
 #ifdef CLUA_BINDINGS
     maybe_bool res = clua.callmaybefn("ch_force_autopickup", "is",
                                       &item, iname.c_str());
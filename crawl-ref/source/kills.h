@@ -157,6 +157,8 @@ private:
 class KillMaster
 {
 public:
+    KillMaster() : changes(0) { }
+
     void record_kill(const monster* mon, int killer, bool ispet);
 
     bool empty() const;
@@ -173,10 +175,14 @@ public:
     int total_kills() const;
 
     string kill_info() const;
+
+    // Changes whenever a kill is recorded or the table is loaded.
+    int generation() const { return changes; }
 private:
     const char *category_name(kill_category kc) const;
 
     Kills categorized_kills[KC_NCATEGORIES];
+    int changes;
 private:
     void add_kill_info(string &, vector<kill_exp> &,
                        int count, const char *c, bool separator) const;
@@ -7,23 +7,35 @@
 
 #include "l-libs.h"
 
+#include <chrono>
+
 #include "act-iter.h"
+#include "beam.h"
+#include "bitary.h"
 #include "branch.h"
 #include "chardump.h"
+#include "cloud.h"
 #include "cluautil.h"
+#include "command.h"
 #include "coordit.h"
 #include "dungeon.h"
 #include "files.h"
 #include "god-wrath.h"
-#include "los.h"
+#include "hash.h"
+#include "los-def.h"
+#include "losglobal.h"
+#include "macro.h"
 #include "message.h"
 #include "mon-act.h"
 #include "mon-death.h"
 #include "mon-poly.h"
+#include "random.h"
+#include "ray.h"
 #include "religion.h"
 #include "stairs.h"
 #include "state.h"
 #include "stringutil.h"
+#include "tiles-build-specific.h"
 #include "tileview.h"
 #include "view.h"
 #include "wiz-dgn.h"
@@ -103,6 +115,13 @@ LUAFN(debug_generate_level)
     return 0;
 }
 
+// Reseed the RNG, e.g. to rebuild a level from a -genlevel-bench seed.
+LUAFN(debug_seed_rng)
+{
+    seed_rng(static_cast<uint32_t>(luaL_checknumber(ls, 1)));
+    return 0;
+}
+
 LUAFN(debug_reveal_mimics)
 {
     for (rectangle_iterator ri(1); ri; ++ri)
@@ -169,6 +188,16 @@ LUAFN(debug_bouncy_beam)
     return 0;
 }
 
+#ifdef DEBUG_TESTS
+LUAFN(debug_check_explosion)
+{
+    const coord_def c(luaL_checkint(ls, 1), luaL_checkint(ls, 2));
+    const int r = luaL_checkint(ls, 3);
+    lua_pushboolean(ls, explosion_matches_dfs(c, r));
+    return 1;
+}
+#endif
+
 // If menv[] is full, dismiss all monsters not near the player.
 LUAFN(debug_cull_monsters)
 {
@@ -325,6 +354,229 @@ LUAFN(debug_viewwindow)
     return 0;
 }
 
+// Redraw the view the given number of times, as the game does after each
+// turn. Returns frames per second and the mean and 99th percentile frame
+// times, in milliseconds.
+LUAFN(debug_render_benchmark)
+{
+    const int frames = luaL_checkint(ls, 1);
+    if (frames <= 0)
+        return 0;
+
+    vector<double> times;
+    times.reserve(frames);
+    double total = 0;
+    for (int i = 0; i < frames; ++i)
+    {
+        const auto start = chrono::steady_clock::now();
+        viewwindow();
+#ifdef USE_TILE
+        tiles.redraw();
+#endif
+        const double ms = chrono::duration<double, milli>(
+            chrono::steady_clock::now() - start).count();
+        times.push_back(ms);
+        total += ms;
+    }
+
+    sort(times.begin(), times.end());
+    lua_pushnumber(ls, total > 0 ? frames * 1000.0 / total : 0);
+    lua_pushnumber(ls, total / frames);
+    lua_pushnumber(ls, times[min(frames - 1, frames * 99 / 100)]);
+    return 3;
+}
+
+// Queries are drawn before timing starts and reused in turn, so the RNG
+// isn't part of what's measured.
+static const int GEOMETRY_BENCH_QUERIES = 4096;
+
+template <class F>
+static double _time_geometry_ops(
+    const vector<pair<coord_def, coord_def>> &queries, int ops, F op)
+{
+    const auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i)
+        op(queries[i % queries.size()]);
+    return chrono::duration<double, nano>(
+               chrono::steady_clock::now() - start).count() / ops;
+}
+
+// Time one of the geometry primitives under most hot paths, on the current
+// level: each operation starts from a random spot, and those that need a
+// second spot get one within LOS. Returns nanoseconds per operation, and a
+// count of what the operations found so the work isn't optimised away.
+LUAFN(debug_geometry_benchmark)
+{
+    const string what = luaL_checkstring(ls, 1);
+    const int ops = luaL_checkint(ls, 2);
+    if (ops <= 0)
+        return 0;
+
+    vector<pair<coord_def, coord_def>> queries(min(ops,
+                                                   GEOMETRY_BENCH_QUERIES));
+    for (auto &query : queries)
+    {
+        query.first = random_in_bounds();
+        query.second = query.first
+                       + coord_def(random_range(-LOS_RADIUS, LOS_RADIUS),
+                                   random_range(-LOS_RADIUS, LOS_RADIUS));
+        if (!in_bounds(query.second))
+            query.second = query.first;
+    }
+
+    typedef const pair<coord_def, coord_def> query_t;
+    int found = 0;
+    double ns;
+    if (what == "rectangle_iterator")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            for (rectangle_iterator ri(q.first, LOS_RADIUS); ri; ++ri)
+                found += ri->x;
+        });
+    }
+    else if (what == "radius_iterator")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            for (radius_iterator ri(q.first, LOS_NO_TRANS); ri; ++ri)
+                found += ri->x;
+        });
+    }
+    else if (what == "distance_iterator")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            for (distance_iterator di(q.first, true, true, 3); di; ++di)
+                found += di->x;
+        });
+    }
+    else if (what == "cell_see_cell")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            found += cell_see_cell(q.first, q.second, LOS_DEFAULT);
+        });
+    }
+    else if (what == "cell_see_cell_nocache")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            found += cell_see_cell_nocache(q.first, q.second);
+        });
+    }
+    else if (what == "los_update")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            los_def los(q.first);
+            los.update();
+            found += los.see_cell(q.second);
+        });
+    }
+    else if (what == "ray")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            ray_def ray;
+            if (!find_ray(q.first, q.second, ray, opc_solid_see))
+                return;
+            for (int i = 0; i < LOS_RADIUS && ray.pos() != q.second; ++i)
+            {
+                ray.advance();
+                ++found;
+            }
+        });
+    }
+    else if (what == "circle")
+    {
+        ns = _time_geometry_ops(queries, ops, [&found](query_t &q) {
+            const circle_def circle(q.first, LOS_RADIUS, C_ROUND);
+            found += circle.contains(q.second);
+        });
+    }
+    else if (what == "bitary")
+    {
+        FixedBitArray<GXM, GYM> bits;
+        ns = _time_geometry_ops(queries, ops, [&found, &bits](query_t &q) {
+            bits.set(q.first, !bits(q.second));
+            found += bits(q.first);
+        });
+    }
+    else
+        return luaL_error(ls, "Unknown primitive: %s", what.c_str());
+
+    lua_pushnumber(ls, ns);
+    lua_pushnumber(ls, found);
+    return 2;
+}
+
+// Type the given keys and play them out, for replaying a recorded game.
+LUAFN(debug_replay_keys)
+{
+    for (const char *key = luaL_checkstring(ls, 1); *key; ++key)
+        macro_sendkeys_end_add_expanded(static_cast<unsigned char>(*key));
+    replay_input();
+    return 0;
+}
+
+static void _digest_item(vector<int> &state, const item_def &item)
+{
+    state.push_back(item.base_type);
+    state.push_back(item.sub_type);
+    state.push_back(item.plus);
+    state.push_back(item.plus2);
+    state.push_back(item.quantity);
+    state.push_back(item.flags);
+}
+
+// A hash of everything a replay should reproduce exactly: the player, the
+// monsters and items on the level, and the level itself.
+LUAFN(debug_state_digest)
+{
+    vector<int> state;
+
+    state.push_back(you.num_turns);
+    state.push_back(you.elapsed_time);
+    state.push_back(you.where_are_you);
+    state.push_back(you.depth);
+    state.push_back(you.pos().x);
+    state.push_back(you.pos().y);
+    state.push_back(you.hp);
+    state.push_back(you.hp_max);
+    state.push_back(you.magic_points);
+    state.push_back(you.experience);
+    state.push_back(you.gold);
+    for (const item_def &item : you.inv)
+        if (item.defined())
+            _digest_item(state, item);
+
+    for (monster_iterator mi; mi; ++mi)
+    {
+        state.push_back(mi->type);
+        state.push_back(mi->mid);
+        state.push_back(mi->pos().x);
+        state.push_back(mi->pos().y);
+        state.push_back(mi->hit_points);
+        state.push_back(mi->behaviour);
+        state.push_back(mi->foe);
+    }
+
+    for (const item_def &item : mitm)
+    {
+        if (!item.defined())
+            continue;
+        state.push_back(item.pos.x);
+        state.push_back(item.pos.y);
+        _digest_item(state, item);
+    }
+
+    for (rectangle_iterator ri(0); ri; ++ri)
+    {
+        state.push_back(grd(*ri));
+        state.push_back(cloud_type_at(*ri));
+    }
+
+    lua_pushstring(ls, make_stringf("%08x",
+                                    hash32(state.data(),
+                                           state.size() * sizeof(int)))
+                       .c_str());
+    return 1;
+}
+
 LUAFN(debug_seen_monsters_react)
 {
     seen_monsters_react();
@@ -389,11 +641,15 @@ const struct luaL_reg debug_dlib[] =
 { "up_stairs", debug_up_stairs },
 { "flush_map_memory", debug_flush_map_memory },
 { "generate_level", debug_generate_level },
+{ "seed_rng", debug_seed_rng },
 { "reveal_mimics", debug_reveal_mimics },
 { "los_changed", debug_los_changed },
 { "dump_map", debug_dump_map },
 { "test_explore", _debug_test_explore },
 { "bouncy_beam", debug_bouncy_beam },
+#ifdef DEBUG_TESTS
+{ "check_explosion", debug_check_explosion },
+#endif
 { "cull_monsters", debug_cull_monsters},
 { "dismiss_adjacent", debug_dismiss_adjacent},
 { "dismiss_monsters", debug_dismiss_monsters},
@@ -404,6 +660,10 @@ const struct luaL_reg debug_dlib[] =
 { "reset_uniques", debug_reset_uniques },
 { "check_uniques", debug_check_uniques },
 { "viewwindow", debug_viewwindow },
+{ "render_benchmark", debug_render_benchmark },
+{ "geometry_benchmark", debug_geometry_benchmark },
+{ "replay_keys", debug_replay_keys },
+{ "state_digest", debug_state_digest },
 { "seen_monsters_react", debug_seen_monsters_react },
 { "disable", debug_disable },
 { "cpp_assert", debug_cpp_assert },
@@ -8,6 +8,7 @@
 #include "files.h"
 #include "libutil.h"
 #include "stringutil.h"
+#include "syscalls.h"
 #include "tags.h"
 
 ///////////////////////////////////////////////////////////
@@ -183,6 +184,24 @@ LUAFN(_file_datadir_files)
     return clua_stringtable(ls, files);
 }
 
+// Returns the contents of the named file, or nil if it can't be read.
+LUAFN(_file_readfile)
+{
+    const string fname(luaL_checkstring(ls, 1));
+    FILE *f = fopen_u(fname.c_str(), "r");
+    if (!f)
+        return 0;
+
+    string text;
+    char buf[4096];
+    size_t got;
+    while ((got = fread(buf, 1, sizeof(buf), f)) > 0)
+        text.append(buf, got);
+    fclose(f);
+    lua_pushstring(ls, text.c_str());
+    return 1;
+}
+
 LUAFN(_file_writefile)
 {
     const string fname(luaL_checkstring(ls, 1));
@@ -207,6 +226,7 @@ static const struct luaL_reg file_dlib[] =
     { "unmarshall_number", file_unmarshall_number },
     { "unmarshall_string", file_unmarshall_string },
     { "writefile", _file_writefile },
+    { "readfile", _file_readfile },
     { "datadir_files", _file_datadir_files },
     { "datadir_files_recursive", _file_datadir_files_recursive },
     { "minor_version", file_minor_version },
@@ -1380,11 +1380,16 @@ static int item_get(lua_State *ls)
     if (!attr)
         return 0;
 
-    for (const ItemAccessor &ia : item_attrs)
-        if (!strcmp(attr, ia.attribute))
-            return ia.accessor(ls, iw, attr);
+    // Upvalue 1 maps attribute names to their index in item_attrs, so that
+    // scripts reading many fields don't pay for a strcmp scan on each one.
+    lua_pushvalue(ls, 2);
+    lua_rawget(ls, lua_upvalueindex(1));
+    const int index = lua_isnumber(ls, -1) ? lua_tointeger(ls, -1) : -1;
+    lua_pop(ls, 1);
+    if (index < 0)
+        return 0;
 
-    return 0;
+    return item_attrs[index].accessor(ls, iw, attr);
 }
 
 static const struct luaL_reg item_lib[] =
@@ -1415,7 +1420,13 @@ void cluaopen_item(lua_State *ls)
 {
     luaL_newmetatable(ls, ITEM_METATABLE);
     lua_pushstring(ls, "__index");
-    lua_pushcfunction(ls, item_get);
+    lua_createtable(ls, 0, ARRAYSZ(item_attrs));
+    for (int i = 0, size = ARRAYSZ(item_attrs); i < size; ++i)
+    {
+        lua_pushnumber(ls, i);
+        lua_setfield(ls, -2, item_attrs[i].attribute);
+    }
+    lua_pushcclosure(ls, item_get, 1);
     lua_settable(ls, -3);
 
     lua_pushstring(ls, "__gc");
@@ -20,6 +20,7 @@
 #include "transform.h"
 
 #define MONINF_METATABLE "monster.info"
+#define MONINF_CACHE "monster.info.cache"
 
 void lua_push_moninf(lua_State *ls, monster_info *mi)
 {
@@ -386,6 +387,56 @@ bool in_show_bounds(const coord_def &s)
     return s.rdist() <= ENV_SHOW_OFFSET;
 }
 
+// Push the monster_info for a visible monster, reusing the wrapper made
+// earlier in the same turn if there is one. Scripts tend to poll every cell
+// in view each turn, and nothing a monster_info records can change until
+// the player acts.
+static void _push_cached_moninf(lua_State *ls, const monster *m)
+{
+    lua_getfield(ls, LUA_REGISTRYINDEX, MONINF_CACHE);
+    if (lua_istable(ls, -1))
+    {
+        lua_getfield(ls, -1, "turn");
+        const bool stale = lua_tointeger(ls, -1) != you.num_turns;
+        lua_pop(ls, 1);
+        if (stale)
+        {
+            lua_pop(ls, 1);
+            lua_pushnil(ls);
+        }
+    }
+    if (!lua_istable(ls, -1))
+    {
+        lua_pop(ls, 1);
+        lua_newtable(ls);
+        lua_pushnumber(ls, you.num_turns);
+        lua_setfield(ls, -2, "turn");
+        lua_pushvalue(ls, -1);
+        lua_setfield(ls, LUA_REGISTRYINDEX, MONINF_CACHE);
+    }
+
+    lua_pushnumber(ls, m->mid);
+    lua_rawget(ls, -2);
+    if (lua_isuserdata(ls, -1))
+    {
+        const monster_info *mi = *(monster_info **) lua_touserdata(ls, -1);
+        if (mi->pos == m->pos())
+        {
+            lua_remove(ls, -2);
+            return;
+        }
+    }
+    lua_pop(ls, 1);
+
+    monster_info **miref =
+        clua_new_userdata<monster_info *>(ls, MONINF_METATABLE);
+    *miref = new monster_info(m);
+    lua_pushnumber(ls, m->mid);
+    lua_pushvalue(ls, -2);
+    lua_rawset(ls, -4);
+    lua_remove(ls, -2);
+}
+
 LUAFN(mi_get_monster_at)
 {
     COORDSHOW(s, 1, 2)
@@ -397,8 +448,7 @@ LUAFN(mi_get_monster_at)
     monster* m = &env.mons[env.mgrid(p)];
     if (!m->visible_to(&you))
         return 0;
-    monster_info mi(m);
-    lua_push_moninf(ls, &mi);
+    _push_cached_moninf(ls, m);
     return 1;
 }
 
@@ -48,9 +48,46 @@ LUAFN(wiz_quick_fsim)
     PLUARET(number, fdata.av_eff_dam);
 }
 
+// wiz.fsim(monster, rounds[, defend]): the full fight_data for one matchup,
+// as a table keyed by the fsim column names.
+LUAFN(wiz_fsim)
+{
+    string mon_name = luaL_checkstring(ls, 1);
+    monster_type mtype = get_monster_by_name(mon_name, true);
+    if (mtype == MONS_PROGRAM_BUG)
+    {
+        string err = make_stringf("No such monster: '%s'.", mon_name.c_str());
+        return luaL_argerror(ls, 1, err.c_str());
+    }
+    const int fsim_rounds = luaL_checkint(ls, 2);
+    const bool defend = lua_toboolean(ls, 3);
+
+    Options.fsim_mons = mon_name;
+    Options.fsim_rounds = fsim_rounds;
+
+    const fight_data fdata = wizard_quick_fsim_raw(defend);
+    lua_newtable(ls);
+    lua_pushnumber(ls, fdata.av_hit_dam);
+    lua_setfield(ls, -2, "AvHitDam");
+    lua_pushnumber(ls, fdata.max_dam);
+    lua_setfield(ls, -2, "MaxDam");
+    lua_pushnumber(ls, fdata.accuracy);
+    lua_setfield(ls, -2, "Accuracy");
+    lua_pushnumber(ls, fdata.av_dam);
+    lua_setfield(ls, -2, "AvDam");
+    lua_pushnumber(ls, fdata.av_time);
+    lua_setfield(ls, -2, "AvTime");
+    lua_pushnumber(ls, fdata.av_speed);
+    lua_setfield(ls, -2, "AvSpeed");
+    lua_pushnumber(ls, fdata.av_eff_dam);
+    lua_setfield(ls, -2, "AvEffDam");
+    return 1;
+}
+
 static const struct luaL_reg wiz_dlib[] =
 {
 { "quick_fsim", wiz_quick_fsim },
+{ "fsim", wiz_fsim },
 
 { nullptr, nullptr }
 };
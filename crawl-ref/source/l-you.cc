@@ -871,6 +871,24 @@ LUAFN(_you_at_branch_bottom)
 
 LUAWRAP(you_gain_exp, gain_exp(luaL_checkint(ls, 1)))
 
+// Returns a table of the base skill levels that the experience pool, and
+// as much more as given, would reach with the current training, without
+// training anything.
+LUAFN(you_projected_skills)
+{
+    training_projection projection(lua_isnumber(ls, 1) ? luaL_checkint(ls, 1)
+                                                       : 0);
+    lua_newtable(ls);
+    for (skill_type sk = SK_FIRST_SKILL; sk < NUM_SKILLS; ++sk)
+    {
+        if (is_invalid_skill(sk) || is_removed_skill(sk))
+            continue;
+        lua_pushnumber(ls, you.skill(sk, 10, true) * 0.1);
+        lua_setfield(ls, -2, skill_name(sk));
+    }
+    return 1;
+}
+
 LUAFN(you_mutate)
 {
     string mutname = luaL_checkstring(ls, 1);
@@ -1010,6 +1028,7 @@ static const struct luaL_reg you_dlib[] =
 { "init",               you_init },
 { "exp_needed",         you_exp_needed },
 { "exercise",           you_exercise },
+{ "projected_skills",   you_projected_skills },
 { "skill_cost_level",   you_skill_cost_level },
 { "skill_points",       you_skill_points },
 { "zigs_completed",     you_zigs_completed },
@@ -742,13 +742,31 @@ void cprintf(const char *format, ...)
     vsnprintf(buffer, sizeof(buffer), format, argp);
     va_end(argp);
 
+    // Decoding can only shrink the text, so these always have room. Hand
+    // the whole string to curses at once rather than a character at a time.
+    wchar_t wbuf[sizeof(buffer)];
+#ifdef USE_TILE_WEB
+    char32_t ubuf[sizeof(buffer)];
+#endif
+    int len = 0;
+
     char32_t c;
     char *bp = buffer;
     while (int s = utf8towc(&c, bp))
     {
         bp += s;
-        putwch(c);
+        wbuf[len] = c;
+#ifdef USE_TILE_WEB
+        ubuf[len] = c;
+#endif
+        len++;
     }
+
+    addnwstr(wbuf, len);
+#ifdef USE_TILE_WEB
+    ubuf[len] = 0;
+    tiles.put_ucs_string(ubuf);
+#endif
 }
 
 void putwch(char32_t chr)
@@ -771,13 +789,39 @@ void puttext(int x1, int y1, const crawl_view_buffer &vbuf)
 {
     const screen_cell_t *cell = vbuf;
     const coord_def size = vbuf.size();
+    // Write each row as runs of cells sharing a colour, so that the colour
+    // is set once per run and curses gets whole strings.
+    vector<wchar_t> run(size.x);
+#ifdef USE_TILE_WEB
+    vector<char32_t> web_run(size.x + 1);
+#endif
     for (int y = 0; y < size.y; ++y)
     {
         cgotoxy(x1, y1 + y);
-        for (int x = 0; x < size.x; ++x)
+        for (int x = 0; x < size.x;)
         {
-            put_colour_ch(cell->colour, cell->glyph);
-            cell++;
+            const unsigned short colour = cell->colour;
+            int len = 0;
+#ifdef USE_TILE_WEB
+            int web_len = 0;
+#endif
+            for (; x < size.x && cell->colour == colour; ++x, ++cell)
+            {
+                run[len++] = cell->glyph ? cell->glyph : ' ';
+#ifdef USE_TILE_WEB
+                // As with putwch(), a null glyph is blank on the console
+                // but sends nothing to webtiles.
+                if (cell->glyph)
+                    web_run[web_len++] = cell->glyph;
+#endif
+            }
+
+            textcolour(colour);
+            addnwstr(&run[0], len);
+#ifdef USE_TILE_WEB
+            web_run[web_len] = 0;
+            tiles.put_ucs_string(&web_run[0]);
+#endif
         }
     }
     update_screen();
@@ -959,10 +1003,42 @@ static void curs_attr_fg(attr_t &attr, short &color_pair, int col)
     curs_attr_mapped(attr, color_pair, FG_COL, BG_COL, get_brand(col));
 }
 
+/**
+ * @internal
+ * Resolved attributes for unbranded foreground/background combinations, as
+ * text colours are set for nearly every character drawn. Flushed whenever the
+ * default colours are refreshed, which also picks up option changes.
+ */
+struct curs_attr_cache_entry
+{
+    bool valid;
+    attr_t attr;
+    short color_pair;
+};
+static curs_attr_cache_entry curs_attr_cache[NUM_TERM_COLOURS][NUM_TERM_COLOURS];
+
+static void curs_attr_cache_flush()
+{
+    memset(curs_attr_cache, 0, sizeof(curs_attr_cache));
+}
+
 // see declaration
 static void curs_attr_mapped(attr_t &attr, short &color_pair, COLOURS fg,
     COLOURS bg, int brand)
 {
+    curs_attr_cache_entry *cached = nullptr;
+    if (brand == CHATTR_NORMAL && fg < NUM_TERM_COLOURS
+        && bg < NUM_TERM_COLOURS)
+    {
+        cached = &curs_attr_cache[fg][bg];
+        if (cached->valid)
+        {
+            attr = cached->attr;
+            color_pair = cached->color_pair;
+            return;
+        }
+    }
+
     COLOURS fg_mod = fg;
     COLOURS bg_mod = bg;
     attr_t flags = 0;
@@ -1003,6 +1079,13 @@ static void curs_attr_mapped(attr_t &attr, short &color_pair, COLOURS fg,
     if ((brand & CHATTR_ATTRMASK) == CHATTR_REVERSE)
         flip_colour(temp_attr, temp_color_pair, temp_attr, temp_color_pair);
 
+    if (cached)
+    {
+        cached->valid = true;
+        cached->attr = temp_attr;
+        cached->color_pair = temp_color_pair;
+    }
+
     // Write out the results.
     color_pair = temp_color_pair;
     attr = temp_attr;
@@ -1288,6 +1371,7 @@ static void curs_set_default_colors()
     // The new default color pair is now in pair 0.
     FG_COL_DEFAULT = default_fg;
     BG_COL_DEFAULT = default_bg;
+    curs_attr_cache_flush();
 
     // Restore the previous default color pair.
     short default_fg_prev_curses = translate_colour(default_fg_prev);
@@ -1553,6 +1637,12 @@ void delay(unsigned int time)
 #endif
 
     refresh();
+#ifdef USE_TILE_WEB
+    // The client holds back everything sent after a delay message until the
+    // delay has passed, so a game played from the browser needn't sleep too.
+    if (tiles.is_controlled_from_web())
+        return;
+#endif
     if (time)
         usleep(time * 1000);
 }
@@ -13,6 +13,7 @@
 #include <cstring>
 #include <sstream>
 
+#include "alloc-tag.h"
 #include "colour.h"
 #include "files.h"
 #include "message.h"
@@ -619,6 +620,10 @@ void init_signals()
 # else
     signal(SIGHUP, handle_hangup);
 # endif
+
+# if defined(TRACK_ALLOCATIONS) && defined(SIGUSR1)
+    signal(SIGUSR1, alloc_tag_signal);
+# endif
 #endif
 
 #ifdef DGL_ENABLE_CORE_DUMP
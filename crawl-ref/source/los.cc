@@ -77,6 +77,12 @@ static vector<coord_def> cellray_ends;
 typedef FixedArray<bit_vector*, LOS_MAX_RANGE+1, LOS_MAX_RANGE+1> blockrays_t;
 static blockrays_t blockrays;
 
+// For each cell p in the quadrant, the distinct end points of the
+// minimal cellrays that p blocks. These are the targets whose visibility
+// from the origin can change when the opacity of p changes; the global
+// LOS cache uses them to invalidate only the affected pairs.
+static FixedArray<vector<coord_def>, LOS_MAX_RANGE+1, LOS_MAX_RANGE+1> blocked_ends;
+
 // We also store the minimal cellrays by target position
 // for efficient retrieval by find_ray.
 // XXX: Consider condensing this representation.
@@ -218,7 +224,7 @@ struct cellray
     coord_def target() const { return ray_coords[index()]; }
 
     // XXX: Currently ray/cellray[0] is the first point outside the origin.
-    coord_def operator[](unsigned int i)
+    coord_def operator[](unsigned int i) const
     {
         ASSERT(i <= end);
         return ray_coords[ray.start+i];
@@ -427,6 +433,17 @@ static void _create_blockrays()
     for (quadrant_iterator qi; qi; ++qi)
         delete all_blockrays(*qi);
 
+    // Collect the footprint targets for cheap invalidation.
+    for (quadrant_iterator qi; qi; ++qi)
+    {
+        vector<coord_def> &ends = blocked_ends(*qi);
+        for (int i = 0; i < n_min_rays; ++i)
+            if (blockrays(*qi)->get(i))
+                ends.push_back(cellray_ends[i]);
+        sort(ends.begin(), ends.end());
+        ends.erase(unique(ends.begin(), ends.end()), ends.end());
+    }
+
     dead_rays  = new bit_vector(n_min_rays);
     smoke_rays = new bit_vector(n_min_rays);
 
@@ -505,6 +522,24 @@ static void raycast()
     _create_blockrays();
 }
 
+/**
+ * Which cells can have their visibility changed by a cell's opacity?
+ *
+ * @param offset The blocking cell, relative to the LOS origin; both
+ *               coordinates must be non-negative (i.e. in the first
+ *               quadrant).
+ * @return The end points (in the same quadrant) of all minimal cellrays
+ *         that pass through offset.
+ */
+const vector<coord_def>& los_blocked_ends(const coord_def& offset)
+{
+    ASSERT(offset.x >= 0 && offset.y >= 0);
+    ASSERT(offset.x <= LOS_MAX_RANGE && offset.y <= LOS_MAX_RANGE);
+
+    raycast();
+    return blocked_ends(offset);
+}
+
 static int _imbalance(ray_def ray, const coord_def& target)
 {
     int imb = 0;
@@ -559,7 +594,6 @@ static bool _find_ray_se(const coord_def& target, ray_def& ray,
 
     const vector<cellray> &min = min_cellrays(target);
     ASSERT(!min.empty());
-    cellray c = min[0]; // XXX: const cellray &c ?
     unsigned int index = 0;
 
     if (cycle)
@@ -568,21 +602,32 @@ static bool _find_ray_se(const coord_def& target, ray_def& ray,
     unsigned int start = cycle ? ray.cycle_idx + 1 : 0;
     ASSERT(start <= min.size());
 
+    // The rays to one target cross mostly the same cells, so look each
+    // cell's opacity up only once; -1 means not yet.
+    signed char opacity[LOS_MAX_RANGE + 1][LOS_MAX_RANGE + 1];
+    memset(opacity, -1, sizeof(opacity));
+
     int blocked = OPC_OPAQUE;
     for (unsigned int i = start;
          (blocked >= OPC_OPAQUE) && (i < start + min.size()); i++)
     {
         index = i % min.size();
-        c = min[index];
+        const cellray &c = min[index];
         blocked = OPC_CLEAR;
         // Check all inner points.
         for (unsigned int j = 0; j < c.end && blocked < OPC_OPAQUE; j++)
-            blocked += opc(c[j]);
+        {
+            const coord_def p = c[j];
+            signed char &cell_opacity = opacity[p.x][p.y];
+            if (cell_opacity < 0)
+                cell_opacity = opc(p);
+            blocked += cell_opacity;
+        }
     }
     if (blocked >= OPC_OPAQUE)
         return false;
 
-    ray = c.ray;
+    ray = min[index].ray;
     ray.cycle_idx = index;
 
     return true;
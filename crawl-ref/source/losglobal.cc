@@ -2,25 +2,68 @@
 
 #include "losglobal.h"
 
+#include "bitary.h"
 #include "coord.h"
 #include "coordit.h"
 #include "libutil.h"
+#include "los.h"
 #include "los-def.h"
 
-#define LOS_KNOWN 4
+// The cache stores, for each cell p, the visibility of all cells q
+// with p < q within LOS range (the "half" LOS window of p). Each entry
+// is a single bit per los_type, so a whole half window fits in a few
+// words. A second set of bits records which entries are known; clearing
+// known bits is how individual pairs are invalidated.
+#define HALFLOS_WIDTH (LOS_MAX_RANGE+1)
+#define HALFLOS_HEIGHT (2*LOS_MAX_RANGE+1)
+#define HALFLOS_CELLS (HALFLOS_WIDTH * HALFLOS_HEIGHT)
+#define NUM_LOS_CACHED 4
 
-typedef uint8_t losfield_t;
-typedef losfield_t halflos_t[LOS_MAX_RANGE+1][2*LOS_MAX_RANGE+1];
 static const int o_half_x = 0;
 static const int o_half_y = LOS_MAX_RANGE;
-typedef halflos_t globallos_t[GXM][GYM];
+
+typedef FixedBitVector<HALFLOS_CELLS> halflos_bits;
+
+struct halflos_t
+{
+    halflos_bits known[NUM_LOS_CACHED];
+    halflos_bits visible[NUM_LOS_CACHED];
+
+    void reset()
+    {
+        for (int i = 0; i < NUM_LOS_CACHED; i++)
+            known[i].reset();
+    }
+
+    void forget(int idx)
+    {
+        for (int i = 0; i < NUM_LOS_CACHED; i++)
+            known[i].set(idx, false);
+    }
+};
+
+typedef FixedArray<halflos_t, GXM, GYM> globallos_t;
 
 static globallos_t globallos;
+static globallos_stats stats;
 
-static losfield_t* _lookup_globallos(const coord_def& p, const coord_def& q)
+static int _los_index(los_type l)
 {
-    COMPILE_CHECK(LOS_KNOWN * 2 <= sizeof(losfield_t) * 8);
+    switch (l)
+    {
+    case LOS_DEFAULT:   return 0;
+    case LOS_NO_TRANS:  return 1;
+    case LOS_SOLID:     return 2;
+    case LOS_SOLID_SEE: return 3;
+    default:
+        die("invalid opacity");
+    }
+}
 
+// Find the half window and the bit index storing the pair (p, q).
+static halflos_t* _lookup_globallos(const coord_def& p, const coord_def& q,
+                                    int &idx)
+{
     if (!map_bounds(p) || !map_bounds(q))
         return nullptr;
     coord_def diff = q - p;
@@ -28,52 +71,90 @@ static losfield_t* _lookup_globallos(const coord_def& p, const coord_def& q)
         return nullptr;
     // p < q iff p.x < q.x || p.x == q.x && p.y < q.y
     if (diff < coord_def(0, 0))
-        return &globallos[q.x][q.y][-diff.x + o_half_x][-diff.y + o_half_y];
+    {
+        idx = (-diff.x + o_half_x) * HALFLOS_HEIGHT + (-diff.y + o_half_y);
+        return &globallos(q);
+    }
     else
-        return &globallos[p.x][p.y][ diff.x + o_half_x][ diff.y + o_half_y];
+    {
+        idx = (diff.x + o_half_x) * HALFLOS_HEIGHT + (diff.y + o_half_y);
+        return &globallos(p);
+    }
 }
 
 static void _save_los(los_def* los, los_type l)
 {
+    const int li = _los_index(l);
     const coord_def o = los->get_center();
     int y1 = o.y - LOS_MAX_RANGE;
     int y2 = o.y + LOS_MAX_RANGE;
     int x1 = o.x - LOS_MAX_RANGE;
     int x2 = o.x + LOS_MAX_RANGE;
-    for (int y = y1; y <= y2; y++)
-        for (int x = x1; x <= x2; x++)
+    // Columns outermost: both globallos and the bit index within each
+    // halflos_t are laid out by x, then y.
+    for (int x = x1; x <= x2; x++)
+        for (int y = y1; y <= y2; y++)
         {
-            if (max(abs(o.x - x), abs(o.y - y)) > LOS_MAX_RANGE)
-                continue;
-
             coord_def ri(x, y);
-            losfield_t* flags = _lookup_globallos(o, ri);
-            if (!flags)
+            int idx;
+            halflos_t* half = _lookup_globallos(o, ri, idx);
+            if (!half)
                 continue;
-            *flags |= l << LOS_KNOWN;
-            if (los->see_cell(ri))
-                *flags |= l;
-            else
-                *flags &= ~l;
+            half->known[li].set(idx);
+            half->visible[li].set(idx, los->see_cell(ri));
         }
 }
 
+// Forget the pair (o, o + d), if it is in the map.
+static void _forget_pair(const coord_def& o, const coord_def& d)
+{
+    int idx;
+    halflos_t* half = _lookup_globallos(o, o + d, idx);
+    if (!half)
+        return;
+    half->forget(idx);
+    stats.pairs_invalidated++;
+}
+
 // Opacity at p has changed.
+//
+// Only pairs (o, t) with p on one of the minimal cellrays from o to t
+// can be affected, so instead of wiping every window that might contain
+// such a pair, walk the precomputed ray footprints from each origin in
+// range and forget exactly those.
 void invalidate_los_around(const coord_def& p)
 {
-    int x1 = max(p.x - LOS_MAX_RANGE, 0);
-    int y1 = max(p.y - LOS_MAX_RANGE, 0);
-    int x2 = min(p.x, GXM - 1);
-    int y2 = min(p.y + LOS_MAX_RANGE, GYM - 1);
-    for (int y = y1; y <= y2; y++)
-        for (int x = x1; x <= x2; x++)
-            memset(globallos[x][y], 0, sizeof(halflos_t));
+    stats.invalidations++;
+
+    for (rectangle_iterator oi(p, LOS_MAX_RANGE); oi; ++oi)
+    {
+        const coord_def o = *oi;
+        if (!map_bounds(o))
+            continue;
+
+        const coord_def d = p - o;
+        // The opacity of the origin itself never matters.
+        if (d.origin())
+            continue;
+
+        const vector<coord_def> &ends =
+            los_blocked_ends(coord_def(abs(d.x), abs(d.y)));
+
+        // Cells on an axis are shared by two quadrants.
+        const int sx_lo = d.x > 0 ? 1 : -1, sx_hi = d.x < 0 ? -1 : 1;
+        const int sy_lo = d.y > 0 ? 1 : -1, sy_hi = d.y < 0 ? -1 : 1;
+        for (int sx = sx_lo; sx <= sx_hi; sx += 2)
+            for (int sy = sy_lo; sy <= sy_hi; sy += 2)
+                for (const coord_def &e : ends)
+                    _forget_pair(o, coord_def(sx * e.x, sy * e.y));
+    }
 }
 
 void invalidate_los()
 {
+    stats.full_invalidations++;
     for (rectangle_iterator ri(0); ri; ++ri)
-        memset(globallos[ri->x][ri->y], 0, sizeof(halflos_t));
+        globallos(*ri).reset();
 }
 
 static void _update_globallos_at(const coord_def& p, los_type l)
@@ -118,17 +199,32 @@ bool cell_see_cell(const coord_def& p, const coord_def& q, los_type l)
     if (l == LOS_NONE)
         return true;
 
-    losfield_t* flags = _lookup_globallos(p, q);
+    int idx;
+    halflos_t* half = _lookup_globallos(p, q, idx);
 
-    if (!flags)
+    if (!half)
         return false; // outside range
 
-    if (!(*flags & (l << LOS_KNOWN)))
+    const int li = _los_index(l);
+    if (half->known[li].get(idx))
+        stats.hits++;
+    else
+    {
+        stats.misses++;
         _update_globallos_at(p, l);
+    }
 
-    //if (!(*flags & (l << LOS_KNOWN)))
-    //    die("cell_see_cell %d,%d %d,%d", p.x,p.y,q.x,q.y);
-    ASSERT(*flags & (l << LOS_KNOWN));
+    ASSERT(half->known[li].get(idx));
+
+    return half->visible[li].get(idx);
+}
 
-    return *flags & l;
+const globallos_stats& get_globallos_stats()
+{
+    return stats;
+}
+
+void reset_globallos_stats()
+{
+    stats = globallos_stats();
 }
@@ -6,3 +6,16 @@ void invalidate_los_around(const coord_def& p);
 void invalidate_los();
 
 bool cell_see_cell(const coord_def& p, const coord_def& q, los_type l);
+
+// Counters for the global LOS cache, to measure its effectiveness.
+struct globallos_stats
+{
+    uint64_t hits = 0;               // lookups answered from the cache
+    uint64_t misses = 0;             // lookups that needed a recomputation
+    uint64_t invalidations = 0;      // calls to invalidate_los_around()
+    uint64_t pairs_invalidated = 0;  // cell pairs forgotten by those calls
+    uint64_t full_invalidations = 0; // calls to invalidate_los()
+};
+
+const globallos_stats& get_globallos_stats();
+void reset_globallos_stats();
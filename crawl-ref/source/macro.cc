@@ -47,7 +47,12 @@
 #include "version.h"
 
 typedef deque<int> keybuf;
-typedef map<keyseq,keyseq> macromap;
+struct macromap : public map<keyseq,keyseq>
+{
+    // No key sequence this long has ever been added, so there's no point
+    // looking up anything longer. Removing macros doesn't lower it.
+    size_t longest_key = 0;
+};
 
 static macromap Keymaps[KMC_CONTEXT_COUNT];
 static macromap Macros;
@@ -390,6 +395,7 @@ static string vtostr(const keyseq &seq)
  */
 static void macro_add(macromap &mapref, keyseq key, keyseq action)
 {
+    mapref.longest_key = max(mapref.longest_key, key.size());
     mapref[key] = action;
 }
 
@@ -496,7 +502,8 @@ static void macro_buf_add_long(keyseq actions,
 
     while (!actions.empty())
     {
-        tmp = actions;
+        const size_t len = min(actions.size(), keymap.longest_key);
+        tmp.assign(actions.begin(), actions.begin() + len);
 
         while (!tmp.empty())
         {
@@ -580,7 +587,8 @@ static void macro_buf_apply_command_macro()
     if (macro_keys_left > 0 || expanded_keys_left > 0)
         return;
 
-    keyseq tmp = Buffer;
+    const size_t len = min(Buffer.size(), Macros.longest_key);
+    keyseq tmp(Buffer.begin(), Buffer.begin() + len);
 
     // find the longest match from the start of the buffer and replace it
     while (!tmp.empty())
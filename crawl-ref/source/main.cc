@@ -152,6 +152,7 @@
 #include "transform.h"
 #include "traps.h"
 #include "travel.h"
+#include "turn-profile.h"
 #include "uncancel.h"
 #include "version.h"
 #include "viewchar.h"
@@ -546,11 +547,23 @@ static void _show_commandline_options_help()
     puts("  -dump-disconnect    In mapstat when a disconnected level is "
          "generated, dump");
     puts("      map to map.dump and exit");
+    puts("  -mapstat-profile    In mapstat, time each map's Lua and each "
+         "level build");
+    puts("      attempt, and write the most expensive to mapstat-profile.log");
+    puts("  -travel-bench       In mapstat, autoexplore and travel across each "
+         "level built");
+    puts("      and write timings and pathfinding work to travel-bench.log");
+    puts("  -genlevel-bench <place> <seeds>");
+    puts("      build <place> once for each (hex) seed in <seeds>, e.g. 1-ff,");
+    puts("      and write builder phase timings to genlevel-bench.log");
     puts("  -objstat [<levels>] run monster and item stats on the given range "
          "of levels");
     puts("      Defaults to entire dungeon; same level syntax as -mapstat.");
     puts("  -iters <num>        For -mapstat and -objstat, set the number of "
          "iterations");
+    puts("  -jobs <num>         For -mapstat and -objstat, split the "
+         "iterations over");
+    puts("      <num> worker processes.");
     puts("  -force-map <map>    For -mapstat and -objstat, alway choose the "
          "      given map on every level.");
 #endif
@@ -561,6 +574,16 @@ static void _show_commandline_options_help()
     puts("  -gdb/-no-gdb     produce gdb backtrace when a crash happens (default:on)");
 #endif
     puts("  -playable-json   list playable species, jobs, and character combos.");
+    puts("  -turn-profile <file>  time each phase of every turn, and write "
+         "percentiles");
+    puts("                   to <file> as CSV on exit");
+    puts("  -sample-profile <file>  sample the call stack every 5ms of CPU "
+         "time, and write");
+    puts("                   folded stacks for flamegraph.pl to <file> on "
+         "exit (debug and");
+    puts("                   profile builds only)");
+    puts("  -startup-profile  time each phase of start-up, print it, and "
+         "exit");
 
 #if defined(TARGET_OS_WINDOWS) && defined(USE_TILE_LOCAL)
     text_popup(help, L"Dungeon Crawl command line help");
@@ -974,6 +997,8 @@ static void _update_place_info()
 //
 static void _input()
 {
+    flush_milestones();
+
     if (crawl_state.seen_hups)
         save_game(true, "Game saved, see you later!");
 
@@ -1097,6 +1122,7 @@ static void _input()
                 mprf(MSGCH_ERROR, "Infinite lua loop detected, aborting.");
             else
             {
+                turn_phase_timer timer(TURN_PHASE_LUA);
                 if (!clua.callfn("ready", 0, 0) && !clua.error.empty())
                     mprf(MSGCH_ERROR, "Lua error: %s", clua.error.c_str());
             }
@@ -1200,6 +1226,18 @@ static void _input()
 
 }
 
+/**
+ * Play out the keys already in the macro buffer as if they had been typed,
+ * until they and any delays they start are used up. This is for replaying
+ * recorded input from scripts, where nobody is at the keyboard; a command
+ * that wants more keys than it has been given would wait for them.
+ */
+void replay_input()
+{
+    while (has_pending_input() || you_are_delayed())
+        _input();
+}
+
 static bool _can_take_stairs(dungeon_feature_type ftype, bool down,
                              bool known_shaft)
 {
@@ -2205,16 +2243,21 @@ void world_reacts()
     // All markers should be activated at this point.
     ASSERT(!env.markers.need_activate());
 
+    turn_profile_scope turn_profile;
+
     fire_final_effects();
 
-    if (crawl_state.viewport_monster_hp || crawl_state.viewport_weapons)
     {
-        crawl_state.viewport_monster_hp = false;
-        crawl_state.viewport_weapons = false;
-        viewwindow();
-    }
+        turn_phase_timer timer(TURN_PHASE_VIEW);
+        if (crawl_state.viewport_monster_hp || crawl_state.viewport_weapons)
+        {
+            crawl_state.viewport_monster_hp = false;
+            crawl_state.viewport_weapons = false;
+            viewwindow();
+        }
 
-    update_monsters_in_view();
+        update_monsters_in_view();
+    }
 
     reset_show_terrain();
 
@@ -2222,6 +2265,7 @@ void world_reacts()
 
     if (!crawl_state.game_is_arena())
     {
+        turn_phase_timer timer(TURN_PHASE_GODS);
         you.turn_is_over = true;
         religion_turn_end();
         crawl_state.clear_god_acting();
@@ -2238,14 +2282,26 @@ void world_reacts()
     _check_banished();
     _check_sanctuary();
 
-    run_environment_effects();
+    {
+        turn_phase_timer timer(TURN_PHASE_ENVIRONMENT);
+        run_environment_effects();
+    }
 
     if (!crawl_state.game_is_arena())
+    {
+        turn_phase_timer timer(TURN_PHASE_PLAYER);
         player_reacts();
+    }
 
     abyss_morph();
-    apply_noises();
-    handle_monsters(true);
+    {
+        turn_phase_timer timer(TURN_PHASE_NOISE);
+        apply_noises();
+    }
+    {
+        turn_phase_timer timer(TURN_PHASE_MONSTERS);
+        handle_monsters(true);
+    }
 
     _check_banished();
 
@@ -2270,8 +2326,14 @@ void world_reacts()
         ouch(INSTANT_DEATH, KILLED_BY_QUITTING);
     }
 
-    handle_time();
-    manage_clouds();
+    {
+        turn_phase_timer timer(TURN_PHASE_TIME);
+        handle_time();
+    }
+    {
+        turn_phase_timer timer(TURN_PHASE_CLOUDS);
+        manage_clouds();
+    }
     if (env.level_state & LSTATE_GLOW_MOLD)
         _update_mold();
     if (env.level_state & LSTATE_GOLUBRIA)
@@ -2279,11 +2341,20 @@ void world_reacts()
     if (env.level_state & LSTATE_STILL_WINDS)
         _update_still_winds();
     if (!crawl_state.game_is_arena())
+    {
+        turn_phase_timer timer(TURN_PHASE_PLAYER);
         player_reacts_to_monsters();
+    }
 
-    wu_jian_end_of_turn_effects();
+    {
+        turn_phase_timer timer(TURN_PHASE_GODS);
+        wu_jian_end_of_turn_effects();
+    }
 
-    viewwindow();
+    {
+        turn_phase_timer timer(TURN_PHASE_VIEW);
+        viewwindow();
+    }
 
     if (you.cannot_act() && any_messages()
         && crawl_state.repeat_cmd != CMD_WIZARD)
@@ -2318,6 +2389,9 @@ void world_reacts()
             save_game(false);
         }
     }
+
+    maybe_pregenerate_level();
+
     // End of a turn.
     //
     // `los_noise_last_turn` is the value for display -- it needs to persist
@@ -2385,6 +2459,11 @@ static keycode_type _get_next_keycode()
 
     flush_input_buffer(FLUSH_BEFORE_COMMAND);
 
+    // Give the Lua collector some time while we wait for the player, rather
+    // than leaving it to run during the next turn's callbacks.
+    if (!has_pending_input() && !kbhit())
+        clua.idle_gc(Options.lua_idle_gc_ms);
+
     mouse_control mc(MOUSE_MODE_COMMAND);
     for (;;)
     {
@@ -13,6 +13,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <unordered_map>
 
 #include "abyss.h"
 #include "artefact.h"
@@ -20,6 +21,7 @@
 #include "cluautil.h"
 #include "colour.h"
 #include "coordit.h"
+#include "dbg-maps.h"
 #include "decks.h"
 #include "describe.h"
 #include "dgn-height.h"
@@ -2312,12 +2314,12 @@ void map_def::write_full(writer& outf) const
     marshallUByte(outf, TAG_MAJOR_VERSION);
     marshallUByte(outf, TAG_MINOR_VERSION);
     marshallString4(outf, name);
-    prelude.write(outf);
-    mapchunk.write(outf);
-    main.write(outf);
-    validate.write(outf);
-    veto.write(outf);
-    epilogue.write(outf);
+    prelude.write(outf, true);
+    mapchunk.write(outf, true);
+    main.write(outf, true);
+    validate.write(outf, true);
+    veto.write(outf, true);
+    epilogue.write(outf, true);
 }
 
 void map_def::read_full(reader& inf, bool check_cache_version)
@@ -2407,6 +2409,23 @@ void map_def::load()
         return;
 
     const string descache_base = get_descache_path(cache_name, "");
+
+    // The body is normally faulted in from the mapped cache, which is a
+    // snapshot consistent with our index and needs no locking.
+    if (const mapped_des_cache *mapped = find_mapped_des_cache(descache_base))
+    {
+        if ((size_t) cache_offset >= mapped->size)
+        {
+            throw map_load_exception(
+                    make_stringf("Map inf is invalid: %s", name.c_str()));
+        }
+        reader inf(mapped->data + cache_offset, mapped->size - cache_offset,
+                   TAG_MINOR_VERSION);
+        read_full(inf, true);
+        index_only = false;
+        return;
+    }
+
     file_lock deslock(descache_base + ".lk", "rb", false);
     const string loadfile = descache_base + ".dsc";
 
@@ -2513,6 +2532,17 @@ void map_def::set_file(const string &s)
     cache_name = get_cache_name(s);
 }
 
+// Runs the chunk on top of the Lua stack as this map's code, timing it
+// under -mapstat-profile.
+static bool _run_map_chunk(const map_def &map, const char *phase,
+                           int nresults)
+{
+#ifdef DEBUG_STATISTICS
+    mapstat_lua_timer timer(map, phase);
+#endif
+    return dlua.callfn("dgn_run_map", 1, nresults);
+}
+
 string map_def::run_lua(bool run_main)
 {
     dlua_set_map mset(this);
@@ -2522,7 +2552,7 @@ string map_def::run_lua(bool run_main)
         lua_pushnil(dlua);
     else if (err)
         return prelude.orig_error();
-    if (!dlua.callfn("dgn_run_map", 1, 0))
+    if (!_run_map_chunk(*this, "prelude", 0))
         return rewrite_chunk_errors(dlua.error);
 
     if (run_main)
@@ -2533,7 +2563,7 @@ string map_def::run_lua(bool run_main)
             lua_pushnil(dlua);
         else if (err)
             return mapchunk.orig_error();
-        if (!dlua.callfn("dgn_run_map", 1, 0))
+        if (!_run_map_chunk(*this, "map", 0))
             return rewrite_chunk_errors(dlua.error);
 
         // The vault may be non-rectangular with a ragged-right edge; for
@@ -2548,7 +2578,7 @@ string map_def::run_lua(bool run_main)
             lua_pushnil(dlua);
         else if (err)
             return main.orig_error();
-        if (!dlua.callfn("dgn_run_map", 1, 0))
+        if (!_run_map_chunk(*this, "main", 0))
             return rewrite_chunk_errors(dlua.error);
         run_hook("post_main");
     }
@@ -2573,6 +2603,9 @@ void map_def::copy_hooks_from(const map_def &other_map, const string &hook_name)
 bool map_def::run_hook(const string &hook_name, bool die_on_lua_error)
 {
     const dlua_set_map mset(this);
+#ifdef DEBUG_STATISTICS
+    mapstat_lua_timer timer(*this, hook_name.c_str());
+#endif
     if (!dlua.callfn("dgn_map_run_hook", "s", hook_name.c_str()))
     {
         if (die_on_lua_error)
@@ -2612,7 +2645,10 @@ bool map_def::test_lua_boolchunk(dlua_chunk &chunk, bool defval,
             mprf(MSGCH_ERROR, "Lua error: %s", chunk.orig_error().c_str());
         return result;
     }
-    if (dlua.callfn("dgn_run_map", 1, 1))
+    const char *phase = &chunk == &validate ? "validate"
+                        : &chunk == &veto   ? "veto"
+                                            : "epilogue";
+    if (_run_map_chunk(*this, phase, 1))
         dlua.fnreturns(">b", &result);
     else
     {
@@ -3247,30 +3283,89 @@ void map_def::fixup()
     }
 }
 
+// Every tag seen on any map, interned so that tag queries need neither
+// allocation nor a substring search of the tags string.
+static unordered_map<string, int> tag_id_map;
+static vector<string> tag_names;
+
+static int _intern_tag(const string &tag)
+{
+    auto it = tag_id_map.find(tag);
+    if (it != tag_id_map.end())
+        return it->second;
+
+    const int id = tag_names.size();
+    tag_names.push_back(tag);
+    tag_id_map[tag] = id;
+    return id;
+}
+
+static int _find_tag_id(const string &tag)
+{
+    auto it = tag_id_map.find(tag);
+    return it == tag_id_map.end() ? -1 : it->second;
+}
+
+const vector<int> &map_def::interned_tags() const
+{
+    // tags is written directly in several places (dgn.tags(), fixup()), so
+    // check the cached ids against it instead of trying to catch every
+    // write.
+    if (tags != tag_ids_source)
+    {
+        tag_ids.clear();
+        for (const string &tag : split_string(" ", tags))
+            tag_ids.push_back(_intern_tag(tag));
+        sort(tag_ids.begin(), tag_ids.end());
+        tag_ids.erase(unique(tag_ids.begin(), tag_ids.end()), tag_ids.end());
+        tag_ids_source = tags;
+    }
+    return tag_ids;
+}
+
 bool map_def::has_tag(const string &tagwanted) const
 {
     if (tags.empty() || tagwanted.empty())
         return false;
 
-    vector<string> wanted_tags = split_string(" ", tagwanted);
+    const vector<int> &ids = interned_tags();
+
+    if (tagwanted.find(' ') == string::npos)
+    {
+        const int id = _find_tag_id(tagwanted);
+        return id != -1 && binary_search(ids.begin(), ids.end(), id);
+    }
 
-    for (const string &tag : wanted_tags)
-        if (tags.find(" " + tag + " ") == string::npos)
+    for (const string &tag : split_string(" ", tagwanted))
+    {
+        const int id = _find_tag_id(tag);
+        if (id == -1 || !binary_search(ids.begin(), ids.end(), id))
             return false;
+    }
 
     return true;
 }
 
 bool map_def::has_tag_prefix(const string &prefix) const
 {
-    return !tags.empty() && !prefix.empty()
-        && tags.find(" " + prefix) != string::npos;
+    if (tags.empty() || prefix.empty())
+        return false;
+
+    for (int id : interned_tags())
+        if (starts_with(tag_names[id], prefix))
+            return true;
+    return false;
 }
 
 bool map_def::has_tag_suffix(const string &suffix) const
 {
-    return !tags.empty() && !suffix.empty()
-        && tags.find(suffix + " ") != string::npos;
+    if (tags.empty() || suffix.empty())
+        return false;
+
+    for (int id : interned_tags())
+        if (ends_with(tag_names[id], suffix))
+            return true;
+    return false;
 }
 
 vector<string> map_def::get_tags() const
@@ -971,6 +971,7 @@ public:
     void write(writer &) const;
     void clear() { depths.clear(); }
     bool empty() const { return depths.empty(); }
+    const depth_ranges_v &ranges() const { return depths; }
     bool is_usable_in(const level_id &lid) const;
     void add_depth(const level_range &range) { depths.push_back(range); }
     void add_depths(const depth_ranges &other_ranges);
@@ -1165,6 +1166,12 @@ private:
     // True if this map is in the process of being validated.
     bool validating_map_flag;
 
+    // The tags as sorted interned ids, rebuilt from the tags string
+    // whenever it no longer matches tag_ids_source.
+    mutable vector<int> tag_ids;
+    mutable string      tag_ids_source;
+    const vector<int> &interned_tags() const;
+
 public:
     map_def();
 
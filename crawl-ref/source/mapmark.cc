@@ -11,7 +11,6 @@
 
 #include "beh-type.h"
 #include "cluautil.h"
-#include "coordit.h"
 #include "dlua.h"
 #include "end.h"
 #include "env.h"
@@ -1142,6 +1141,29 @@ vector<map_marker*> map_markers::get_all(const string &key, const string &val)
     return rmarkers;
 }
 
+/**
+ * Every marker on the map, in the order a rectangle_iterator over the whole
+ * map would reach their cells, and in get_markers_at() order within a cell.
+ * Walking this visits only the cells that have markers.
+ */
+vector<map_marker*> map_markers::get_all_by_cell() const
+{
+    vector<map_marker*> rmarkers;
+    for (const auto &entry : markers)
+        if (map_bounds(entry.first))
+            rmarkers.push_back(entry.second);
+
+    // The map is ordered by column first; stable, so that markers sharing a
+    // cell keep their order.
+    stable_sort(rmarkers.begin(), rmarkers.end(),
+                [](const map_marker *a, const map_marker *b)
+                {
+                    return a->pos.y < b->pos.y
+                           || a->pos.y == b->pos.y && a->pos.x < b->pos.x;
+                });
+    return rmarkers;
+}
+
 vector<map_marker*> map_markers::get_markers_at(const coord_def &c)
 {
     auto els = markers.equal_range(c);
@@ -1236,12 +1258,22 @@ vector<coord_def> find_marker_positions_by_prop(const string &prop,
                                                 unsigned maxresults)
 {
     vector<coord_def> marker_positions;
-    for (rectangle_iterator i(0, 0); i; ++i)
+    coord_def done(-1, -1);
+    for (map_marker *mark : env.markers.get_all_by_cell())
     {
-        const string value = env.markers.property_at(*i, MAT_ANY, prop);
-        if (!value.empty() && (expected.empty() || value == expected))
+        // As with property_at(), only the first marker in a cell with the
+        // property counts.
+        if (mark->pos == done)
+            continue;
+
+        const string value = mark->property(prop);
+        if (value.empty())
+            continue;
+
+        done = mark->pos;
+        if (expected.empty() || value == expected)
         {
-            marker_positions.push_back(*i);
+            marker_positions.push_back(mark->pos);
             if (maxresults && marker_positions.size() >= maxresults)
                 return marker_positions;
         }
@@ -1254,17 +1286,14 @@ vector<map_marker*> find_markers_by_prop(const string &prop,
                                          unsigned maxresults)
 {
     vector<map_marker*> markers;
-    for (rectangle_iterator pos(0, 0); pos; ++pos)
+    for (map_marker *mark : env.markers.get_all_by_cell())
     {
-        for (map_marker *mark : env.markers.get_markers_at(*pos))
+        const string value(mark->property(prop));
+        if (!value.empty() && (expected.empty() || value == expected))
         {
-            const string value(mark->property(prop));
-            if (!value.empty() && (expected.empty() || value == expected))
-            {
-                markers.push_back(mark);
-                if (maxresults && markers.size() >= maxresults)
-                    return markers;
-            }
+            markers.push_back(mark);
+            if (maxresults && markers.size() >= maxresults)
+                return markers;
         }
     }
     return markers;
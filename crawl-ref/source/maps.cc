@@ -15,6 +15,11 @@
 #ifndef TARGET_COMPILER_VC
 #include <unistd.h>
 #endif
+#ifdef UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "branch.h"
 #include "coord.h"
@@ -67,6 +72,9 @@ point_vector map_anchor_points;
 
 static map_vector vdefs;
 
+// Whether the selector index below needs rebuilding because vdefs changed.
+static bool map_index_stale = true;
+
 // Parameter array that vault code can use.
 string_vector map_parameters;
 
@@ -398,6 +406,16 @@ static bool _is_portal_place(const coord_def &c)
     return _marker_is_portal(env.markers.find(c, MAT_LUA_MARKER));
 }
 
+// Whether any square within one square of the rectangle of the given size
+// at c is part of a vault.
+static bool _vault_near_rect(const coord_def &c, const coord_def &size)
+{
+    for (rectangle_iterator ri(c - 1, c + size); ri; ++ri)
+        if (map_bounds(*ri) && (env.level_map_mask(*ri) & MMT_VAULT))
+            return true;
+    return false;
+}
+
 static bool _map_safe_vault_place(const map_def &map,
                                   const coord_def &c,
                                   const coord_def &size)
@@ -418,6 +436,14 @@ static bool _map_safe_vault_place(const map_def &map,
     const bool vault_can_replace_portals =
         map.has_tag("replace_portal");
 
+    // Most candidate places are nowhere near another vault, and one pass
+    // over the surrounding rectangle shows that much more cheaply than
+    // looking around each square in turn.
+    const bool check_adjacent_vaults =
+        !vault_can_overwrite_other_vaults && _vault_near_rect(c, size);
+
+    const bool in_slime = player_in_branch(BRANCH_SLIME);
+
     const vector<string> &lines = map.map.get_lines();
     for (rectangle_iterator ri(c, c + size - 1); ri; ++ri)
     {
@@ -435,7 +461,7 @@ static bool _map_safe_vault_place(const map_def &map,
         {
             // Also check adjacent squares for collisions, because being next
             // to another vault may block off one of this vault's exits.
-            for (adjacent_iterator ai(cp); ai; ++ai)
+            for (adjacent_iterator ai(cp); check_adjacent_vaults && ai; ++ai)
             {
                 if (map_bounds(*ai) && (env.level_map_mask(*ai) & MMT_VAULT))
                     return false;
@@ -461,7 +487,7 @@ static bool _map_safe_vault_place(const map_def &map,
 
         // If in Slime, don't let stairs end up next to minivaults,
         // so that they don't possibly end up next to unsafe walls.
-        if (player_in_branch(BRANCH_SLIME))
+        if (in_slime)
         {
             for (adjacent_iterator ai(cp); ai; ++ai)
             {
@@ -738,7 +764,7 @@ mapref_vector find_maps_for_tag(const string &tag,
 
 struct map_selector
 {
-private:
+public:
     enum select_type
     {
         PLACE,
@@ -747,7 +773,7 @@ private:
         TAG,
     };
 
-public:
+
     bool accept(const map_def &md) const;
     void announce(const map_def *map) const;
 
@@ -931,13 +957,108 @@ string vault_chance_tag(const map_def &map)
 
 typedef vector<unsigned> vault_indices;
 
+// Candidate maps for selectors, indexed by tag and by the branches their
+// DEPTH and PLACE ranges mention. Ranges given as absolute depths apply to
+// every branch and are kept separately. All lists are in ascending vdefs
+// order, so filtering a candidate list gives exactly what a scan over all
+// of vdefs would, in the same order.
+struct vault_selector_index
+{
+    map<string, vault_indices> by_tag;
+    vault_indices depth_by_branch[NUM_BRANCHES];
+    vault_indices depth_any_branch;
+    vault_indices place_by_branch[NUM_BRANCHES];
+    vault_indices place_any_branch;
+};
+
+static vault_selector_index vault_index;
+
+static void _index_vault(vault_indices &list, unsigned i)
+{
+    if (list.empty() || list.back() != i)
+        list.push_back(i);
+}
+
+static void _index_vault_ranges(const depth_ranges &ranges, unsigned i,
+                                vault_indices by_branch[],
+                                vault_indices &any_branch)
+{
+    for (const level_range &lr : ranges.ranges())
+    {
+        // A deny range alone never makes a map usable anywhere.
+        if (lr.deny)
+            continue;
+        if (lr.branch == NUM_BRANCHES)
+            _index_vault(any_branch, i);
+        else
+            _index_vault(by_branch[lr.branch], i);
+    }
+}
+
+static void _rebuild_vault_index()
+{
+    vault_index = vault_selector_index();
+
+    for (unsigned i = 0, size = vdefs.size(); i < size; ++i)
+    {
+        const map_def &mapdef = vdefs[i];
+        for (const string &tag : mapdef.get_tags())
+            _index_vault(vault_index.by_tag[tag], i);
+
+        _index_vault_ranges(mapdef.depths, i, vault_index.depth_by_branch,
+                            vault_index.depth_any_branch);
+        _index_vault_ranges(mapdef.place, i, vault_index.place_by_branch,
+                            vault_index.place_any_branch);
+    }
+
+    map_index_stale = false;
+}
+
+static vault_indices _merge_candidates(const vault_indices &a,
+                                       const vault_indices &b)
+{
+    vault_indices merged;
+    merged.reserve(a.size() + b.size());
+    set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(merged));
+    return merged;
+}
+
+// The maps a selector could possibly accept; a superset of the real answer.
+static vault_indices _candidate_maps_for_selector(const map_selector &sel)
+{
+    if (map_index_stale)
+        _rebuild_vault_index();
+
+    switch (sel.sel)
+    {
+    case map_selector::TAG:
+    {
+        // Every wanted tag must be present, so the first one will do.
+        const vector<string> wanted = split_string(" ", sel.tag);
+        if (wanted.empty())
+            return vault_indices();
+        auto it = vault_index.by_tag.find(wanted[0]);
+        return it == vault_index.by_tag.end() ? vault_indices() : it->second;
+    }
+    case map_selector::PLACE:
+        return _merge_candidates(vault_index.place_by_branch[sel.place.branch],
+                                 vault_index.place_any_branch);
+    case map_selector::DEPTH:
+    case map_selector::DEPTH_AND_CHANCE:
+        return _merge_candidates(vault_index.depth_by_branch[sel.place.branch],
+                                 vault_index.depth_any_branch);
+    default:
+        return vault_indices();
+    }
+}
+
 static vault_indices _eligible_maps_for_selector(const map_selector &sel)
 {
     vault_indices eligible;
 
     if (sel.valid())
     {
-        for (unsigned i = 0, size = vdefs.size(); i < size; ++i)
+        for (unsigned i : _candidate_maps_for_selector(sel))
             if (sel.accept(vdefs[i]))
                 eligible.push_back(i);
     }
@@ -1216,6 +1337,69 @@ string get_descache_path(const string &file, const string &ext)
     return _des_cache_dir(basename);
 }
 
+#ifdef UNIX
+struct des_cache_mapping : public mapped_des_cache
+{
+    des_cache_mapping(void *d, size_t s)
+    {
+        data = static_cast<const unsigned char *>(d);
+        size = s;
+    }
+    ~des_cache_mapping()
+    {
+        munmap(const_cast<unsigned char *>(data), size);
+    }
+};
+
+// .dsc caches mapped into memory, by base path. Map bodies are read straight
+// out of these by map_def::load(), so only the pages for maps actually used
+// are ever faulted in. Each mapping is taken under the cache lock right after
+// its index is read or written, and caches are rewritten by replacing the
+// file, so the offsets in our index always refer to the mapped copy.
+static map<string, unique_ptr<des_cache_mapping>> des_cache_maps;
+#endif
+
+static void _map_des_cache(const string &descache_base)
+{
+#ifdef UNIX
+    des_cache_maps.erase(descache_base);
+
+    const string file = descache_base + ".dsc";
+    const int fd = open_u(file.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+        return;
+
+    struct stat st;
+    if (!fstat(fd, &st) && st.st_size > 0)
+    {
+        void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            des_cache_maps[descache_base].reset(
+                new des_cache_mapping(data, st.st_size));
+        }
+    }
+    close(fd);
+#endif
+}
+
+/**
+ * Find the in-memory copy of a .dsc cache.
+ *
+ * @param descache_base The cache path without extension.
+ * @return The mapped cache, or nullptr if it isn't mapped (e.g. on platforms
+ *         without mmap), in which case the file must be read directly.
+ */
+const mapped_des_cache *find_mapped_des_cache(const string &descache_base)
+{
+#ifdef UNIX
+    auto it = des_cache_maps.find(descache_base);
+    if (it != des_cache_maps.end())
+        return it->second.get();
+#endif
+    return nullptr;
+}
+
 static bool verify_file_version(const string &file, time_t mtime)
 {
     FILE *fp = fopen_u(file.c_str(), "rb");
@@ -1299,6 +1483,7 @@ static bool _load_map_index(const string& cache, const string &base,
     const int nmaps = unmarshallShort(inf);
     const int nexist = vdefs.size();
     vdefs.resize(nexist + nmaps, map_def());
+    map_index_stale = true;
     for (int i = 0; i < nmaps; ++i)
     {
         map_def &vdef(vdefs[nexist + i]);
@@ -1333,7 +1518,11 @@ static bool _load_map_cache(const string &filename, const string &cachename)
         return false;
     }
 
-    return _load_map_index(cachename, descache_base, mtime);
+    if (!_load_map_index(cachename, descache_base, mtime))
+        return false;
+
+    _map_des_cache(descache_base);
+    return true;
 }
 
 static void _write_map_prelude(const string &filebase, time_t mtime)
@@ -1359,11 +1548,14 @@ static void _write_map_full(const string &filebase, size_t vs, size_t ve,
                             time_t mtime)
 {
     const string cfile = filebase + ".dsc";
-    FILE *fp = fopen_u(cfile.c_str(), "wb");
+    // Write a new file and move it into place rather than overwriting, since
+    // other processes may have the old one mapped.
+    const string tmpfile = cfile + ".tmp";
+    FILE *fp = fopen_u(tmpfile.c_str(), "wb");
     if (!fp)
-        end(1, true, "Unable to open %s for writing", cfile.c_str());
+        end(1, true, "Unable to open %s for writing", tmpfile.c_str());
 
-    writer outf(cfile, fp);
+    writer outf(tmpfile, fp);
     marshallUByte(outf, TAG_MAJOR_VERSION);
     marshallUByte(outf, TAG_MINOR_VERSION);
     marshallByte(outf, WORD_LEN);
@@ -1371,6 +1563,8 @@ static void _write_map_full(const string &filebase, size_t vs, size_t ve,
     for (size_t i = vs; i < ve; ++i)
         vdefs[i].write_full(outf);
     fclose(fp);
+    if (rename_u(tmpfile.c_str(), cfile.c_str()))
+        end(1, true, "Unable to replace %s", cfile.c_str());
 }
 
 static void _write_map_index(const string &filebase, size_t vs, size_t ve,
@@ -1410,6 +1604,7 @@ static void _write_map_cache(const string &filename, size_t vs, size_t ve,
     _write_map_prelude(descache_base, mtime);
     _write_map_full(descache_base, vs, ve, mtime);
     _write_map_index(descache_base, vs, ve, mtime);
+    _map_des_cache(descache_base);
 }
 
 static void _parse_maps(const string &s)
@@ -1483,6 +1678,7 @@ void reread_maps()
 
     // BOOM!
     vdefs.clear();
+    map_index_stale = true;
     map_files_read.clear();
     read_maps();
 }
@@ -1502,6 +1698,7 @@ void add_parsed_map(const map_def &md)
 
     map.fixup();
     vdefs.push_back(map);
+    map_index_stale = true;
 }
 
 void run_map_global_preludes()
@@ -1518,6 +1715,8 @@ void run_map_global_preludes()
 
 void run_map_local_preludes()
 {
+    // Preludes may touch the maps' tags.
+    map_index_stale = true;
     for (map_def &vdef : vdefs)
     {
         if (!vdef.prelude.empty())
@@ -60,6 +60,14 @@ void run_map_global_preludes();
 void run_map_local_preludes();
 string get_descache_path(const string &file, const string &ext);
 
+// A .dsc cache file mapped into memory; see find_mapped_des_cache().
+struct mapped_des_cache
+{
+    const unsigned char *data;
+    size_t size;
+};
+const mapped_des_cache *find_mapped_des_cache(const string &descache_base);
+
 typedef map<string, map_file_place> map_load_info_t;
 
 extern map_load_info_t lc_loaded_maps;
@@ -2139,10 +2139,13 @@ void melee_attack::apply_staff_damage()
 
         if (special_damage)
         {
-            special_damage_message =
-                make_stringf("%s %s electrocuted!",
-                             defender->name(DESC_THE).c_str(),
-                             defender->conj_verb("are").c_str());
+            if (needs_message)
+            {
+                special_damage_message =
+                    make_stringf("%s %s electrocuted!",
+                                 defender->name(DESC_THE).c_str(),
+                                 defender->conj_verb("are").c_str());
+            }
             special_damage_flavour = BEAM_ELECTRICITY;
         }
 
@@ -2156,12 +2159,15 @@ void melee_attack::apply_staff_damage()
 
         if (special_damage)
         {
-            special_damage_message =
-                make_stringf(
-                    "%s freeze%s %s!",
-                    attacker->name(DESC_THE).c_str(),
-                    attacker->is_player() ? "" : "s",
-                    defender->name(DESC_THE).c_str());
+            if (needs_message)
+            {
+                special_damage_message =
+                    make_stringf(
+                        "%s freeze%s %s!",
+                        attacker->name(DESC_THE).c_str(),
+                        attacker->is_player() ? "" : "s",
+                        defender->name(DESC_THE).c_str());
+            }
             special_damage_flavour = BEAM_COLD;
         }
         break;
@@ -2170,7 +2176,7 @@ void melee_attack::apply_staff_damage()
         special_damage = staff_damage(SK_EARTH_MAGIC);
         special_damage = apply_defender_ac(special_damage);
 
-        if (special_damage > 0)
+        if (special_damage > 0 && needs_message)
         {
             special_damage_message =
                 make_stringf(
@@ -2189,12 +2195,15 @@ void melee_attack::apply_staff_damage()
 
         if (special_damage)
         {
-            special_damage_message =
-                make_stringf(
-                    "%s burn%s %s!",
-                    attacker->name(DESC_THE).c_str(),
-                    attacker->is_player() ? "" : "s",
-                    defender->name(DESC_THE).c_str());
+            if (needs_message)
+            {
+                special_damage_message =
+                    make_stringf(
+                        "%s burn%s %s!",
+                        attacker->name(DESC_THE).c_str(),
+                        attacker->is_player() ? "" : "s",
+                        defender->name(DESC_THE).c_str());
+            }
             special_damage_flavour = BEAM_FIRE;
 
             if (defender->is_player())
@@ -2221,11 +2230,14 @@ void melee_attack::apply_staff_damage()
 
         if (special_damage)
         {
-            special_damage_message =
-                make_stringf(
-                    "%s %s in agony!",
-                    defender->name(DESC_THE).c_str(),
-                    defender->conj_verb("writhe").c_str());
+            if (needs_message)
+            {
+                special_damage_message =
+                    make_stringf(
+                        "%s %s in agony!",
+                        defender->name(DESC_THE).c_str(),
+                        defender->conj_verb("writhe").c_str());
+            }
 
             attacker->god_conduct(DID_EVIL, 4);
         }
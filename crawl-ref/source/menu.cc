@@ -1702,7 +1702,10 @@ void Menu::webtiles_write_menu(bool replace) const
     tiles.json_open_array("items");
 
     for (int i = start; i < end; ++i)
+    {
         webtiles_write_item(i, items[i]);
+        webtiles_mark_sent(i);
+    }
 
     tiles.json_close_array();
 
@@ -1740,7 +1743,10 @@ void Menu::webtiles_handle_item_request(int start, int end)
     tiles.json_open_array("items");
 
     for (int i = start; i <= end; ++i)
+    {
         webtiles_write_item(i, items[i]);
+        webtiles_mark_sent(i);
+    }
 
     tiles.json_close_array();
 
@@ -1757,11 +1763,51 @@ void Menu::webtiles_set_title(const formatted_string title_)
     }
 }
 
+void Menu::webtiles_mark_sent(int index) const
+{
+    if (index >= (int) _webtiles_items_sent.size())
+        _webtiles_items_sent.resize(index + 1, false);
+    _webtiles_items_sent[index] = true;
+}
+
+bool Menu::webtiles_was_sent(int index) const
+{
+    return index < (int) _webtiles_items_sent.size()
+           && _webtiles_items_sent[index];
+}
+
+/**
+ * Send clients the current text and colour of a range of items. For a long
+ * menu, only the items some client already has are sent, one message per
+ * run of them; formatting every item of a shop or a stash search on each
+ * redraw was most of the cost of a redraw. A menu small enough to have
+ * gone out whole is always sent whole, so items added to it show up.
+ */
 void Menu::webtiles_update_items(int start, int end) const
 {
     ASSERT_RANGE(start, 0, (int) items.size());
     ASSERT_RANGE(end, start, (int) items.size());
 
+    if ((int) items.size() <= chunk_size * 2)
+    {
+        webtiles_send_item_updates(start, end);
+        return;
+    }
+
+    for (int run_start = start; run_start <= end; ++run_start)
+    {
+        if (!webtiles_was_sent(run_start))
+            continue;
+        int run_end = run_start;
+        while (run_end < end && webtiles_was_sent(run_end + 1))
+            ++run_end;
+        webtiles_send_item_updates(run_start, run_end);
+        run_start = run_end;
+    }
+}
+
+void Menu::webtiles_send_item_updates(int start, int end) const
+{
     tiles.json_open_object();
 
     tiles.json_write_string("msg", "update_menu_items");
@@ -1782,6 +1828,7 @@ void Menu::webtiles_update_items(int start, int end) const
             tiles.json_write_int("colour", col);
         webtiles_write_tiles(*me);
         tiles.json_close_object();
+        webtiles_mark_sent(i);
     }
 
     tiles.json_close_array();
@@ -408,6 +408,7 @@ protected:
 
     void webtiles_write_tiles(const MenuEntry& me) const;
     void webtiles_update_items(int start, int end) const;
+    void webtiles_send_item_updates(int start, int end) const;
     void webtiles_update_item(int index) const;
     void webtiles_update_title() const;
     void webtiles_update_scroll_pos() const;
@@ -423,6 +424,12 @@ protected:
     bool _webtiles_title_changed;
     formatted_string _webtiles_title;
 
+    // Which items have gone out to any client. Updates skip the rest: a
+    // client asks for those as it scrolls to them.
+    mutable vector<bool> _webtiles_items_sent;
+    void webtiles_mark_sent(int index) const;
+    bool webtiles_was_sent(int index) const;
+
     inline int webtiles_section_start() const
     {
         return _webtiles_section_start == -1 ? 0 : _webtiles_section_start;
@@ -9,6 +9,7 @@
 
 #include <sstream>
 
+#include "alloc-tag.h"
 #include "areas.h"
 #include "colour.h"
 #include "delay.h"
@@ -66,9 +67,17 @@ struct message_particle
     string text;        /// text of message (tagged string...)
     int repeats;        /// Number of times the message is in succession (x2)
 
-    string pure_text() const
+    message_particle(string t, int reps)
+        : text(move(t)), repeats(reps),
+          pure(formatted_string::parse_string(text).tostring())
     {
-        return formatted_string::parse_string(text).tostring();
+    }
+
+    /// The text without its colour tags. Joining and condensing messages
+    /// asks for this over and over, so it is only worked out once.
+    const string &pure_text() const
+    {
+        return pure;
     }
 
     string with_repeats() const
@@ -96,6 +105,9 @@ struct message_particle
     {
         return repeats > 1 || !_ends_in_punctuation(pure_text());
     }
+
+private:
+    string pure;
 };
 
 struct message_line
@@ -318,7 +330,7 @@ public:
      * Append the contents of `buf` to the current buffer.
      * If `buf` has cycled, this will overwrite the entire contents of `this`.
      */
-    void append(const circ_vec<T, SIZE> buf)
+    void append(const circ_vec<T, SIZE> &buf)
     {
         const int buf_size = buf.filled_size();
         for (int i = 0; i < buf_size; i++)
@@ -757,7 +769,10 @@ public:
 
     void add(const message_line& msg)
     {
+        alloc_tag_scope tag(ALLOC_MESSAGES);
+#ifdef USE_SOUND
         string orig_full_text = msg.full_text();
+#endif
 
         if (!(msg.channel != MSGCH_PROMPT && prev_msg.merge(msg)))
         {
@@ -848,7 +863,7 @@ public:
         return msgs;
     }
 
-    void append_store(store_t store)
+    void append_store(const store_t &store)
     {
         msgs.append(store);
         const int msgs_to_print = store.filled_size();
@@ -1100,9 +1115,21 @@ int channel_to_colour(msg_channel_type channel, int param)
     return colour_msg(channel_to_msgcol(channel, param));
 }
 
+static void _debug_channel_arena(msg_channel_type channel);
+
 static void do_message_print(msg_channel_type channel, int param, bool cap,
                              bool nojoin, const char *format, va_list argp)
 {
+    // A muted arena message goes nowhere, so don't spend time formatting
+    // it. Errors and prompts still have work to do when muted.
+    if (suppress_messages && crawl_state.game_is_arena()
+        && _msg_dump_file == nullptr
+        && channel != MSGCH_ERROR && channel != MSGCH_PROMPT)
+    {
+        _debug_channel_arena(channel);
+        return;
+    }
+
     va_list ap;
     va_copy(ap, argp);
     char buff[200];
@@ -1386,8 +1413,12 @@ static void _mpr(string text, msg_channel_type channel, int param, bool nojoin,
 
     // Must do this before converting to formatted string and back;
     // that doesn't preserve close tags!
-    string col = colour_to_str(colour_msg(colour));
-    text = "<" + col + ">" + text + "</" + col + ">"; // XXX
+    const string col = colour_to_str(colour_msg(colour));
+    string tagged;
+    tagged.reserve(text.size() + 2 * col.size() + 5);
+    tagged.append("<").append(col).append(">").append(text)
+          .append("</").append(col).append(">"); // XXX
+    text = move(tagged);
 
     formatted_string fs = formatted_string::parse_string(text);
     if (you.duration[DUR_QUAD_DAMAGE])
@@ -1509,25 +1540,28 @@ static void mpr_check_patterns(const string& message,
                                msg_channel_type channel,
                                int param)
 {
-    for (const text_pattern &pat : Options.note_messages)
+    if (channel != MSGCH_EQUIPMENT && channel != MSGCH_FLOOR_ITEMS
+        && channel != MSGCH_MULTITURN_ACTION
+        && channel != MSGCH_EXAMINE && channel != MSGCH_EXAMINE_FILTER
+        && channel != MSGCH_TUTORIAL && channel != MSGCH_DGL_MESSAGE)
     {
-        if (channel == MSGCH_EQUIPMENT || channel == MSGCH_FLOOR_ITEMS
-            || channel == MSGCH_MULTITURN_ACTION
-            || channel == MSGCH_EXAMINE || channel == MSGCH_EXAMINE_FILTER
-            || channel == MSGCH_TUTORIAL || channel == MSGCH_DGL_MESSAGE)
+        for (const text_pattern &pat : Options.note_messages)
         {
-            continue;
-        }
-
-        if (pat.matches(message))
-        {
-            take_note(Note(NOTE_MESSAGE, channel, param, message));
-            break;
+            if (pat.matches(message))
+            {
+                take_note(Note(NOTE_MESSAGE, channel, param, message));
+                break;
+            }
         }
     }
 
-    if (channel != MSGCH_DIAGNOSTICS && channel != MSGCH_EQUIPMENT)
+    // A message can only interrupt a delay or a repeated command, so don't
+    // build the "channel:message" payload when neither is running.
+    if (channel != MSGCH_DIAGNOSTICS && channel != MSGCH_EQUIPMENT
+        && (you_are_delayed() || crawl_state.is_repeating_cmd()))
+    {
         interrupt_activity(AI_MESSAGE, channel_to_str(channel) + ":" + message);
+    }
 }
 
 static bool channel_message_history(msg_channel_type channel)
@@ -1898,7 +1932,7 @@ string get_last_messages(int mcount, bool full)
     mcount = min(mcount, NUM_STORED_MESSAGES);
     for (int i = -1; mcount > 0; --i)
     {
-        const message_line msg = msgs[i];
+        const message_line &msg = msgs[i];
         if (!msg)
             break;
         if (full || is_channel_dumpworthy(msg.channel))
@@ -1921,7 +1955,7 @@ void get_recent_messages(vector<string> &mess,
     int mcount = NUM_STORED_MESSAGES;
     for (int i = -1; mcount > 0; --i, --mcount)
     {
-        const message_line msg = msgs[i];
+        const message_line &msg = msgs[i];
         if (!msg)
             break;
         mess.push_back(msg.pure_text_with_repeats());
@@ -1929,13 +1963,14 @@ void get_recent_messages(vector<string> &mess,
     }
 }
 
-// We just write out the whole message store including empty/unused
-// messages. They'll be ignored when restoring.
 void save_messages(writer& outf)
 {
-    store_t msgs = buffer.get_store();
-    marshallInt(outf, msgs.size());
-    for (int i = 0; i < msgs.size(); ++i)
+    // Only the filled part of the buffer: load_messages() would skip the
+    // empty slots anyway.
+    const store_t& msgs = buffer.get_store();
+    const int filled = msgs.filled_size();
+    marshallInt(outf, filled);
+    for (int i = -filled; i < 0; ++i)
     {
         marshallString4(outf, msgs[i].full_text());
         marshallInt(outf, msgs[i].channel);
@@ -1981,7 +2016,7 @@ void replay_messages()
     formatted_scroller hist(MF_START_AT_END | MF_ALWAYS_SHOW_MORE, "");
     hist.set_more();
 
-    const store_t msgs = buffer.get_store();
+    const store_t& msgs = buffer.get_store();
     for (int i = 0; i < msgs.size(); ++i)
         if (channel_message_history(msgs[i].channel))
         {
@@ -2294,16 +2294,90 @@ static void _post_monster_move(monster* mons)
         monster_die(*mons, KILL_MISC, NON_MONSTER);
 }
 
-priority_queue<pair<monster *, int>,
-               vector<pair<monster *, int> >,
-               MonsterActionQueueCompare> monster_queue;
+// Monsters waiting to act, bucketed by their energy when they were queued.
+// speed_increment is saved as a byte and sanity-checked to stay below 200,
+// so a flat array of buckets covers every real value; anything higher
+// shares the top bucket. The most energetic monster acts first, and
+// monsters with equal energy act in the order they were queued, so the
+// order is deterministic regardless of the standard library in use.
+class monster_action_queue
+{
+public:
+    typedef pair<monster *, int> entry;
+
+    monster_action_queue() : top(-1), count(0) { }
+
+    bool empty() const
+    {
+        return !count;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    void push(monster *mons)
+    {
+        const int energy = mons->speed_increment;
+        const int b = max(0, min(energy, MAX_BUCKET));
+        buckets[b].entries.emplace_back(mons, energy);
+        top = max(top, b);
+        ++count;
+    }
+
+    const entry &front() const
+    {
+        ASSERT(count);
+        const bucket &bk = buckets[top];
+        return bk.entries[bk.head];
+    }
+
+    void pop()
+    {
+        ASSERT(count);
+        bucket &bk = buckets[top];
+        if (++bk.head == bk.entries.size())
+        {
+            bk.entries.clear();
+            bk.head = 0;
+        }
+        --count;
+        while (top >= 0 && buckets[top].entries.empty())
+            --top;
+    }
+
+private:
+    static const int MAX_BUCKET = 255;
+
+    struct bucket
+    {
+        bucket() : head(0) { }
+        // A FIFO: entries before head have already been popped.
+        vector<entry> entries;
+        size_t head;
+    };
+
+    bucket buckets[MAX_BUCKET + 1];
+    int top;
+    int count;
+};
+
+static monster_action_queue monster_queue;
+static monster_turn_stats turn_stats;
 
 // Inserts a monster into the monster queue (needed to ensure that any monsters
 // given energy or an action by a effect can actually make use of that energy
 // this round)
 void queue_monster_for_action(monster* mons)
 {
-    monster_queue.emplace(mons, mons->speed_increment);
+    monster_queue.push(mons);
+    turn_stats.requeues++;
+}
+
+const monster_turn_stats& get_monster_turn_stats()
+{
+    return turn_stats;
 }
 
 static void _clear_monster_flags()
@@ -2312,7 +2386,7 @@ static void _clear_monster_flags()
     // monsters get their actions in the next round.
     // Also clear one-turn deep sleep flag.
     // XXX: MF_JUST_SLEPT only really works for player-cast hibernation.
-    for (auto &mons : menv_real)
+    for (auto &mons : menv_used)
         mons.flags &= ~MF_JUST_SUMMONED & ~MF_JUST_SLEPT;
 }
 
@@ -2339,11 +2413,15 @@ static void _update_monster_attitude(monster *mon)
  */
 void handle_monsters(bool with_noise)
 {
+    turn_stats = monster_turn_stats();
+
     for (monster_iterator mi; mi; ++mi)
     {
         _pre_monster_move(**mi);
         if (!invalid_monster(*mi) && mi->alive() && mi->has_action_energy())
-            monster_queue.emplace(*mi, mi->speed_increment);
+            monster_queue.push(*mi);
+        else
+            turn_stats.idle++;
     }
 
     int tries = 0; // infinite loop protection, shouldn't be ever needed
@@ -2352,12 +2430,12 @@ void handle_monsters(bool with_noise)
         if (tries++ > 32767)
         {
             die("infinite handle_monsters() loop, mons[0 of %d] is %s",
-                (int)monster_queue.size(),
-                monster_queue.top().first->name(DESC_PLAIN, true).c_str());
+                monster_queue.size(),
+                monster_queue.front().first->name(DESC_PLAIN, true).c_str());
         }
 
-        monster *mon = monster_queue.top().first;
-        const int oldspeed = monster_queue.top().second;
+        monster *mon = monster_queue.front().first;
+        const int oldspeed = monster_queue.front().second;
         monster_queue.pop();
 
         if (invalid_monster(mon) || !mon->alive() || !mon->has_action_energy())
@@ -2371,13 +2449,21 @@ void handle_monsters(bool with_noise)
         // the queue just after this.
         if (oldspeed == mon->speed_increment)
         {
+            const monster_type type = mon->type;
+            const auto start = chrono::steady_clock::now();
+
             handle_monster_move(mon);
             _post_monster_move(mon);
             fire_final_effects();
+
+            turn_stats.actions++;
+            turn_stats.time_by_type[type] +=
+                chrono::duration_cast<chrono::microseconds>(
+                    chrono::steady_clock::now() - start).count();
         }
 
         if (mon->has_action_energy())
-            monster_queue.emplace(mon, mon->speed_increment);
+            queue_monster_for_action(mon);
 
         // If the player got banished, discard pending monster actions.
         if (you.banished)
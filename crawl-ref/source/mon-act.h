@@ -7,15 +7,6 @@
 
 struct bolt;
 
-class MonsterActionQueueCompare
-{
-public:
-    bool operator() (pair<monster*, int> m1, pair<monster*, int> m2)
-    {
-        return m1.second < m2.second;
-    }
-};
-
 bool mon_can_move_to_pos(const monster* mons, const coord_def& delta,
                          bool just_check = false);
 bool mons_can_move_towards_target(const monster* mon);
@@ -29,4 +20,16 @@ void handle_monster_move(monster* mon);
 
 void queue_monster_for_action(monster* mons);
 
+// What handle_monsters() did during its most recent call.
+struct monster_turn_stats
+{
+    int actions = 0;  // monster moves taken
+    int requeues = 0; // entries pushed back after acting or being queued
+    int idle = 0;     // monsters that had no energy to act at all
+    // Time spent in monster moves, in microseconds, by monster type.
+    map<monster_type, int64_t> time_by_type;
+};
+
+const monster_turn_stats& get_monster_turn_stats();
+
 #define ENERGY_SUBMERGE(entry) (max(entry->energy_usage.swim / 2, 1))
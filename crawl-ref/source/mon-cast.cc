@@ -2311,12 +2311,13 @@ static vector<coord_def> _get_push_spaces_max_tension(const coord_def& pos,
     actor *act = actor_at(pos);
     ASSERT(act);
 
+    // Every candidate is tried with the same door shut.
+    set<coord_def> all_door;
+    find_connected_identical(pos, all_door);
+    const dungeon_feature_type old_feat = grd(pos);
+
     for (auto c : possible_spaces)
     {
-        set<coord_def> all_door;
-        find_connected_identical(pos, all_door);
-        dungeon_feature_type old_feat = grd(pos);
-
         act->move_to_pos(c);
         _set_door(all_door, DNGN_CLOSED_DOOR);
         int new_tension = get_tension(GOD_NO_GOD);
@@ -4049,6 +4050,10 @@ bool handle_mon_spell(monster* mons)
         return false;
     }
 
+    // Weighing up spells and targets, then announcing the cast, can trace
+    // the same beam several times over.
+    tracer_memo_scope tracer_memo;
+
     const monster_spells hspell_pass = _find_usable_spells(*mons);
 
     // If no useful spells... cast no spell.
@@ -6533,7 +6538,7 @@ void mons_cast(monster* mons, bolt pbolt, spell_type spell_cast,
             simple_monster_message(*mons, " radiates an aura of cold.");
         else if (mons->see_cell_no_trans(you.pos()))
             mpr("A wave of cold passes over you.");
-        apply_area_visible([splpow, mons] (coord_def where) {
+        apply_area_visible_actors([splpow, mons] (coord_def where) {
             return englaciate(where, min(splpow, 200), mons);
         }, mons->pos());
         return;
@@ -2059,14 +2059,18 @@ void monster::apply_enchantments()
 
     // We process an enchantment only if it existed both at the start of this
     // function and when getting to it in order; any enchantment can add, modify
-    // or remove others -- or even itself.
-    FixedBitVector<NUM_ENCHANTMENTS> ec = ench_cache;
+    // or remove others -- or even itself. The list is keyed by type, so a
+    // copy of its keys gives that order without testing every type there is.
+    enchant_type present[NUM_ENCHANTMENTS];
+    int num_present = 0;
+    for (const auto &entry : enchantments)
+        present[num_present++] = entry.first;
 
     // The ordering in enchant_type makes sure that "super-enchantments"
     // like berserk time out before their parts.
-    for (int i = 0; i < NUM_ENCHANTMENTS; ++i)
-        if (ec[i] && has_ench(static_cast<enchant_type>(i)))
-            apply_enchantment(enchantments.find(static_cast<enchant_type>(i))->second);
+    for (int i = 0; i < num_present; ++i)
+        if (has_ench(present[i]))
+            apply_enchantment(enchantments.find(present[i])->second);
 }
 
 // Used to adjust time durations in calc_duration() for monster speed.
@@ -15,7 +15,6 @@
 #include "item-prop.h"
 #include "item-status-flag-type.h"
 #include "items.h"
-#include "libutil.h" // map_find
 #include "mon-place.h"
 #include "randbook.h" // roxanne, roxanne...
 #include "religion.h" // upgrade_hepliaklqana_weapon
@@ -285,6 +284,22 @@ static bool _apply_weapon_spec(const mon_weapon_spec &spec, item_def &item,
     return true;
 }
 
+/**
+ * Index a table of weapon specs by monster type.
+ *
+ * @param specs     The weapon specs for each monster type that has one.
+ * @return          A pointer into specs for each monster type, or nullptr for
+ *                  those without a spec.
+ */
+static vector<const mon_weapon_spec *>
+_index_weapon_specs(const map<monster_type, mon_weapon_spec> &specs)
+{
+    vector<const mon_weapon_spec *> index(NUM_MONSTERS, nullptr);
+    for (const auto &entry : specs)
+        index[entry.first] = &entry.second;
+    return index;
+}
+
 /**
  * Make a weapon for the given monster.
  *
@@ -986,17 +1001,22 @@ int make_mons_weapon(monster_type type, int level, bool melee_only)
     item.base_type = OBJ_UNASSIGNED;
     item.quantity = 1;
 
+    // Every monster placed comes through here, so look the specs up by
+    // index rather than searching both maps each time.
+    static const vector<const mon_weapon_spec *> primary_index
+        = _index_weapon_specs(primary_weapon_specs);
+    static const vector<const mon_weapon_spec *> secondary_index
+        = _index_weapon_specs(secondary_weapon_specs);
+
     // do we have a secondary weapon to give the monster? (usually ranged)
-    const mon_weapon_spec *secondary_spec = map_find(secondary_weapon_specs,
-                                                     type);
+    const mon_weapon_spec *secondary_spec = secondary_index[type];
     if (!secondary_spec || melee_only ||
         !_apply_weapon_spec(*secondary_spec, item, force_item, level))
     {
         // either we're just giving only giving out primary weapons in this
         // call, or we didn't find a secondary weapon to give. either way,
         // try to give the monster a primary weapon. (may be its second!)
-        const mon_weapon_spec *primary_spec = map_find(primary_weapon_specs,
-                                                       type);
+        const mon_weapon_spec *primary_spec = primary_index[type];
         if (primary_spec)
             _apply_weapon_spec(*primary_spec, item, force_item, level);
     }
@@ -1804,6 +1804,49 @@ bool monster_info::debuffable() const
                   { return this->has_trivial_ench(ench); });
 }
 
+static map<mid_t, monster_info> _moninfo_cache;
+static int _moninfo_cache_depth = 0;
+
+monster_info_cache_scope::monster_info_cache_scope()
+{
+    if (!_moninfo_cache_depth++)
+        _moninfo_cache.clear();
+}
+
+monster_info_cache_scope::~monster_info_cache_scope()
+{
+    if (!--_moninfo_cache_depth)
+        _moninfo_cache.clear();
+}
+
+/**
+ * The full monster_info for m. Inside a monster_info_cache_scope this is
+ * shared by every caller; otherwise it is only good until the next call.
+ */
+const monster_info &cached_monster_info(const monster* m)
+{
+    if (!_moninfo_cache_depth)
+    {
+        static monster_info uncached;
+        uncached = monster_info(m);
+        return uncached;
+    }
+
+    auto it = _moninfo_cache.find(m->mid);
+    // Map knowledge hands out client ids as it goes, so a snapshot taken
+    // before the monster had one needs replacing.
+    if (it != _moninfo_cache.end()
+        && (it->second.pos != m->pos()
+            || it->second.client_id != m->get_client_id()))
+    {
+        _moninfo_cache.erase(it);
+        it = _moninfo_cache.end();
+    }
+    if (it == _moninfo_cache.end())
+        it = _moninfo_cache.emplace(m->mid, monster_info(m)).first;
+    return it->second;
+}
+
 void get_monster_info(vector<monster_info>& mons)
 {
     vector<monster* > visible;
@@ -1820,7 +1863,7 @@ void get_monster_info(vector<monster_info>& mons)
         if (mons_is_threatening(*mon)
             || mon->is_child_tentacle())
         {
-            mons.emplace_back(mon);
+            mons.push_back(cached_monster_info(mon));
         }
     }
     sort(mons.begin(), mons.end(), monster_info::less_than_wrapper);
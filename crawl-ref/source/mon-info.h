@@ -260,6 +260,11 @@ struct monster_info : public monster_info_base
         return *this;
     }
 
+    // Sorting the monster list moves these around a lot; without these
+    // every swap would deep-copy the names, props and equipment.
+    monster_info(monster_info&& mi) = default;
+    monster_info& operator=(monster_info&& mi) = default;
+
     void to_string(int count, string& desc, int& desc_colour,
                    bool fullname = true, const char *adjective = nullptr) const;
 
@@ -385,4 +390,15 @@ void clear_monster_list_colours();
 
 void get_monster_info(vector<monster_info>& mons);
 
+// While one of these is alive, cached_monster_info() builds each monster's
+// snapshot only once. A redraw makes several from monsters that can't
+// change under it: for map knowledge, the monster list and the tiles.
+class monster_info_cache_scope
+{
+public:
+    monster_info_cache_scope();
+    ~monster_info_cache_scope();
+};
+const monster_info &cached_monster_info(const monster* m);
+
 typedef function<vector<string> (const monster_info& mi)> (desc_filter);
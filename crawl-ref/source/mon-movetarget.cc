@@ -220,6 +220,19 @@ bool try_pathfind(monster* mon)
          mon->name(DESC_PLAIN).c_str(), mon->pos().x, mon->pos().y,
          targpos.x, targpos.y, range);
 #endif
+    // If other monsters are after the same target, share their search.
+    if (pathfield_waypoints(mon, targpos, range, mon->travel_path))
+    {
+        if (!mon->travel_path.empty())
+        {
+            mon->target = mon->travel_path[0];
+            mon->travel_target = MTRAV_FOE;
+            return true;
+        }
+        _set_no_path_found(mon);
+        return false;
+    }
+
     monster_pathfind mp;
     if (range > 0)
         mp.set_range(range);
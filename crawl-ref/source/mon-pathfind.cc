@@ -7,6 +7,7 @@
 #include "los.h"
 #include "mon-movetarget.h"
 #include "mon-place.h"
+#include "mon-tentacle.h"
 #include "religion.h"
 #include "state.h"
 #include "terrain.h"
@@ -18,13 +19,13 @@
 // The pathfinding is an implementation of the A* algorithm. Beginning at the
 // monster position we check all neighbours of a given grid, estimate the
 // distance needed for any shortest path including this grid and push the
-// result into a hash. We can then easily access all points with the shortest
-// distance estimates and then check _their_ neighbours and so on.
+// result into a bucketed open list. We can then easily access all points with
+// the shortest distance estimates and then check _their_ neighbours and so on.
 // The algorithm terminates once we reach the destination since - because
-// of the sorting of grids by shortest distance in the hash - there can be no
+// of the sorting of grids by shortest distance in the buckets - there can be no
 // path between start and target that is shorter than the current one. There
 // could be other paths that have the same length but that has no real impact.
-// If the hash has been cleared and the start grid has not been encountered,
+// If the buckets have been emptied and the start grid has not been encountered,
 // then there's no path that matches the requirements fed into monster_pathfind.
 // (These requirements are usually preference of habitat of a specific monster
 // or a limit of the distance between start and any grid on the path.)
@@ -64,16 +65,176 @@ int mons_tracking_range(const monster* mon)
     return range;
 }
 
+// Scratch space for a single search. A cell's dist and prev entries, and a
+// bucket's head, are only meaningful if their stamp matches the current
+// generation, so starting a new search is a matter of bumping it.
+//
+// The open list is a set of buckets indexed by estimated total path length,
+// each an intrusive doubly-linked list threaded through the cells, so that
+// adding, removing and re-bucketing a cell never allocates.
+#define PATHFIND_CELLS (GXM * GYM)
+#define PATHFIND_NONE (-1)
+
+struct pathfind_grids
+{
+    pathfind_grids() : generation(0)
+    {
+        clear_stamps();
+    }
+
+    void reset()
+    {
+        if (++generation == 0)
+        {
+            // Wrapped around; old stamps could look current again.
+            clear_stamps();
+            generation = 1;
+        }
+    }
+
+    int dist(const coord_def &p) const
+    {
+        const int c = _cell(p);
+        return cell_stamp[c] == generation ? cell_dist[c] : INFINITE_DISTANCE;
+    }
+
+    void set_dist(const coord_def &p, int d)
+    {
+        const int c = _cell(p);
+        if (cell_stamp[c] != generation)
+        {
+            cell_stamp[c] = generation;
+            cell_prev[c] = 0;
+            cell_open[c] = false;
+        }
+        cell_dist[c] = d;
+    }
+
+    int prev(const coord_def &p) const
+    {
+        const int c = _cell(p);
+        return cell_stamp[c] == generation ? cell_prev[c] : 0;
+    }
+
+    void set_prev(const coord_def &p, int dir)
+    {
+        cell_prev[_cell(p)] = dir;
+    }
+
+    bool bucket_empty(int total) const
+    {
+        return _head(total) == PATHFIND_NONE;
+    }
+
+    // Buckets are LIFO: the most recently pushed cell is the most likely to
+    // be close to the target.
+    void push(const coord_def &p, int total)
+    {
+        ASSERT(total >= 0 && total < PATHFIND_CELLS);
+        const int c = _cell(p);
+        const int head = _head(total);
+        link_prev[c] = PATHFIND_NONE;
+        link_next[c] = head;
+        if (head != PATHFIND_NONE)
+            link_prev[head] = c;
+        bucket_stamp[total] = generation;
+        bucket_head[total] = c;
+        cell_open[c] = true;
+    }
+
+    coord_def pop(int total)
+    {
+        const int c = _head(total);
+        ASSERT(c != PATHFIND_NONE);
+        _unlink(c, total);
+        return coord_def(c / GYM, c % GYM);
+    }
+
+    // Remove p from its bucket, if it is still in the open list.
+    void remove(const coord_def &p, int total)
+    {
+        const int c = _cell(p);
+        if (cell_stamp[c] == generation && cell_open[c])
+            _unlink(c, total);
+    }
+
+private:
+    static int _cell(const coord_def &p)
+    {
+        return p.x * GYM + p.y;
+    }
+
+    int _head(int total) const
+    {
+        return bucket_stamp[total] == generation ? bucket_head[total]
+                                                 : PATHFIND_NONE;
+    }
+
+    void _unlink(int c, int total)
+    {
+        const int p = link_prev[c], n = link_next[c];
+        if (p != PATHFIND_NONE)
+            link_next[p] = n;
+        else
+            bucket_head[total] = n;
+        if (n != PATHFIND_NONE)
+            link_prev[n] = p;
+        cell_open[c] = false;
+    }
+
+    void clear_stamps()
+    {
+        memset(cell_stamp, 0, sizeof(cell_stamp));
+        memset(bucket_stamp, 0, sizeof(bucket_stamp));
+    }
+
+    uint32_t generation;
+
+    uint32_t cell_stamp[PATHFIND_CELLS];
+    int cell_dist[PATHFIND_CELLS];
+    int8_t cell_prev[PATHFIND_CELLS];
+    bool cell_open[PATHFIND_CELLS];
+    int16_t link_prev[PATHFIND_CELLS];
+    int16_t link_next[PATHFIND_CELLS];
+
+    uint32_t bucket_stamp[PATHFIND_CELLS];
+    int16_t bucket_head[PATHFIND_CELLS];
+};
+
+COMPILE_CHECK(PATHFIND_CELLS <= INT16_MAX);
+
+// Grids not currently borrowed by a monster_pathfind. Pathfinders are
+// created constantly (several per monster per turn), but rarely more than
+// one or two are alive at a time, so this stays small.
+static thread_local vector<unique_ptr<pathfind_grids>> free_grids;
+
+static pathfind_grids *_borrow_grids()
+{
+    if (free_grids.empty())
+        return new pathfind_grids;
+
+    pathfind_grids *grids = free_grids.back().release();
+    free_grids.pop_back();
+    return grids;
+}
+
+static void _return_grids(pathfind_grids *grids)
+{
+    free_grids.emplace_back(grids);
+}
+
 //#define DEBUG_PATHFIND
 monster_pathfind::monster_pathfind()
     : mons(nullptr), start(), target(), pos(), allow_diagonals(true),
       traverse_unmapped(false), range(0), min_length(0), max_length(0),
-      dist(), prev(), hash()
+      grids(_borrow_grids())
 {
+    grids->reset();
 }
 
 monster_pathfind::~monster_pathfind()
 {
+    _return_grids(grids);
 }
 
 void monster_pathfind::set_range(int r)
@@ -84,7 +245,7 @@ void monster_pathfind::set_range(int r)
 
 coord_def monster_pathfind::next_pos(const coord_def &c) const
 {
-    return c + Compass[prev[c.x][c.y]];
+    return c + Compass[grids->prev(c)];
 }
 
 // The main method in the monster_pathfind class.
@@ -140,17 +301,15 @@ bool monster_pathfind::start_pathfind(bool msg)
     //       a wall.
 
     max_length = min_length = grid_distance(pos, target);
-    for (int i = 0; i < GXM; i++)
-        for (int j = 0; j < GYM; j++)
-            dist[i][j] = INFINITE_DISTANCE;
-
-    dist[pos.x][pos.y] = 0;
+    grids->reset();
+    grids->set_dist(pos, 0);
 
     bool success = false;
     do
     {
         // Calculate the distance to all neighbours of the current position,
-        // and add them to the hash, if they haven't already been looked at.
+        // and add them to the open list, if they haven't already been looked
+        // at.
         success = calc_path_to_neighbours();
         if (success)
             return true;
@@ -214,8 +373,8 @@ bool monster_pathfind::calc_path_to_neighbours()
         if (range && estimated_cost(npos) > range)
             continue;
 
-        distance = dist[pos.x][pos.y] + travel_cost(npos);
-        old_dist = dist[npos.x][npos.y];
+        distance = grids->dist(pos) + travel_cost(npos);
+        old_dist = grids->dist(npos);
 
         // Also bail out if this would make the path longer than twice the
         // allowed distance from the target. (This factor may need tuning.)
@@ -239,7 +398,7 @@ bool monster_pathfind::calc_path_to_neighbours()
             if (old_dist == INFINITE_DISTANCE)
             {
 #ifdef DEBUG_PATHFIND
-                mprf("Adding (%d,%d) to hash (total dist = %d)",
+                mprf("Adding (%d,%d) to open list (total dist = %d)",
                      npos.x, npos.y, total);
 #endif
                 add_new_pos(npos, total);
@@ -257,7 +416,7 @@ bool monster_pathfind::calc_path_to_neighbours()
             }
 
             // Update distance start->pos.
-            dist[npos.x][npos.y] = distance;
+            grids->set_dist(npos, distance);
 
             // Set backtracking information.
             // Converts the Compass direction to its counterpart.
@@ -265,7 +424,7 @@ bool monster_pathfind::calc_path_to_neighbours()
             //      7  .  3   ==>   3  .  7       e.g. (3 + 4) % 8          = 7
             //      6  5  4         2  1  0            (7 + 4) % 8 = 11 % 8 = 3
 
-            prev[npos.x][npos.y] = (dir + 4) % 8;
+            grids->set_prev(npos, (dir + 4) % 8);
 
             // Are we finished?
             if (npos == target)
@@ -281,22 +440,20 @@ bool monster_pathfind::calc_path_to_neighbours()
 }
 
 // Starting at known min_length (minimum total estimated path distance), check
-// the hash for existing vectors, then pick the last entry of the first vector
-// that matches. Update min_length, if necessary.
+// the open list for non-empty buckets, then pick the last entry of the first
+// bucket that matches. Update min_length, if necessary.
 bool monster_pathfind::get_best_position()
 {
     for (int i = min_length; i <= max_length; i++)
     {
-        if (!hash[i].empty())
+        if (!grids->bucket_empty(i))
         {
             if (i > min_length)
                 min_length = i;
 
-            vector<coord_def> &vec = hash[i];
-            // Pick the last position pushed into the vector as it's most
+            // Pick the last position pushed into the bucket as it's most
             // likely to be close to the target.
-            pos = vec[vec.size()-1];
-            vec.pop_back();
+            pos = grids->pop(i);
 
 #ifdef DEBUG_PATHFIND
             mprf("Returning (%d, %d) as best pos with total dist %d.",
@@ -331,14 +488,16 @@ vector<coord_def> monster_pathfind::backtrack()
     int dir;
     do
     {
-        dir = prev[pos.x][pos.y];
+        dir = grids->prev(pos);
         pos = pos + Compass[dir];
         ASSERT_IN_BOUNDS(pos);
 #ifdef DEBUG_PATHFIND
         mprf("prev: (%d, %d), pos: (%d, %d)", Compass[dir].x, Compass[dir].y,
                                               pos.x, pos.y);
 #endif
-        path.insert(path.begin(), pos);
+        // Built target-first and reversed at the end, rather than inserting
+        // at the front and shifting the whole path at every step.
+        path.push_back(pos);
 
         if (pos.origin())
             break;
@@ -346,6 +505,7 @@ vector<coord_def> monster_pathfind::backtrack()
     while (pos != start);
     ASSERT(pos == start);
 
+    reverse(path.begin(), path.end());
     return path;
 }
 
@@ -450,10 +610,8 @@ int monster_pathfind::travel_cost(coord_def npos)
 
 // Assumes that grids that really cannot be entered don't even get here.
 // (Checked by traversable().)
-int monster_pathfind::mons_travel_cost(coord_def npos)
+static int _mons_travel_cost(const monster* mons, coord_def npos)
 {
-    ASSERT(grid_distance(pos, npos) <= 1);
-
     // Doors need to be opened.
     if (feat_is_closed_door(grd(npos)))
         return 2;
@@ -489,6 +647,13 @@ int monster_pathfind::mons_travel_cost(coord_def npos)
     return 1;
 }
 
+int monster_pathfind::mons_travel_cost(coord_def npos)
+{
+    ASSERT(grid_distance(pos, npos) <= 1);
+
+    return _mons_travel_cost(mons, npos);
+}
+
 // The estimated cost to reach a grid is simply max(dx, dy).
 int monster_pathfind::estimated_cost(coord_def p)
 {
@@ -497,24 +662,305 @@ int monster_pathfind::estimated_cost(coord_def p)
 
 void monster_pathfind::add_new_pos(coord_def npos, int total)
 {
-    hash[total].push_back(npos);
+    grids->push(npos, total);
 }
 
 void monster_pathfind::update_pos(coord_def npos, int total)
 {
-    // Find hash position of old distance and delete it,
-    // then call_add_new_pos.
-    int old_total = dist[npos.x][npos.y] + estimated_cost(npos);
+    // Find the bucket of the old distance and remove it from there,
+    // then call add_new_pos.
+    int old_total = grids->dist(npos) + estimated_cost(npos);
+
+    grids->remove(npos, old_total);
+
+    add_new_pos(npos, total);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Shared distance fields
+//
+// When several monsters are tracking the same target, running A* for each of
+// them repeats the same work. Instead, the second request in a turn for a
+// given target and kind of mover builds a reverse Dijkstra field from the
+// target, after which every such monster can read its next step in O(1).
+//
+// Monsters are considered to move alike if they share a movement habitat,
+// flight, door handling and trap knowledge; the field is laid out using the
+// rules of whichever monster triggered the build. Movers with unusual rules
+// (wall clingers, tentacles, friendly summons staying in sight, and a few
+// special cases in monster_pathfind::traversable()) always use A*.
+
+// Costs are between 1 and 3, so four buckets suffice for Dial's algorithm.
+#define PATHFIELD_BUCKETS 4
+#define PATHFIELD_CACHE_SIZE 8
+#define PATHFIELD_NO_STEP (-1)
+
+struct pathfield_key
+{
+    coord_def target;
+    habitat_type habitat;
+    bool airborne;
+    bool doors;
+    bool friendly;
+    bool wont_attack;
+    int intel;
+    bool native;
+
+    bool operator==(const pathfield_key &other) const
+    {
+        return target == other.target && habitat == other.habitat
+               && airborne == other.airborne && doors == other.doors
+               && friendly == other.friendly
+               && wont_attack == other.wont_attack
+               && intel == other.intel && native == other.native;
+    }
+};
+
+struct pathfield
+{
+    pathfield_key key;
+    level_id place;
+    int stamp;
+    bool built;
+    int last_used;
+
+    FixedArray<int, GXM, GYM> dist;
+    // The Compass index of the next step towards the target.
+    FixedArray<int8_t, GXM, GYM> step;
+};
+
+static vector<unique_ptr<pathfield>> pathfields;
+static int pathfield_clock = 0;
+static pathfield_stats pf_stats;
+
+static bool _pathfield_eligible(const monster* mons)
+{
+    if (mons->can_cling_to_walls()
+        || mons_is_tentacle_or_tentacle_segment(mons->type)
+        || mons->type == MONS_KRAKEN
+        || mons->type == MONS_THORN_HUNTER
+        || mons->type == MONS_WANDERING_MUSHROOM)
+    {
+        return false;
+    }
+
+    // As in monster_pathfind::init_pathfind().
+    return crawl_state.game_is_arena() || !mons->friendly()
+           || !mons->is_summoned() || !you.see_cell_no_trans(mons->pos());
+}
+
+static pathfield_key _pathfield_key(const monster* mons, coord_def target)
+{
+    pathfield_key key;
+    key.target      = target;
+    key.habitat     = mons_habitat(*mons, true);
+    key.airborne    = mons->airborne();
+    key.doors       = mons_itemuse(*mons) >= MONUSE_OPEN_DOORS
+                      || mons_eats_items(*mons)
+                      || mons_class_flag(mons_base_type(*mons), M_EAT_DOORS)
+                      || mons_class_flag(mons_base_type(*mons), M_CRASH_DOORS);
+    key.friendly    = mons->friendly();
+    key.wont_attack = mons->wont_attack();
+    key.intel       = mons_intel(*mons);
+    key.native      = mons_is_native_in_branch(*mons);
+    return key;
+}
+
+// The equivalent of monster_pathfind::traversable() for eligible monsters
+// with traverse_unmapped unset.
+static bool _pathfield_traversable(const monster* mons, const coord_def& p)
+{
+    if (grd(p) == DNGN_UNSEEN)
+        return false;
+
+    if (opc_immob(p) == OPC_OPAQUE
+        && grd(p) != DNGN_CLOSED_DOOR && grd(p) != DNGN_SEALED_DOOR)
+    {
+        return false;
+    }
+
+    return mons_can_traverse(*mons, p);
+}
+
+static void _build_pathfield(pathfield &field, const monster* mons)
+{
+    const coord_def target = field.key.target;
+
+    field.dist.init(INFINITE_DISTANCE);
+    field.step.init(PATHFIELD_NO_STEP);
+    field.dist(target) = 0;
+
+    vector<coord_def> buckets[PATHFIELD_BUCKETS];
+    buckets[0].push_back(target);
+    int pending = 1;
 
-    vector<coord_def> &vec = hash[old_total];
-    for (unsigned int i = 0; i < vec.size(); i++)
+    for (int d = 0; pending; ++d)
     {
-        if (vec[i] == npos)
+        vector<coord_def> &bucket = buckets[d % PATHFIELD_BUCKETS];
+        while (!bucket.empty())
         {
-            vec.erase(vec.begin() + i);
-            break;
+            const coord_def b = bucket.back();
+            bucket.pop_back();
+            --pending;
+
+            // Stale entry, or a cell that can be stepped off but not onto
+            // (such as a monster's starting position in a wall).
+            if (field.dist(b) != d
+                || b != target && !_pathfield_traversable(mons, b))
+            {
+                continue;
+            }
+
+            // As with A*, entering the target carries its usual cost, but
+            // its traversability is never checked.
+            const int total = d + _mons_travel_cost(mons, b);
+            for (int dir = 0; dir < 8; ++dir)
+            {
+                const coord_def a = b - Compass[dir];
+                if (!in_bounds(a))
+                    continue;
+
+                int &old = field.dist(a);
+                // On ties, prefer orthogonal steps to reduce zigzagging.
+                if (total < old
+                    || total == old && !(dir % 2) && field.step(a) % 2)
+                {
+                    if (total < old)
+                    {
+                        buckets[total % PATHFIELD_BUCKETS].push_back(a);
+                        ++pending;
+                    }
+                    old = total;
+                    field.step(a) = dir;
+                }
+            }
         }
     }
 
-    add_new_pos(npos, total);
+    field.built = true;
+    pf_stats.builds++;
+}
+
+static pathfield *_find_pathfield(const monster* mons, coord_def target)
+{
+    if (!_pathfield_eligible(mons))
+        return nullptr;
+
+    const pathfield_key key = _pathfield_key(mons, target);
+    const level_id place = level_id::current();
+
+    pathfield *oldest = nullptr;
+    for (auto &field : pathfields)
+    {
+        if (field->key == key && field->place == place
+            && field->stamp == you.elapsed_time)
+        {
+            field->last_used = ++pathfield_clock;
+            if (!field->built)
+                _build_pathfield(*field, mons);
+            else
+                pf_stats.hits++;
+            return field.get();
+        }
+        if (!oldest || field->last_used < oldest->last_used)
+            oldest = field.get();
+    }
+
+    // The first request for a field only registers interest; a lone
+    // monster is better served by a plain A* search.
+    pf_stats.misses++;
+    if (pathfields.size() < PATHFIELD_CACHE_SIZE)
+    {
+        pathfields.emplace_back(new pathfield);
+        oldest = pathfields.back().get();
+    }
+    oldest->key       = key;
+    oldest->place     = place;
+    oldest->stamp     = you.elapsed_time;
+    oldest->built     = false;
+    oldest->last_used = ++pathfield_clock;
+    return nullptr;
+}
+
+/**
+ * Look up the next step from p towards a shared field's target.
+ *
+ * @return The next position, or p itself if the target can't be reached.
+ */
+static coord_def _pathfield_next_step(const pathfield &field, coord_def p)
+{
+    const int dir = field.step(p);
+    if (dir == PATHFIELD_NO_STEP || field.dist(p) == INFINITE_DISTANCE)
+        return p;
+    return p + Compass[dir];
+}
+
+/**
+ * Try to find a path for a monster using a shared distance field.
+ *
+ * @param mons      The monster looking for a path.
+ * @param target    Where it wants to go.
+ * @param range     As monster_pathfind::set_range(); 0 for no limit.
+ * @param[out] waypoints As monster_pathfind::calc_waypoints(), if a path was
+ *                  found.
+ * @return Whether a shared field was available. If it was, waypoints is
+ *         empty if there is no path; if not, the caller should fall back to
+ *         monster_pathfind.
+ */
+bool pathfield_waypoints(const monster* mons, coord_def target, int range,
+                         vector<coord_def> &waypoints)
+{
+    waypoints.clear();
+
+    pathfield *field = _find_pathfield(mons, target);
+    if (!field)
+        return false;
+
+    const coord_def start = mons->pos();
+    const int dist = field->dist(start);
+    if (dist == INFINITE_DISTANCE || range && dist > range * 2)
+        return true;
+
+    vector<coord_def> path;
+    path.push_back(start);
+    for (coord_def p = start; p != target; )
+    {
+        const coord_def next = _pathfield_next_step(*field, p);
+        if (next == p || path.size() > GXM * GYM)
+        {
+            waypoints.clear();
+            return true;
+        }
+        path.push_back(next);
+        p = next;
+    }
+
+    // From here, as in monster_pathfind::calc_waypoints().
+    coord_def pos = path[0];
+    for (unsigned int i = 1; i < path.size(); i++)
+    {
+        if (!can_go_straight(mons, pos, path[i])
+            || !mons_can_traverse(*mons, path[i]))
+        {
+            pos = path[i-1];
+            waypoints.push_back(pos);
+        }
+    }
+
+    if (pos != path[path.size() - 1])
+        waypoints.push_back(path[path.size() - 1]);
+
+    return true;
+}
+
+// Terrain has changed; no field can be trusted any more.
+void clear_pathfields()
+{
+    for (auto &field : pathfields)
+        field->stamp = -1;
+}
+
+const pathfield_stats& get_pathfield_stats()
+{
+    return pf_stats;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 class monster;
+struct pathfind_grids;
 
 int mons_tracking_range(const monster* mon);
 
@@ -10,6 +11,9 @@ public:
     monster_pathfind();
     virtual ~monster_pathfind();
 
+    monster_pathfind(const monster_pathfind&) = delete;
+    monster_pathfind& operator=(const monster_pathfind&) = delete;
+
     // public methods
     void set_range(int r);
     coord_def next_pos(const coord_def &p) const;
@@ -59,10 +63,21 @@ protected:
     int min_length;
     int max_length;
 
-    // The array of distances from start to any already tried point.
-    int dist[GXM][GYM];
-    // An array to store where we came from on a given shortest path.
-    int prev[GXM][GYM];
+    // Distances, backtracking directions and the open list, borrowed from
+    // a per-thread pool for the lifetime of this object.
+    pathfind_grids *grids;
+};
+
+bool pathfield_waypoints(const monster* mons, coord_def target, int range,
+                         vector<coord_def> &waypoints);
+void clear_pathfields();
 
-    FixedVector<vector<coord_def>, GXM * GYM> hash;
+// Counters for the shared distance fields used by pathfield_waypoints().
+struct pathfield_stats
+{
+    uint64_t hits = 0;   // paths read from an existing field
+    uint64_t misses = 0; // requests that found no field
+    uint64_t builds = 0; // fields built
 };
+
+const pathfield_stats& get_pathfield_stats();
@@ -42,6 +42,7 @@ public:
                                 mon_pick_vetoer vetoer = nullptr);
 
     virtual bool veto(monster_type mon) override;
+    virtual bool has_veto() const override { return _veto; }
 
 private:
     mon_pick_vetoer _veto;
@@ -55,6 +56,7 @@ public:
         : monster_picker(), pos(_pos), posveto(_posveto) { };
 
     virtual bool veto(monster_type mon) override;
+    virtual bool has_veto() const override { return true; }
 
 protected:
     const coord_def &pos;
@@ -571,6 +571,43 @@ const monster_type fixup_zombie_type(const monster_type cls,
             : cls;
 }
 
+static unique_ptr<map_mask_boolean> _near_stairs_mask;
+
+monster_placement_batch::monster_placement_batch()
+    : did_compute_mask(false)
+{
+    if (_near_stairs_mask)
+        return;
+
+    did_compute_mask = true;
+    _near_stairs_mask.reset(new map_mask_boolean(false));
+    map_mask_boolean &mask(*_near_stairs_mask);
+    for (rectangle_iterator ri(1); ri; ++ri)
+    {
+        if (!feat_is_stone_stair(grd(*ri)))
+            continue;
+        for (rectangle_iterator si(*ri, LOS_RADIUS, true); si; ++si)
+            mask(*si) = true;
+    }
+}
+
+monster_placement_batch::~monster_placement_batch()
+{
+    if (did_compute_mask)
+        _near_stairs_mask.reset(nullptr);
+}
+
+static bool _near_stone_stairs(const coord_def &pos)
+{
+    if (_near_stairs_mask)
+        return (*_near_stairs_mask)(pos);
+
+    for (distance_iterator di(pos, false, false, LOS_RADIUS); di; ++di)
+        if (feat_is_stone_stair(grd(*di)))
+            return true;
+    return false;
+}
+
 // Checks if the monster is ok to place at mg_pos. If force_location
 // is true, then we'll be less rigorous in our checks, in particular
 // allowing land monsters to be placed in shallow water and water
@@ -601,11 +638,10 @@ static bool _valid_monster_generation_location(const mgen_data &mg,
         return false;
     }
     // Check that the location is not proximal to level stairs.
-    else if (mg.proximity == PROX_AWAY_FROM_STAIRS)
+    else if (mg.proximity == PROX_AWAY_FROM_STAIRS
+             && _near_stone_stairs(mg_pos))
     {
-        for (distance_iterator di(mg_pos, false, false, LOS_RADIUS); di; ++di)
-            if (feat_is_stone_stair(grd(*di)))
-                return false;
+        return false;
     }
 
     // Don't generate monsters on top of teleport traps.
@@ -719,11 +755,12 @@ monster* place_monster(mgen_data mg, bool force_pos, bool dont_place)
 
             mg.pos = random_in_bounds();
 
-            if (!_valid_monster_generation_location(mg))
+            // Is the grid verboten? This is much cheaper to check than the
+            // rest, and neither check uses the RNG.
+            if (map_masked(mg.pos, mg.map_mask))
                 continue;
 
-            // Is the grid verboten?
-            if (map_masked(mg.pos, mg.map_mask))
+            if (!_valid_monster_generation_location(mg))
                 continue;
 
             break;
@@ -835,13 +872,21 @@ monster* place_monster(mgen_data mg, bool force_pos, bool dont_place)
 
 monster* get_free_monster()
 {
-    for (auto &mons : menv_real)
-        if (mons.type == MONS_NO_MONSTER)
+    // Slots below mons_free_from are all in use, so this still finds the
+    // lowest free slot, as a scan from 0 would.
+    for (monster *mons = &menv[env.mons_free_from]; mons != menv_real.end();
+         ++mons)
+    {
+        if (mons->type == MONS_NO_MONSTER)
         {
-            mons.reset();
-            return &mons;
+            mons->reset();
+            env.mons_used = max(env.mons_used, mons->mindex() + 1);
+            env.mons_free_from = mons->mindex() + 1;
+            return mons;
         }
+    }
 
+    env.mons_free_from = MAX_MONSTERS;
     return nullptr;
 }
 
@@ -1437,7 +1482,7 @@ static monster* _place_monster_aux(const mgen_data &mg, const monster *leader,
             force_colour = mg.colour;
         ghost.init_ugly_thing(mon->type == MONS_VERY_UGLY_THING, false,
                               force_colour);
-        mon->set_ghost(ghost);
+        mon->set_ghost(move(ghost));
         mon->uglything_init();
     }
 #if TAG_MAJOR_VERSION == 34
@@ -1468,7 +1513,7 @@ static monster* _place_monster_aux(const mgen_data &mg, const monster *leader,
                                        mg.props.exists(TUKIMA_POWER) ?
                                            mg.props[TUKIMA_POWER].get_int() : 100);
         }
-        mon->set_ghost(ghost);
+        mon->set_ghost(move(ghost));
         mon->ghost_demon_init();
     }
 
@@ -51,6 +51,22 @@ const monster_type fixup_zombie_type(const monster_type cls,
  * *********************************************************************** */
 monster* place_monster(mgen_data mg, bool force_pos = false, bool dont_place = false);
 
+// While one of these is held, place_monster() works out once which squares
+// are too close to stairs for PROX_AWAY_FROM_STAIRS, rather than searching
+// around every square it tries. Only for use while no stairs are added or
+// removed, such as when populating a freshly built level.
+class monster_placement_batch
+{
+public:
+    monster_placement_batch();
+    ~monster_placement_batch();
+
+    monster_placement_batch(const monster_placement_batch&) = delete;
+    monster_placement_batch& operator=(const monster_placement_batch&) = delete;
+private:
+    bool did_compute_mask;
+};
+
 /* ***********************************************************************
  * Returns a monster class type of a zombie for generation
  * on the player's current level.
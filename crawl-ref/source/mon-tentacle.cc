@@ -624,22 +624,46 @@ static void _collect_tentacles(monster* mons,
             tentacles.push_back(mi);
 }
 
+static void _purge_connector(monster* tentacle, monster* connector)
+{
+    int hp = connector->hit_points;
+    if (hp > 0 && hp < tentacle->hit_points)
+        tentacle->hit_points = hp;
+
+    monster_die(*connector, KILL_MISC, NON_MONSTER, true);
+}
+
 static void _purge_connectors(monster* tentacle)
 {
     for (monster_iterator mi; mi; ++mi)
-    {
         if (mi->is_child_tentacle_of(tentacle))
-        {
-            int hp = mi->hit_points;
-            if (hp > 0 && hp < tentacle->hit_points)
-                tentacle->hit_points = hp;
+            _purge_connector(tentacle, *mi);
+    ASSERT(tentacle->alive());
+}
 
-            monster_die(**mi, KILL_MISC, NON_MONSTER, true);
-        }
-    }
+// As above, but only looking at the candidates gathered for this tentacle
+// by _collect_connectors(). Nothing makes new connectors for a tentacle
+// before its own purge, so rechecking the candidates finds the same ones
+// in the same order.
+static void _purge_connectors(monster* tentacle,
+                              const vector<monster*> &candidates)
+{
+    for (monster *mon : candidates)
+        if (mon->alive() && mon->is_child_tentacle_of(tentacle))
+            _purge_connector(tentacle, mon);
     ASSERT(tentacle->alive());
 }
 
+// Group every monster attached to something by the mid it's attached to,
+// in one pass, so a head with many tentacles doesn't walk the monster list
+// once for each of them.
+static void _collect_connectors(map<mid_t, vector<monster*>> &connectors)
+{
+    for (monster_iterator mi; mi; ++mi)
+        if (mi->tentacle_connect)
+            connectors[mi->tentacle_connect].push_back(*mi);
+}
+
 static void _collect_foe_positions(monster *mons,
                                    vector<coord_def> &foe_positions,
                                    function<bool(const actor *)> sight_check)
@@ -974,6 +998,10 @@ void move_child_tentacles(monster* mons)
     vector<monster_iterator> tentacles;
     _collect_tentacles(mons, tentacles);
 
+    map<mid_t, vector<monster*>> connectors;
+    if (!tentacles.empty())
+        _collect_connectors(connectors);
+
     // Move each tentacle in turn
     for (monster_iterator &tent_it : tentacles)
     {
@@ -1022,7 +1050,7 @@ void move_child_tentacles(monster* mons)
             current_count++;
         }
 
-        _purge_connectors(tentacle);
+        _purge_connectors(tentacle, connectors[tentacle->mid]);
 
         if (no_foe
             && grid_distance(tentacle->pos(), mons->pos()) == 1)
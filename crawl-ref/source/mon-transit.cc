@@ -442,7 +442,7 @@ void tag_followers()
  **/
 void untag_followers()
 {
-    for (auto &mons : menv_real)
+    for (auto &mons : menv_used)
         mons.flags &= ~MF_TAKING_STAIRS;
 }
 
@@ -2934,7 +2934,7 @@ void define_monster(monster& mons)
     {
         ghost_demon ghost;
         ghost.init_pandemonium_lord();
-        mons.set_ghost(ghost);
+        mons.set_ghost(move(ghost));
         mons.ghost_demon_init();
         mons.bind_melee_flags();
         mons.bind_spell_flags();
@@ -2946,7 +2946,7 @@ void define_monster(monster& mons)
     {
         ghost_demon ghost;
         ghost.init_player_ghost(mcls == MONS_PLAYER_GHOST);
-        mons.set_ghost(ghost);
+        mons.set_ghost(move(ghost));
         mons.ghost_init(!mons.props.exists("fake"));
         break;
     }
@@ -2956,7 +2956,7 @@ void define_monster(monster& mons)
     {
         ghost_demon ghost;
         ghost.init_ugly_thing(mcls == MONS_VERY_UGLY_THING);
-        mons.set_ghost(ghost);
+        mons.set_ghost(move(ghost));
         mons.uglything_init();
         break;
     }
@@ -2967,7 +2967,7 @@ void define_monster(monster& mons)
     case MONS_SPECTRAL_WEAPON:
     {
         ghost_demon ghost;
-        mons.set_ghost(ghost);
+        mons.set_ghost(move(ghost));
         break;
     }
 
@@ -5174,6 +5174,8 @@ void reset_all_monsters()
         }
         mons.reset();
     }
+    env.mons_used = 0;
+    env.mons_free_from = 0;
 
     env.mid_cache.clear();
 }
@@ -5712,15 +5714,12 @@ void set_ancestor_spells(monster &ancestor, bool notify)
     }
 }
 
-static bool _apply_to_monsters(monster_func f, radius_iterator&& ri)
+static bool _apply_to_monsters(monster_func f, vector<monster*> targets)
 {
     bool affected_any = false;
-    for (; ri; ri++)
-    {
-        monster* mons = monster_at(*ri);
-        if (!invalid_monster(mons))
+    for (monster* mons : targets)
+        if (mons->alive())
             affected_any = f(*mons) || affected_any;
-    }
 
     return affected_any;
 }
@@ -5728,10 +5727,12 @@ static bool _apply_to_monsters(monster_func f, radius_iterator&& ri)
 bool apply_monsters_around_square(monster_func f, const coord_def& where,
                                   int radius)
 {
-    return _apply_to_monsters(f, radius_iterator(where, radius, C_SQUARE, true));
+    return _apply_to_monsters(f,
+        monsters_in_shape(circle_def(where, radius, C_SQUARE), LOS_NONE, true));
 }
 
 bool apply_visible_monsters(monster_func f, const coord_def& where, los_type los)
 {
-    return _apply_to_monsters(f, radius_iterator(where, los, true));
+    return _apply_to_monsters(f, monsters_in_shape(
+                    circle_def(where, LOS_RADIUS, C_SQUARE), los, true));
 }
@@ -161,6 +161,10 @@ void monster::reset()
     // Just for completeness.
     speed           = 0;
     colour         = COLOUR_INHERIT;
+
+    // Copies outside menv are reset too, and don't count.
+    if (this >= menv_real.begin() && this < menv_real.end())
+        env.mons_free_from = min(env.mons_free_from, mindex());
 }
 
 void monster::init_with(const monster& mon)
@@ -4551,6 +4555,16 @@ void monster::set_ghost(const ghost_demon &g)
         mname = ghost->name;
 }
 
+// For a freshly built ghost_demon: takes its name and spells rather than
+// copying them.
+void monster::set_ghost(ghost_demon &&g)
+{
+    ghost.reset(new ghost_demon(move(g)));
+
+    if (!ghost->name.empty())
+        mname = ghost->name;
+}
+
 void monster::set_new_monster_id()
 {
     mid = ++you.last_mid;
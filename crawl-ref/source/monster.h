@@ -234,6 +234,7 @@ public:
     void set_originating_map(const string &);
 
     void set_ghost(const ghost_demon &ghost);
+    void set_ghost(ghost_demon &&ghost);
     void ghost_init(bool need_pos = true);
     void ghost_demon_init();
     void uglything_init(bool only_mutate = false);
@@ -1389,6 +1389,47 @@ bool undead_mutation_rot()
  *
  * @return whether the mutation succeeded.
  */
+static int _mutation_batch_depth = 0;
+static unsigned int _batch_old_talents = 0;
+static bool _batch_needs_validation = false;
+
+static void _check_new_talents(unsigned int old_talents)
+{
+#ifdef USE_TILE_LOCAL
+    if (your_talents(false).size() != old_talents)
+    {
+        tiles.layout_statcol();
+        redraw_screen();
+    }
+#endif
+    if (crawl_state.game_is_hints()
+        && your_talents(false).size() > old_talents)
+    {
+        learned_something_new(HINT_NEW_ABILITY_MUT);
+    }
+}
+
+mutation_batch::mutation_batch()
+{
+    if (!_mutation_batch_depth++)
+    {
+        _batch_old_talents = your_talents(false).size();
+        _batch_needs_validation = false;
+    }
+}
+
+mutation_batch::~mutation_batch()
+{
+    if (--_mutation_batch_depth)
+        return;
+
+    _check_new_talents(_batch_old_talents);
+#ifdef DEBUG
+    if (_batch_needs_validation)
+        validate_mutations(false);
+#endif
+}
+
 bool mutate(mutation_type which_mutation, const string &reason, bool failMsg,
             bool force_mutation, bool god_gift, bool beneficial,
             mutation_permanence_class mutclass)
@@ -1534,7 +1575,8 @@ bool mutate(mutation_type which_mutation, const string &reason, bool failMsg,
 
     ASSERT(rc == 0);
 
-    const unsigned int old_talents = your_talents(false).size();
+    const unsigned int old_talents =
+        _mutation_batch_depth ? 0 : your_talents(false).size();
 
     const int levels = (which_mutation == RANDOM_CORRUPT_MUTATION
                          || which_mutation == RANDOM_QAZLAL_MUTATION)
@@ -1715,18 +1757,14 @@ bool mutate(mutation_type which_mutation, const string &reason, bool failMsg,
         }
     }
 
-#ifdef USE_TILE_LOCAL
-    if (your_talents(false).size() != old_talents)
-    {
-        tiles.layout_statcol();
-        redraw_screen();
-    }
-#endif
-    if (crawl_state.game_is_hints()
-        && your_talents(false).size() > old_talents)
+    if (_mutation_batch_depth)
     {
-        learned_something_new(HINT_NEW_ABILITY_MUT);
+        if (mutclass != MUTCLASS_INNATE)
+            _batch_needs_validation = true;
+        return true;
     }
+
+    _check_new_talents(old_talents);
 #ifdef DEBUG
     if (mutclass != MUTCLASS_INNATE) // taken care of in perma_mutate. Skipping this here avoids validation issues in doing repairs.
         validate_mutations(false);
@@ -2551,7 +2589,12 @@ bool perma_mutate(mutation_type which_mut, int how_much, const string &reason)
     // don't validate permamutate directly on level regain; this is so that wizmode level change
     // functions can work correctly.
     if (you.experience_level >= you.max_level)
-        validate_mutations(false);
+    {
+        if (_mutation_batch_depth)
+            _batch_needs_validation = true;
+        else
+            validate_mutations(false);
+    }
 #endif
     return levels > 0;
 }
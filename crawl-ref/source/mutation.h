@@ -35,6 +35,19 @@ bool is_body_facet(mutation_type mut);
 bool is_slime_mutation(mutation_type mut);
 bool undead_mutation_rot();
 
+// Mutations gained while one of these is alive put off the checks that
+// only need doing once for the lot: laying out and hinting about any new
+// abilities, and in debug builds validating the player's mutations.
+class mutation_batch
+{
+public:
+    mutation_batch();
+    ~mutation_batch();
+
+    mutation_batch(const mutation_batch&) = delete;
+    mutation_batch& operator=(const mutation_batch&) = delete;
+};
+
 bool mutate(mutation_type which_mutation, const string &reason,
             bool failMsg = true,
             bool force_mutation = false, bool god_gift = false,
@@ -566,4 +566,7 @@ static void _setup_generic(const newgame_def& ng)
     else
         you.save = new package(get_savedir_filename(you.your_name).c_str(),
                                true, true);
+    you.save->set_codec(Options.save_compression,
+                        Options.save_compression_level);
+    reset_level_cache();
 }
@@ -70,6 +70,10 @@ struct noise_cell
     int noise_intensity_millis;
     int noise_travel_distance;
 
+    // The noise_grid generation this cell was last written in; the cell is
+    // empty in any other generation.
+    unsigned int generation;
+
     noise_cell();
     bool can_apply_noise(int noise_intensity_millis) const;
     bool apply_noise(int noise_intensity_millis,
@@ -111,6 +115,9 @@ public:
     // Clear all noise from the noise grid.
     void reset();
 
+    // Take over the noises registered on another grid, clearing it.
+    void take_noises(noise_grid &other);
+
     bool dirty() const { return !noises.empty(); }
 
 #ifdef DEBUG_NOISE_PROPAGATION
@@ -120,6 +127,11 @@ public:
 #endif
 
 private:
+    noise_cell &cell_at(const coord_def &p);
+    const noise_cell &cell_at(const coord_def &p) const;
+    void index_actors();
+    bool actor_within(const coord_def &p, int radius) const;
+
     bool propagate_noise_to_neighbour(int base_attenuation,
                                       int travel_distance,
                                       const noise_cell &cell,
@@ -136,6 +148,11 @@ private:
 
 private:
     FixedArray<noise_cell, GXM, GYM> cells;
+    unsigned int generation;
     vector<noise_t> noises;
     int affected_actor_count;
+
+    // Summed-area table of actor positions, so that propagation can tell
+    // whether anyone is left within earshot of a cell.
+    FixedArray<int, GXM + 1, GYM + 1> actor_sums;
 };
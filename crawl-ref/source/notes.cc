@@ -463,6 +463,8 @@ void Note::load(reader& inf)
 }
 
 static bool notes_active = false;
+// Bumped whenever note_list changes, so saves can tell if it needs writing.
+static int notes_changes = 0;
 
 bool notes_are_active()
 {
@@ -474,6 +476,7 @@ void take_note(const Note& note, bool force)
     if (notes_active && (force || _is_noteworthy(note)))
     {
         note_list.push_back(note);
+        notes_changes++;
         note.check_milestone();
     }
 }
@@ -483,6 +486,11 @@ void activate_notes(bool active)
     notes_active = active;
 }
 
+int notes_generation()
+{
+    return notes_changes;
+}
+
 void save_notes(writer& outf)
 {
     marshallInt(outf, NOTES_VERSION_NUMBER);
@@ -503,6 +511,7 @@ void load_notes(reader& inf)
         new_note.load(inf);
         note_list.push_back(new_note);
     }
+    notes_changes++;
 }
 
 void make_user_note()
@@ -89,6 +89,7 @@ void activate_notes(bool active);
 bool notes_are_active();
 void take_note(const Note& note, bool force = false);
 void save_notes(writer&);
+int notes_generation();
 void load_notes(reader&);
 void make_user_note();
 
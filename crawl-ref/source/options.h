@@ -15,6 +15,7 @@
 #include "mpr.h"
 #include "newgame-def.h"
 #include "pattern.h"
+#include "save-codec-type.h"
 #include "screen-mode.h"
 #include "skill-focus-mode.h"
 #include "tag-pref.h"
@@ -127,6 +128,9 @@ struct game_options
 public:
     game_options();
     ~game_options();
+    // option_behaviour points into this object, so it must not be copied.
+    game_options(const game_options &) = delete;
+    game_options &operator=(const game_options &) = delete;
     void reset_options();
 
     void read_option_line(const string &s, bool runscripts = false);
@@ -320,6 +324,13 @@ public:
 
     bool        show_travel_trail;
 
+    bool        pregen_levels;  // Build the level below a nearby downstair
+                                // ahead of time in a helper process.
+
+    int         lua_gc_pause;   // Lua collector pause, as a percentage.
+    int         lua_gc_stepmul; // Lua collector step multiplier.
+    int         lua_idle_gc_ms; // Time to spend collecting while idle.
+
     int         view_delay;
 
     bool        arena_dump_msgs;
@@ -422,6 +433,9 @@ public:
     bool        read_persist_options; // If true, Crawl will try to load
                                       // options from c_persist.options
 
+    save_codec  save_compression;       // Codec for newly written save chunks
+    int         save_compression_level; // and its level; 0 for the default
+
     vector<text_pattern> drop_filter;
 
     map<string, FixedBitVector<NUM_AINTERRUPTS>> activity_interrupts;
@@ -474,6 +488,7 @@ public:
     string      fsim_mode;
     bool        fsim_csv;
     int         fsim_rounds;
+    int         fsim_jobs;
     string      fsim_mons;
     vector<string> fsim_scale;
     vector<string> fsim_kit;
@@ -540,6 +555,9 @@ public:
     int         tile_window_width;
     int         tile_window_height;
     maybe_bool  tile_use_small_layout;
+    // render profiling
+    bool        tile_show_frame_stats;
+    string      tile_frame_log;
 #endif
     int         tile_cell_pixels;
     bool        tile_filter_scaling;
@@ -569,6 +587,7 @@ public:
     bool        tile_level_map_hide_messages;
     bool        tile_level_map_hide_sidebar;
     bool        tile_web_mouse_control;
+    int         tile_web_flush_rate;
 #endif
 #endif // USE_TILE
 
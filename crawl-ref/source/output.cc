@@ -1282,6 +1282,7 @@ static void _redraw_title()
 
 void print_stats()
 {
+    derived_stat_cache_scope stat_cache;
     int ac_pos = 5;
     int ev_pos = ac_pos + 1;
 
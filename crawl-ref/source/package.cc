@@ -16,6 +16,10 @@ Notes:
 * Readers always get the last complete (but not necessarily committed) write
   (ie, READ_UNCOMMITTED) at the time they started; it is safe to continue
   reading even if the chunk has been changed since.
+* A commit normally writes only a small directory record listing the chunks
+  changed since the previous one, chained to the record before it. Once the
+  chain gets long the whole directory is written out again and the old
+  records are freed.
 */
 
 #include "AppHdr.h"
@@ -56,9 +60,27 @@ static plen_t htole(plen_t x)
 #define dprintf(...) do {} while (0)
 #endif
 
-#define PACKAGE_VERSION 1
+// Version 1 has a single full directory. Version 2 points at a chain of
+// directory records: each starts with an entry with an empty name giving
+// the previous record, and an entry starting at 0 is a deleted chunk. The
+// oldest record of a chain is a plain version 1 directory.
+#define PACKAGE_VERSION         1
+#define PACKAGE_VERSION_JOURNAL 2
 #define PACKAGE_MAGIC   0x53534344 /* "DCSS" */
 
+// Rewrite the full directory once this many records are chained, or once
+// the superseded records take up this many bytes.
+#define JOURNAL_MAX_RECORDS 32
+#define JOURNAL_MAX_SLACK   16384
+
+// Frame magic numbers of the optional codecs, stored little-endian at the
+// start of a chunk.
+#define ZSTD_FRAME_MAGIC 0xFD2FB528
+#define LZ4_FRAME_MAGIC  0x184D2204
+// LZ4F_compressUpdate() needs room for the worst case of its whole input,
+// so feed it in steps of this size.
+#define LZ4_INPUT_STEP   16384
+
 struct file_header
 {
     uint32_t magic;
@@ -79,7 +101,8 @@ typedef map<plen_t, bm_p> bm_t;
 typedef map<plen_t, plen_t> fb_t;
 
 package::package(const char* file, bool writeable, bool empty)
-  : n_users(0), dirty(false), aborted(false)
+  : n_users(0), dirty(false), aborted(false), codec(SAVE_CODEC_ZLIB),
+    codec_level(0)
 #ifdef DO_FSYNC
     , tmp(false)
 #endif
@@ -126,7 +149,8 @@ package::package(const char* file, bool writeable, bool empty)
 }
 
 package::package()
-  : rw(true), n_users(0), dirty(false), aborted(false)
+  : rw(true), n_users(0), dirty(false), aborted(false),
+    codec(SAVE_CODEC_ZLIB), codec_level(0)
 #ifdef DO_FSYNC
     , tmp(true)
 #endif
@@ -191,6 +215,8 @@ void package::load_traces()
 
     for (const auto &entry : directory)
         trace_chunk(entry.second);
+    for (plen_t rec : journal)
+        trace_chunk(rec);
 
 #ifdef COSTLY_ASSERTS
     // any inconsitency in the save is guaranteed to be already found
@@ -238,9 +264,9 @@ void package::commit()
 
     file_header head;
     head.magic = htole(PACKAGE_MAGIC);
-    head.version = PACKAGE_VERSION;
-    memset(&head.padding, 0, sizeof(head.padding));
     head.start = htole(write_directory());
+    head.version = journal.empty() ? PACKAGE_VERSION : PACKAGE_VERSION_JOURNAL;
+    memset(&head.padding, 0, sizeof(head.padding));
 #ifdef DO_FSYNC
     // We need a barrier before updating the link to point at the new directory.
     if (!tmp && fdatasync(fd))
@@ -255,6 +281,7 @@ void package::commit()
 #endif
 
     new_chunks.clear();
+    changed_chunks.clear();
     collect_blocks();
     dirty = false;
 
@@ -273,6 +300,45 @@ void package::seek(plen_t to)
         sysfail("failed to seek inside the save file");
 }
 
+const char* save_codec_name(save_codec codec)
+{
+    switch (codec)
+    {
+    case SAVE_CODEC_ZLIB: return "zlib";
+    case SAVE_CODEC_ZSTD: return "zstd";
+    case SAVE_CODEC_LZ4:  return "lz4";
+    default:              return "unknown";
+    }
+}
+
+bool save_codec_supported(save_codec codec)
+{
+    switch (codec)
+    {
+#ifdef USE_ZLIB
+    case SAVE_CODEC_ZLIB:
+        return true;
+#endif
+#ifdef USE_ZSTD
+    case SAVE_CODEC_ZSTD:
+        return true;
+#endif
+#ifdef USE_LZ4
+    case SAVE_CODEC_LZ4:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+void package::set_codec(save_codec new_codec, int level)
+{
+    ASSERT(save_codec_supported(new_codec));
+    codec = new_codec;
+    codec_level = level;
+}
+
 chunk_writer* package::writer(const string &name)
 {
     return new chunk_writer(this, name);
@@ -357,6 +423,8 @@ void package::finish_chunk(const string &name, plen_t at)
 {
     free_chunk(name);
     directory[name] = at;
+    if (!name.empty())
+        changed_chunks.insert(name);
     new_chunks.insert(at);
     dirty = true;
 }
@@ -379,21 +447,77 @@ void package::free_chunk(const string &name)
 void package::delete_chunk(const string &name)
 {
     free_chunk(name);
-    directory.erase(name);
+    if (directory.erase(name) && !name.empty())
+        changed_chunks.insert(name);
 }
 
-plen_t package::write_directory()
+plen_t package::chain_length(plen_t at)
+{
+    plen_t len = 0;
+    while (at)
+    {
+        auto bl = block_map.find(at);
+        ASSERT(bl != block_map.end());
+        len += bl->second.first;
+        at = bl->second.second;
+    }
+    return len;
+}
+
+bool package::want_full_directory()
 {
-    delete_chunk("");
+    // Nothing to chain to.
+    if (!directory.count(""))
+        return true;
+
+    if (journal.size() + 1 >= JOURNAL_MAX_RECORDS
+        || changed_chunks.size() * 2 >= directory.size())
+    {
+        return true;
+    }
 
+    plen_t slack = 0;
+    for (plen_t rec : journal)
+        slack += chain_length(rec);
+    return slack + chain_length(directory[""]) > JOURNAL_MAX_SLACK;
+}
+
+plen_t package::write_directory()
+{
     stringstream dir;
-    for (const auto &entry : directory)
+    auto add_entry = [&dir](const string &name, plen_t at)
     {
-        uint8_t name_len = entry.first.length();
+        uint8_t name_len = name.length();
         dir.write((const char*)&name_len, sizeof(name_len));
-        dir.write(&entry.first[0], entry.first.length());
-        plen_t start = htole(entry.second);
+        dir.write(&name[0], name.length());
+        plen_t start = htole(at);
         dir.write((const char*)&start, sizeof(plen_t));
+    };
+
+    if (want_full_directory())
+    {
+        // Once the new directory is committed, no old record is needed.
+        for (plen_t rec : journal)
+            unlinked_blocks.push_back(rec);
+        journal.clear();
+        delete_chunk("");
+
+        for (const auto &entry : directory)
+            add_entry(entry.first, entry.second);
+    }
+    else
+    {
+        // Keep the current record; the new one chains to it.
+        const plen_t prev = directory[""];
+        journal.push_back(prev);
+        directory.erase("");
+
+        add_entry("", prev);
+        for (const string &name : changed_chunks)
+        {
+            const plen_t *at = map_find(directory, name);
+            add_entry(name, at ? *at : 0);
+        }
     }
 
     ASSERT(dir.str().size());
@@ -511,17 +635,38 @@ struct dir_entry0
     plen_t start;
 };
 
+void package::read_directory_record(plen_t start, directory_t &entries)
+{
+    chunk_reader rd(this, start);
+
+    uint8_t name_len;
+    plen_t bstart;
+    while (plen_t res = rd.read(&name_len, sizeof(name_len)))
+    {
+        if (res != sizeof(name_len))
+            corrupted("save file corrupted -- truncated directory");
+        string chname;
+        chname.resize(name_len);
+        if (rd.read(&chname[0], name_len) != name_len)
+            corrupted("save file corrupted -- truncated directory");
+        if (rd.read(&bstart, sizeof(bstart)) != sizeof(bstart))
+            corrupted("save file corrupted -- truncated directory");
+        entries[chname] = htole(bstart);
+        dprintf("* %s\n", chname.c_str());
+    }
+}
+
 void package::read_directory(plen_t start, uint8_t version)
 {
     ASSERT(directory.empty());
-    directory[""] = start;
 
     dprintf("package: reading directory\n");
-    chunk_reader rd(this, start);
 
     switch (version)
     {
     case 0:
+    {
+        chunk_reader rd(this, start);
         dir_entry0 ch0;
         while (plen_t res = rd.read(&ch0, sizeof(dir_entry0)))
         {
@@ -533,27 +678,43 @@ void package::read_directory(plen_t start, uint8_t version)
             dprintf("* %s\n", chname.c_str());
         }
         break;
+    }
     case 1:
-        uint8_t name_len;
-        plen_t bstart;
-        while (plen_t res = rd.read(&name_len, sizeof(name_len)))
+        read_directory_record(start, directory);
+        break;
+    case 2:
+    {
+        // Walk back to the full directory, then replay the newer records.
+        vector<directory_t> records;
+        for (plen_t at = start; at; )
         {
-            if (res != sizeof(name_len))
-                corrupted("save file corrupted -- truncated directory");
-            string chname;
-            chname.resize(name_len);
-            if (rd.read(&chname[0], name_len) != name_len)
-                corrupted("save file corrupted -- truncated directory");
-            if (rd.read(&bstart, sizeof(bstart)) != sizeof(bstart))
-                corrupted("save file corrupted -- truncated directory");
-            directory[chname] = htole(bstart);
-            dprintf("* %s\n", chname.c_str());
+            if (records.size() > JOURNAL_MAX_RECORDS)
+                corrupted("save file corrupted -- directory journal loops");
+            if (at != start)
+                journal.insert(journal.begin(), at);
+            records.emplace_back();
+            read_directory_record(at, records.back());
+            const plen_t *prev = map_find(records.back(), string());
+            at = prev ? *prev : 0;
         }
+        for (auto rec = records.rbegin(); rec != records.rend(); ++rec)
+            for (const auto &entry : *rec)
+            {
+                if (entry.first.empty())
+                    continue;
+                if (entry.second)
+                    directory[entry.first] = entry.second;
+                else
+                    directory.erase(entry.first);
+            }
         break;
+    }
     default:
         corrupted("save file (%s) uses an unknown format %u", filename.c_str(),
              version);
     }
+
+    directory[""] = start;
 }
 
 bool package::has_chunk(const string &name)
@@ -655,16 +816,13 @@ plen_t package::get_chunk_compressed_length(const string &name)
 {
     load_traces();
     ASSERT(directory.count(name)); // not has_chunk(), "" is valid
-    plen_t len = 0;
-    plen_t at = directory[name];
-    while (at)
-    {
-        auto bl = block_map.find(at);
-        ASSERT(bl != block_map.end());
-        len += bl->second.first;
-        at = bl->second.second;
-    }
-    return len;
+    return chain_length(directory[name]);
+}
+
+save_codec package::get_chunk_codec(const string &name)
+{
+    chunk_reader in(this, name);
+    return in.get_codec();
 }
 
 chunk_writer::chunk_writer(package *parent, const string &_name)
@@ -683,15 +841,74 @@ chunk_writer::chunk_writer(package *parent, const string &_name)
     name = _name;
 
 #ifdef USE_ZLIB
-    zs.data_type = Z_BINARY;
-    zs.zalloc    = 0;
-    zs.zfree     = 0;
-    zs.opaque    = Z_NULL;
-    if (deflateInit(&zs, Z_DEFAULT_COMPRESSION))
-        fail("save file compression failed during init: %s", zs.msg);
+    // The directory always uses zlib, so that any build can at least list
+    // the chunks of a save it cannot fully read.
+    codec = name.empty() ? SAVE_CODEC_ZLIB : pkg->codec;
+    const int level = pkg->codec_level;
 #define ZB_SIZE 32768
-    zs.next_out  = z_buffer = (Bytef*)malloc(ZB_SIZE);
-    zs.avail_out = ZB_SIZE;
+    z_buffer_size = ZB_SIZE;
+
+    switch (codec)
+    {
+    case SAVE_CODEC_ZLIB:
+        zs.data_type = Z_BINARY;
+        zs.zalloc    = 0;
+        zs.zfree     = 0;
+        zs.opaque    = Z_NULL;
+        if (deflateInit(&zs, level ? level : Z_DEFAULT_COMPRESSION))
+            fail("save file compression failed during init: %s", zs.msg);
+        break;
+#ifdef USE_ZSTD
+    case SAVE_CODEC_ZSTD:
+    {
+        zstd = ZSTD_createCStream();
+        if (!zstd)
+            fail("save file compression failed during init");
+        const size_t res = ZSTD_CCtx_setParameter(zstd,
+                                                  ZSTD_c_compressionLevel,
+                                                  level);
+        if (ZSTD_isError(res))
+        {
+            fail("save file compression failed during init: %s",
+                 ZSTD_getErrorName(res));
+        }
+        break;
+    }
+#endif
+#ifdef USE_LZ4
+    case SAVE_CODEC_LZ4:
+    {
+        const size_t res = LZ4F_createCompressionContext(&lz4, LZ4F_VERSION);
+        if (LZ4F_isError(res))
+        {
+            fail("save file compression failed during init: %s",
+                 LZ4F_getErrorName(res));
+        }
+        memset(&lz4_prefs, 0, sizeof(lz4_prefs));
+        lz4_prefs.compressionLevel = level;
+        z_buffer_size = max<size_t>(ZB_SIZE,
+                                    LZ4F_compressBound(LZ4_INPUT_STEP,
+                                                       &lz4_prefs));
+        break;
+    }
+#endif
+    default:
+        die("save codec %s is not supported", save_codec_name(codec));
+    }
+
+    zs.next_out  = z_buffer = (Bytef*)malloc(z_buffer_size);
+    zs.avail_out = z_buffer_size;
+
+#ifdef USE_LZ4
+    if (codec == SAVE_CODEC_LZ4)
+    {
+        const size_t res = LZ4F_compressBegin(lz4, z_buffer, z_buffer_size,
+                                              &lz4_prefs);
+        if (LZ4F_isError(res))
+            fail("save file compression failed: %s", LZ4F_getErrorName(res));
+        raw_write(z_buffer, res);
+    }
+#endif
 #endif
 }
 
@@ -705,26 +922,23 @@ chunk_writer::~chunk_writer()
     {
 #ifdef USE_ZLIB
         // ignore errors, they're not relevant anymore
-        deflateEnd(&zs);
+        if (codec == SAVE_CODEC_ZLIB)
+            deflateEnd(&zs);
+#ifdef USE_ZSTD
+        if (codec == SAVE_CODEC_ZSTD)
+            ZSTD_freeCStream(zstd);
+#endif
+#ifdef USE_LZ4
+        if (codec == SAVE_CODEC_LZ4)
+            LZ4F_freeCompressionContext(lz4);
+#endif
         free(z_buffer);
 #endif
         return;
     }
 
 #ifdef USE_ZLIB
-    zs.avail_in = 0;
-    int res;
-    do
-    {
-        res = deflate(&zs, Z_FINISH);
-        if (res != Z_STREAM_END && res != Z_OK && res != Z_BUF_ERROR)
-            fail("save file compression failed: %s", zs.msg);
-        raw_write(z_buffer, zs.next_out - z_buffer);
-        zs.next_out = z_buffer;
-        zs.avail_out = ZB_SIZE;
-    } while (res != Z_STREAM_END);
-    if (deflateEnd(&zs) != Z_OK)
-        fail("save file compression failed during clean-up: %s", zs.msg);
+    finish_stream();
     free(z_buffer);
 #endif
     if (cur_block)
@@ -732,6 +946,67 @@ chunk_writer::~chunk_writer()
     pkg->finish_chunk(name, first_block);
 }
 
+// Write out whatever the compressor still holds, and release it.
+void chunk_writer::finish_stream()
+{
+#ifdef USE_ZLIB
+    switch (codec)
+    {
+    case SAVE_CODEC_ZLIB:
+    {
+        zs.avail_in = 0;
+        int res;
+        do
+        {
+            res = deflate(&zs, Z_FINISH);
+            if (res != Z_STREAM_END && res != Z_OK && res != Z_BUF_ERROR)
+                fail("save file compression failed: %s", zs.msg);
+            raw_write(z_buffer, zs.next_out - z_buffer);
+            zs.next_out = z_buffer;
+            zs.avail_out = z_buffer_size;
+        } while (res != Z_STREAM_END);
+        if (deflateEnd(&zs) != Z_OK)
+            fail("save file compression failed during clean-up: %s", zs.msg);
+        break;
+    }
+#ifdef USE_ZSTD
+    case SAVE_CODEC_ZSTD:
+    {
+        ZSTD_inBuffer in = { nullptr, 0, 0 };
+        size_t res;
+        do
+        {
+            ZSTD_outBuffer out = { z_buffer, z_buffer_size, 0 };
+            res = ZSTD_compressStream2(zstd, &out, &in, ZSTD_e_end);
+            if (ZSTD_isError(res))
+            {
+                fail("save file compression failed: %s",
+                     ZSTD_getErrorName(res));
+            }
+            raw_write(z_buffer, out.pos);
+        } while (res);
+        ZSTD_freeCStream(zstd);
+        break;
+    }
+#endif
+#ifdef USE_LZ4
+    case SAVE_CODEC_LZ4:
+    {
+        const size_t res = LZ4F_compressEnd(lz4, z_buffer, z_buffer_size,
+                                            nullptr);
+        if (LZ4F_isError(res))
+            fail("save file compression failed: %s", LZ4F_getErrorName(res));
+        raw_write(z_buffer, res);
+        LZ4F_freeCompressionContext(lz4);
+        break;
+    }
+#endif
+    default:
+        die("save codec %s is not supported", save_codec_name(codec));
+    }
+#endif
+}
+
 void chunk_writer::raw_write(const void *data, plen_t len)
 {
     while (len > 0)
@@ -777,30 +1052,89 @@ void chunk_writer::write(const void *data, plen_t len)
     ASSERT(!pkg->aborted);
 
 #ifdef USE_ZLIB
-    zs.next_in  = (Bytef*)data;
-    zs.avail_in = len;
-    while (zs.avail_in)
+    switch (codec)
     {
-        if (!zs.avail_out)
+    case SAVE_CODEC_ZLIB:
+        zs.next_in  = (Bytef*)data;
+        zs.avail_in = len;
+        while (zs.avail_in)
         {
-            raw_write(z_buffer, zs.next_out - z_buffer);
-            zs.next_out  = z_buffer;
-            zs.avail_out = ZB_SIZE;
+            if (!zs.avail_out)
+            {
+                raw_write(z_buffer, zs.next_out - z_buffer);
+                zs.next_out  = z_buffer;
+                zs.avail_out = z_buffer_size;
+            }
+            // we don't allow Z_BUF_ERROR, so it's fatal for us
+            if (deflate(&zs, Z_NO_FLUSH) != Z_OK)
+                fail("save file compression failed: %s", zs.msg);
         }
-        // we don't allow Z_BUF_ERROR, so it's fatal for us
-        if (deflate(&zs, Z_NO_FLUSH) != Z_OK)
-            fail("save file compression failed: %s", zs.msg);
+        break;
+#ifdef USE_ZSTD
+    case SAVE_CODEC_ZSTD:
+    {
+        ZSTD_inBuffer in = { data, len, 0 };
+        while (in.pos < in.size)
+        {
+            ZSTD_outBuffer out = { z_buffer, z_buffer_size, 0 };
+            const size_t res = ZSTD_compressStream2(zstd, &out, &in,
+                                                    ZSTD_e_continue);
+            if (ZSTD_isError(res))
+            {
+                fail("save file compression failed: %s",
+                     ZSTD_getErrorName(res));
+            }
+            raw_write(z_buffer, out.pos);
+        }
+        break;
+    }
+#endif
+#ifdef USE_LZ4
+    case SAVE_CODEC_LZ4:
+        while (len)
+        {
+            const plen_t step = min<plen_t>(len, LZ4_INPUT_STEP);
+            const size_t res = LZ4F_compressUpdate(lz4, z_buffer,
+                                                   z_buffer_size, data, step,
+                                                   nullptr);
+            if (LZ4F_isError(res))
+            {
+                fail("save file compression failed: %s",
+                     LZ4F_getErrorName(res));
+            }
+            raw_write(z_buffer, res);
+            data = (const char*)data + step;
+            len -= step;
+        }
+        break;
+#endif
+    default:
+        die("save codec %s is not supported", save_codec_name(codec));
     }
 #else
     raw_write(data, len);
 #endif
 }
 
+#ifdef USE_ZLIB
+static save_codec _identify_codec(const Bytef *data, plen_t len)
+{
+    if (len >= 4)
+    {
+        const uint32_t magic = data[0] | data[1] << 8 | data[2] << 16
+                               | (uint32_t)data[3] << 24;
+        if (magic == ZSTD_FRAME_MAGIC)
+            return SAVE_CODEC_ZSTD;
+        if (magic == LZ4_FRAME_MAGIC)
+            return SAVE_CODEC_LZ4;
+    }
+    return SAVE_CODEC_ZLIB;
+}
+#endif
+
 void chunk_reader::init(plen_t start)
 {
     ASSERT(!pkg->aborted);
-    pkg->n_users++;
-    pkg->reader_count[start]++;
     first_block = next_block = start;
     block_left = 0;
 
@@ -808,15 +1142,63 @@ void chunk_reader::init(plen_t start)
     if (!start)
         corrupted("save file corrupted -- zlib header missing");
 
-    zs.zalloc    = 0;
-    zs.zfree     = 0;
-    zs.opaque    = Z_NULL;
-    zs.next_in   = Z_NULL;
-    zs.avail_in  = 0;
-    if (inflateInit(&zs))
-        fail("save file decompression failed during init: %s", zs.msg);
+    // Peek at the start of the stream to see how it was compressed.
+    in_pos = 0;
+    in_len = raw_read(z_buffer, sizeof(z_buffer));
+    codec = _identify_codec(z_buffer, in_len);
+    if (!save_codec_supported(codec))
+    {
+        fail("This save uses %s compression, which this build of Crawl "
+             "does not support.", save_codec_name(codec));
+    }
     eof = false;
 #endif
+
+    pkg->n_users++;
+    pkg->reader_count[start]++;
+
+#ifdef USE_ZLIB
+    start_stream();
+#endif
+}
+
+void chunk_reader::start_stream()
+{
+#ifdef USE_ZLIB
+    switch (codec)
+    {
+    case SAVE_CODEC_ZLIB:
+        zs.zalloc    = 0;
+        zs.zfree     = 0;
+        zs.opaque    = Z_NULL;
+        zs.next_in   = z_buffer;
+        zs.avail_in  = in_len;
+        if (inflateInit(&zs))
+            fail("save file decompression failed during init: %s", zs.msg);
+        break;
+#ifdef USE_ZSTD
+    case SAVE_CODEC_ZSTD:
+        zstd = ZSTD_createDStream();
+        if (!zstd || ZSTD_isError(ZSTD_initDStream(zstd)))
+            fail("save file decompression failed during init");
+        break;
+#endif
+#ifdef USE_LZ4
+    case SAVE_CODEC_LZ4:
+    {
+        const size_t res = LZ4F_createDecompressionContext(&lz4, LZ4F_VERSION);
+        if (LZ4F_isError(res))
+        {
+            fail("save file decompression failed during init: %s",
+                 LZ4F_getErrorName(res));
+        }
+        break;
+    }
+#endif
+    default:
+        die("save codec %s is not supported", save_codec_name(codec));
+    }
+#endif
 }
 
 chunk_reader::chunk_reader(package *parent, plen_t start)
@@ -842,8 +1224,28 @@ chunk_reader::~chunk_reader()
     dprintf("chunk_reader: closing\n");
 
 #ifdef USE_ZLIB
-    if (inflateEnd(&zs) != Z_OK)
-        fail("save file decompression failed during clean-up: %s", zs.msg);
+    switch (codec)
+    {
+    case SAVE_CODEC_ZLIB:
+        if (inflateEnd(&zs) != Z_OK)
+        {
+            fail("save file decompression failed during clean-up: %s",
+                 zs.msg);
+        }
+        break;
+#ifdef USE_ZSTD
+    case SAVE_CODEC_ZSTD:
+        ZSTD_freeDStream(zstd);
+        break;
+#endif
+#ifdef USE_LZ4
+    case SAVE_CODEC_LZ4:
+        LZ4F_freeDecompressionContext(lz4);
+        break;
+#endif
+    default:
+        break;
+    }
 #endif
     ASSERT(pkg->reader_count[first_block] > 0);
     if (!--pkg->reader_count[first_block])
@@ -910,6 +1312,29 @@ plen_t chunk_reader::read(void *data, plen_t len)
     if (eof)
         return 0;
 
+    switch (codec)
+    {
+    case SAVE_CODEC_ZLIB:
+        return read_zlib(data, len);
+#ifdef USE_ZSTD
+    case SAVE_CODEC_ZSTD:
+        return read_zstd(data, len);
+#endif
+#ifdef USE_LZ4
+    case SAVE_CODEC_LZ4:
+        return read_lz4(data, len);
+#endif
+    default:
+        die("save codec %s is not supported", save_codec_name(codec));
+    }
+#else
+    return raw_read(data, len);
+#endif
+}
+
+plen_t chunk_reader::read_zlib(void *data, plen_t len)
+{
+#ifdef USE_ZLIB
     zs.next_out  = (Bytef*)data;
     zs.avail_out = len;
     while (zs.avail_out)
@@ -936,6 +1361,84 @@ plen_t chunk_reader::read(void *data, plen_t len)
 #endif
 }
 
+#ifdef USE_ZSTD
+plen_t chunk_reader::read_zstd(void *data, plen_t len)
+{
+    ZSTD_outBuffer out = { data, len, 0 };
+    while (out.pos < out.size)
+    {
+        ZSTD_inBuffer in = { z_buffer, in_len, in_pos };
+        const size_t before = out.pos;
+        const size_t res = ZSTD_decompressStream(zstd, &out, &in);
+        if (ZSTD_isError(res))
+        {
+            corrupted("save file decompression failed: %s",
+                      ZSTD_getErrorName(res));
+        }
+        in_pos = in.pos;
+        if (!res)
+        {
+            eof = true;
+            break;
+        }
+        // The decoder may still hold output after using up its input, so
+        // only fetch more once it stops making progress.
+        if (out.pos == before && in_pos == in_len)
+        {
+            in_pos = 0;
+            in_len = raw_read(z_buffer, sizeof(z_buffer));
+            if (!in_len)
+                corrupted("save file corrupted -- block truncated");
+        }
+    }
+    return out.pos;
+}
+#endif
+
+#ifdef USE_LZ4
+plen_t chunk_reader::read_lz4(void *data, plen_t len)
+{
+    plen_t done = 0;
+    while (done < len)
+    {
+        size_t out_size = len - done;
+        size_t in_size = in_len - in_pos;
+        const size_t res = LZ4F_decompress(lz4, (char*)data + done, &out_size,
+                                           z_buffer + in_pos, &in_size,
+                                           nullptr);
+        if (LZ4F_isError(res))
+        {
+            corrupted("save file decompression failed: %s",
+                      LZ4F_getErrorName(res));
+        }
+        in_pos += in_size;
+        done += out_size;
+        if (!res)
+        {
+            eof = true;
+            break;
+        }
+        if (!out_size && in_pos == in_len)
+        {
+            in_pos = 0;
+            in_len = raw_read(z_buffer, sizeof(z_buffer));
+            if (!in_len)
+                corrupted("save file corrupted -- block truncated");
+        }
+    }
+    return done;
+}
+#endif
+
+save_codec chunk_reader::get_codec() const
+{
+#ifdef USE_ZLIB
+    return codec;
+#else
+    return SAVE_CODEC_ZLIB;
+#endif
+}
+
 void chunk_reader::read_all(vector<char> &data)
 {
 #define SPACE 1024
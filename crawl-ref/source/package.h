@@ -8,6 +8,14 @@
 #ifdef USE_ZLIB
 #include <zlib.h>
 #endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef USE_LZ4
+#include <lz4frame.h>
+#endif
+
+#include "save-codec-type.h"
 
 #if !defined(DGAMELAUNCH) && !defined(__ANDROID__) && !defined(DEBUG_DIAGNOSTICS)
 #define DO_FSYNC
@@ -17,6 +25,9 @@
 
 typedef uint32_t plen_t;
 
+const char* save_codec_name(save_codec codec);
+bool save_codec_supported(save_codec codec);
+
 class package;
 
 class chunk_writer
@@ -28,11 +39,21 @@ private:
     plen_t cur_block;
     plen_t block_len;
 #ifdef USE_ZLIB
+    save_codec codec;
     z_stream zs;
     Bytef *z_buffer;
+    size_t z_buffer_size;
+#endif
+#ifdef USE_ZSTD
+    ZSTD_CStream *zstd;
+#endif
+#ifdef USE_LZ4
+    LZ4F_cctx *lz4;
+    LZ4F_preferences_t lz4_prefs;
 #endif
     void raw_write(const void *data, plen_t len);
     void finish_block(plen_t next);
+    void finish_stream();
 public:
     chunk_writer(package *parent, const string &_name);
     ~chunk_writer();
@@ -49,16 +70,34 @@ private:
     plen_t first_block, next_block;
     plen_t off, block_left;
 #ifdef USE_ZLIB
+    save_codec codec;
     bool eof;
     z_stream zs;
     Bytef z_buffer[32768];
+    // Unconsumed input in z_buffer, for the codecs other than zlib.
+    plen_t in_pos, in_len;
+#endif
+#ifdef USE_ZSTD
+    ZSTD_DStream *zstd;
+#endif
+#ifdef USE_LZ4
+    LZ4F_dctx *lz4;
 #endif
     plen_t raw_read(void *data, plen_t len);
+    void start_stream();
+    plen_t read_zlib(void *data, plen_t len);
+#ifdef USE_ZSTD
+    plen_t read_zstd(void *data, plen_t len);
+#endif
+#ifdef USE_LZ4
+    plen_t read_lz4(void *data, plen_t len);
+#endif
 public:
     chunk_reader(package *parent, const string &_name);
     ~chunk_reader();
     plen_t read(void *data, plen_t len);
     void read_all(vector<char> &data);
+    save_codec get_codec() const;
     friend class package;
 };
 
@@ -76,12 +115,16 @@ public:
     vector<string> list_chunks();
     void abort();
     void unlink();
+    // Codec and level used for chunks written from now on. A level of 0
+    // picks the codec's default.
+    void set_codec(save_codec new_codec, int level = 0);
 
     // statistics
     plen_t get_slack();
     plen_t get_size() const { return file_len; };
     plen_t get_chunk_fragmentation(const string &name);
     plen_t get_chunk_compressed_length(const string &name);
+    save_codec get_chunk_codec(const string &name);
 private:
     string filename;
     bool rw;
@@ -90,10 +133,17 @@ private:
     int n_users;
     bool dirty;
     bool aborted;
+    save_codec codec;
+    int codec_level;
 #ifdef DO_FSYNC
     bool tmp;
 #endif
     map<string, plen_t> directory;
+    // Superseded directory records still needed to rebuild the directory,
+    // oldest first; the newest record is directory[""].
+    vector<plen_t> journal;
+    // Chunks written or deleted since the last commit.
+    set<string> changed_chunks;
     map<plen_t, plen_t> free_blocks;
     vector<plen_t> unlinked_blocks;
     map<plen_t, pair<plen_t, plen_t> > block_map;
@@ -104,12 +154,15 @@ private:
     void finish_chunk(const string &name, plen_t at);
     void free_chunk(const string &name);
     plen_t write_directory();
+    bool want_full_directory();
+    plen_t chain_length(plen_t at);
     void collect_blocks();
     void free_block_chain(plen_t at);
     void free_block(plen_t at, plen_t size);
     void seek(plen_t to);
     void fsck();
     void read_directory(plen_t start, uint8_t version);
+    void read_directory_record(plen_t start, map<string, plen_t> &entries);
     void trace_chunk(plen_t start);
     void load();
     void load_traces();
@@ -1,5 +1,7 @@
 #include "AppHdr.h"
 
+#include <algorithm>
+
 #ifdef REGEX_PCRE
     // Statically link pcre on Windows
     #if defined(TARGET_OS_WINDOWS)
@@ -13,6 +15,7 @@
     #include <regex.h>
 #endif
 
+#include "libutil.h"
 #include "pattern.h"
 #include "stringutil.h"
 
@@ -20,40 +23,67 @@
 ////////////////////////////////////////////////////////////////////
 // Perl Compatible Regular Expressions
 
+struct compiled_pcre
+{
+    pcre *re;
+    pcre_extra *extra;
+};
+
 static void *_compile_pattern(const char *pattern, bool icase)
 {
     const char *error;
     int erroffset;
     int flags = icase ? PCRE_CASELESS : 0;
-    return pcre_compile(pattern,
-                        flags,
-                        &error,
-                        &erroffset,
-                        nullptr);
+    pcre *re = pcre_compile(pattern,
+                            flags,
+                            &error,
+                            &erroffset,
+                            nullptr);
+    if (!re)
+        return nullptr;
+
+    // rc patterns are compiled once and then run against item names and
+    // messages over and over, so study them: this finds the literal a match
+    // has to start with, and lets the JIT turn the pattern into native code.
+    compiled_pcre *cp = new compiled_pcre;
+    cp->re = re;
+#ifdef PCRE_STUDY_JIT_COMPILE
+    cp->extra = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &error);
+#else
+    cp->extra = pcre_study(re, 0, &error);
+#endif
+    return cp;
 }
 
-static void _free_compiled_pattern(void *cp)
+static void _free_compiled_pattern(void *p)
 {
-    if (cp)
-        pcre_free(cp);
+    if (!p)
+        return;
+
+    compiled_pcre *cp = static_cast<compiled_pcre *>(p);
+#ifdef PCRE_STUDY_JIT_COMPILE
+    pcre_free_study(cp->extra);
+#else
+    if (cp->extra)
+        pcre_free(cp->extra);
+#endif
+    pcre_free(cp->re);
+    delete cp;
 }
 
 static bool _pattern_match(void *compiled_pattern, const char *text, int length)
 {
-    int ovector[42];
-    int pcre_rc = pcre_exec(static_cast<pcre *>(compiled_pattern),
-                            nullptr,
-                            text, length, 0, 0,
-                            ovector, sizeof(ovector) / sizeof(*ovector));
-    return pcre_rc >= 0;
+    const compiled_pcre *cp = static_cast<compiled_pcre *>(compiled_pattern);
+    // No captures are needed just to test for a match.
+    return pcre_exec(cp->re, cp->extra, text, length, 0, 0, nullptr, 0) >= 0;
 }
 
 static pattern_match _pattern_match_location(void *compiled_pattern,
                                              const char *text, int length)
 {
+    const compiled_pcre *cp = static_cast<compiled_pcre *>(compiled_pattern);
     int ovector[42];
-    int pcre_rc = pcre_exec(static_cast<pcre *>(compiled_pattern),
-                            nullptr,
+    int pcre_rc = pcre_exec(cp->re, cp->extra,
                             text, length, 0, 0,
                             ovector, sizeof(ovector) / sizeof(*ovector));
     if (pcre_rc >= 0)
@@ -145,6 +175,7 @@ const text_pattern &text_pattern::operator= (const text_pattern &tp)
     pattern = tp.pattern;
     compiled_pattern = nullptr;
     isvalid      = tp.isvalid;
+    is_literal   = false;
     ignore_case  = tp.ignore_case;
     return *this;
 }
@@ -159,6 +190,7 @@ const text_pattern &text_pattern::operator= (const string &spattern)
     pattern = spattern;
     compiled_pattern = nullptr;
     isvalid = true;
+    is_literal = false;
     // We don't change ignore_case
     return *this;
 }
@@ -171,24 +203,62 @@ bool text_pattern::operator== (const text_pattern &tp) const
     return pattern == tp.pattern && ignore_case == tp.ignore_case;
 }
 
+static bool _is_literal_pattern(const string &pattern)
+{
+    return pattern.find_first_of("\\^$.|?*+()[]{}") == string::npos;
+}
+
+static bool _ascii_iequal(char a, char b)
+{
+    return toalower(a) == toalower(b);
+}
+
+// Where the literal pattern first occurs in s, or -1.
+static int _find_literal(const string &pattern, bool icase,
+                         const char *s, int length)
+{
+    const char *end = s + length;
+    const char *found =
+        icase ? search(s, end, pattern.begin(), pattern.end(), _ascii_iequal)
+              : search(s, end, pattern.begin(), pattern.end());
+    return found == end ? -1 : found - s;
+}
+
 bool text_pattern::compile() const
 {
-    return !empty()?
-        !!(compiled_pattern = _compile_pattern(pattern.c_str(), ignore_case))
-      : false;
+    if (empty())
+        return false;
+
+    if (_is_literal_pattern(pattern))
+        return is_literal = true;
+
+    return !!(compiled_pattern = _compile_pattern(pattern.c_str(), ignore_case));
 }
 
 bool text_pattern::matches(const char *s, int length) const
 {
-    return valid() && _pattern_match(compiled_pattern, s, length);
+    if (!valid())
+        return false;
+    if (is_literal)
+        return _find_literal(pattern, ignore_case, s, length) != -1;
+    return _pattern_match(compiled_pattern, s, length);
 }
 
 pattern_match text_pattern::match_location(const char *s, int length) const
 {
-    if (valid())
-        return _pattern_match_location(compiled_pattern, s, length);
-    else
+    if (!valid())
         return pattern_match::failed(string(s));
+
+    if (is_literal)
+    {
+        const int start = _find_literal(pattern, ignore_case, s, length);
+        if (start == -1)
+            return pattern_match::failed(string(s));
+        return pattern_match::succeeded(string(s), start,
+                                        start + pattern.length());
+    }
+
+    return _pattern_match_location(compiled_pattern, s, length);
 }
 
 const plaintext_pattern &plaintext_pattern::operator= (const string &spattern)
@@ -54,13 +54,13 @@ class text_pattern : public base_pattern
 public:
     text_pattern(const string &s, bool icase = false)
         : pattern(s), compiled_pattern(nullptr),
-          isvalid(true), ignore_case(icase)
+          isvalid(true), is_literal(false), ignore_case(icase)
     {
     }
 
     text_pattern()
         : pattern(), compiled_pattern(nullptr),
-         isvalid(false), ignore_case(false)
+         isvalid(false), is_literal(false), ignore_case(false)
     {
     }
 
@@ -69,6 +69,7 @@ public:
           pattern(tp.pattern),
           compiled_pattern(nullptr),
           isvalid(tp.isvalid),
+          is_literal(false),
           ignore_case(tp.ignore_case)
     {
     }
@@ -84,7 +85,7 @@ public:
     bool valid() const override
     {
         return isvalid
-            && (compiled_pattern || (isvalid = compile()));
+            && (compiled_pattern || is_literal || (isvalid = compile()));
     }
 
     bool matches(const char *s, int length) const;
@@ -120,6 +121,9 @@ private:
     string pattern;
     mutable void *compiled_pattern;
     mutable bool isvalid;
+    // Set by compile() for patterns with no regex syntax at all, which are
+    // matched with a plain substring search instead of the regex engine.
+    mutable bool is_literal;
     bool ignore_case;
 };
 
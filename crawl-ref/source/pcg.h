@@ -5,8 +5,9 @@ class PcgRNG
     public:
         PcgRNG();
         PcgRNG(uint64_t init_key[], int key_length);
-        uint32_t get_uint32();
-        uint64_t get_uint64();
+        // Defined below: nearly every random number goes through these.
+        inline uint32_t get_uint32();
+        inline uint64_t get_uint64();
         uint32_t operator()() { return get_uint32(); }
 
         typedef uint32_t result_type;
@@ -17,3 +18,25 @@ class PcgRNG
         uint64_t state_;
         uint64_t inc_;
 };
+
+/* get_uint32 is derived from M.E. O'Neill's minimal PCG implementation.
+ * That function (c) 2014 M.E. O'Neill / pcg-random.org
+ * Licensed under Apache License 2.0
+ */
+inline uint32_t
+PcgRNG::get_uint32()
+{
+    uint64_t oldstate = state_;
+    // Advance internal state
+    state_ = oldstate * 6364136223846793005ULL + (inc_|1);
+    // Calculate output function (XSH RR), uses old state for max ILP
+    uint32_t xorshifted = ((oldstate >> 18u) ^ oldstate) >> 27u;
+    uint32_t rot = oldstate >> 59u;
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+inline uint64_t
+PcgRNG::get_uint64()
+{
+  return static_cast<uint64_t>(get_uint32()) << 32 | get_uint32();
+}
@@ -504,7 +504,7 @@ static void _handle_recitation(int step)
          zin_recite_text(you.attribute[ATTR_RECITE_SEED],
                          you.attribute[ATTR_RECITE_TYPE], step).c_str());
 
-    if (apply_area_visible(zin_recite_to_single_monster, you.pos()))
+    if (apply_area_visible_actors(zin_recite_to_single_monster, you.pos()))
         viewwindow();
 
     // Recite trains more than once per use, because it has a
@@ -2271,6 +2271,43 @@ int player_wizardry(spell_type spell)
            + you.wearing(EQ_STAFF, STAFF_WIZARDRY);
 }
 
+struct derived_stat_cache
+{
+    int depth;
+    bool have_ac, have_ev, have_sh;
+    int ac, ev, sh;
+};
+static derived_stat_cache _derived_stats;
+
+derived_stat_cache_scope::derived_stat_cache_scope()
+{
+    if (!_derived_stats.depth++)
+        _derived_stats.have_ac = _derived_stats.have_ev
+                               = _derived_stats.have_sh = false;
+}
+
+derived_stat_cache_scope::~derived_stat_cache_scope()
+{
+    --_derived_stats.depth;
+}
+
+// If a derived_stat_cache_scope is alive, fetch value from the cache,
+// filling it with calc() the first time.
+template<typename F>
+static int _cached_derived_stat(bool &have, int &value, F calc)
+{
+    if (!_derived_stats.depth)
+        return calc();
+    if (!have)
+    {
+        value = calc();
+        have = true;
+    }
+    return value;
+}
+
+static int _player_shield_class();
+
 /**
  * Calculate the SH value used internally.
  *
@@ -2278,6 +2315,12 @@ int player_wizardry(spell_type spell)
  * @return      The player's current SH value.
  */
 int player_shield_class()
+{
+    return _cached_derived_stat(_derived_stats.have_sh, _derived_stats.sh,
+                                _player_shield_class);
+}
+
+static int _player_shield_class()
 {
     int shield = 0;
 
@@ -2964,6 +3007,7 @@ void level_change(bool skip_attribute_increase)
                     }
                 }
 
+                mutation_batch batch;
                 for (const player::demon_trait trait : you.demonic_traits)
                 {
                     if (trait.level_gained == you.experience_level)
@@ -5965,6 +6009,12 @@ int player::base_ac(int scale) const
 }
 
 int player::armour_class(bool /*calc_unid*/) const
+{
+    return _cached_derived_stat(_derived_stats.have_ac, _derived_stats.ac,
+                                [this] { return _armour_class(); });
+}
+
+int player::_armour_class() const
 {
     const int scale = 100;
     int AC = base_ac(scale);
@@ -6038,6 +6088,17 @@ int player::gdr_perc() const
  * @return         The player's relevant EV.
  */
 int player::evasion(ev_ignore_type evit, const actor* act) const
+{
+    if (evit == EV_IGNORE_NONE && !act)
+    {
+        return _cached_derived_stat(_derived_stats.have_ev, _derived_stats.ev,
+                                    [this] { return _evasion(EV_IGNORE_NONE,
+                                                             nullptr); });
+    }
+    return _evasion(evit, act);
+}
+
+int player::_evasion(ev_ignore_type evit, const actor* act) const
 {
     const int base_evasion = _player_evasion(evit);
 
@@ -893,6 +893,9 @@ protected:
 
     void _removed_fearmonger(bool quiet = false);
     bool _possible_fearmonger(const monster* mon) const;
+
+    int _armour_class() const;
+    int _evasion(ev_ignore_type evit, const actor *act) const;
 };
 COMPILE_CHECK((int) SP_UNKNOWN_BRAND < 8*sizeof(you.seen_weapon[0]));
 COMPILE_CHECK((int) SP_UNKNOWN_BRAND < 8*sizeof(you.seen_armour[0]));
@@ -992,6 +995,21 @@ int player_res_magic(bool calc_unid = true, bool temp = true);
 
 int player_shield_class();
 int player_displayed_shield_class();
+
+// While one of these is alive, you.armour_class(), you.evasion() with no
+// arguments and player_shield_class() are worked out once and remembered.
+// Keep it around code that shows those values and can't change them, such
+// as drawing the stat panel.
+class derived_stat_cache_scope
+{
+public:
+    derived_stat_cache_scope();
+    ~derived_stat_cache_scope();
+
+    derived_stat_cache_scope(const derived_stat_cache_scope&) = delete;
+    derived_stat_cache_scope& operator=(const derived_stat_cache_scope&)
+        = delete;
+};
 bool player_omnireflects();
 
 int player_spec_air();
@@ -803,6 +803,7 @@ public:
         bool mutated = false;
         int remove_mutations = random_range(MIN_REMOVED, MAX_REMOVED);
         int add_mutations = random_range(MIN_ADDED, MAX_ADDED);
+        mutation_batch batch;
 
         // Remove mutations.
         for (int i = 0; i < remove_mutations; i++)
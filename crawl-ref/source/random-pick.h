@@ -27,6 +27,16 @@ struct random_pick_entry
     T value;
 };
 
+// The entries of one table that can appear at one level, with their
+// rarities there and the running total of those rarities.
+template <typename T>
+struct random_pick_table
+{
+    vector<T> values;
+    vector<int> rarities;
+    vector<int> cumulative;
+};
+
 template <typename T, int max>
 class random_picker
 {
@@ -36,6 +46,13 @@ public:
     int rarity_at(const random_pick_entry<T> *pop,
                   int depth);
     virtual bool veto(T val) { return false; }
+    // Whether veto() might refuse anything. Subclasses whose veto() never
+    // does can say so, and are picked for without looking at each entry.
+    virtual bool has_veto() const { return true; }
+
+private:
+    const random_pick_table<T> &table_at(const random_pick_entry<T> *weights,
+                                         int level);
 };
 
 template <typename T, int max>
@@ -43,28 +60,67 @@ random_picker<T, max>::~random_picker()
 {
 }
 
+// The weight tables are all static, so what each offers at a given level is
+// worked out once and kept.
 template <typename T, int max>
-T random_picker<T, max>::pick(const random_pick_entry<T> *weights, int level,
-                              T none)
+const random_pick_table<T> &
+random_picker<T, max>::table_at(const random_pick_entry<T> *weights, int level)
 {
-    struct { T value; int rarity; } valid[max];
-    int nvalid = 0;
-    int totalrar = 0;
+    static map<pair<const random_pick_entry<T> *, int>, random_pick_table<T>>
+        tables;
+
+    const auto key = make_pair(weights, level);
+    auto it = tables.find(key);
+    if (it != tables.end())
+        return it->second;
 
+    random_pick_table<T> &table = tables[key];
+    int totalrar = 0;
     for (const random_pick_entry<T> *pop = weights; pop->rarity; pop++)
     {
         if (level < pop->minr || level > pop->maxr)
             continue;
 
-        if (veto(pop->value))
-            continue;
-
         int rar = rarity_at(pop, level);
         ASSERTM(rar > 0, "Rarity %d: %d at level %d", rar, pop->value, level);
 
-        valid[nvalid].value = pop->value;
-        valid[nvalid].rarity = rar;
         totalrar += rar;
+        table.values.push_back(pop->value);
+        table.rarities.push_back(rar);
+        table.cumulative.push_back(totalrar);
+    }
+    return table;
+}
+
+template <typename T, int max>
+T random_picker<T, max>::pick(const random_pick_entry<T> *weights, int level,
+                              T none)
+{
+    const random_pick_table<T> &table = table_at(weights, level);
+
+    if (!has_veto())
+    {
+        if (table.values.empty())
+            return none;
+
+        const int roll = random2(table.cumulative.back()); // the roll!
+        const auto chosen = upper_bound(table.cumulative.begin(),
+                                        table.cumulative.end(), roll);
+        return table.values[chosen - table.cumulative.begin()];
+    }
+
+    struct { T value; int rarity; } valid[max];
+    int nvalid = 0;
+    int totalrar = 0;
+
+    for (size_t i = 0; i < table.values.size(); i++)
+    {
+        if (veto(table.values[i]))
+            continue;
+
+        valid[nvalid].value = table.values[i];
+        valid[nvalid].rarity = table.rarities[i];
+        totalrar += table.rarities[i];
         nvalid++;
     }
 
@@ -50,6 +50,17 @@ void seed_rng()
     _seed_rng(seed_key, ARRAYSZ(seed_key));
 }
 
+rng_override::rng_override(uint64_t seed_array[], int seed_len)
+    : saved(rngs[RNG_GAMEPLAY])
+{
+    rngs[RNG_GAMEPLAY] = PcgRNG(seed_array, seed_len);
+}
+
+rng_override::~rng_override()
+{
+    rngs[RNG_GAMEPLAY] = saved;
+}
+
 // [low, high]
 int random_range(int low, int high)
 {
@@ -65,16 +76,15 @@ int random_range(int low, int high, int nrolls)
     return low + roll;
 }
 
-static int _random2(int max, int rng)
+// A uniform draw from [0, max), for max > 1, given the partition size
+// PcgRNG::max() / max. Loops that draw many times from the same range work
+// that out once and go through this directly; the values are exactly those
+// random2() would give.
+static int _random2_partn(int max, uint32_t partn, PcgRNG &rng)
 {
-    if (max <= 1)
-        return 0;
-
-    uint32_t partn = PcgRNG::max() / max;
-
     while (true)
     {
-        uint32_t bits = get_uint32(rng);
+        uint32_t bits = rng.get_uint32();
         uint32_t val  = bits / partn;
 
         if (val < (uint32_t)max)
@@ -82,6 +92,14 @@ static int _random2(int max, int rng)
     }
 }
 
+static int _random2(int max, int rng)
+{
+    if (max <= 1)
+        return 0;
+
+    return _random2_partn(max, PcgRNG::max() / max, rngs[rng]);
+}
+
 // [0, max)
 int random2(int max)
 {
@@ -144,8 +162,13 @@ int roll_dice(int num, int size)
     {
         ret += num;     // since random2() is zero based
 
-        for (int i = 0; i < num; i++)
-            ret += random2(size);
+        if (size > 1)
+        {
+            const uint32_t partn = PcgRNG::max() / size;
+            PcgRNG &rng = rngs[RNG_GAMEPLAY];
+            for (int i = 0; i < num; i++)
+                ret += _random2_partn(size, partn, rng);
+        }
     }
 
     return ret;
@@ -207,8 +230,13 @@ int random2avg(int max, int rolls)
 {
     int sum = random2(max);
 
-    for (int i = 0; i < (rolls - 1); i++)
-        sum += random2(max + 1);
+    if (max + 1 > 1)
+    {
+        const uint32_t partn = PcgRNG::max() / (max + 1);
+        PcgRNG &rng = rngs[RNG_GAMEPLAY];
+        for (int i = 0; i < (rolls - 1); i++)
+            sum += _random2_partn(max + 1, partn, rng);
+    }
 
     return sum / rolls;
 }
@@ -237,8 +265,13 @@ int random2limit(int max, int limit)
     if (max < 1)
         return 0;
 
+    if (limit <= 1)
+        return 1; // random2(limit) is always 0, which only passes for i = 0.
+
+    const uint32_t partn = PcgRNG::max() / limit;
+    PcgRNG &rng = rngs[RNG_GAMEPLAY];
     for (int i = 0; i < max; i++)
-        if (random2(limit) >= i)
+        if (_random2_partn(limit, partn, rng) >= i)
             sum++;
 
     return sum;
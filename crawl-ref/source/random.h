@@ -6,12 +6,30 @@
 #include <vector>
 
 #include "hash.h"
+#include "pcg.h"
 #include "rng-type.h"
 
 void seed_rng();
 void seed_rng(uint32_t seed);
 void seed_rng(uint64_t[], int);
 
+/**
+ * Replace the gameplay RNG with a freshly seeded one for the lifetime of this
+ * object, so that e.g. level generation draws from a stream that depends only
+ * on its seed. The original stream is restored untouched on destruction.
+ */
+class rng_override
+{
+public:
+    rng_override(uint64_t seed_array[], int seed_len);
+    ~rng_override();
+
+    rng_override(const rng_override&) = delete;
+    rng_override& operator=(const rng_override&) = delete;
+private:
+    PcgRNG saved;
+};
+
 uint32_t get_uint32(int generator = RNG_GAMEPLAY);
 uint64_t get_uint64(int generator = RNG_GAMEPLAY);
 bool coinflip();
@@ -34,28 +34,34 @@ ranged_attack::ranged_attack(actor *attk, actor *defn, item_def *proj,
     init_attack(SK_THROWING, 0);
     kill_type = KILLED_BY_BEAM;
 
-    string proj_name = projectile->name(DESC_PLAIN);
     // init launch type early, so we can use it later in the constructor
     launch_type = is_launched(attacker, weapon, *projectile);
 
-    // [dshaligram] When changing bolt names here, you must edit
-    // hiscores.cc (scorefile_entry::terse_missile_cause()) to match.
     if (attacker->is_player())
-    {
         kill_type = KILLED_BY_SELF_AIMED;
-        aux_source = proj_name;
-    }
-    else if (launch_type == launch_retval::LAUNCHED)
-    {
-        aux_source = make_stringf("Shot with a%s %s by %s",
-                 (is_vowel(proj_name[0]) ? "n" : ""), proj_name.c_str(),
-                 attacker->name(DESC_A).c_str());
-    }
-    else
+
+    // Only the player's death records the aux source, and naming the
+    // projectile and attacker is slow, so don't bother for every arrow of
+    // a monster volley.
+    // [dshaligram] When changing bolt names here, you must edit
+    // hiscores.cc (scorefile_entry::terse_missile_cause()) to match.
+    if (defender->is_player())
     {
-        aux_source = make_stringf("Hit by a%s %s thrown by %s",
-                 (is_vowel(proj_name[0]) ? "n" : ""), proj_name.c_str(),
-                 attacker->name(DESC_A).c_str());
+        const string proj_name = projectile->name(DESC_PLAIN);
+        if (attacker->is_player())
+            aux_source = proj_name;
+        else if (launch_type == launch_retval::LAUNCHED)
+        {
+            aux_source = make_stringf("Shot with a%s %s by %s",
+                     (is_vowel(proj_name[0]) ? "n" : ""), proj_name.c_str(),
+                     attacker->name(DESC_A).c_str());
+        }
+        else
+        {
+            aux_source = make_stringf("Hit by a%s %s thrown by %s",
+                     (is_vowel(proj_name[0]) ? "n" : ""), proj_name.c_str(),
+                     attacker->name(DESC_A).c_str());
+        }
     }
 
     needs_message = defender_visible;
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <cctype>
 #include <iostream>
+#include <iterator>
 #include <fstream>
 #include <string.h>
 #include <stdlib.h>
@@ -875,6 +876,41 @@ void tile_list_processor::add_abstracts(
     }
 }
 
+// Generated source is written to a temporary file and only moved over the
+// real one if something changed, so that regenerating a page with the same
+// tiles leaves its headers' timestamps alone and nothing that includes them
+// gets rebuilt.
+static FILE *_open_output(const char *filename)
+{
+    return fopen((string(filename) + ".tmp").c_str(), "w");
+}
+
+static bool _same_contents(const string &a, const string &b)
+{
+    ifstream fa(a.c_str(), ios::binary), fb(b.c_str(), ios::binary);
+    if (!fa || !fb)
+        return false;
+    istreambuf_iterator<char> ia(fa), ib(fb), end;
+    for (; ia != end && ib != end; ++ia, ++ib)
+        if (*ia != *ib)
+            return false;
+    return ia == end && ib == end;
+}
+
+static void _close_output(FILE *fp, const char *filename)
+{
+    fclose(fp);
+    const string tmp = string(filename) + ".tmp";
+    if (_same_contents(tmp, filename))
+        remove(tmp.c_str());
+    else
+    {
+        // rename() won't replace an existing file everywhere.
+        remove(filename);
+        rename(tmp.c_str(), filename);
+    }
+}
+
 bool tile_list_processor::write_data(bool image, bool code)
 {
     if (m_name == "")
@@ -944,7 +980,7 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "tiledef-%s.h", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _open_output(filename);
 
         if (!fp)
         {
@@ -1093,7 +1129,7 @@ bool tile_list_processor::write_data(bool image, bool code)
                     lcname.c_str(), ctg_max.c_str());
         }
 
-        fclose(fp);
+        _close_output(fp, filename);
     }
 
     // write "tiledef-%name.cc"
@@ -1101,7 +1137,7 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "tiledef-%s.cc", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _open_output(filename);
 
         if (!fp)
         {
@@ -1335,7 +1371,7 @@ bool tile_list_processor::write_data(bool image, bool code)
             "}\n\n",
             lcname.c_str(), lcname.c_str(), lcname.c_str(), lcname.c_str());
 
-        fclose(fp);
+        _close_output(fp, filename);
     }
     else
     {
@@ -1347,7 +1383,7 @@ bool tile_list_processor::write_data(bool image, bool code)
 
         char filename[1024];
         sprintf(filename, "tiledef-%s.cc", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _open_output(filename);
 
         if (!fp)
         {
@@ -1428,7 +1464,7 @@ bool tile_list_processor::write_data(bool image, bool code)
         add_abstracts(fp, "return (tile_%s_coloured(idx, col));", lc_enum, uc_max_enum);
         fprintf(fp, "}\n\n");
 
-        fclose(fp);
+        _close_output(fp, filename);
     }
 
     // write "tile-%name.html"
@@ -1436,7 +1472,7 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "tile-%s.html", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _open_output(filename);
 
         if (!fp)
         {
@@ -1506,7 +1542,7 @@ bool tile_list_processor::write_data(bool image, bool code)
 
         fprintf(fp, "</table></html>\n");
 
-        fclose(fp);
+        _close_output(fp, filename);
     }
 
     delete[] part_min;
@@ -1516,7 +1552,7 @@ bool tile_list_processor::write_data(bool image, bool code)
     {
         char filename[1024];
         sprintf(filename, "%s.d", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _open_output(filename);
 
         if (!fp)
         {
@@ -1538,14 +1574,14 @@ bool tile_list_processor::write_data(bool image, bool code)
         for (const auto& str : m_depends)
              fprintf(fp, "%s:\n", str.c_str());
 
-        fclose(fp);
+        _close_output(fp, filename);
     }
 
     // write "tileinfo-%name.js"
     {
         char filename[1024];
         sprintf(filename, "tileinfo-%s.js", lcname.c_str());
-        FILE *fp = fopen(filename, "w");
+        FILE *fp = _open_output(filename);
 
         if (!fp)
         {
@@ -1746,7 +1782,7 @@ bool tile_list_processor::write_data(bool image, bool code)
 
         fprintf(fp, "return exports;\n});\n");
 
-        fclose(fp);
+        _close_output(fp, filename);
     }
 
     return true;
@@ -172,14 +172,16 @@ static bool _item_needs_rot_check(const item_def &item)
     if (!item.defined())
         return false;
 
-    if (item.props.exists(CORPSE_NEVER_DECAYS))
+    // Look at the type before the props: this is asked of every item on
+    // the level, and most of them can't rot.
+    if (!is_perishable_stack(item)
+        && (item.base_type != OBJ_CORPSES
+            || item.sub_type > CORPSE_SKELETON)) // XXX: is this needed?
+    {
         return false;
+    }
 
-    if (is_perishable_stack(item))
-        return true;
-
-    return item.base_type == OBJ_CORPSES
-           && item.sub_type <= CORPSE_SKELETON; // XXX: is this needed?
+    return !item.props.exists(CORPSE_NEVER_DECAYS);
 }
 
 /**
@@ -375,8 +377,9 @@ void rot_inventory_food(int time_delta)
 #endif
 
         const int initial_quantity = item.quantity;
-        const string item_name = item.name(DESC_PLAIN, false);
         const bool is_chunk = _is_chunk(item);
+        // Only potions get a message of their own.
+        const string item_name = is_chunk ? "" : item.name(DESC_PLAIN, false);
 
         if (is_chunk)
             num_chunks += item.quantity;
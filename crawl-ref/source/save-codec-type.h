@@ -0,0 +1,13 @@
+#pragma once
+
+// How a save chunk's data is compressed. Every codec writes a
+// self-identifying stream (zstd and LZ4 frames start with their magic
+// numbers, anything else is taken to be zlib), so readers work out the codec
+// of each chunk from its first bytes and older saves load unchanged.
+enum save_codec
+{
+    SAVE_CODEC_ZLIB,
+    SAVE_CODEC_ZSTD,
+    SAVE_CODEC_LZ4,
+    NUM_SAVE_CODECS,
+};
@@ -0,0 +1,77 @@
+-- Times the geometry primitives under most hot paths (iterators, LOS, rays,
+-- circles and bit arrays) on a fixed set of generated levels, in ns per
+-- operation. With "save", writes the results to bench-core.baseline;
+-- otherwise compares them with that file if it exists, and fails if any
+-- primitive got more than 10% slower.
+
+local BASELINE = "bench-core.baseline"
+local TOLERANCE = 1.10
+
+local places = { "D:2", "D:12", "Lair:3", "Vaults:3", "Depths:2" }
+
+-- Operations per primitive per level; the cheaper ones get more of them.
+local primitives = {
+  { "rectangle_iterator",    20000 },
+  { "radius_iterator",       20000 },
+  { "distance_iterator",    200000 },
+  { "cell_see_cell",       1000000 },
+  { "cell_see_cell_nocache", 200000 },
+  { "los_update",            20000 },
+  { "ray",                  200000 },
+  { "circle",              2000000 },
+  { "bitary",              2000000 },
+}
+
+local args = script.simple_args()
+local save = args[1] == "save"
+if #args > 1 or #args == 1 and not save then
+  script.usage("Usage: bench-core [save]")
+end
+
+local totals = { }
+for seed, place in ipairs(places) do
+  debug.goto_place(place)
+  debug.seed_rng(seed)
+  test.regenerate_level()
+  for _, prim in ipairs(primitives) do
+    local name, ops = prim[1], prim[2]
+    local ns = debug.geometry_benchmark(name, ops)
+    totals[name] = (totals[name] or 0) + ns / #places
+  end
+end
+
+local baseline = { }
+local old = file.readfile(BASELINE)
+if old and not save then
+  for name, ns in string.gmatch(old, "(%S+)%s+(%S+)") do
+    baseline[name] = tonumber(ns)
+  end
+end
+
+local lines = { }
+local slower = { }
+crawl.stderr(string.format("%-22s %10s %10s", "primitive", "ns/op",
+                           "baseline"))
+for _, prim in ipairs(primitives) do
+  local name = prim[1]
+  local ns = totals[name]
+  local base = baseline[name]
+  local note = ""
+  if base and ns > base * TOLERANCE then
+    note = string.format("  %d%% slower", math.floor(100 * (ns / base - 1)))
+    table.insert(slower, name)
+  end
+  crawl.stderr(string.format("%-22s %10.1f %10s%s", name, ns,
+                             base and string.format("%.1f", base) or "-",
+                             note))
+  table.insert(lines, string.format("%s %.1f", name, ns))
+end
+
+if save then
+  assert(file.writefile(BASELINE, table.concat(lines, "\n") .. "\n"),
+         "Couldn't write " .. BASELINE)
+  crawl.stderr("Saved " .. BASELINE)
+end
+
+assert(#slower == 0, "Slower than " .. BASELINE .. ": "
+                     .. table.concat(slower, ", "))
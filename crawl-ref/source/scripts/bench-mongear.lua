@@ -0,0 +1,53 @@
+-- Times placing monsters that get handed weapons, armour and other gear, to
+-- show what give_item() costs per monster. The monsters are placed a
+-- hundred at a time on a floor patch of a fixed level, then dismissed
+-- along with their gear; only the placement is timed.
+
+local args = script.simple_args()
+local total = tonumber(args[1] or "10000")
+if #args > 1 or not total then
+  script.usage("Usage: bench-mongear [monsters]")
+end
+
+local types = {
+  "gnoll", "kobold", "goblin", "orc warrior", "orc knight", "orc priest",
+  "deep elf knight", "deep elf archer", "naga warrior", "centaur warrior",
+  "vault guard", "vault warden",
+}
+
+local SIDE = 10
+local ORIGIN = dgn.point(10, 10)
+
+debug.goto_place("D:10")
+debug.seed_rng(1)
+test.regenerate_level()
+debug.dismiss_monsters()
+for x = ORIGIN.x - 1, ORIGIN.x + SIDE do
+  for y = ORIGIN.y - 1, ORIGIN.y + SIDE do
+    dgn.grid(x, y, "floor")
+  end
+end
+you.moveto(ORIGIN.x - 1, ORIGIN.y - 1)
+
+local specs = { }
+for _, name in ipairs(types) do
+  table.insert(specs, dgn.monster_spec(name))
+end
+
+local placed, elapsed, n = 0, 0, 0
+while placed < total do
+  local batch = math.min(SIDE * SIDE, total - placed)
+  local began = crawl.millis()
+  for i = 0, batch - 1 do
+    n = n % #specs + 1
+    local x, y = ORIGIN.x + i % SIDE, ORIGIN.y + math.floor(i / SIDE)
+    assert(dgn.create_monster(x, y, specs[n]),
+           "Couldn't place " .. types[n])
+  end
+  elapsed = elapsed + crawl.millis() - began
+  placed = placed + batch
+  debug.dismiss_monsters()
+end
+
+crawl.stderr(string.format("%d monsters in %d ms, %.1f us each", placed,
+                           elapsed, elapsed * 1000 / placed))
@@ -0,0 +1,46 @@
+-- A headless fight simulator
+-- To simulate a level 15 Minotaur Fighter with a hand axe against some
+-- monsters, sharing the rounds between four processes, run it with:
+-- crawl -script fsim MiFi "hand axe" 15 4000 4 orc ogre "stone giant" 2> results.csv
+--
+-- Each line has the same tab separated columns as fsim.csv, after the
+-- monster's name and whether the player was attacking or defending.
+
+local args = script.simple_args()
+if #args < 6 then
+  script.usage([[
+Usage: fsim <combo> <weapon> <xl> <rounds> <jobs> <monster> [<monster> ...]
+]])
+end
+
+if not you.wizard then
+  script.usage("fsim needs a build with wizard mode.")
+end
+
+local columns = { "AvHitDam", "MaxDam", "Accuracy", "AvDam", "AvTime",
+                  "AvSpeed", "AvEffDam" }
+local formats = { "%.1f", "%d", "%d%%", "%.1f", "%d", "%.2f", "%.1f" }
+
+you.init(args[1], args[2])
+you.set_xl(tonumber(args[3]))
+local rounds = tonumber(args[4])
+crawl.setopt("fsim_jobs = " .. args[5])
+
+debug.flush_map_memory()
+debug.goto_place("D:1")
+debug.generate_level()
+dgn.grid(2, 2, "floor")
+dgn.grid(2, 3, "floor")
+you.moveto(2, 2)
+
+crawl.stderr("Monster\tMode\t" .. table.concat(columns, "\t"))
+for i = 6, #args do
+  for _, defend in ipairs({ false, true }) do
+    local result = wiz.fsim(args[i], rounds, defend)
+    local line = args[i] .. "\t" .. (defend and "defense" or "attack")
+    for j, column in ipairs(columns) do
+      line = line .. "\t" .. string.format(formats[j], result[column])
+    end
+    crawl.stderr(line)
+  end
+end
@@ -1,19 +1,27 @@
--- Generates maps for the supplied place names.
+-- Generates maps for the supplied place names. A place may be given as
+-- place@seed, with the seed in hex as for -seed, to reseed the RNG just
+-- before building it.
 
 local places = script.simple_args()
 if #places == 0 then
-  script.usage("Usage: genlevel <place> [<place2> ...]")
+  script.usage("Usage: genlevel <place>[@<seed>] [<place2>[@<seed2>] ...]")
 end
 
 local function map_dump_name_for_place(place)
-  return "dump-" .. string.gsub(place, ":", "-") .. ".map"
+  return "dump-" .. string.gsub(place, "[:@]", "-") .. ".map"
 end
 
-for _, place in ipairs(places) do
+for _, arg in ipairs(places) do
+  local place, seed = string.match(arg, "^(.-)@(%x+)$")
+  place = place or arg
+
   debug.goto_place(place)
+  if seed then
+    debug.seed_rng(tonumber(seed, 16))
+  end
   test.regenerate_level()
 
-  local filename = map_dump_name_for_place(place)
-  crawl.mpr("Dumping map of " .. place .. " to " .. filename)
+  local filename = map_dump_name_for_place(arg)
+  crawl.mpr("Dumping map of " .. arg .. " to " .. filename)
   debug.dump_map(filename)
 end
@@ -0,0 +1,80 @@
+-- Replays a recorded game and checks that it plays out exactly as it did
+-- when its golden digests were saved, and how long it took. Run it on a
+-- build before and after a change that shouldn't affect gameplay.
+--
+-- A keys file starts with the game to set up:
+--   seed 1
+--   char mifi morningstar
+--   place D:1
+-- and then has one command per line, as the keys to type for it; \{27}
+-- stands for the key with that code. After each line the state digest and
+-- turn count are compared with <keys file>.digest, written by "save".
+
+local args = script.simple_args()
+local keysfile, save = args[1], args[2] == "save"
+if not keysfile or #args > 2 or #args == 2 and not save then
+  script.usage("Usage: replay <keys file> [save]")
+end
+local goldfile = keysfile .. ".digest"
+
+local text = file.readfile(keysfile)
+assert(text, "Couldn't read " .. keysfile)
+
+local setup, commands = { }, { }
+for line in string.gmatch(text, "([^\n]*)\n") do
+  local key, val = string.match(line, "^(%a+) (.*)$")
+  if #commands == 0 and (key == "seed" or key == "char" or key == "place") then
+    setup[key] = val
+  elseif line ~= "" then
+    table.insert(commands, (string.gsub(line, "\\{(%d+)}", string.char)))
+  end
+end
+assert(setup.seed and setup.char and setup.place,
+       keysfile .. " needs seed, char and place lines before its keys")
+
+local combo, weapon = string.match(setup.char, "^(%S+)%s+(%S+)$")
+assert(combo, "The char line needs a combo and a weapon")
+you.init(combo, weapon)
+debug.goto_place(setup.place)
+debug.seed_rng(tonumber(setup.seed))
+test.regenerate_level()
+local start = test.find_feature("exit_dungeon")
+              or test.find_feature("stone_stairs_up_i")
+assert(start, "No up staircase to start on in " .. setup.place)
+you.moveto(start.x, start.y)
+
+local golden = { }
+local old = not save and file.readfile(goldfile)
+if old then
+  for digest in string.gmatch(old, "([^\n]+)\n") do
+    table.insert(golden, digest)
+  end
+end
+
+local lines = { }
+local began = crawl.millis()
+for i, keys in ipairs(commands) do
+  debug.replay_keys(keys)
+  local digest = string.format("%d %s", you.turns(), debug.state_digest())
+  table.insert(lines, digest)
+  if old then
+    assert(golden[i] == digest,
+           string.format("%s:%d (%s) diverged: expected %s, got %s",
+                         keysfile, i, keys, golden[i] or "nothing", digest))
+  end
+end
+local elapsed = crawl.millis() - began
+
+crawl.stderr(string.format("%s: %d commands, %d turns in %d ms", keysfile,
+                           #commands, you.turns(), elapsed))
+
+if save then
+  assert(file.writefile(goldfile, table.concat(lines, "\n") .. "\n"),
+         "Couldn't write " .. goldfile)
+  crawl.stderr("Saved " .. goldfile)
+elseif not old then
+  crawl.stderr("No " .. goldfile .. " to compare with; run with save first")
+elseif #golden ~= #lines then
+  assert(false, string.format("%s has %d digests, but %s has %d commands",
+                              goldfile, #golden, keysfile, #lines))
+end
@@ -35,6 +35,7 @@
 #include "state.h"
 #include "stringutil.h"
 #include "terrain.h"
+#include "unwind.h"
 #include "view.h"
 #include "viewchar.h"
 
@@ -770,10 +771,22 @@ void apply_noises()
     // middle of propagate_noise().
     if (_noise_grid.dirty())
     {
-        noise_grid copy = _noise_grid;
-        // Reset the main grid.
-        _noise_grid.reset();
-        copy.propagate_noise();
+        // Moving the pending noises onto a grid of their own is much
+        // cheaper than copying the whole grid, and that grid can be reused
+        // unless noises are somehow applied while we're propagating.
+        static noise_grid propagation_grid;
+        static bool propagating = false;
+        if (propagating)
+        {
+            noise_grid copy;
+            copy.take_noises(_noise_grid);
+            copy.propagate_noise();
+            return;
+        }
+
+        unwind_bool in_propagation(propagating, true);
+        propagation_grid.take_noises(_noise_grid);
+        propagation_grid.propagate_noise();
     }
 }
 
@@ -942,7 +955,7 @@ static int _noise_attenuation_millis(const coord_def &pos)
 
 noise_cell::noise_cell()
     : neighbour_delta(0, 0), noise_id(-1), noise_intensity_millis(0),
-      noise_travel_distance(0)
+      noise_travel_distance(0), generation(0)
 {
 }
 
@@ -985,29 +998,88 @@ int noise_cell::turn_angle(const coord_def &next_delta) const
 }
 
 noise_grid::noise_grid()
-    : cells(), noises(), affected_actor_count(0)
+    : cells(), generation(1), noises(), affected_actor_count(0)
 {
 }
 
 void noise_grid::reset()
 {
-    cells.init(noise_cell());
+    // Cells from older generations read as empty, so there's no need to
+    // clear them, except on the (very rare) wrap-around.
+    if (!++generation)
+    {
+        cells.init(noise_cell());
+        generation = 1;
+    }
     noises.clear();
     affected_actor_count = 0;
 }
 
+void noise_grid::take_noises(noise_grid &other)
+{
+    reset();
+    // Registering only ever touches the noise source cells, so registering
+    // the same noises in the same order rebuilds the other grid exactly.
+    for (const noise_t &noise : other.noises)
+        register_noise(noise);
+    other.reset();
+}
+
+noise_cell &noise_grid::cell_at(const coord_def &p)
+{
+    noise_cell &cell(cells(p));
+    if (cell.generation != generation)
+    {
+        cell = noise_cell();
+        cell.generation = generation;
+    }
+    return cell;
+}
+
+const noise_cell &noise_grid::cell_at(const coord_def &p) const
+{
+    static const noise_cell empty;
+    const noise_cell &cell(cells(p));
+    return cell.generation == generation ? cell : empty;
+}
+
+void noise_grid::index_actors()
+{
+    for (int x = 0; x <= GXM; ++x)
+        actor_sums[x][0] = 0;
+    for (int y = 0; y <= GYM; ++y)
+        actor_sums[0][y] = 0;
+
+    for (int x = 0; x < GXM; ++x)
+        for (int y = 0; y < GYM; ++y)
+        {
+            const coord_def c(x, y);
+            const int here = (c == you.pos() || monster_at(c)) ? 1 : 0;
+            actor_sums[x + 1][y + 1] = here + actor_sums[x][y + 1]
+                                       + actor_sums[x + 1][y]
+                                       - actor_sums[x][y];
+        }
+}
+
+// Is there an actor within radius (by grid distance) of p?
+bool noise_grid::actor_within(const coord_def &p, int radius) const
+{
+    const int x0 = max(p.x - radius, 0), x1 = min(p.x + radius + 1, GXM);
+    const int y0 = max(p.y - radius, 0), y1 = min(p.y + radius + 1, GYM);
+    return actor_sums[x1][y1] - actor_sums[x0][y1] - actor_sums[x1][y0]
+           + actor_sums[x0][y0] > 0;
+}
+
 void noise_grid::register_noise(const noise_t &noise)
 {
-    noise_cell &target_cell(cells(noise.noise_source));
+    noise_cell &target_cell(cell_at(noise.noise_source));
     if (target_cell.can_apply_noise(noise.noise_intensity_millis))
     {
         const int noise_index = noises.size();
         noises.push_back(noise);
         noises[noise_index].noise_id = noise_index;
-        cells(noise.noise_source).apply_noise(noise.noise_intensity_millis,
-                                              noise_index,
-                                              0,
-                                              coord_def(0, 0));
+        target_cell.apply_noise(noise.noise_intensity_millis, noise_index, 0,
+                                coord_def(0, 0));
     }
 }
 
@@ -1020,6 +1092,8 @@ void noise_grid::propagate_noise()
     dprf(DIAG_NOISE, "noise_grid: %u noises to apply",
          (unsigned int)noises.size());
 #endif
+    index_actors();
+
     vector<coord_def> noise_perimeter[2];
     int circ_index = 0;
 
@@ -1034,7 +1108,7 @@ void noise_grid::propagate_noise()
         ++travel_distance;
         for (const coord_def p : perimeter)
         {
-            const noise_cell &cell(cells(p));
+            const noise_cell &cell(cell_at(p));
 
             if (!cell.silent())
             {
@@ -1044,8 +1118,15 @@ void noise_grid::propagate_noise()
                                     travel_distance - 1);
 
                 const int attenuation = _noise_attenuation_millis(p);
-                // If the base noise attenuation kills the noise, go no farther:
-                if (noise_is_audible(cell.noise_intensity_millis - attenuation))
+                // Every step costs at least the base attenuation, so this is
+                // as far as the noise could still carry from here.
+                const int reach = (cell.noise_intensity_millis
+                                   - LOWEST_AUDIBLE_NOISE_INTENSITY_MILLIS)
+                                  / BASE_NOISE_ATTENUATION_MILLIS;
+                // If the base noise attenuation kills the noise, or there's
+                // nobody left who could hear it, go no farther:
+                if (noise_is_audible(cell.noise_intensity_millis - attenuation)
+                    && actor_within(p, reach))
                 {
                     // [ds] Not using adjacent iterator which has
                     // unnecessary overhead for the tight loop here.
@@ -1096,7 +1177,7 @@ bool noise_grid::propagate_noise_to_neighbour(int base_attenuation,
                                               const coord_def &current_pos,
                                               const coord_def &next_pos)
 {
-    noise_cell &neighbour(cells(next_pos));
+    noise_cell &neighbour(cell_at(next_pos));
     if (!neighbour.can_apply_noise(cell.noise_intensity_millis
                                    - base_attenuation))
     {
@@ -1198,7 +1279,8 @@ coord_def noise_grid::noise_perceived_position(actor *act,
                                                const coord_def &affected_pos,
                                                const noise_t &noise) const
 {
-    const int noise_travel_distance = cells(affected_pos).noise_travel_distance;
+    const int noise_travel_distance =
+        cell_at(affected_pos).noise_travel_distance;
     if (!noise_travel_distance)
         return noise.noise_source;
 
@@ -1309,7 +1391,7 @@ static void _write_noise_grid_css(FILE *outf)
 
 void noise_grid::write_cell(FILE *outf, coord_def p, int ch) const
 {
-    const int intensity = min(25, cells(p).noise_intensity_millis / 1000);
+    const int intensity = min(25, cell_at(p).noise_intensity_millis / 1000);
     if (intensity)
         fprintf(outf, "<span class='i%d'>&#%d;</span>", intensity, ch);
     else
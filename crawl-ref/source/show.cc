@@ -29,6 +29,7 @@
 #include "tiles-build-specific.h"
 #include "traps.h"
 #include "travel.h"
+#include "unwind.h"
 #include "viewgeom.h"
 #include "viewmap.h"
 
@@ -106,6 +107,10 @@ bool show_type::is_cleanable_monster() const
     return cls == SH_MONSTER && !mons_class_is_stationary(mons);
 }
 
+// Whether a fungusform player is nervous, once show_init() has worked it out
+// for the whole view; MB_MAYBE means each cell has to check for itself.
+static maybe_bool _player_nervous = MB_MAYBE;
+
 static void _update_feat_at(const coord_def &gp)
 {
     if (!you.see_cell(gp))
@@ -119,68 +124,78 @@ static void _update_feat_at(const coord_def &gp)
     if (feat_is_trap(feat))
         trap = get_trap_type(gp);
 
-    env.map_knowledge(gp).set_feature(feat, colour, trap);
+    map_cell &cell = env.map_knowledge(gp);
+    cell.set_feature(feat, colour, trap);
+
+    // Collect the flags locally and store them once at the end.
+    uint32_t flags = 0;
 
     if (haloed(gp))
-        env.map_knowledge(gp).flags |= MAP_HALOED;
+        flags |= MAP_HALOED;
 
     if (umbraed(gp))
-        env.map_knowledge(gp).flags |= MAP_UMBRAED;
+        flags |= MAP_UMBRAED;
 
     if (silenced(gp))
-        env.map_knowledge(gp).flags |= MAP_SILENCED;
+        flags |= MAP_SILENCED;
 
     if (liquefied(gp, false))
-        env.map_knowledge(gp).flags |= MAP_LIQUEFIED;
+        flags |= MAP_LIQUEFIED;
 
     if (orb_haloed(gp))
-        env.map_knowledge(gp).flags |= MAP_ORB_HALOED;
+        flags |= MAP_ORB_HALOED;
 
     if (quad_haloed(gp))
-        env.map_knowledge(gp).flags |= MAP_QUAD_HALOED;
+        flags |= MAP_QUAD_HALOED;
 
     if (disjunction_haloed(gp))
-        env.map_knowledge(gp).flags |= MAP_DISJUNCT;
+        flags |= MAP_DISJUNCT;
 
     if (is_sanctuary(gp))
     {
         if (testbits(env.pgrid(gp), FPROP_SANCTUARY_1))
-            env.map_knowledge(gp).flags |= MAP_SANCTUARY_1;
+            flags |= MAP_SANCTUARY_1;
         else if (testbits(env.pgrid(gp), FPROP_SANCTUARY_2))
-            env.map_knowledge(gp).flags |= MAP_SANCTUARY_2;
+            flags |= MAP_SANCTUARY_2;
     }
 
     if (you.get_beholder(gp))
-        env.map_knowledge(gp).flags |= MAP_WITHHELD;
+        flags |= MAP_WITHHELD;
 
     if (you.get_fearmonger(gp))
-        env.map_knowledge(gp).flags |= MAP_WITHHELD;
+        flags |= MAP_WITHHELD;
 
-    if (you.is_nervous() && you.see_cell(gp) && !monster_at(gp))
-        env.map_knowledge(gp).flags |= MAP_WITHHELD;
+    if (!(flags & MAP_WITHHELD) && !monster_at(gp)
+        && (_player_nervous == MB_MAYBE ? you.is_nervous()
+                                        : _player_nervous == MB_TRUE))
+    {
+        flags |= MAP_WITHHELD;
+    }
 
     if ((feat_is_stone_stair(feat)
          || feat_is_escape_hatch(feat))
         && is_exclude_root(gp))
     {
-        env.map_knowledge(gp).flags |= MAP_EXCLUDED_STAIRS;
+        flags |= MAP_EXCLUDED_STAIRS;
     }
 
     if (is_bloodcovered(gp))
-        env.map_knowledge(gp).flags |= MAP_BLOODY;
+        flags |= MAP_BLOODY;
 
     if (is_moldy(gp))
     {
-        env.map_knowledge(gp).flags |= MAP_MOLDY;
+        flags |= MAP_MOLDY;
         if (glowing_mold(gp))
-            env.map_knowledge(gp).flags |= MAP_GLOWING_MOLDY;
+            flags |= MAP_GLOWING_MOLDY;
     }
 
     if (env.level_state & LSTATE_SLIMY_WALL && slime_wall_neighbour(gp))
-        env.map_knowledge(gp).flags |= MAP_CORRODING;
+        flags |= MAP_CORRODING;
 
     if (emphasise(gp))
-        env.map_knowledge(gp).flags |= MAP_EMPHASIZE;
+        flags |= MAP_EMPHASIZE;
+
+    cell.flags |= flags;
 
     // Tell the world first.
     dungeon_events.fire_position_event(DET_PLAYER_IN_LOS, gp);
@@ -429,8 +444,7 @@ static void _update_monster(monster* mons)
     if (mons->visible_to(&you))
     {
         mons->ensure_has_client_id();
-        monster_info mi(mons);
-        env.map_knowledge(gp).set_monster(mi);
+        env.map_knowledge(gp).set_monster(cached_monster_info(mons));
         return;
     }
 
@@ -545,16 +559,18 @@ void show_init(layers_type layers)
         return;
     }
 
-    vector <coord_def> update_locs;
-    for (radius_iterator ri(you.pos(), you.xray_vision ? LOS_NONE : LOS_DEFAULT); ri; ++ri)
-    {
+    // Fungusform nervousness scans every monster in view, and doesn't
+    // depend on the cell being updated, so check it just once.
+    unwind_var<maybe_bool> nervous(_player_nervous,
+                                   you.is_nervous() ? MB_TRUE : MB_FALSE);
+
+    const los_type los = you.xray_vision ? LOS_NONE : LOS_DEFAULT;
+    for (radius_iterator ri(you.pos(), los); ri; ++ri)
         show_update_at(*ri, layers);
-        update_locs.push_back(*ri);
-    }
 
     // Need to clear these update flags now so they don't persist.
-    for (coord_def loc : update_locs)
-        env.map_knowledge(loc).flags &= ~MAP_INVISIBLE_UPDATE;
+    for (radius_iterator ri(you.pos(), los); ri; ++ri)
+        env.map_knowledge(*ri).flags &= ~MAP_INVISIBLE_UPDATE;
 }
 
 // Emphasis may change while off-level. This catches up.
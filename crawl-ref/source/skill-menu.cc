@@ -1398,15 +1398,15 @@ void SkillMenu::init_switches()
 
 void SkillMenu::refresh_display()
 {
-    if (is_set(SKMF_EXPERIENCE))
-        train_skills(true);
-
-    for (int ln = 0; ln < SK_ARR_LN; ++ln)
-        for (int col = 0; col < SK_ARR_COL; ++col)
-            m_skills[ln][col].refresh(true);
+    {
+        unique_ptr<training_projection> projection;
+        if (is_set(SKMF_EXPERIENCE))
+            projection.reset(new training_projection());
 
-    if (is_set(SKMF_EXPERIENCE))
-        m_skill_backup.restore_levels();
+        for (int ln = 0; ln < SK_ARR_LN; ++ln)
+            for (int col = 0; col < SK_ARR_COL; ++col)
+                m_skills[ln][col].refresh(true);
+    }
     refresh_button_row();
 }
 
@@ -2208,6 +2208,20 @@ void skill_state::restore_levels()
     set_all_manual_charges(manual_charges);
 }
 
+training_projection::training_projection(int exp)
+    : seed{you.total_experience, static_cast<uint64_t>(exp)},
+      rng(seed, ARRAYSZ(seed))
+{
+    saved.save();
+    you.exp_available += exp;
+    train_skills(true);
+}
+
+training_projection::~training_projection()
+{
+    saved.restore_levels();
+}
+
 void skill_state::restore_training()
 {
     for (skill_type sk = SK_FIRST_SKILL; sk < NUM_SKILLS; ++sk)
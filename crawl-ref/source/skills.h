@@ -6,6 +6,7 @@
 #pragma once
 
 #include "player.h"
+#include "random.h"
 
 const int MAX_SKILL_ORDER = 100;
 struct skill_state
@@ -31,6 +32,24 @@ struct skill_state
     void restore_training();
 };
 
+// While this is alive, the player's skills are where their training would
+// take them with the experience pool and `exp` more; everything is put back
+// afterwards. Training draws from an RNG of its own, so that looking at a
+// projection can't change what happens in the game.
+class training_projection
+{
+public:
+    explicit training_projection(int exp = 0);
+    ~training_projection();
+
+    training_projection(const training_projection&) = delete;
+    training_projection& operator=(const training_projection&) = delete;
+private:
+    skill_state saved;
+    uint64_t seed[2];
+    rng_override rng;
+};
+
 struct skill_diff
 {
     skill_diff() : skill_points(0), experience(0) { }
@@ -35,6 +35,7 @@
 #include "output.h"
 #include "prompt.h"
 #include "religion.h"
+#include "spl-cast.h"
 #include "spl-util.h"
 #include "state.h"
 #include "stringutil.h"
@@ -461,6 +462,8 @@ vector<spell_type> get_mem_spell_list()
     if (mem_spells.empty())
         return spell_list();
 
+    // The comparison asks for failure rates many times over.
+    spell_calc_cache_scope cache;
     sort(mem_spells.begin(), mem_spells.end(), _sort_mem_spells);
 
     return mem_spells;
@@ -703,6 +706,9 @@ static spell_type _choose_mem_spell()
     // memorisable, which is enough.
     spell_set available_spells;
     _list_available_spells(available_spells);
+    // Covers the sort and the menu; the chosen spell is learnt after this
+    // returns.
+    spell_calc_cache_scope cache;
     spell_list spells;
     for (spell_type spell : available_spells)
         if (!you.has_spell(spell))
@@ -233,6 +233,9 @@ int list_spells(bool toggle_with_I, bool viewing, bool allow_preselect,
         spell_menu.set_flags(spell_menu.get_flags() | MF_PRESELECTED);
     }
 
+    // Nothing in the menu can change the player, so one cache does for
+    // every entry and for any spell descriptions looked at from it.
+    spell_calc_cache_scope cache;
     for (int i = 0; i < 52; ++i)
     {
         const char letter = index_to_letter(i);
@@ -306,6 +309,31 @@ static int _apply_spellcasting_success_boosts(spell_type spell, int chance)
     return chance * fail_reduce / 100;
 }
 
+static int _spell_calc_cache_depth = 0;
+static int _cached_fail[NUM_SPELLS];
+// Keyed by spell, then the flags and scale calc_spell_power() was given.
+static map<pair<spell_type, int>, int> _cached_power;
+
+static void _clear_spell_calc_cache()
+{
+    fill(begin(_cached_fail), end(_cached_fail), -1);
+    _cached_power.clear();
+}
+
+spell_calc_cache_scope::spell_calc_cache_scope()
+{
+    if (!_spell_calc_cache_depth++)
+        _clear_spell_calc_cache();
+}
+
+spell_calc_cache_scope::~spell_calc_cache_scope()
+{
+    if (!--_spell_calc_cache_depth)
+        _clear_spell_calc_cache();
+}
+
+static int _raw_spell_fail(spell_type spell);
+
 /**
  * Calculate the player's failure rate with the given spell, including all
  * modifiers. (Armour, mutations, statuses effects, etc.)
@@ -315,6 +343,17 @@ static int _apply_spellcasting_success_boosts(spell_type spell, int chance)
  *                  readable version, call _get_true_fail_rate().
  */
 int raw_spell_fail(spell_type spell)
+{
+    if (!_spell_calc_cache_depth)
+        return _raw_spell_fail(spell);
+
+    int &fail = _cached_fail[spell];
+    if (fail < 0)
+        fail = _raw_spell_fail(spell);
+    return fail;
+}
+
+static int _raw_spell_fail(spell_type spell)
 {
     int chance = 60;
 
@@ -420,8 +459,33 @@ int stepdown_spellpower(int power, int scale)
  *
  * @return the resulting spell power.
  */
+static int _calc_spell_power(spell_type spell, bool apply_intel,
+                             bool fail_rate_check, bool cap_power, int scale);
+
 int calc_spell_power(spell_type spell, bool apply_intel, bool fail_rate_check,
                      bool cap_power, int scale)
+{
+    if (!_spell_calc_cache_depth)
+    {
+        return _calc_spell_power(spell, apply_intel, fail_rate_check,
+                                 cap_power, scale);
+    }
+
+    const int args = scale << 3 | apply_intel << 2 | fail_rate_check << 1
+                     | cap_power;
+    const auto key = make_pair(spell, args);
+    auto it = _cached_power.find(key);
+    if (it == _cached_power.end())
+    {
+        it = _cached_power.emplace(key,
+                 _calc_spell_power(spell, apply_intel, fail_rate_check,
+                                   cap_power, scale)).first;
+    }
+    return it->second;
+}
+
+static int _calc_spell_power(spell_type spell, bool apply_intel,
+                             bool fail_rate_check, bool cap_power, int scale)
 {
     int power = 0;
 
@@ -87,6 +87,21 @@ int calc_spell_power(spell_type spell, bool apply_intel,
                      int scale = 1);
 int calc_spell_range(spell_type spell, int power = 0, bool allow_bonus = true);
 
+// While one of these is alive, raw_spell_fail() and calc_spell_power()
+// remember what they worked out for each spell. Keep it around code that
+// asks about many spells but can't change the player, such as building a
+// spell menu; anything that casts, trains or changes equipment must be
+// outside it.
+class spell_calc_cache_scope
+{
+public:
+    spell_calc_cache_scope();
+    ~spell_calc_cache_scope();
+
+    spell_calc_cache_scope(const spell_calc_cache_scope&) = delete;
+    spell_calc_cache_scope& operator=(const spell_calc_cache_scope&) = delete;
+};
+
 bool cast_a_spell(bool check_range, spell_type spell = SPELL_NO_SPELL);
 
 int apply_enhancement(const int initial_power, const int enhancer_levels);
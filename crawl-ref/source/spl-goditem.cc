@@ -1085,8 +1085,10 @@ void holy_word(int pow, holy_word_source_type source, const coord_def& where,
              attacker->conj_verb("speak").c_str());
     }
 
-    for (radius_iterator ri(where, LOS_SOLID); ri; ++ri)
-        holy_word_monsters(*ri, pow, source, attacker);
+    apply_area_visible_actors([pow, source, attacker] (coord_def p) {
+        holy_word_monsters(p, pow, source, attacker);
+        return 0;
+    }, where, LOS_SOLID);
 }
 
 void torment_player(actor *attacker, torment_source_type taux)
@@ -1214,8 +1216,10 @@ void torment_cell(coord_def where, actor *attacker, torment_source_type taux)
 
 void torment(actor *attacker, torment_source_type taux, const coord_def& where)
 {
-    for (radius_iterator ri(where, LOS_NO_TRANS); ri; ++ri)
-        torment_cell(*ri, attacker, taux);
+    apply_area_visible_actors([attacker, taux] (coord_def p) {
+        torment_cell(p, attacker, taux);
+        return 0;
+    }, where);
 }
 
 void setup_cleansing_flame_beam(bolt &beam, int pow, int caster,
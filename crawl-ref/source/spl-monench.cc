@@ -64,7 +64,7 @@ spret_type cast_englaciation(int pow, bool fail)
 {
     fail_check();
     mpr("You radiate an aura of cold.");
-    apply_area_visible([pow] (coord_def where) {
+    apply_area_visible_actors([pow] (coord_def where) {
         return englaciate(where, pow, &you);
     }, you.pos());
     return SPRET_SUCCESS;
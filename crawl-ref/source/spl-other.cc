@@ -317,7 +317,7 @@ spret_type cast_intoxicate(int pow, bool fail)
 {
     fail_check();
     mpr("You attempt to intoxicate your foes!");
-    int count = apply_area_visible([pow] (coord_def where) {
+    int count = apply_area_visible_actors([pow] (coord_def where) {
         return _intoxicate_monsters(where, pow);
     }, you.pos());
     if (count > 0)
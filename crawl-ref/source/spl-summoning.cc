@@ -3381,11 +3381,15 @@ void summoned_monster(const monster *mons, const actor *caster,
         if (mons == *mi)
             continue;
 
+        // Most monsters on the level aren't this caster's, and checking
+        // that is much cheaper than looking up their enchantments.
+        if (mi->summoner != caster->mid)
+            continue;
+
         int duration = 0;
         int stype    = 0;
         const bool summoned = mi->is_summoned(&duration, &stype);
-        if (summoned && stype == spell && caster->mid == mi->summoner
-            && mons_aligned(caster, *mi))
+        if (summoned && stype == spell && mons_aligned(caster, *mi))
         {
             // Count large abominations and tentacled monstrosities separately
             if (spell == SPELL_SUMMON_HORRIBLE_THINGS && mi->type != mons->type)
@@ -3425,13 +3429,12 @@ int count_summons(const actor *summoner, spell_type spell)
     int count = 0;
     for (monster_iterator mi; mi; ++mi)
     {
-        if (summoner == *mi)
+        if (summoner == *mi || mi->summoner != summoner->mid)
             continue;
 
         int stype    = 0;
         const bool summoned = mi->is_summoned(nullptr, &stype);
-        if (summoned && stype == spell && summoner->mid == mi->summoner
-            && mons_aligned(summoner, *mi))
+        if (summoned && stype == spell && mons_aligned(summoner, *mi))
         {
             count++;
         }
@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "act-iter.h"
 #include "areas.h"
 #include "coordit.h"
 #include "directn.h"
@@ -563,6 +564,26 @@ int apply_area_visible(cell_func cf, const coord_def &where)
     return rv;
 }
 
+// Apply a function-pointer to the visible squares that hold an actor, for
+// effects with nothing to do on an empty square. The squares are found
+// before any are affected, so nothing is visited twice if the effect moves
+// its targets around.
+// Returns summation of return values from passed in function.
+int apply_area_visible_actors(cell_func cf, const coord_def &where,
+                              los_type los)
+{
+    vector<coord_def> cells;
+    for (const actor *act : actors_in_los(where, los))
+        if (cells.empty() || cells.back() != act->pos())
+            cells.push_back(act->pos());
+
+    int rv = 0;
+    for (const coord_def &p : cells)
+        rv += cf(p);
+
+    return rv;
+}
+
 // Applies the effect to all nine squares around/including the target.
 // Returns summation of return values from passed in function.
 static int _apply_area_square(cell_func cf, const coord_def& where)
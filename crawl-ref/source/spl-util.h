@@ -101,6 +101,8 @@ typedef function<int (coord_def where, int pow, int spreadrate,
         cloud_func;
 
 int apply_area_visible(cell_func cf, const coord_def& where);
+int apply_area_visible_actors(cell_func cf, const coord_def& where,
+                              los_type los = LOS_NO_TRANS);
 
 int apply_random_around_square(cell_func cf, const coord_def& where,
                                bool hole_in_middle, int max_targs);
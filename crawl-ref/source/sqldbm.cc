@@ -16,6 +16,8 @@
 
 #ifdef USE_SQLITE_DBM
 
+#define QUERY_CACHE_CEILING 4096
+
 class sqlite_retry_iterator
 {
 public:
@@ -47,7 +49,8 @@ private:
 
 SQL_DBM::SQL_DBM(const string &dbname, bool _readonly, bool do_open)
     : error(), errc(SQLITE_OK), db(nullptr), s_insert(nullptr), s_remove(nullptr),
-      s_query(nullptr), s_iterator(nullptr), dbfile(dbname), readonly(_readonly)
+      s_query(nullptr), s_iterator(nullptr), dbfile(dbname), readonly(_readonly),
+      walking_keys(false)
 {
     if (do_open && !dbfile.empty())
         open();
@@ -123,6 +126,17 @@ From SQLite's documentation:
     }
 
     init_schema();
+
+    // Read-only databases are the same for every crawl process on a host.
+    // Reading them through a shared mapping lets those processes share one
+    // copy of the pages instead of each filling a private page cache, so
+    // keep that cache small. Older SQLites ignore pragmas they don't know.
+    if (readonly)
+    {
+        sqlite3_exec(db, "PRAGMA mmap_size=268435456;", nullptr, nullptr,
+                     nullptr);
+        sqlite3_exec(db, "PRAGMA cache_size=16;", nullptr, nullptr, nullptr);
+    }
     return errc;
 }
 
@@ -149,6 +163,8 @@ int SQL_DBM::init_schema()
 
 void SQL_DBM::close()
 {
+    query_cache.clear();
+    walking_keys = false;
     if (db)
     {
         if (!readonly)
@@ -251,10 +267,28 @@ int SQL_DBM::do_query(const string &key, string *result)
 
 string SQL_DBM::query(const string &key)
 {
+    if (readonly)
+    {
+        auto cached = query_cache.find(key);
+        if (cached != query_cache.end())
+            return cached->second;
+    }
+
     string result;
     for (sqlite_retry_iterator ri; ri;
          ri.check(do_query(key, &result)))
     {}
+
+    // A read-only db can't change under us, so remember the answer, misses
+    // included: speech and name lookups try several keys that mostly
+    // aren't there, and try the same ones again every time. Bodies fetched
+    // while walking every key would only flush out those answers.
+    if (readonly && errc == SQLITE_OK && !walking_keys)
+    {
+        if (query_cache.size() >= QUERY_CACHE_CEILING)
+            query_cache.clear();
+        query_cache[key] = result;
+    }
     return result;
 }
 
@@ -266,6 +300,7 @@ unique_ptr<string> SQL_DBM::firstkey()
         return result;
     }
 
+    walking_keys = true;
     return nextkey();
 }
 
@@ -280,7 +315,10 @@ unique_ptr<string> SQL_DBM::nextkey()
                 new string((const char *) sqlite3_column_text(s_iterator, 0)));
         }
         else
+        {
             sqlite3_reset(s_iterator);
+            walking_keys = false;
+        }
     }
     return result;
 }
@@ -15,6 +15,7 @@
 
 #include <sqlite3.h>
 #include <string>
+#include <unordered_map>
 
 // A string dbm interface for SQLite. Makes no attempt to store arbitrary
 // data, only valid C strings.
@@ -88,6 +89,8 @@ private:
     sqlite3_stmt *s_iterator;
     string       dbfile;
     bool readonly;
+    unordered_map<string, string> query_cache;
+    bool walking_keys;
 };
 
 SQL_DBM  *dbm_open(const char *filename, int open_mode, int permissions);
@@ -213,7 +213,7 @@ static void _clear_golubria_traps()
 
 static void _clear_prisms()
 {
-    for (auto &mons : menv_real)
+    for (auto &mons : menv_used)
         if (mons.type == MONS_FULMINANT_PRISM)
             mons.reset();
 }
@@ -243,7 +243,7 @@ static void _update_travel_cache(const level_id& old_level,
                                  const coord_def& stair_pos)
 {
     // If the old level is gone, nothing to save.
-    if (!you.save || !you.save->has_chunk(old_level.describe()))
+    if (!is_existing_level(old_level))
         return;
 
     // Update stair information for the stairs we just ascended, and the
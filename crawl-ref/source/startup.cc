@@ -52,6 +52,7 @@
 #include "status.h"
 #include "stringutil.h"
 #include "terrain.h"
+#include "threads.h"
 #ifdef USE_TILE
  #include "tilepick.h"
 #endif
@@ -67,9 +68,53 @@
 
 static void _cio_init();
 
+// How long each phase of _initialize() took, for -startup-profile.
+static vector<pair<const char *, int64_t>> _startup_phases;
+static chrono::steady_clock::time_point _startup_phase_start;
+static int64_t _database_init_us = 0;
+
+static int64_t _us_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration_cast<chrono::microseconds>(
+               chrono::steady_clock::now() - start).count();
+}
+
+static void _startup_phase_done(const char *name)
+{
+    if (!crawl_state.startup_profile)
+        return;
+    _startup_phases.emplace_back(name, _us_since(_startup_phase_start));
+    _startup_phase_start = chrono::steady_clock::now();
+}
+
+static void _startup_profile_report()
+{
+    int64_t total_us = 0;
+    for (const auto &phase : _startup_phases)
+    {
+        printf("%-28s %8.1fms\n", phase.first, phase.second / 1000.0);
+        total_us += phase.second;
+    }
+    printf("%-28s %8.1fms\n", "databases (worker thread)",
+           _database_init_us / 1000.0);
+    printf("%-28s %8.1fms\n", "total", total_us / 1000.0);
+}
+
+// The text databases don't touch Lua, the maps or the display, so they can
+// be checked and rebuilt while the main thread reads the des files.
+static void *_database_init_thread(void */*unused*/)
+{
+    const auto start = chrono::steady_clock::now();
+    databaseSystemInit();
+    _database_init_us = _us_since(start);
+    return nullptr;
+}
+
 // Initialise a whole lot of stuff...
 static void _initialize()
 {
+    _startup_phase_start = chrono::steady_clock::now();
+
     Options.fixup_options();
 
     you.symbol = MONS_PLAYER;
@@ -109,8 +154,11 @@ static void _initialize()
     you.unique_creatures.reset();
     you.unique_items.init(UNIQ_NOT_EXISTS);
 
+    _startup_phase_done("tables and caches");
+
     // Set up the Lua interpreter for the dungeon builder.
     init_dungeon_lua();
+    _startup_phase_done("dungeon lua");
 
 #ifdef USE_TILE_LOCAL
     // Draw the splash screen before the database gets initialised as that
@@ -123,8 +171,14 @@ static void _initialize()
     }
 #endif
 
-    // Initialise internal databases.
-    databaseSystemInit();
+    // Initialise internal databases, on their own thread if we can.
+    thread_t database_thread;
+    const bool database_threaded =
+        !thread_create_joinable(&database_thread, _database_init_thread,
+                                nullptr);
+    if (!database_threaded)
+        _database_init_thread(nullptr);
+    _startup_phase_done("starting databases");
 #ifdef USE_TILE_LOCAL
     if (!crawl_state.tiles_disabled && crawl_state.title_screen)
         tiles.update_title_msg("Loading spells and features...");
@@ -133,6 +187,7 @@ static void _initialize()
     init_feat_desc_cache();
     init_spell_name_cache();
     init_spell_rarities();
+    _startup_phase_done("spell and feature caches");
 #ifdef USE_TILE_LOCAL
     if (!crawl_state.tiles_disabled && crawl_state.title_screen)
         tiles.update_title_msg("Loading maps...");
@@ -140,7 +195,19 @@ static void _initialize()
 
     // Read special levels and vaults.
     read_maps();
+    _startup_phase_done("maps");
     run_map_global_preludes();
+    _startup_phase_done("map preludes");
+
+    if (database_threaded)
+        thread_join(database_thread);
+    _startup_phase_done("waiting for databases");
+
+    if (crawl_state.startup_profile)
+    {
+        _startup_profile_report();
+        end(0);
+    }
 
     if (crawl_state.build_db)
         end(0);
@@ -243,6 +310,7 @@ static void _post_init(bool newc)
     ASSERT(strwidth(you.your_name) <= MAX_NAME_LENGTH);
 
     clua.load_persist();
+    clua.tune_gc(Options.lua_gc_pause, Options.lua_gc_stepmul);
 
     // Load macros
     macro_init();
@@ -1049,6 +1117,9 @@ bool startup_step()
 
     bool newchar = false;
     newgame_def ng;
+#ifdef DEBUG_DIAGNOSTICS
+    chrono::steady_clock::time_point setup_start, setup_end;
+#endif
     if (choice.filename.empty() && !choice.name.empty())
         choice.filename = get_save_filename(choice.name);
 
@@ -1061,12 +1132,35 @@ bool startup_step()
     }
     else
     {
+#ifdef DEBUG_DIAGNOSTICS
+        setup_start = chrono::steady_clock::now();
+#endif
         setup_game(ng);
         newchar = true;
+#ifdef DEBUG_DIAGNOSTICS
+        setup_end = chrono::steady_clock::now();
+#endif
     }
 
     _post_init(newchar);
 
+#ifdef DEBUG_DIAGNOSTICS
+    // Time to the first turn once the character is chosen, which is all of
+    // it for a preset name and combo.
+    if (newchar)
+    {
+        const auto ms = [](chrono::steady_clock::duration d)
+        {
+            return (int) chrono::duration_cast<chrono::milliseconds>(d).count();
+        };
+        dprf("New game ready in %dms: setup %dms, "
+             "first level and options %dms.",
+             ms(chrono::steady_clock::now() - setup_start),
+             ms(setup_end - setup_start),
+             ms(chrono::steady_clock::now() - setup_end));
+    }
+#endif
+
     return newchar;
 }
 
@@ -12,6 +12,7 @@
 #include <cstdio>
 #include <sstream>
 
+#include "alloc-tag.h"
 #include "chardump.h"
 #include "clua.h"
 #include "cluautil.h"
@@ -166,7 +167,8 @@ static void _fully_identify_item(item_def *item)
 // Stash
 // ----------------------------------------------------------------------
 
-Stash::Stash(coord_def pos_) : items()
+Stash::Stash(coord_def pos_) : feat(DNGN_UNSEEN), trap(NUM_TRAPS), items(),
+                                search_cache_turn(-1)
 {
     // First, fix what square we're interested in
     if (pos_.origin())
@@ -245,11 +247,16 @@ bool Stash::unmark_trapping_nets()
     for (auto &item : items)
         if (item_is_stationary_net(item))
             item.net_placed = false, changed = true;
+    if (changed)
+        search_cache_turn = -1;
     return changed;
 }
 
 void Stash::update()
 {
+    search_cache_turn = -1;
+    const dungeon_feature_type old_feat = feat;
+    const trap_type old_trap = trap;
     feat = grd(pos);
     trap = NUM_TRAPS;
 
@@ -263,9 +270,12 @@ void Stash::update()
             feat = DNGN_FLOOR, trap = TRAP_UNASSIGNED;
     }
 
+    // This runs for every stash in view each turn, and describing a feature
+    // asks the Lua markers here, so keep the old description unless the
+    // feature has changed.
     if (feat == DNGN_FLOOR)
         feat_desc = "";
-    else
+    else if (feat != old_feat || trap != old_trap || feat_desc.empty())
         feat_desc = feature_description_at(pos, false, DESC_A, false);
 
     // If this is your position, you know what's on this square
@@ -441,6 +451,27 @@ string Stash::feature_description() const
     return feat_desc;
 }
 
+void Stash::update_search_text() const
+{
+    if (search_cache_turn == you.num_turns
+        && search_cache.size() == items.size())
+    {
+        return;
+    }
+
+    search_cache.clear();
+    for (const item_def &item : items)
+    {
+        stash_search_text text;
+        text.name       = stash_item_name(item);
+        text.annotation = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE,
+                                              &item);
+        text.have_desc  = false;
+        search_cache.push_back(text);
+    }
+    search_cache_turn = you.num_turns;
+}
+
 vector<stash_search_result> Stash::matches_search(
     const string &prefix, const base_pattern &search) const
 {
@@ -448,15 +479,26 @@ vector<stash_search_result> Stash::matches_search(
     if (empty())
         return results;
 
-    for (const item_def &item : items)
+    update_search_text();
+    for (size_t i = 0; i < items.size(); ++i)
     {
-        const string s   = stash_item_name(item);
-        const string ann = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE, &item);
-        if (search.matches(prefix + " " + ann + " " + s)
-            || is_dumpable_artefact(item) && search.matches(chardump_desc(item)))
+        const item_def &item = items[i];
+        stash_search_text &text = search_cache[i];
+        bool match = search.matches(prefix + " " + text.annotation + " "
+                                    + text.name);
+        if (!match && is_dumpable_artefact(item))
+        {
+            if (!text.have_desc)
+            {
+                text.desc = chardump_desc(item);
+                text.have_desc = true;
+            }
+            match = search.matches(text.desc);
+        }
+        if (match)
         {
             stash_search_result res;
-            res.match = s;
+            res.match = text.name;
             res.primary_sort = item.name(DESC_QUALNAME);
             res.item = item;
             results.push_back(res);
@@ -484,6 +526,7 @@ vector<stash_search_result> Stash::matches_search(
 /// Fedhas: rot away all corpses.
 void Stash::rot_all_corpses()
 {
+    search_cache_turn = -1;
     for (int i = items.size() - 1; i >= 0; i--)
     {
         item_def &item = items[i];
@@ -494,6 +537,7 @@ void Stash::rot_all_corpses()
 
 void Stash::_update_corpses(int rot_time)
 {
+    search_cache_turn = -1;
     for (int i = items.size() - 1; i >= 0; i--)
     {
         item_def &item = items[i];
@@ -514,6 +558,7 @@ void Stash::_update_corpses(int rot_time)
 
 void Stash::_update_identification()
 {
+    search_cache_turn = -1;
     for (int i = items.size() - 1; i >= 0; i--)
     {
         god_id_item(items[i]);
@@ -619,6 +664,7 @@ void Stash::save(writer& outf) const
 
 void Stash::load(reader& inf)
 {
+    search_cache_turn = -1;
     // How many items?
     int count = unmarshallShort(inf);
 
@@ -645,7 +691,7 @@ void Stash::load(reader& inf)
 }
 
 ShopInfo::ShopInfo(const shop_struct& shop_)
-    : shop(shop_)
+    : shop(shop_), search_cache_turn(-1)
 {
 }
 
@@ -690,6 +736,27 @@ void ShopInfo::show_menu(const level_pos& pos) const
     ::shop(const_cast<shop_struct&>(shop), pos);
 }
 
+void ShopInfo::update_search_text() const
+{
+    if (search_cache_turn == you.num_turns
+        && search_cache.size() == shop.stock.size())
+    {
+        return;
+    }
+
+    search_cache.clear();
+    for (const item_def &item : shop.stock)
+    {
+        stash_search_text text;
+        text.name       = shop_item_name(item);
+        text.annotation = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE,
+                                              &item, true);
+        text.have_desc  = false;
+        search_cache.push_back(text);
+    }
+    search_cache_turn = you.num_turns;
+}
+
 vector<stash_search_result> ShopInfo::matches_search(
     const string &prefix, const base_pattern &search) const
 {
@@ -716,18 +783,28 @@ vector<stash_search_result> ShopInfo::matches_search(
         shop_matches = true;
     }
 
-    for (const item_def &item : shop.stock)
+    update_search_text();
+    for (size_t i = 0; i < shop.stock.size(); ++i)
     {
-        const string sname = shop_item_name(item);
-        const string ann   = stash_annotate_item(STASH_LUA_SEARCH_ANNOTATE,
-                                                 &item, true);
+        const item_def &item = shop.stock[i];
+        stash_search_text &text = search_cache[i];
+        bool match = shop_matches
+                     || search.matches(prefix + " " + text.annotation + " "
+                                       + text.name);
+        if (!match)
+        {
+            if (!text.have_desc)
+            {
+                text.desc = shop_item_desc(item);
+                text.have_desc = true;
+            }
+            match = search.matches(text.desc);
+        }
 
-        if (shop_matches
-            || search.matches(prefix + " " + ann + " " + sname)
-            || search.matches(shop_item_desc(item)))
+        if (match)
         {
             stash_search_result res;
-            res.match = sname;
+            res.match = text.name;
             res.primary_sort = item.name(DESC_QUALNAME);
             res.item = item;
             res.pos.pos = shop.pos;
@@ -857,6 +934,8 @@ void LevelStashes::move_stash(const coord_def& from, const coord_def& to)
 
     coord_def old_pos = s->pos;
     s->pos = to;
+    // Describe whatever is at the new spot when it's next updated.
+    s->feat_desc.clear();
     m_stashes[s->pos] = *s;
     m_stashes.erase(old_pos);
 }
@@ -1100,6 +1179,7 @@ void StashTracker::remove_level(const level_id &place)
 
 void StashTracker::add_stash(coord_def p)
 {
+    alloc_tag_scope tag(ALLOC_STASH);
     LevelStashes &current = get_current_level();
     current.add_stash(p);
 
@@ -1161,6 +1241,7 @@ void StashTracker::load(reader& inf)
 
 void StashTracker::update_visible_stashes()
 {
+    alloc_tag_scope tag(ALLOC_STASH);
     LevelStashes *lev = find_current_level();
     coord_def c;
     for (radius_iterator ri(you.pos(),
@@ -18,6 +18,18 @@ class writer;
 class StashMenu;
 
 struct stash_search_result;
+
+// The strings an item is searched by. Building them means naming the item
+// and calling the Lua annotation hooks, so they're kept for the rest of the
+// turn instead of being rebuilt for each search.
+struct stash_search_text
+{
+    string name;
+    string annotation;
+    string desc;        // Only filled in once it's needed.
+    bool have_desc;
+};
+
 class Stash
 {
 public:
@@ -67,6 +79,7 @@ private:
     void _update_corpses(int rot_time);
     void _update_identification();
     void add_item(const item_def &item, bool add_to_front = false);
+    void update_search_text() const;
 
 private:
     bool verified;      // Is this correct to the best of our knowledge?
@@ -77,6 +90,9 @@ private:
 
     vector<item_def> items;
 
+    mutable vector<stash_search_text> search_cache;
+    mutable int search_cache_turn;
+
     static bool are_items_same(const item_def &, const item_def &,
                                bool exact = false);
 
@@ -106,6 +122,10 @@ private:
 
     string shop_item_name(const item_def &it) const;
     string shop_item_desc(const item_def &it) const;
+    void update_search_text() const;
+
+    mutable vector<stash_search_text> search_cache;
+    mutable int search_cache_turn;
 
     friend class ST_ItemIterator;
 };
@@ -31,11 +31,12 @@ game_state::game_state()
       terminal_resized(false), last_winch(0), io_inited(false),
       need_save(false), saving_game(false), updating_scores(false),
       seen_hups(0), map_stat_gen(false), map_stat_dump_disconnect(false),
+      map_stat_profile(false), map_stat_travel_bench(false),
       obj_stat_gen(false), type(GAME_TYPE_NORMAL),
       last_type(GAME_TYPE_UNSPECIFIED), last_game_exit(game_exit::unknown),
       marked_as_won(false), arena_suspended(false),
       generating_level(false), dump_maps(false), test(false), script(false),
-      build_db(false), tests_selected(),
+      build_db(false), startup_profile(false), tests_selected(),
 #ifdef DGAMELAUNCH
       throttle(true),
       bypassed_startup_menu(true),
@@ -55,10 +55,16 @@ struct game_state
     bool map_stat_gen;      // Set if we're generating stats on maps.
     bool map_stat_dump_disconnect; // Set if we dump disconnected maps and exit
                                    // under mapstat.
+    bool map_stat_profile;  // Set to time map Lua and level builds under
+                            // mapstat.
+    bool map_stat_travel_bench; // Set to benchmark explore and travel on
+                                // each level built under mapstat.
     bool obj_stat_gen;      // Set if we're generating object stats.
 
     string force_map;       // Set if we're forcing a specific map to generate.
 
+    string turn_profile_file; // Where to write turn timings on exit, if set.
+
     game_type type;
     game_type last_type;
     game_exit last_game_exit;
@@ -72,6 +78,7 @@ struct game_state
     bool test_list;         // Show available tests and exit.
     bool script;            // Set if we want to run a Lua script and exit.
     bool build_db;          // Set if we want to rebuild the db and exit.
+    bool startup_profile;   // Time each phase of start-up, report, and exit.
     vector<string> tests_selected; // Tests to be run.
     vector<string> script_args;    // Arguments to scripts.
 
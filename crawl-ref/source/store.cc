@@ -1237,6 +1237,16 @@ static map<string, int> accesses;
 # define ACCESS(x)
 #endif
 
+// Most lookups are by string literal, and would otherwise build and free a
+// temporary key string every time; this one keeps its buffer between calls.
+// Callers must be done with it before anything else looks up a property.
+static const string &_key_string(const char *key)
+{
+    static string scratch;
+    scratch.assign(key);
+    return scratch;
+}
+
 //////////////////
 // Misc functions
 
@@ -1247,6 +1257,14 @@ bool CrawlHashTable::exists(const string &key) const
     return find(key) != end();
 }
 
+bool CrawlHashTable::exists(const char *key) const
+{
+    ASSERT_VALIDITY();
+    const string &skey = _key_string(key);
+    ACCESS(skey);
+    return find(skey) != end();
+}
+
 void CrawlHashTable::assert_validity() const
 {
 #ifdef DEBUG
@@ -1318,6 +1336,15 @@ CrawlStoreValue& CrawlHashTable::get_value(const string &key)
     return map::operator[](key);
 }
 
+CrawlStoreValue& CrawlHashTable::get_value(const char *key)
+{
+    ASSERT_VALIDITY();
+    const string &skey = _key_string(key);
+    ACCESS(skey);
+    // Inserts CrawlStoreValue() if the key was not found.
+    return map::operator[](skey);
+}
+
 const CrawlStoreValue& CrawlHashTable::get_value(const string &key) const
 {
     ASSERT_VALIDITY();
@@ -1332,6 +1359,30 @@ const CrawlStoreValue& CrawlHashTable::get_value(const string &key) const
     return store;
 }
 
+const CrawlStoreValue* CrawlHashTable::find_value(const char *key) const
+{
+    ASSERT_VALIDITY();
+    const string &skey = _key_string(key);
+    ACCESS(skey);
+    auto iter = find(skey);
+    return iter == end() ? nullptr : &iter->second;
+}
+
+const CrawlStoreValue& CrawlHashTable::get_value(const char *key) const
+{
+    ASSERT_VALIDITY();
+    const string &skey = _key_string(key);
+    ACCESS(skey);
+    auto iter = find(skey);
+    ASSERTM(iter != end(), "trying to read non-existent property \"%s\"", key);
+
+    const CrawlStoreValue& store = iter->second;
+    ASSERT(store.type != SV_NONE);
+    ASSERT(!(store.flags & SFLAG_UNSET));
+
+    return store;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
 
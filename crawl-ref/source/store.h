@@ -255,18 +255,22 @@ public:
     void read(reader &);
 
     bool exists(const string &key) const;
+    bool exists(const char *key) const;
 
     void assert_validity() const;
 
     // NOTE: If the const versions of get_value() or [] are given a
     // key which doesn't exist, they will assert.
     const CrawlStoreValue& get_value(const string &key) const;
-    const CrawlStoreValue& get_value(const char *key) const
-    { return get_value(string(key)); }
+    const CrawlStoreValue& get_value(const char *key) const;
     const CrawlStoreValue& operator[] (const string &key) const
     { return get_value(key); }
     const CrawlStoreValue& operator[] (const char *key) const
-    { return get_value(string(key)); }
+    { return get_value(key); }
+
+    // The value for key, or nullptr if there is none: one lookup instead
+    // of the two taken by exists() followed by get_value().
+    const CrawlStoreValue* find_value(const char *key) const;
 
     // NOTE: If get_value() or [] is given a key which doesn't exist
     // in the table, an unset/empty CrawlStoreValue will be created
@@ -276,11 +280,10 @@ public:
     // then trying to assign a different type to the CrawlStoreValue
     // will assert.
     CrawlStoreValue& get_value(const string &key);
-    CrawlStoreValue& get_value(const char *key)
-    { return get_value(string(key)); }
+    CrawlStoreValue& get_value(const char *key);
     using map::operator[];
     CrawlStoreValue& operator[] (const char *key)
-    { return get_value(string(key)); }
+    { return get_value(key); }
 };
 
 // A CrawlVector is the vector version of CrawlHashTable, except that
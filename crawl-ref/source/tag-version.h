@@ -221,6 +221,9 @@ enum tag_minor_version
     TAG_MINOR_XP_SCALING,          // scale exp_available and total_experience
     TAG_MINOR_NO_ACTOR_HELD,       // Remove actor.held.
     TAG_MINOR_GOLDIFY_BOOKS,       // Spellbooks disintegrate when picked up, like gold/runes/orbs
+    TAG_MINOR_MAP_KNOWLEDGE_RLE,   // Run-length encode map knowledge.
+    TAG_MINOR_PACKED_FIELDS,       // Fixed-size item and monster fields in one block.
+    TAG_MINOR_DES_BYTECODE,        // Lua bytecode stored alongside source in the des cache.
 #endif
     NUM_TAG_MINORS,
     TAG_MINOR_VERSION = NUM_TAG_MINORS - 1
@@ -103,19 +103,21 @@ extern set<pair<string, level_id> > auto_unique_annotations;
 extern abyss_state abyssal_state;
 
 reader::reader(const string &_read_filename, int minorVersion)
-    : _filename(_read_filename), _chunk(0), _pbuf(nullptr), _read_offset(0),
-      _minorVersion(minorVersion), _safe_read(false)
+    : _filename(_read_filename), _chunk(0), _pbuf(nullptr), _pbuf_size(0),
+      _read_offset(0), _minorVersion(minorVersion), _safe_read(false)
 {
     _file       = fopen_u(_filename.c_str(), "rb");
     opened_file = !!_file;
 }
 
 reader::reader(package *save, const string &chunkname, int minorVersion)
-    : _file(0), _chunk(0), opened_file(false), _pbuf(0), _read_offset(0),
-     _minorVersion(minorVersion), _safe_read(false)
+    : _file(0), _chunk(0), opened_file(false), _pbuf(0), _pbuf_size(0),
+      _read_offset(0), _stage(new unsigned char[MARSHALL_STAGE_SIZE]),
+      _minorVersion(minorVersion), _safe_read(false)
 {
     ASSERT(save);
     _chunk = new chunk_reader(save, chunkname);
+    _pbuf = _stage.get();
 }
 
 reader::~reader()
@@ -134,6 +136,10 @@ void reader::close()
 
 void reader::advance(size_t offset)
 {
+    // Files and buffers can skip ahead directly.
+    if (!_chunk)
+        return read(nullptr, offset);
+
     char junk[128];
 
     while (offset)
@@ -147,7 +153,7 @@ void reader::advance(size_t offset)
 bool reader::valid() const
 {
     return (_file && !feof(_file)) ||
-           (_pbuf && _read_offset < _pbuf->size());
+           (!_chunk && _pbuf && _read_offset < _pbuf_size);
 }
 
 static NORETURN void _short_read(bool safe_read)
@@ -159,8 +165,19 @@ static NORETURN void _short_read(bool safe_read)
     die_noline("short read while reading save");
 }
 
-// Reads input in network byte order, from a file or buffer.
-unsigned char reader::readByte()
+// Decompress the next block of a chunk into the staging buffer. Returns
+// false at the end of the chunk.
+bool reader::refill_stage()
+{
+    ASSERT(_chunk);
+    _pbuf_size = _chunk->read(_stage.get(), MARSHALL_STAGE_SIZE);
+    _read_offset = 0;
+    return _pbuf_size > 0;
+}
+
+// The inline readByte() handles bytes already in memory; this deals with
+// files, empty staging buffers and running off the end.
+unsigned char reader::read_byte_unbuffered()
 {
     if (_file)
     {
@@ -169,19 +186,10 @@ unsigned char reader::readByte()
             _short_read(_safe_read);
         return b;
     }
-    else if (_chunk)
-    {
-        unsigned char buf;
-        if (_chunk->read(&buf, 1) != 1)
-            _short_read(_safe_read);
-        return buf;
-    }
-    else
-    {
-        if (_read_offset >= _pbuf->size())
-            _short_read(_safe_read);
-        return (*_pbuf)[_read_offset++];
-    }
+    else if (_chunk && refill_stage())
+        return _pbuf[_read_offset++];
+
+    _short_read(_safe_read);
 }
 
 void reader::read(void *data, size_t size)
@@ -198,15 +206,38 @@ void reader::read(void *data, size_t size)
     }
     else if (_chunk)
     {
-        if (_chunk->read(data, size) != size)
+        unsigned char *cdata = static_cast<unsigned char*>(data);
+        const size_t staged = min(size, _pbuf_size - _read_offset);
+        if (cdata)
+        {
+            memcpy(cdata, &_pbuf[_read_offset], staged);
+            cdata += staged;
+        }
+        _read_offset += staged;
+        size -= staged;
+        if (!size)
+            return;
+
+        // Large reads bypass the staging buffer.
+        if (cdata && size >= MARSHALL_STAGE_SIZE)
+        {
+            if (_chunk->read(cdata, size) != size)
+                _short_read(_safe_read);
+            return;
+        }
+
+        if (!refill_stage() || _pbuf_size < size)
             _short_read(_safe_read);
+        if (cdata)
+            memcpy(cdata, _pbuf, size);
+        _read_offset = size;
     }
     else
     {
-        if (_read_offset+size > _pbuf->size())
+        if (_read_offset+size > _pbuf_size)
             _short_read(_safe_read);
         if (data && size)
-            memcpy(data, &(*_pbuf)[_read_offset], size);
+            memcpy(data, &_pbuf[_read_offset], size);
 
         _read_offset += size;
     }
@@ -226,9 +257,9 @@ void reader::setMinorVersion(int minorVersion)
 void reader::fail_if_not_eof(const string &name)
 {
     char dummy;
-    if (_chunk ? _chunk->read(&dummy, 1) :
+    if (_chunk ? _read_offset < _pbuf_size || _chunk->read(&dummy, 1) :
         _file ? (fgetc(_file) != EOF) :
-        _read_offset >= _pbuf->size())
+        _read_offset >= _pbuf_size)
     {
         fail("Incomplete read of \"%s\" - aborting.", name.c_str());
     }
@@ -244,26 +275,32 @@ void writer::check_ok(bool ok)
     }
 }
 
-void writer::writeByte(unsigned char ch)
+// Hand the staged bytes to the chunk in one go.
+void writer::flush_stage()
 {
-    if (failed)
-        return;
-
-    if (_chunk)
-        _chunk->write(&ch, 1);
-    else if (_file)
-        check_ok(fputc(ch, _file) != EOF);
-    else
-        _pbuf->push_back(ch);
+    if (_stage_len && !failed)
+        _chunk->write(_stage.get(), _stage_len);
+    _stage_len = 0;
 }
 
-void writer::write(const void *data, size_t size)
+// The inline writeByte() and write() only stage data that fits in the
+// buffer; everything else, and all non-chunk output, comes here.
+void writer::write_unstaged(const void *data, size_t size)
 {
     if (failed)
         return;
 
     if (_chunk)
-        _chunk->write(data, size);
+    {
+        flush_stage();
+        if (size < _stage_cap)
+        {
+            memcpy(_stage.get(), data, size);
+            _stage_len = size;
+        }
+        else
+            _chunk->write(data, size);
+    }
     else if (_file)
         check_ok(fwrite(data, 1, size, _file) == size);
     else
@@ -334,6 +371,8 @@ static void marshallMonsterInfo (writer &, const monster_info &);
 static void unmarshallMonsterInfo (reader &, monster_info &mi);
 static void marshallMapCell (writer &, const map_cell &);
 static void unmarshallMapCell (reader &, map_cell& cell);
+static void marshallMapKnowledge (writer &, const MapKnowledge &);
+static void unmarshallMapKnowledge (reader &, MapKnowledge &);
 
 template<typename T, typename T_iter, typename T_marshal>
 static void marshall_iterator(writer &th, T_iter beg, T_iter end,
@@ -372,10 +411,12 @@ uint8_t unmarshallUByte(reader &th)
 void marshallShort(writer &th, short data)
 {
     CHECK_INITIALIZED(data);
-    const char b2 = (char)(data & 0x00FF);
-    const char b1 = (char)((data & 0xFF00) >> 8);
-    th.writeByte(b1);
-    th.writeByte(b2);
+    const unsigned char buf[2] =
+    {
+        (unsigned char)((data & 0xFF00) >> 8),
+        (unsigned char)(data & 0x00FF),
+    };
+    th.write(buf, sizeof(buf));
 }
 
 // Unmarshall 2 byte short in network order.
@@ -391,15 +432,14 @@ int16_t unmarshallShort(reader &th)
 void marshallInt(writer &th, int32_t data)
 {
     CHECK_INITIALIZED(data);
-    char b4 = (char) (data & 0x000000FF);
-    char b3 = (char)((data & 0x0000FF00) >> 8);
-    char b2 = (char)((data & 0x00FF0000) >> 16);
-    char b1 = (char)((data & 0xFF000000) >> 24);
-
-    th.writeByte(b1);
-    th.writeByte(b2);
-    th.writeByte(b3);
-    th.writeByte(b4);
+    const unsigned char buf[4] =
+    {
+        (unsigned char)((data & 0xFF000000) >> 24),
+        (unsigned char)((data & 0x00FF0000) >> 16),
+        (unsigned char)((data & 0x0000FF00) >> 8),
+        (unsigned char) (data & 0x000000FF),
+    };
+    th.write(buf, sizeof(buf));
 }
 
 // Unmarshall 4 byte signed int in network order.
@@ -461,6 +501,73 @@ int64_t unmarshallSigned(reader& th)
         return (int64_t)(u >> 1);
 }
 
+// Items and monsters gather their fixed-size fields into one block of known
+// size, which is written and read with a single call rather than a call per
+// field. Values are stored in network order, like the marshallers above.
+template<size_t SIZE>
+class field_packer
+{
+public:
+    field_packer() : len(0) { }
+
+    void put(uint64_t v, size_t bytes)
+    {
+        ASSERT(len + bytes <= SIZE);
+        for (size_t i = bytes; i-- > 0;)
+            buf[len++] = (unsigned char) (v >> (8 * i));
+    }
+
+    void put_coord(const coord_def &c)
+    {
+        put(c.x, 2);
+        put(c.y, 2);
+    }
+
+    void write(writer &th) const
+    {
+        ASSERT(len == SIZE);
+        th.write(buf, SIZE);
+    }
+
+private:
+    unsigned char buf[SIZE];
+    size_t len;
+};
+
+template<size_t SIZE>
+class field_unpacker
+{
+public:
+    field_unpacker(reader &th) : pos(0)
+    {
+        th.read(buf, SIZE);
+    }
+
+    uint64_t get(size_t bytes)
+    {
+        ASSERT(pos + bytes <= SIZE);
+        uint64_t v = 0;
+        for (size_t i = 0; i < bytes; i++)
+            v = (v << 8) | buf[pos++];
+        return v;
+    }
+
+    int8_t get8() { return (int8_t) get(1); }
+    uint8_t get_u8() { return (uint8_t) get(1); }
+    int16_t get16() { return (int16_t) get(2); }
+    int32_t get32() { return (int32_t) get(4); }
+
+    coord_def get_coord()
+    {
+        const int x = get16();
+        return coord_def(x, get16());
+    }
+
+private:
+    unsigned char buf[SIZE];
+    size_t pos;
+};
+
 // Optimized for short vectors that have only the first few bits set, and
 // can have invalid length. For long ones you might want to do this
 // differently to not lose 1/8 bits and speed.
@@ -4239,15 +4346,14 @@ static void tag_construct_level(writer &th)
         for (int count_y = 0; count_y < GYM; count_y++)
         {
             marshallByte(th, grd[count_x][count_y]);
-            marshallMapCell(th, env.map_knowledge[count_x][count_y]);
             marshallInt(th, env.pgrid[count_x][count_y].flags);
         }
 
+    marshallMapKnowledge(th, env.map_knowledge);
+
     marshallBoolean(th, !!env.map_forgotten.get());
     if (env.map_forgotten.get())
-        for (int x = 0; x < GXM; x++)
-            for (int y = 0; y < GYM; y++)
-                marshallMapCell(th, (*env.map_forgotten)[x][y]);
+        marshallMapKnowledge(th, *env.map_forgotten);
 
     _run_length_encode(th, marshallByte, env.grid_colours, GXM, GYM);
 
@@ -4313,6 +4419,15 @@ static void tag_construct_level(writer &th)
     }
 }
 
+enum item_part_t
+{
+    IP_INSCRIPTION      = BIT(0),
+    IP_PROPS            = BIT(1),
+};
+
+// The size of the fixed fields written by marshallItem().
+#define ITEM_PACKED_SIZE 28
+
 void marshallItem(writer &th, const item_def &item, bool iinfo)
 {
     marshallByte(th, item.base_type);
@@ -4332,30 +4447,32 @@ void marshallItem(writer &th, const item_def &item, bool iinfo)
 #endif
     ASSERT(item.is_valid(iinfo));
 
-    marshallByte(th, item.sub_type);
-    marshallShort(th, item.plus);
-    marshallShort(th, item.plus2);
-    marshallInt(th, item.special);
-    marshallShort(th, item.quantity);
-
-    marshallByte(th, item.rnd);
-    marshallShort(th, item.pos.x);
-    marshallShort(th, item.pos.y);
-    marshallInt(th, item.flags);
-
-    marshallShort(th, item.link);
-    if (item.pos.x >= 0 && item.pos.y >= 0)
-        marshallShort(th, igrd(item.pos));  //  unused
-    else
-        marshallShort(th, -1); // unused
-
-    marshallByte(th, item.slot);
-
-    item.orig_place.save(th);
-    marshallShort(th, item.orig_monnum);
-    marshallString(th, item.inscription);
-
-    item.props.write(th);
+    uint8_t parts = 0;
+    if (!item.inscription.empty())
+        parts |= IP_INSCRIPTION;
+    if (!item.props.empty())
+        parts |= IP_PROPS;
+
+    field_packer<ITEM_PACKED_SIZE> fields;
+    fields.put(item.sub_type, 1);
+    fields.put(item.plus, 2);
+    fields.put(item.plus2, 2);
+    fields.put(item.special, 4);
+    fields.put(item.quantity, 2);
+    fields.put(item.rnd, 1);
+    fields.put_coord(item.pos);
+    fields.put(item.flags, 4);
+    fields.put(item.link, 2);
+    fields.put(item.slot, 1);
+    fields.put(_pack(item.orig_place), 2);
+    fields.put(item.orig_monnum, 2);
+    fields.put(parts, 1);
+    fields.write(th);
+
+    if (parts & IP_INSCRIPTION)
+        marshallString(th, item.inscription);
+    if (parts & IP_PROPS)
+        item.props.write(th);
 }
 
 #if TAG_MAJOR_VERSION == 34
@@ -4382,14 +4499,12 @@ static void _fixup_dragon_artefact_name(item_def &item, string name_key)
 }
 #endif
 
-void unmarshallItem(reader &th, item_def &item)
+#if TAG_MAJOR_VERSION == 34
+// Items from before TAG_MINOR_PACKED_FIELDS wrote each field separately.
+static void _unmarshall_unpacked_item(reader &th, item_def &item)
 {
-    item.base_type   = static_cast<object_class_type>(unmarshallByte(th));
-    if (item.base_type == OBJ_UNASSIGNED)
-        return;
     item.sub_type    = unmarshallUByte(th);
     item.plus        = unmarshallShort(th);
-#if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_RUNE_TYPE
         && item.is_type(OBJ_MISCELLANY, MISC_RUNE_OF_ZOT))
     {
@@ -4403,30 +4518,11 @@ void unmarshallItem(reader &th, item_def &item)
     {
         item.sub_type = MISC_PHANTOM_MIRROR;
     }
-#endif
     item.plus2       = unmarshallShort(th);
     item.special     = unmarshallInt(th);
     item.quantity    = unmarshallShort(th);
-#if TAG_MAJOR_VERSION == 34
-    // These used to come in stacks in monster inventory as throwing weapons.
-    // Replace said stacks (but not single items) with tomahawks.
-    if (item.quantity > 1 && item.base_type == OBJ_WEAPONS
-        && (item.sub_type == WPN_CLUB || item.sub_type == WPN_HAND_AXE
-            || item.sub_type == WPN_DAGGER || item.sub_type == WPN_SPEAR))
-    {
-        item.base_type = OBJ_MISSILES;
-        item.sub_type = MI_TOMAHAWK;
-        item.plus = item.plus2 = 0;
-        item.brand = SPMSL_NORMAL;
-    }
-
-    // Strip vestiges of distracting gold.
-    if (item.base_type == OBJ_GOLD)
-        item.special = 0;
-
     if (th.getMinorVersion() < TAG_MINOR_REMOVE_ITEM_COLOUR)
         /* item.colour = */ unmarshallUByte(th);
-#endif
 
     item.rnd          = unmarshallUByte(th);
 
@@ -4434,18 +4530,15 @@ void unmarshallItem(reader &th, item_def &item)
     item.pos.y       = unmarshallShort(th);
     item.flags       = unmarshallInt(th);
     item.link        = unmarshallShort(th);
-#if TAG_MAJOR_VERSION == 34
     // ITEM_IN_SHOP was briefly NON_ITEM + NON_ITEM (1e85cf0), but that
     // doesn't fit in a short.
     if (item.link == static_cast<signed short>(54000))
         item.link = ITEM_IN_SHOP;
-#endif
 
     unmarshallShort(th);  // igrd[item.x][item.y] -- unused
 
     item.slot        = unmarshallByte(th);
 
-#if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_PLACE_UNPACK)
     {
         unsigned short packed = unmarshallShort(th);
@@ -4457,19 +4550,77 @@ void unmarshallItem(reader &th, item_def &item)
             item.orig_place = level_id::from_packed_place(packed);
     }
     else
-#endif
     item.orig_place.load(th);
 
     item.orig_monnum = unmarshallShort(th);
-#if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_ORIG_MONNUM && item.orig_monnum > 0)
         item.orig_monnum--;
-#endif
     item.inscription = unmarshallString(th);
 
     item.props.clear();
     item.props.read(th);
+}
+#endif
+
+static void _unmarshall_packed_item(reader &th, item_def &item)
+{
+    field_unpacker<ITEM_PACKED_SIZE> fields(th);
+    item.sub_type    = fields.get_u8();
+    item.plus        = fields.get16();
+    item.plus2       = fields.get16();
+    item.special     = fields.get32();
+    item.quantity    = fields.get16();
+    item.rnd         = fields.get_u8();
+    item.pos         = fields.get_coord();
+    item.flags       = fields.get(4);
+    item.link        = fields.get16();
+    item.slot        = fields.get8();
+#if TAG_MAJOR_VERSION == 34
+    item.orig_place  = level_id::from_packed_place(fields.get(2));
+#else
+    item.orig_place  = _unpack(fields.get(2));
+#endif
+    item.orig_monnum = fields.get16();
+    const uint8_t parts = fields.get_u8();
+
+    item.inscription.clear();
+    if (parts & IP_INSCRIPTION)
+        item.inscription = unmarshallString(th);
+
+    item.props.clear();
+    if (parts & IP_PROPS)
+        item.props.read(th);
+}
+
+void unmarshallItem(reader &th, item_def &item)
+{
+    item.base_type   = static_cast<object_class_type>(unmarshallByte(th));
+    if (item.base_type == OBJ_UNASSIGNED)
+        return;
 #if TAG_MAJOR_VERSION == 34
+    if (th.getMinorVersion() < TAG_MINOR_PACKED_FIELDS)
+        _unmarshall_unpacked_item(th, item);
+    else
+#endif
+    _unmarshall_packed_item(th, item);
+
+#if TAG_MAJOR_VERSION == 34
+    // These used to come in stacks in monster inventory as throwing weapons.
+    // Replace said stacks (but not single items) with tomahawks.
+    if (item.quantity > 1 && item.base_type == OBJ_WEAPONS
+        && (item.sub_type == WPN_CLUB || item.sub_type == WPN_HAND_AXE
+            || item.sub_type == WPN_DAGGER || item.sub_type == WPN_SPEAR))
+    {
+        item.base_type = OBJ_MISSILES;
+        item.sub_type = MI_TOMAHAWK;
+        item.plus = item.plus2 = 0;
+        item.brand = SPMSL_NORMAL;
+    }
+
+    // Strip vestiges of distracting gold.
+    if (item.base_type == OBJ_GOLD)
+        item.special = 0;
+
     if (th.getMinorVersion() < TAG_MINOR_CORPSE_COLOUR
         && item.base_type == OBJ_CORPSES
         && item.props.exists(FORCED_ITEM_COLOUR_KEY)
@@ -5067,6 +5218,97 @@ void unmarshallMapCell(reader &th, map_cell& cell)
     cell.flags = cell_flags;
 }
 
+// Cells without a cloud, item or monster; most of a map is made of long
+// runs of identical ones (unexplored rock, remembered floor).
+static bool _map_cell_is_plain(const map_cell &cell)
+{
+    return cell.cloud() == CLOUD_NONE && !cell.item()
+           && cell.monster() == MONS_NO_MONSTER;
+}
+
+static bool _same_plain_cell(const map_cell &a, const map_cell &b)
+{
+    return a.flags == b.flags && a.feat() == b.feat()
+           && a.feat_colour() == b.feat_colour() && a.trap() == b.trap();
+}
+
+// Map knowledge is stored as a sparse list of the cells with a cloud, item
+// or monster, followed by the remaining cells in column order as runs of
+// identical cells.
+static void marshallMapKnowledge(writer &th, const MapKnowledge &map)
+{
+    vector<coord_def> detailed;
+    for (int x = 0; x < GXM; x++)
+        for (int y = 0; y < GYM; y++)
+            if (!_map_cell_is_plain(map[x][y]))
+                detailed.emplace_back(x, y);
+
+    marshallUnsigned(th, detailed.size());
+    for (const coord_def &c : detailed)
+    {
+        marshallCoord(th, c);
+        marshallMapCell(th, map(c));
+    }
+
+    const map_cell *run = nullptr;
+    unsigned run_len = 0;
+    for (int x = 0; x < GXM; x++)
+        for (int y = 0; y < GYM; y++)
+        {
+            const map_cell &cell = map[x][y];
+            if (!_map_cell_is_plain(cell))
+                continue;
+            if (run && _same_plain_cell(*run, cell))
+            {
+                run_len++;
+                continue;
+            }
+            if (run)
+            {
+                marshallUnsigned(th, run_len);
+                marshallMapCell(th, *run);
+            }
+            run = &cell;
+            run_len = 1;
+        }
+    if (run)
+    {
+        marshallUnsigned(th, run_len);
+        marshallMapCell(th, *run);
+    }
+}
+
+static void unmarshallMapKnowledge(reader &th, MapKnowledge &map)
+{
+    FixedBitVector<GXM * GYM> is_detailed;
+    const unsigned num_detailed = unmarshallUnsigned(th);
+    for (unsigned i = 0; i < num_detailed; i++)
+    {
+        const coord_def c = unmarshallCoord(th);
+        ASSERT(map_bounds(c));
+        unmarshallMapCell(th, map(c));
+        is_detailed.set(c.x * GYM + c.y);
+    }
+
+    unsigned run_len = 0;
+    map_cell run;
+    for (int x = 0; x < GXM; x++)
+        for (int y = 0; y < GYM; y++)
+        {
+            if (is_detailed[x * GYM + y])
+                continue;
+            if (!run_len)
+            {
+                run_len = unmarshallUnsigned(th);
+                ASSERT(run_len);
+                unmarshallMapCell(th, run);
+            }
+            map[x][y] = run;
+            run_len--;
+        }
+    ASSERT(!run_len);
+}
+
 static void tag_construct_level_items(writer &th)
 {
     // how many traps?
@@ -5115,8 +5357,12 @@ enum mon_part_t
     MP_CONSTRICTION     = BIT(1),
     MP_ITEMS            = BIT(2),
     MP_SPELLS           = BIT(3),
+    MP_PROPS            = BIT(4),
 };
 
+// The size of the fixed fields written by marshallMonster().
+#define MONSTER_PACKED_SIZE 68
+
 void marshallMonster(writer &th, const monster& m)
 {
     if (!m.alive())
@@ -5135,58 +5381,61 @@ void marshallMonster(writer &th, const monster& m)
             parts |= MP_ITEMS;
     if (m.spells.size() > 0)
         parts |= MP_SPELLS;
+    if (!m.props.empty())
+        parts |= MP_PROPS;
 
     marshallShort(th, m.type);
     marshallUnsigned(th, parts);
     ASSERT(m.mid > 0);
-    marshallInt(th, m.mid);
+
+    field_packer<MONSTER_PACKED_SIZE> fields;
+    fields.put(m.mid, 4);
+    fields.put(m.xp_tracking, 1);
+    fields.put(m.get_experience_level(), 1);
+    fields.put(m.speed, 1);
+    fields.put(m.speed_increment, 1);
+    fields.put(m.behaviour, 1);
+    fields.put(m.pos().x, 1);
+    fields.put(m.pos().y, 1);
+    fields.put(m.target.x, 1);
+    fields.put(m.target.y, 1);
+    fields.put_coord(m.firing_pos);
+    fields.put_coord(m.patrol_point);
+    fields.put(m.travel_target, 1);
+    fields.put(m.flags.flags, 8);
+    fields.put(m.experience, 4);
+    fields.put(m.ench_countdown, 1);
+    fields.put(min(m.hit_points, MAX_MONSTER_HP), 2);
+    fields.put(min(m.max_hit_points, MAX_MONSTER_HP), 2);
+    fields.put(m.number, 4);
+    fields.put(m.base_monster, 2);
+    fields.put(m.colour, 2);
+    fields.put(m.summoner, 4);
+    fields.put(m.god, 1);
+    fields.put(m.attitude, 1);
+    fields.put(m.foe, 2);
+    fields.put(m.foe_memory, 4);
+    fields.put(m.damage_friendly, 2);
+    fields.put(m.damage_total, 2);
+    fields.put(m.went_unseen_this_turn, 1);
+    fields.put_coord(m.unseen_pos);
+    fields.write(th);
+
     marshallString(th, m.mname);
-    marshallByte(th, m.xp_tracking);
-    marshallByte(th, m.get_experience_level());
-    marshallByte(th, m.speed);
-    marshallByte(th, m.speed_increment);
-    marshallByte(th, m.behaviour);
-    marshallByte(th, m.pos().x);
-    marshallByte(th, m.pos().y);
-    marshallByte(th, m.target.x);
-    marshallByte(th, m.target.y);
-    marshallCoord(th, m.firing_pos);
-    marshallCoord(th, m.patrol_point);
-    int help = m.travel_target;
-    marshallByte(th, help);
 
     marshallShort(th, m.travel_path.size());
     for (coord_def pos : m.travel_path)
         marshallCoord(th, pos);
 
-    marshallUnsigned(th, m.flags.flags);
-    marshallInt(th, m.experience);
-
     marshallShort(th, m.enchantments.size());
     for (const auto &entry : m.enchantments)
         marshall_mon_enchant(th, entry.second);
-    marshallByte(th, m.ench_countdown);
-
-    marshallShort(th, min(m.hit_points, MAX_MONSTER_HP));
-    marshallShort(th, min(m.max_hit_points, MAX_MONSTER_HP));
-    marshallInt(th, m.number);
-    marshallShort(th, m.base_monster);
-    marshallShort(th, m.colour);
-    marshallInt(th, m.summoner);
 
     if (parts & MP_ITEMS)
         for (int j = 0; j < NUM_MONSTER_SLOTS; j++)
             marshallShort(th, m.inv[j]);
     if (parts & MP_SPELLS)
         marshallSpells(th, m.spells);
-    marshallByte(th, m.god);
-    marshallByte(th, m.attitude);
-    marshallShort(th, m.foe);
-    marshallInt(th, m.foe_memory);
-    marshallShort(th, m.damage_friendly);
-    marshallShort(th, m.damage_total);
-    marshallByte(th, m.went_unseen_this_turn);
-    marshallCoord(th, m.unseen_pos);
 
     if (parts & MP_GHOST_DEMON)
     {
@@ -5198,7 +5447,8 @@ void marshallMonster(writer &th, const monster& m)
     if (parts & MP_CONSTRICTION)
         _marshall_constriction(th, &m);
 
-    m.props.write(th);
+    if (parts & MP_PROPS)
+        m.props.write(th);
 }
 
 static void _marshall_mi_attack(writer &th, const mon_attack_def &attk)
@@ -5677,6 +5927,8 @@ static void tag_read_level(reader &th)
     env.map_seen.reset();
 #if TAG_MAJOR_VERSION == 34
     vector<coord_def> transporters;
+    const bool interleaved_map =
+        th.getMinorVersion() < TAG_MINOR_MAP_KNOWLEDGE_RLE;
 #endif
     for (int i = 0; i < gx; i++)
         for (int j = 0; j < gy; j++)
@@ -5689,22 +5941,33 @@ static void tag_read_level(reader &th)
             // Save these for potential destination clean up.
             if (grd[i][j] == DNGN_TRANSPORTER)
                 transporters.push_back(coord_def(i, j));
+            if (interleaved_map)
+                unmarshallMapCell(th, env.map_knowledge[i][j]);
 #endif
-            unmarshallMapCell(th, env.map_knowledge[i][j]);
-            // Fixup positions
-            if (env.map_knowledge[i][j].monsterinfo())
-                env.map_knowledge[i][j].monsterinfo()->pos = coord_def(i, j);
-            if (env.map_knowledge[i][j].cloudinfo())
-                env.map_knowledge[i][j].cloudinfo()->pos = coord_def(i, j);
-
-            env.map_knowledge[i][j].flags &= ~MAP_VISIBLE_FLAG;
-            if (env.map_knowledge[i][j].seen())
-                env.map_seen.set(i, j);
             env.pgrid[i][j].flags = unmarshallInt(th);
 
             mgrd[i][j] = NON_MONSTER;
         }
 
+#if TAG_MAJOR_VERSION == 34
+    if (!interleaved_map)
+#endif
+    unmarshallMapKnowledge(th, env.map_knowledge);
+
+    for (rectangle_iterator ri(0); ri; ++ri)
+    {
+        map_cell &cell = env.map_knowledge(*ri);
+        // Fixup positions
+        if (cell.monsterinfo())
+            cell.monsterinfo()->pos = *ri;
+        if (cell.cloudinfo())
+            cell.cloudinfo()->pos = *ri;
+
+        cell.flags &= ~MAP_VISIBLE_FLAG;
+        if (cell.seen())
+            env.map_seen.set(*ri);
+    }
+
 #if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_FORGOTTEN_MAP)
         env.map_forgotten.reset();
@@ -5713,9 +5976,16 @@ static void tag_read_level(reader &th)
     if (unmarshallBoolean(th))
     {
         MapKnowledge *f = new MapKnowledge();
-        for (int x = 0; x < GXM; x++)
-            for (int y = 0; y < GYM; y++)
-                unmarshallMapCell(th, (*f)[x][y]);
+#if TAG_MAJOR_VERSION == 34
+        if (interleaved_map)
+        {
+            for (int x = 0; x < GXM; x++)
+                for (int y = 0; y < GYM; y++)
+                    unmarshallMapCell(th, (*f)[x][y]);
+        }
+        else
+#endif
+        unmarshallMapKnowledge(th, *f);
         env.map_forgotten.reset(f);
     }
     else
@@ -5937,63 +6207,84 @@ static void tag_read_level_items(reader &th)
 #endif
 }
 
-void unmarshallMonster(reader &th, monster& m)
-{
-    m.reset();
-
-    m.type           = unmarshallMonType(th);
-    if (m.type == MONS_NO_MONSTER)
-        return;
-
-    ASSERT(!invalid_monster_type(m.type));
-
 #if TAG_MAJOR_VERSION == 34
-    uint32_t parts    = 0;
-    if (th.getMinorVersion() < TAG_MINOR_MONSTER_PARTS)
+static void _fixup_monster_spells(monster &m)
+{
+    monster_spells oldspells = m.spells;
+    m.spells.clear();
+    for (mon_spell_slot &slot : oldspells)
     {
-        if (mons_is_ghost_demon(m.type))
-            parts |= MP_GHOST_DEMON;
+        if (mons_is_zombified(m) && !mons_enslaved_soul(m)
+            && slot.spell != SPELL_CREATE_TENTACLES)
+        {
+            // zombies shouldn't have (most) spells
+        }
+        else if (slot.spell == SPELL_DRACONIAN_BREATH)
+        {
+            // Replace Draconian Breath with the colour-specific spell,
+            // and remove Azrael's bad breath while we're at it.
+            if (mons_genus(m.type) == MONS_DRACONIAN)
+                m.spells.push_back(drac_breath(draco_or_demonspawn_subspecies(m)));
+        }
+        // Give Mnoleg back malign gateway in place of tentacles.
+        else if (slot.spell == SPELL_CREATE_TENTACLES
+                 && m.type == MONS_MNOLEG)
+        {
+            slot.spell = SPELL_MALIGN_GATEWAY;
+            slot.freq = 27;
+            m.spells.push_back(slot);
+        }
+        else if (slot.spell == SPELL_CHANT_FIRE_STORM)
+        {
+            slot.spell = SPELL_FIRE_STORM;
+            m.spells.push_back(slot);
+        }
+        else if (slot.spell == SPELL_SERPENT_OF_HELL_BREATH_REMOVED)
+        {
+            slot.spell = _fixup_soh_breath(m.type);
+            m.spells.push_back(slot);
+        }
+        else if (slot.spell != SPELL_DELAYED_FIREBALL
+                 && slot.spell != SPELL_MELEE)
+        {
+            m.spells.push_back(slot);
+        }
+        else if (slot.spell == SPELL_CORRUPT_BODY)
+        {
+            slot.spell = SPELL_CORRUPTING_PULSE;
+            m.spells.push_back(slot);
+        }
     }
-    else
-        parts         = unmarshallUnsigned(th);
-    if (th.getMinorVersion() < TAG_MINOR_OPTIONAL_PARTS)
-        parts |= MP_CONSTRICTION | MP_ITEMS | MP_SPELLS;
-#else
-    uint32_t parts    = unmarshallUnsigned(th);
-#endif
+}
+
+// Monsters from before TAG_MINOR_PACKED_FIELDS wrote each field separately.
+static void _unmarshall_unpacked_monster(reader &th, monster &m,
+                                         uint32_t parts)
+{
     m.mid             = unmarshallInt(th);
     ASSERT(m.mid > 0);
     m.mname           = unmarshallString(th);
-#if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() >= TAG_MINOR_LEVEL_XP_INFO)
     {
         // This was monster::is_spawn before the level XP info fix.
         if (th.getMinorVersion() < TAG_MINOR_LEVEL_XP_INFO_FIX)
             m.xp_tracking = unmarshallByte(th) ? XP_SPAWNED : XP_GENERATED;
         else
-#endif
-    m.xp_tracking     = static_cast<xp_tracking_type>(unmarshallUByte(th));
-#if TAG_MAJOR_VERSION == 34
+            m.xp_tracking = static_cast<xp_tracking_type>(unmarshallUByte(th));
     }
     // Don't track monsters generated before TAG_MINOR_LEVEL_XP_INFO.
     else
         m.xp_tracking = XP_UNTRACKED;
 
-
     if (th.getMinorVersion() < TAG_MINOR_REMOVE_MON_AC_EV)
     {
         unmarshallByte(th);
         unmarshallByte(th);
     }
-#endif
     m.set_hit_dice(     unmarshallByte(th));
-#if TAG_MAJOR_VERSION == 34
     // Draining used to be able to take a monster to 0 HD, but that
     // caused crashes if they tried to cast spells.
     m.set_hit_dice(max(m.get_experience_level(), 1));
-#else
-    ASSERT(m.get_experience_level() > 0);
-#endif
     m.speed           = unmarshallByte(th);
     // Avoid sign extension when loading files (Elethiomel's hang)
     m.speed_increment = unmarshallUByte(th);
@@ -6032,89 +6323,29 @@ void unmarshallMonster(reader &th, monster& m)
     m.number         = unmarshallInt(th);
     m.base_monster   = unmarshallMonType(th);
     m.colour         = unmarshallShort(th);
-#if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_SUMMONER)
         m.summoner = 0;
     else
-#endif
-    m.summoner       = unmarshallInt(th);
+        m.summoner   = unmarshallInt(th);
 
     if (parts & MP_ITEMS)
         for (int j = 0; j < NUM_MONSTER_SLOTS; j++)
             m.inv[j] = unmarshallShort(th);
 
     if (parts & MP_SPELLS)
-    {
-        unmarshallSpells(th, m.spells
-#if TAG_MAJOR_VERSION == 34
-                         , m.get_experience_level()
-#endif
-                         );
-#if TAG_MAJOR_VERSION == 34
-    monster_spells oldspells = m.spells;
-    m.spells.clear();
-    for (mon_spell_slot &slot : oldspells)
-    {
-        if (mons_is_zombified(m) && !mons_enslaved_soul(m)
-            && slot.spell != SPELL_CREATE_TENTACLES)
-        {
-            // zombies shouldn't have (most) spells
-        }
-        else if (slot.spell == SPELL_DRACONIAN_BREATH)
-        {
-            // Replace Draconian Breath with the colour-specific spell,
-            // and remove Azrael's bad breath while we're at it.
-            if (mons_genus(m.type) == MONS_DRACONIAN)
-                m.spells.push_back(drac_breath(draco_or_demonspawn_subspecies(m)));
-        }
-        // Give Mnoleg back malign gateway in place of tentacles.
-        else if (slot.spell == SPELL_CREATE_TENTACLES
-                 && m.type == MONS_MNOLEG)
-        {
-            slot.spell = SPELL_MALIGN_GATEWAY;
-            slot.freq = 27;
-            m.spells.push_back(slot);
-        }
-        else if (slot.spell == SPELL_CHANT_FIRE_STORM)
-        {
-            slot.spell = SPELL_FIRE_STORM;
-            m.spells.push_back(slot);
-        }
-        else if (slot.spell == SPELL_SERPENT_OF_HELL_BREATH_REMOVED)
-        {
-            slot.spell = _fixup_soh_breath(m.type);
-            m.spells.push_back(slot);
-        }
-#if TAG_MAJOR_VERSION == 34
-        else if (slot.spell != SPELL_DELAYED_FIREBALL
-                 && slot.spell != SPELL_MELEE)
-        {
-            m.spells.push_back(slot);
-        }
-#endif
-        else if (slot.spell == SPELL_CORRUPT_BODY)
-        {
-            slot.spell = SPELL_CORRUPTING_PULSE;
-            m.spells.push_back(slot);
-        }
-    }
-#endif
-    }
+        unmarshallSpells(th, m.spells, m.get_experience_level());
 
     m.god      = static_cast<god_type>(unmarshallByte(th));
     m.attitude = static_cast<mon_attitude_type>(unmarshallByte(th));
     m.foe      = unmarshallShort(th);
-#if TAG_MAJOR_VERSION == 34
     // In 0.16 alpha we briefly allowed YOU_FAULTLESS as a monster's foe.
     if (m.foe == YOU_FAULTLESS)
         m.foe = MHITYOU;
-#endif
     m.foe_memory = unmarshallInt(th);
 
     m.damage_friendly = unmarshallShort(th);
     m.damage_total = unmarshallShort(th);
 
-#if TAG_MAJOR_VERSION == 34
     if (th.getMinorVersion() < TAG_MINOR_UNSEEN_MONSTER)
     {
         m.went_unseen_this_turn = false;
@@ -6122,14 +6353,121 @@ void unmarshallMonster(reader &th, monster& m)
     }
     else
     {
+        m.went_unseen_this_turn = unmarshallByte(th);
+        m.unseen_pos = unmarshallCoord(th);
+    }
+}
 #endif
-    m.went_unseen_this_turn = unmarshallByte(th);
-    m.unseen_pos = unmarshallCoord(th);
+
+static void _unmarshall_packed_monster(reader &th, monster &m, uint32_t parts)
+{
+    {
+        field_unpacker<MONSTER_PACKED_SIZE> fields(th);
+        m.mid             = fields.get32();
+        ASSERT(m.mid > 0);
+        m.xp_tracking     = static_cast<xp_tracking_type>(fields.get_u8());
+        m.set_hit_dice(     fields.get8());
 #if TAG_MAJOR_VERSION == 34
+        m.set_hit_dice(max(m.get_experience_level(), 1));
+#else
+        ASSERT(m.get_experience_level() > 0);
+#endif
+        m.speed           = fields.get8();
+        m.speed_increment = fields.get_u8();
+        m.behaviour       = static_cast<beh_type>(fields.get_u8());
+        const int x       = fields.get8();
+        m.set_position(coord_def(x, fields.get8()));
+        m.target.x        = fields.get8();
+        m.target.y        = fields.get8();
+        m.firing_pos      = fields.get_coord();
+        m.patrol_point    = fields.get_coord();
+        m.travel_target   = static_cast<montravel_target_type>(fields.get8());
+        m.flags.flags     = fields.get(8);
+        m.experience      = fields.get32();
+        m.ench_countdown  = fields.get8();
+        m.hit_points      = fields.get16();
+        m.max_hit_points  = fields.get16();
+        m.number          = fields.get32();
+        m.base_monster    = static_cast<monster_type>(fields.get16());
+        m.colour          = fields.get16();
+        m.summoner        = fields.get32();
+        m.god             = static_cast<god_type>(fields.get8());
+        m.attitude        = static_cast<mon_attitude_type>(fields.get8());
+        m.foe             = fields.get16();
+        m.foe_memory      = fields.get32();
+        m.damage_friendly = fields.get16();
+        m.damage_total    = fields.get16();
+        m.went_unseen_this_turn = fields.get8();
+        m.unseen_pos      = fields.get_coord();
+    }
+
+    m.mname = unmarshallString(th);
+
+    const int len = unmarshallShort(th);
+    for (int i = 0; i < len; ++i)
+        m.travel_path.push_back(unmarshallCoord(th));
+
+    m.enchantments.clear();
+    const int nenchs = unmarshallShort(th);
+    for (int i = 0; i < nenchs; ++i)
+    {
+        mon_enchant me = unmarshall_mon_enchant(th);
+        m.enchantments[me.ench] = me;
+        m.ench_cache.set(me.ench, true);
     }
+
+    if (parts & MP_ITEMS)
+        for (int j = 0; j < NUM_MONSTER_SLOTS; j++)
+            m.inv[j] = unmarshallShort(th);
+
+    if (parts & MP_SPELLS)
+    {
+        unmarshallSpells(th, m.spells
+#if TAG_MAJOR_VERSION == 34
+                         , m.get_experience_level()
 #endif
+                         );
+    }
+}
+
+void unmarshallMonster(reader &th, monster& m)
+{
+    m.reset();
+
+    m.type           = unmarshallMonType(th);
+    if (m.type == MONS_NO_MONSTER)
+        return;
+
+    ASSERT(!invalid_monster_type(m.type));
+
+#if TAG_MAJOR_VERSION == 34
+    uint32_t parts    = 0;
+    if (th.getMinorVersion() < TAG_MINOR_MONSTER_PARTS)
+    {
+        if (mons_is_ghost_demon(m.type))
+            parts |= MP_GHOST_DEMON;
+    }
+    else
+        parts         = unmarshallUnsigned(th);
+    if (th.getMinorVersion() < TAG_MINOR_OPTIONAL_PARTS)
+        parts |= MP_CONSTRICTION | MP_ITEMS | MP_SPELLS;
+#else
+    uint32_t parts    = unmarshallUnsigned(th);
+#endif
+#if TAG_MAJOR_VERSION == 34
+    if (th.getMinorVersion() < TAG_MINOR_PACKED_FIELDS)
+    {
+        _unmarshall_unpacked_monster(th, m, parts);
+        parts |= MP_PROPS;
+    }
+    else
+#endif
+    _unmarshall_packed_monster(th, m, parts);
 
 #if TAG_MAJOR_VERSION == 34
+    if (parts & MP_SPELLS)
+        _fixup_monster_spells(m);
+
     if (m.type == MONS_LABORATORY_RAT)
         unmarshallGhost(th), m.type = MONS_RAT;
 
@@ -6298,7 +6636,8 @@ void unmarshallMonster(reader &th, monster& m)
         _unmarshall_constriction(th, &m);
 
     m.props.clear();
-    m.props.read(th);
+    if (parts & MP_PROPS)
+        m.props.read(th);
 
     if (m.props.exists("monster_tile_name"))
     {
@@ -6405,6 +6744,7 @@ static void tag_read_level_monsters(reader &th)
     // how many monsters?
     count = unmarshallShort(th);
     ASSERT_RANGE(count, 0, MAX_MONSTERS + 1);
+    env.mons_used = count;
 
     for (int i = 0; i < count; i++)
     {
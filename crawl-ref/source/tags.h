@@ -6,6 +6,8 @@
 #pragma once
 
 #include <cstdio>
+#include <cstring>
+#include <memory>
 
 #include "package.h"
 
@@ -32,36 +34,74 @@ enum tag_type   // used during save/load process to identify data blocks
  * writer API
  * *********************************************************************** */
 
+// Size of the staging buffers that collect bytes for (or from) a package
+// chunk, so that zlib sees large blocks instead of one call per byte.
+const size_t MARSHALL_STAGE_SIZE = 64 * 1024;
+
 class writer
 {
 public:
     writer(const string &filename, FILE* output, bool ignore_errors = false)
         : _filename(filename), _file(output), _chunk(0),
-          _ignore_errors(ignore_errors), _pbuf(0), failed(false)
+          _ignore_errors(ignore_errors), _pbuf(0), _stage_len(0),
+          _stage_cap(0), failed(false)
     {
         ASSERT(output);
     }
     writer(vector<unsigned char>* poutput)
         : _filename(), _file(0), _chunk(0), _ignore_errors(false),
-          _pbuf(poutput), failed(false) { ASSERT(poutput); }
+          _pbuf(poutput), _stage_len(0), _stage_cap(0), failed(false)
+    {
+        ASSERT(poutput);
+    }
     writer(package *save, const string &chunkname)
         : _filename(), _file(0), _chunk(0), _ignore_errors(false),
-          failed(false)
+          _pbuf(0), _stage(new unsigned char[MARSHALL_STAGE_SIZE]),
+          _stage_len(0), _stage_cap(MARSHALL_STAGE_SIZE), failed(false)
     {
         ASSERT(save);
         _chunk = save->writer(chunkname);
     }
 
-    ~writer() { if (_chunk) delete _chunk; }
+    ~writer()
+    {
+        if (_chunk)
+        {
+            flush_stage();
+            delete _chunk;
+        }
+    }
+
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    void writeByte(unsigned char byte)
+    {
+        if (_stage_len < _stage_cap)
+            _stage[_stage_len++] = byte;
+        else
+            write_unstaged(&byte, 1);
+    }
+
+    void write(const void *data, size_t size)
+    {
+        if (size && _stage_cap - _stage_len >= size)
+        {
+            memcpy(&_stage[_stage_len], data, size);
+            _stage_len += size;
+        }
+        else
+            write_unstaged(data, size);
+    }
 
-    void writeByte(unsigned char byte);
-    void write(const void *data, size_t size);
     long tell();
 
     bool succeeded() const { return !failed; }
 
 private:
     void check_ok(bool ok);
+    void flush_stage();
+    void write_unstaged(const void *data, size_t size);
 
 private:
     string _filename;
@@ -71,6 +111,11 @@ private:
 
     vector<unsigned char>* _pbuf;
 
+    // Only used when writing to a chunk.
+    unique_ptr<unsigned char[]> _stage;
+    size_t _stage_len;
+    size_t _stage_cap;
+
     bool failed;
 };
 
@@ -99,16 +144,33 @@ public:
     reader(const string &filename, int minorVersion = TAG_MINOR_INVALID);
     reader(FILE* input, int minorVersion = TAG_MINOR_INVALID)
         : _file(input), _chunk(0), opened_file(false), _pbuf(0),
-          _read_offset(0), _minorVersion(minorVersion), _safe_read(false) {}
+          _pbuf_size(0), _read_offset(0), _minorVersion(minorVersion),
+          _safe_read(false) {}
     reader(const vector<unsigned char>& input,
            int minorVersion = TAG_MINOR_INVALID)
-        : _file(0), _chunk(0), opened_file(false), _pbuf(&input),
-          _read_offset(0), _minorVersion(minorVersion), _safe_read(false) {}
+        : _file(0), _chunk(0), opened_file(false), _pbuf(input.data()),
+          _pbuf_size(input.size()), _read_offset(0),
+          _minorVersion(minorVersion), _safe_read(false) {}
+    // Read from memory owned by the caller, e.g. a mapped file.
+    reader(const unsigned char *input, size_t size,
+           int minorVersion = TAG_MINOR_INVALID)
+        : _file(0), _chunk(0), opened_file(false), _pbuf(input),
+          _pbuf_size(size), _read_offset(0), _minorVersion(minorVersion),
+          _safe_read(false) {}
     reader(package *save, const string &chunkname,
            int minorVersion = TAG_MINOR_INVALID);
     ~reader();
 
-    unsigned char readByte();
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+
+    unsigned char readByte()
+    {
+        if (_read_offset < _pbuf_size)
+            return _pbuf[_read_offset++];
+        return read_byte_unbuffered();
+    }
+
     void read(void *data, size_t size);
     void advance(size_t size);
     int getMinorVersion() const;
@@ -121,13 +183,21 @@ public:
 
     void set_safe_read(bool setting) { _safe_read = setting; }
 
+private:
+    unsigned char read_byte_unbuffered();
+    bool refill_stage();
+
 private:
     string _filename;
     FILE* _file;
     chunk_reader *_chunk;
     bool  opened_file;
-    const vector<unsigned char>* _pbuf;
+    // The bytes being read: the caller's buffer, or for a chunk the staging
+    // buffer holding its next few decompressed bytes.
+    const unsigned char* _pbuf;
+    size_t _pbuf_size;
     unsigned int _read_offset;
+    unique_ptr<unsigned char[]> _stage;
     int _minorVersion;
     // always throw an exception rather than dying when reading past EOF
     bool _safe_read;
@@ -117,6 +117,12 @@ void targeter_beam::set_explosion_aim(bolt tempbeam)
     exp_map_min.init(INT_MAX);
     tempbeam.determine_affected_cells(exp_map_min, coord_def(), 0,
                                       min_expl_rad, true, true);
+    // Most explosions have a fixed radius; don't search the same cells twice.
+    if (max_expl_rad == min_expl_rad)
+    {
+        exp_map_max = exp_map_min;
+        return;
+    }
     exp_map_max.init(INT_MAX);
     tempbeam.determine_affected_cells(exp_map_max, coord_def(), 0,
                                       max_expl_rad, true, true);
@@ -426,9 +432,14 @@ bool targeter_smite::set_aim(coord_def a)
         exp_map_min.init(INT_MAX);
         beam.determine_affected_cells(exp_map_min, coord_def(), 0,
                                       exp_range_min, true, true);
-        exp_map_max.init(INT_MAX);
-        beam.determine_affected_cells(exp_map_max, coord_def(), 0,
-                                      exp_range_max, true, true);
+        if (exp_range_max == exp_range_min)
+            exp_map_max = exp_map_min;
+        else
+        {
+            exp_map_max.init(INT_MAX);
+            beam.determine_affected_cells(exp_map_max, coord_def(), 0,
+                                          exp_range_max, true, true);
+        }
     }
     return true;
 }
@@ -566,9 +577,7 @@ bool targeter_fragment::set_aim(coord_def a)
     exp_map_min.init(INT_MAX);
     beam.determine_affected_cells(exp_map_min, coord_def(), 0,
                                   exp_range_min, false, false);
-    exp_map_max.init(INT_MAX);
-    beam.determine_affected_cells(exp_map_max, coord_def(), 0,
-                                  exp_range_max, false, false);
+    exp_map_max = exp_map_min;
 
     return true;
 }
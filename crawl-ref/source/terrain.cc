@@ -33,6 +33,7 @@
 #include "mapmark.h"
 #include "message.h"
 #include "misc.h"
+#include "mon-pathfind.h"
 #include "mon-place.h"
 #include "mon-poly.h"
 #include "mon-util.h"
@@ -801,6 +802,32 @@ unwind_slime_wall_precomputer::~unwind_slime_wall_precomputer()
         _slime_wall_precomputed_neighbour_mask.reset(nullptr);
 }
 
+static int _terrain_batch_depth = 0;
+static vector<coord_def> _terrain_batch_cells;
+
+terrain_change_batch::terrain_change_batch()
+{
+    ++_terrain_batch_depth;
+}
+
+terrain_change_batch::~terrain_change_batch()
+{
+    if (--_terrain_batch_depth || _terrain_batch_cells.empty())
+        return;
+
+    // Past a few dozen cells, forgetting all of LOS is cheaper than
+    // forgetting the pairs through each cell.
+    if (_terrain_batch_cells.size() > 32)
+        los_changed();
+    else
+    {
+        for (const coord_def &c : _terrain_batch_cells)
+            los_terrain_changed(c);
+    }
+    clear_pathfields();
+    _terrain_batch_cells.clear();
+}
+
 bool slime_wall_neighbour(const coord_def& c)
 {
     if (!(env.level_state & LSTATE_SLIMY_WALL))
@@ -1952,7 +1979,13 @@ void set_terrain_changed(const coord_def p)
 
     dungeon_events.fire_position_event(DET_FEAT_CHANGE, p);
 
-    los_terrain_changed(p);
+    if (_terrain_batch_depth)
+        _terrain_batch_cells.push_back(p);
+    else
+    {
+        los_terrain_changed(p);
+        clear_pathfields();
+    }
 
     for (orth_adjacent_iterator ai(p); ai; ++ai)
         if (actor *act = actor_at(*ai))
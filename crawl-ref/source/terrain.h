@@ -28,6 +28,20 @@ private:
     bool did_compute_mask;
 };
 
+// While one of these is held, set_terrain_changed() defers the LOS and
+// pathing cache invalidation for the cells it is told about until the
+// outermost one goes away. Only for changes that nothing in between needs
+// to see in LOS, such as swapping floor for shallow water.
+class terrain_change_batch
+{
+public:
+    terrain_change_batch();
+    ~terrain_change_batch();
+
+    terrain_change_batch(const terrain_change_batch&) = delete;
+    terrain_change_batch& operator=(const terrain_change_batch&) = delete;
+};
+
 actor* actor_at(const coord_def& c);
 
 bool cell_is_solid(const coord_def &c);
@@ -0,0 +1,34 @@
+-- Check that explosions reach exactly the cells the original recursive
+-- search found, around random spots on generated levels.
+
+local checks = 0
+
+local function test_explosions_at(x, y)
+  for r = 1, 8 do
+    checks = checks + 1
+    assert(debug.check_explosion(x, y, r),
+           "explosion mismatch at (" .. x .. "," .. y .. ") radius " .. r)
+  end
+end
+
+local function run_explosion_tests(depth, nlevels, tests_per_level)
+  local place = "D:" .. depth
+  crawl.message("Running explosion tests on " .. place)
+  debug.goto_place(place)
+
+  for lev_i = 1, nlevels do
+    debug.flush_map_memory()
+    debug.generate_level()
+    for t_i = 1, tests_per_level do
+      you.random_teleport()
+      local x, y = you.pos()
+      test_explosions_at(x, y)
+      -- And somewhere that might well be inside rock.
+      test_explosions_at(crawl.random_range(1, 78), crawl.random_range(1, 68))
+    end
+  end
+end
+
+for depth = 1, 15 do
+  run_explosion_tests(depth, 1, 5)
+end
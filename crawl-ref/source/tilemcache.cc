@@ -5,6 +5,7 @@
 
 #include "colour.h"
 #include "env.h"
+#include "hash.h"
 #include "libutil.h"
 #include "misc.h"
 #include "mon-info.h"
@@ -35,11 +36,11 @@ struct demon_data
 class mcache_monster : public mcache_entry
 {
 public:
-    mcache_monster(const monster_info& mon);
+    mcache_monster(const monster_info& mon, tileidx_t mon_tile);
 
     virtual int info(tile_draw_info *dinfo) const override;
 
-    static bool valid(const monster_info& mon);
+    static bool valid(const monster_info& mon, tileidx_t mon_tile);
 
     static bool get_weapon_offset(tileidx_t mon_tile, int *ofs_x, int *ofs_y);
     static bool get_shield_offset(tileidx_t mon_tile, int *ofs_x, int *ofs_y);
@@ -134,6 +135,57 @@ tileidx_t tile_fg_store::operator=(tileidx_t tile)
     return m_tile;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// mcache_entry
+
+bool mcache_entry::draws_like(const mcache_entry &other) const
+{
+    if (transparent() != other.transparent())
+        return false;
+
+    const dolls_data *our_doll = doll();
+    const dolls_data *their_doll = other.doll();
+    if (!our_doll != !their_doll || our_doll && *our_doll != *their_doll)
+        return false;
+
+    tile_draw_info ours[MAX_INFO_COUNT];
+    tile_draw_info theirs[MAX_INFO_COUNT];
+    const int count = info(&ours[0]);
+    if (other.info(&theirs[0]) != count)
+        return false;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (ours[i].idx != theirs[i].idx
+            || ours[i].ofs_x != theirs[i].ofs_x
+            || ours[i].ofs_y != theirs[i].ofs_y)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32_t mcache_entry::draw_hash() const
+{
+    tile_draw_info dinfo[MAX_INFO_COUNT];
+    const int count = info(&dinfo[0]);
+
+    vector<uint32_t> key;
+    key.push_back(transparent());
+    for (int i = 0; i < count; i++)
+    {
+        key.push_back(dinfo[i].idx);
+        key.push_back(dinfo[i].ofs_x);
+        key.push_back(dinfo[i].ofs_y);
+    }
+    if (const dolls_data *d = doll())
+        key.insert(key.end(), d->parts, d->parts + TILEP_PART_MAX);
+
+    return hash32(key.data(), key.size() * sizeof(uint32_t));
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // mcache_manager
 
@@ -144,15 +196,23 @@ mcache_manager::~mcache_manager()
 
 unsigned int mcache_manager::register_monster(const monster_info& minf)
 {
-    // TODO enne - is it worth it to search against all mcache entries?
+    return register_monster(minf, tileidx_monster(minf) & TILE_FLAG_MASK);
+}
+
+// mon_tile is tileidx_monster(minf) without flags; callers that have
+// already picked it pass it in rather than having it looked up again for
+// the validity check and the entry itself.
+unsigned int mcache_manager::register_monster(const monster_info& minf,
+                                              tileidx_t mon_tile)
+{
     // TODO enne - pool mcache types to avoid too much alloc/dealloc?
 
     mcache_entry *entry;
 
     if (minf.props.exists("monster_tile"))
     {
-        if (mcache_monster::valid(minf))
-            entry = new mcache_monster(minf);
+        if (mcache_monster::valid(minf, mon_tile))
+            entry = new mcache_monster(minf, mon_tile);
         else
             return 0;
     }
@@ -164,27 +224,40 @@ unsigned int mcache_manager::register_monster(const monster_info& minf)
         entry = new mcache_ghost(minf);
     else if (mcache_draco::valid(minf))
         entry = new mcache_draco(minf);
-    else if (mcache_monster::valid(minf))
-        entry = new mcache_monster(minf);
+    else if (mcache_monster::valid(minf, mon_tile))
+        entry = new mcache_monster(minf, mon_tile);
     else
         return 0;
 
+    // Share an entry that draws the same way: a band of identically
+    // equipped monsters then needs only one, and a monster that hasn't
+    // changed keeps its tile between redraws, so webtiles doesn't resend
+    // its layers.
+    const uint32_t hash = entry->draw_hash();
     tileidx_t idx = ~0;
 
     for (unsigned int i = 0; i < m_entries.size(); i++)
     {
-        if (!m_entries[i])
+        if (m_entries[i] && m_hashes[i] == hash
+            && m_entries[i]->draws_like(*entry))
         {
-            m_entries[i] = entry;
-            idx = i;
-            break;
+            delete entry;
+            return TILEP_MCACHE_START + i;
         }
+        if (!m_entries[i] && idx > m_entries.size())
+            idx = i;
     }
 
     if (idx > m_entries.size())
     {
         idx = m_entries.size();
         m_entries.push_back(entry);
+        m_hashes.push_back(hash);
+    }
+    else
+    {
+        m_entries[idx] = entry;
+        m_hashes[idx] = hash;
     }
 
     return TILEP_MCACHE_START + idx;
@@ -205,6 +278,7 @@ void mcache_manager::clear_nonref()
 void mcache_manager::clear_all()
 {
     deleteAll(m_entries);
+    m_hashes.clear();
 }
 
 mcache_entry *mcache_manager::get(tileidx_t tile)
@@ -223,12 +297,12 @@ mcache_entry *mcache_manager::get(tileidx_t tile)
 /////////////////////////////////////////////////////////////////////////////
 // mcache_monster
 
-mcache_monster::mcache_monster(const monster_info& mon)
+mcache_monster::mcache_monster(const monster_info& mon, tileidx_t mon_tile)
 {
-    ASSERT(mcache_monster::valid(mon));
+    ASSERT(mcache_monster::valid(mon, mon_tile));
 
     mtype = mon.type;
-    m_mon_tile = tileidx_monster(mon) & TILE_FLAG_MASK;
+    m_mon_tile = mon_tile;
 
     const item_info* mon_weapon = mon.inv[MSLOT_WEAPON].get();
     m_equ_tile = (mon_weapon != nullptr) ? tilep_equ_weapon(*mon_weapon) : 0;
@@ -1231,10 +1305,8 @@ int mcache_monster::info(tile_draw_info *dinfo) const
     return count;
 }
 
-bool mcache_monster::valid(const monster_info& mon)
+bool mcache_monster::valid(const monster_info& mon, tileidx_t mon_tile)
 {
-    tileidx_t mon_tile = tileidx_monster(mon) & TILE_FLAG_MASK;
-
     int ox, oy;
     bool have_weapon_offs = (mon.type == MONS_PLAYER
                              && Options.tile_weapon_offsets.first != INT_MAX)
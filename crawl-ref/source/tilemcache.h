@@ -53,6 +53,10 @@ public:
 
     virtual bool transparent() const { return false; }
 
+    // Whether the two would be drawn exactly the same way.
+    bool draws_like(const mcache_entry &other) const;
+    uint32_t draw_hash() const;
+
 protected:
 
     // ref count in backstore
@@ -65,6 +69,7 @@ public:
     ~mcache_manager();
 
     unsigned int register_monster(const monster_info& mon);
+    unsigned int register_monster(const monster_info& mon, tileidx_t mon_tile);
     mcache_entry *get(tileidx_t idx);
 
     void clear_nonref();
@@ -74,6 +79,8 @@ public:
 
 protected:
     vector<mcache_entry*> m_entries;
+    // draw_hash() of each entry, for finding one to share.
+    vector<uint32_t> m_hashes;
 };
 
 // The global monster cache.
@@ -77,15 +77,50 @@ DungeonRegion::~DungeonRegion()
 {
 }
 
+static bool _same_flavour(const tile_flavour &a, const tile_flavour &b)
+{
+    return a.floor == b.floor && a.wall == b.wall && a.feat == b.feat
+           && a.special == b.special;
+}
+
+// Does the view buffer hold the same tiles as the one last packed?
+static bool _same_view(const crawl_view_buffer &a, const crawl_view_buffer &b)
+{
+    if (a.empty() || b.empty() || a.size() != b.size())
+        return false;
+
+    const screen_cell_t *ac = a;
+    const screen_cell_t *bc = b;
+    for (int i = 0, n = a.size().x * a.size().y; i < n; ++i, ++ac, ++bc)
+    {
+        if (ac->flash_colour != bc->flash_colour
+            || ac->tile != bc->tile
+            || !_same_flavour(ac->tile.flv, bc->tile.flv))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void DungeonRegion::load_dungeon(const crawl_view_buffer &vbuf,
                                  const coord_def &gc)
 {
-    m_dirty = true;
+    const int cx_to_gx = gc.x - mx / 2;
+    const int cy_to_gy = gc.y - my / 2;
 
-    m_cx_to_gx = gc.x - mx / 2;
-    m_cy_to_gy = gc.y - my / 2;
+    // The view is reloaded on every redraw, but most of the time nothing
+    // in it has changed. Keep the packed buffers from last time if so.
+    if (m_dirty || cx_to_gx != m_cx_to_gx || cy_to_gy != m_cy_to_gy
+        || !_same_view(vbuf, m_vbuf))
+    {
+        m_dirty = true;
 
-    m_vbuf = vbuf;
+        m_cx_to_gx = cx_to_gx;
+        m_cy_to_gy = cy_to_gy;
+
+        m_vbuf = vbuf;
+    }
 
     place_cursor(CURSOR_TUTORIAL, m_cursor[CURSOR_TUTORIAL]);
 }
@@ -13,10 +13,18 @@
 #include "options.h"
 #include "tiles-build-specific.h"
 #include "travel.h"
+#include "unwind.h"
 #include "viewgeom.h"
 
 MapRegion::MapRegion(int pixsz) :
     m_buf(nullptr),
+    m_pixels(nullptr),
+    m_tex_width(0),
+    m_tex_height(0),
+    m_tex_loaded(false),
+    m_changed_min(GXM, GYM),
+    m_changed_max(-1, -1),
+    m_buf_map(true, false, &m_tex),
     m_dirty(true),
     m_far_view(false)
 {
@@ -28,6 +36,14 @@ MapRegion::MapRegion(int pixsz) :
     init_colours();
 }
 
+static unsigned int _power_of_two_at_least(unsigned int n)
+{
+    unsigned int p = 1;
+    while (p < n)
+        p *= 2;
+    return p;
+}
+
 void MapRegion::on_resize()
 {
     delete[] m_buf;
@@ -35,6 +51,78 @@ void MapRegion::on_resize()
     int size = mx * my;
     m_buf    = new unsigned char[size];
     memset(m_buf, 0, sizeof(unsigned char) * size);
+
+    delete[] m_pixels;
+    m_tex_width  = _power_of_two_at_least(mx);
+    m_tex_height = _power_of_two_at_least(my);
+    m_pixels = new unsigned char[4 * m_tex_width * m_tex_height];
+    memset(m_pixels, 0, 4 * m_tex_width * m_tex_height);
+    if (m_tex_loaded)
+    {
+        m_tex.unload_texture();
+        m_tex_loaded = false;
+    }
+    recolour();
+}
+
+// Write the colour of one cell into the pixel buffer, to be uploaded with
+// the rest of the changed rectangle.
+void MapRegion::set_texel(int x, int y)
+{
+    const VColour &col = m_colours[m_buf[x + y * mx]];
+    unsigned char *texel = &m_pixels[4 * (x + y * m_tex_width)];
+    texel[0] = col.r;
+    texel[1] = col.g;
+    texel[2] = col.b;
+    texel[3] = col.a;
+
+    m_changed_min.x = min(m_changed_min.x, x);
+    m_changed_min.y = min(m_changed_min.y, y);
+    m_changed_max.x = max(m_changed_max.x, x);
+    m_changed_max.y = max(m_changed_max.y, y);
+}
+
+void MapRegion::recolour()
+{
+    if (!m_pixels)
+        return;
+
+    for (int y = 0; y < my; y++)
+        for (int x = 0; x < mx; x++)
+            set_texel(x, y);
+}
+
+void MapRegion::update_texture()
+{
+    if (!m_pixels)
+        return;
+
+    // Always sample the nearest texel; cells should have hard edges.
+    unwind_bool noscaling(Options.tile_filter_scaling, false);
+
+    if (!m_tex_loaded)
+    {
+        m_tex.load_texture(m_pixels, m_tex_width, m_tex_height, MIPMAP_NONE);
+        m_tex_loaded = true;
+    }
+    else if (m_changed_min.x <= m_changed_max.x)
+    {
+        const int w = m_changed_max.x - m_changed_min.x + 1;
+        const int h = m_changed_max.y - m_changed_min.y + 1;
+        vector<unsigned char> rect(4 * w * h);
+        for (int y = 0; y < h; y++)
+        {
+            memcpy(&rect[4 * w * y],
+                   &m_pixels[4 * (m_changed_min.x
+                                  + (m_changed_min.y + y) * m_tex_width)],
+                   4 * w);
+        }
+        m_tex.load_texture(&rect[0], w, h, MIPMAP_NONE,
+                           m_changed_min.x, m_changed_min.y);
+    }
+
+    m_changed_min = coord_def(GXM, GYM);
+    m_changed_max = coord_def(-1, -1);
 }
 
 void MapRegion::init_colours()
@@ -68,11 +156,14 @@ void MapRegion::init_colours()
     m_colours[MF_TRANSPORTER]   = Options.tile_transporter_col;
     m_colours[MF_TRANSPORTER_LANDING] = Options.tile_transporter_landing_col;
     m_colours[MF_EXPLORE_HORIZON] = Options.tile_explore_horizon_col;
+
+    recolour();
 }
 
 MapRegion::~MapRegion()
 {
     delete[] m_buf;
+    delete[] m_pixels;
 }
 
 void MapRegion::pack_buffers()
@@ -80,15 +171,12 @@ void MapRegion::pack_buffers()
     m_buf_map.clear();
     m_buf_lines.clear();
 
-    for (int x = m_min_gx; x <= m_max_gx; x++)
-        for (int y = m_min_gy; y <= m_max_gy; y++)
-        {
-            map_feature f = (map_feature)m_buf[x + y * mx];
-
-            float pos_x = x - m_min_gx;
-            float pos_y = y - m_min_gy;
-            m_buf_map.add(pos_x, pos_y, pos_x + 1, pos_y + 1, m_colours[f]);
-        }
+    GLWPrim rect(0, 0, m_max_gx - m_min_gx + 1, m_max_gy - m_min_gy + 1);
+    rect.set_tex((float)m_min_gx / m_tex_width,
+                 (float)m_min_gy / m_tex_height,
+                 (float)(m_max_gx + 1) / m_tex_width,
+                 (float)(m_max_gy + 1) / m_tex_height);
+    m_buf_map.add_primitive(rect);
 
     // Draw window box.
     if (m_win_start.x == -1 && m_win_end.x == -1)
@@ -111,6 +199,7 @@ void MapRegion::render()
 #ifdef DEBUG_TILES_REDRAW
     cprintf("rendering MapRegion\n");
 #endif
+    update_texture();
     if (m_dirty)
     {
         pack_buffers();
@@ -134,11 +223,21 @@ void MapRegion::recenter()
 void MapRegion::set(const coord_def &gc, map_feature f)
 {
     ASSERT((unsigned int)f <= (unsigned char)~0);
-    m_buf[gc.x + gc.y * mx] = f;
+    if (m_buf[gc.x + gc.y * mx] != f)
+    {
+        m_buf[gc.x + gc.y * mx] = f;
+        set_texel(gc.x, gc.y);
+    }
 
     if (f == MF_UNSEEN)
         return;
 
+    if (gc.x >= m_min_gx && gc.x <= m_max_gx
+        && gc.y >= m_min_gy && gc.y <= m_max_gy)
+    {
+        return;
+    }
+
     // Get map extents
     m_min_gx = min(m_min_gx, gc.x);
     m_max_gx = max(m_max_gx, gc.x);
@@ -146,6 +245,7 @@ void MapRegion::set(const coord_def &gc, map_feature f)
     m_max_gy = max(m_max_gy, gc.y);
 
     recenter();
+    m_dirty = true;
 }
 
 void MapRegion::update_bounds()
@@ -174,6 +274,7 @@ void MapRegion::update_bounds()
         }
 
     recenter();
+    m_dirty = true;
 }
 
 void MapRegion::set_window(const coord_def &start, const coord_def &end)
@@ -200,9 +301,11 @@ void MapRegion::clear()
 
     if (m_buf)
         memset(m_buf, 0, sizeof(*m_buf) * mx * my);
+    recolour();
 
     m_buf_map.clear();
     m_buf_lines.clear();
+    m_dirty = true;
 }
 
 int MapRegion::handle_mouse(MouseEvent &event)
@@ -4,6 +4,7 @@
 #include "map-feature.h"
 #include "tilebuf.h"
 #include "tilereg.h"
+#include "tiletex.h"
 
 class MapRegion : public Region
 {
@@ -25,6 +26,9 @@ protected:
     virtual void on_resize() override;
     void recenter();
     void pack_buffers();
+    void set_texel(int x, int y);
+    void recolour();
+    void update_texture();
 
     VColour m_colours[MF_MAX];
     int m_min_gx, m_max_gx, m_min_gy, m_max_gy;
@@ -32,7 +36,15 @@ protected:
     coord_def m_win_end;
     unsigned char *m_buf;
 
-    ShapeBuffer m_buf_map;
+    // The map is drawn as a single quad from a texture with one texel per
+    // cell. Only the changed rectangle is uploaded before each draw.
+    GenericTexture m_tex;
+    unsigned char *m_pixels;
+    unsigned int m_tex_width, m_tex_height;
+    bool m_tex_loaded;
+    coord_def m_changed_min, m_changed_max;
+
+    VertBuffer m_buf_map;
     LineBuffer m_buf_lines;
     bool m_dirty;
     bool m_far_view;
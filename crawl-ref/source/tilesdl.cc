@@ -4,9 +4,13 @@
 
 #include "tilesdl.h"
 
+#include <chrono>
+
 #include "ability.h"
+#include "alloc-tag.h"
 #include "artefact.h"
 #include "cio.h"
+#include "clua.h"
 #include "command.h"
 #include "coord.h"
 #include "env.h"
@@ -20,6 +24,8 @@
 #include "options.h"
 #include "player.h"
 #include "state.h"
+#include "stringutil.h"
+#include "syscalls.h"
 #include "tiledef-dngn.h"
 #include "tiledef-gui.h"
 #include "tiledef-main.h"
@@ -169,7 +175,11 @@ TilesFramework::TilesFramework() :
     m_key_mod(0),
     m_mouse(-1, -1),
     m_last_tick_moved(0),
-    m_last_tick_redraw(0)
+    m_last_tick_redraw(0),
+    m_frame_count(0),
+    m_frame_log(nullptr),
+    m_frame_log_failed(false),
+    m_lua_allocated(0)
 {
 }
 
@@ -226,6 +236,12 @@ static void _shutdown_console()
 }
 void TilesFramework::shutdown()
 {
+    if (m_frame_log)
+    {
+        fclose(m_frame_log);
+        m_frame_log = nullptr;
+    }
+
     delete m_region_tile;
     delete m_region_stat;
     delete m_region_msg;
@@ -717,6 +733,10 @@ int TilesFramework::getch_ck()
     m_tooltip.clear();
     m_region_msg->alt_text().clear();
     string prev_msg_alt_text = "";
+    // Where prev_msg_alt_text was built for. Describing a monster or an item
+    // is slow, and nothing it depends on changes while we wait for a key
+    // unless a button is pressed, so moving within a cell can reuse it.
+    cursor_loc alt_text_loc;
 
     if (need_redraw())
         redraw();
@@ -849,8 +869,15 @@ int TilesFramework::getch_ck()
 
                     // update_alt_text() handlers may depend on data set in handle_mouse() handler
                     m_region_msg->alt_text().clear();
-                    if (m_cur_loc.reg)
+                    if (m_cur_loc.reg && m_cur_loc == alt_text_loc)
+                        m_region_msg->alt_text() = prev_msg_alt_text;
+                    else if (m_cur_loc.reg)
+                    {
                         m_cur_loc.reg->update_alt_text(m_region_msg->alt_text());
+                        alt_text_loc = m_cur_loc;
+                    }
+                    else
+                        alt_text_loc.reset();
                     if (prev_msg_alt_text != m_region_msg->alt_text())
                     {
                         prev_msg_alt_text = m_region_msg->alt_text();
@@ -861,6 +888,7 @@ int TilesFramework::getch_ck()
 
             case WME_MOUSEBUTTONUP:
                 {
+                    alt_text_loc.reset();
                     m_buttons_held  &= ~(event.mouse_event.button);
                     event.mouse_event.held = m_buttons_held;
                     event.mouse_event.mod  = m_key_mod;
@@ -871,6 +899,7 @@ int TilesFramework::getch_ck()
 
             case WME_MOUSEBUTTONDOWN:
                 {
+                    alt_text_loc.reset();
                     m_buttons_held  |= event.mouse_event.button;
                     event.mouse_event.held = m_buttons_held;
                     event.mouse_event.mod  = m_key_mod;
@@ -1513,17 +1542,126 @@ GotoRegion TilesFramework::get_cursor_region() const
 }
 
 // #define DEBUG_TILES_REDRAW
+static double _ms_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now()
+                                           - start).count();
+}
+
+static GLFrameStats _gl_stats_since(const GLFrameStats &start)
+{
+    GLFrameStats diff;
+    diff.draw_calls = gl_frame_stats.draw_calls - start.draw_calls;
+    diff.vertices = gl_frame_stats.vertices - start.vertices;
+    diff.texture_binds = gl_frame_stats.texture_binds - start.texture_binds;
+    return diff;
+}
+
+const char *TilesFramework::_region_name(const Region *region) const
+{
+    if (region == m_region_tile)
+        return "dungeon";
+    if (region == m_region_stat)
+        return "stat";
+    if (region == m_region_msg)
+        return "message";
+    if (region == m_region_map)
+        return "minimap";
+    if (region == m_region_tab)
+        return "tabs";
+    if (region == m_region_crt)
+        return "crt";
+    if (region == m_region_menu)
+        return "menu";
+    return "other";
+}
+
+// Log the costs gathered in m_frame_stats, and keep a summary to draw over
+// the next frame.
+void TilesFramework::_report_frame_stats()
+{
+    m_frame_count++;
+
+    if (!Options.tile_frame_log.empty() && !m_frame_log && !m_frame_log_failed)
+    {
+        m_frame_log = fopen_u(Options.tile_frame_log.c_str(), "w");
+        if (m_frame_log)
+            fprintf(m_frame_log, "frame,region,ms,draw_calls,vertices,binds\n");
+        else
+        {
+            dprf("Couldn't open frame log '%s'",
+                 Options.tile_frame_log.c_str());
+            m_frame_log_failed = true;
+        }
+    }
+
+    if (m_frame_log)
+    {
+        for (const region_frame_stats &stats : m_frame_stats)
+        {
+            fprintf(m_frame_log, "%u,%s,%.3f,%u,%u,%u\n", m_frame_count,
+                    stats.name, stats.ms, stats.gl.draw_calls,
+                    stats.gl.vertices, stats.gl.texture_binds);
+        }
+    }
+
+    if (Options.tile_show_frame_stats && !m_frame_stats.empty())
+    {
+        // The frame total comes last.
+        const region_frame_stats &total = m_frame_stats.back();
+        m_frame_stats_text = make_stringf("%.2f ms, %u draws, %u verts, "
+                                          "%u binds",
+                                          total.ms, total.gl.draw_calls,
+                                          total.gl.vertices,
+                                          total.gl.texture_binds);
+        for (const region_frame_stats &stats : m_frame_stats)
+        {
+            if (&stats == &total)
+                break;
+            m_frame_stats_text += make_stringf("\n%s: %.2f ms, %u draws",
+                                               stats.name, stats.ms,
+                                               stats.gl.draw_calls);
+        }
+        // User Lua allocations since the last redraw, to spot scripts that
+        // churn the collector.
+        m_frame_stats_text += make_stringf("\nlua: %ld KB, +%ld KB",
+                                           clua.memory_used / 1024,
+                                           (clua.memory_allocated
+                                            - m_lua_allocated) / 1024);
+    }
+    m_lua_allocated = clua.memory_allocated;
+}
+
 void TilesFramework::redraw()
 {
+    alloc_tag_scope tag(ALLOC_TILES);
 #ifdef DEBUG_TILES_REDRAW
     cprintf("\nredrawing tiles");
 #endif
     m_need_redraw = false;
 
+    const bool frame_stats = Options.tile_show_frame_stats
+                             || !Options.tile_frame_log.empty();
+    const auto frame_start = chrono::steady_clock::now();
+    gl_frame_stats.reset();
+    m_frame_stats.clear();
+
     glmanager->reset_view_for_redraw(m_viewsc.x, m_viewsc.y);
 
     for (Region *region : m_layers[m_active_layer].m_regions)
+    {
+        if (!frame_stats)
+        {
+            region->render();
+            continue;
+        }
+
+        const auto start = chrono::steady_clock::now();
+        const GLFrameStats gl_start = gl_frame_stats;
         region->render();
+        m_frame_stats.push_back({_region_name(region), _ms_since(start),
+                                 _gl_stats_since(gl_start)});
+    }
 
     // Draw tooltip
     if (Options.tile_tooltip_ms > 0 && !m_tooltip.empty())
@@ -1535,6 +1673,22 @@ void TilesFramework::redraw()
                             min_pos, m_windowsz, WHITE, false, 220, BLUE, 5,
                             true);
     }
+
+    if (frame_stats)
+    {
+        m_frame_stats.push_back({"total", _ms_since(frame_start),
+                                 gl_frame_stats});
+        _report_frame_stats();
+    }
+
+    if (Options.tile_show_frame_stats && !m_frame_stats_text.empty())
+    {
+        const coord_def min_pos(0, 0);
+        FontWrapper *font = m_fonts[m_tip_font].font;
+
+        font->render_string(0, 0, m_frame_stats_text.c_str(), min_pos,
+                            m_windowsz, WHITE, false, 200, BLACK, 2);
+    }
     wm->swap_buffers();
 
 #ifdef __ANDROID__
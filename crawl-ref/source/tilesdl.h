@@ -8,6 +8,7 @@
 #ifdef USE_TILE_LOCAL
 
 #include "cursor-type.h"
+#include "glwrapper.h"
 #include "text-tag-type.h"
 #include "tilereg.h"
 
@@ -291,6 +292,22 @@ protected:
 
     string m_tooltip;
 
+    // Per-frame render costs, for tile_show_frame_stats and tile_frame_log.
+    struct region_frame_stats
+    {
+        const char *name;
+        double ms;
+        GLFrameStats gl;
+    };
+    vector<region_frame_stats> m_frame_stats;
+    string m_frame_stats_text;
+    unsigned int m_frame_count;
+    FILE *m_frame_log;
+    bool m_frame_log_failed;
+    long m_lua_allocated;       // clua.memory_allocated at the last report
+    const char *_region_name(const Region *region) const;
+    void _report_frame_stats();
+
     int m_screen_width;
     int m_screen_height;
 
@@ -969,7 +969,7 @@ static void _tile_place_monster(const coord_def &gc, const monster_info& mon)
     }
     else
     {
-        tileidx_t mcache_idx = mcache.register_monster(mon);
+        tileidx_t mcache_idx = mcache.register_monster(mon, t0);
         t = flag | (mcache_idx ? mcache_idx : t0);
     }
 
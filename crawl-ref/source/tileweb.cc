@@ -7,15 +7,18 @@
 #include <cerrno>
 #include <cstdarg>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+#include "alloc-tag.h"
 #include "artefact.h"
 #include "branch.h"
 #include "command.h"
 #include "coord.h"
+#include "delay.h"
 #include "directn.h"
 #include "english.h"
 #include "env.h"
@@ -36,6 +39,7 @@
 #include "skills.h"
 #include "state.h"
 #include "stringutil.h"
+#include "syscalls.h"
 #include "throw.h"
 #include "tile-flags.h"
 #include "tile-player-flag-cut.h"
@@ -70,6 +74,13 @@ TilesFramework tiles;
 TilesFramework::TilesFramework()
     : m_crt_mode(CRT_NORMAL),
       m_controlled_from_web(false),
+      m_can_coalesce(true),
+      m_last_tick_flush(0),
+      m_record(nullptr),
+      m_record_index(nullptr),
+      m_record_start(0),
+      m_last_keyframe(0),
+      m_recording_keyframe(false),
       m_last_ui_state(UI_INIT),
       m_view_loaded(false),
       m_next_view_tl(0, 0),
@@ -96,8 +107,33 @@ void TilesFramework::shutdown()
     if (m_sock_name.empty())
         return;
 
+    // Clear the name first, in case a socket error makes us die and end up
+    // back here.
+    const string sock_name = m_sock_name;
+    m_sock_name.clear();
+
+    // Give the server a moment to take anything still queued, such as the
+    // exit reason.
+    for (int tries = 0; tries < 20 && _output_pending(); ++tries)
+    {
+        if (tries)
+            usleep(100 * 1000);
+        _drain_queues();
+    }
+
     close(m_sock);
-    remove(m_sock_name.c_str());
+    remove(sock_name.c_str());
+
+    if (m_record)
+    {
+        gzclose(m_record);
+        m_record = nullptr;
+    }
+    if (m_record_index)
+    {
+        fclose(m_record_index);
+        m_record_index = nullptr;
+    }
 }
 
 void TilesFramework::draw_doll_edit()
@@ -138,6 +174,8 @@ bool TilesFramework::initialise()
     if (setsockopt(m_sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) < 0)
         die("Can't set send timeout!");
 
+    _open_recording();
+
     if (m_await_connection)
         _await_connection();
 
@@ -182,56 +220,282 @@ void TilesFramework::finish_message()
     }
 
     m_msg_buf.append("\n");
-    const char* fragment_start = m_msg_buf.data();
-    const char* data_end = m_msg_buf.data() + m_msg_buf.size();
-    while (fragment_start < data_end)
+    if (m_out_buf.empty())
+        m_out_buf.swap(m_msg_buf);
+    else
+        m_out_buf.append(m_msg_buf);
+    m_msg_buf.clear();
+
+    if (_coalescing()
+        && get_milliseconds() - m_last_tick_flush
+           < (unsigned int) Options.tile_web_flush_rate)
     {
-        int fragment_size = data_end - fragment_start;
-        if (fragment_size > m_max_msg_size)
-            fragment_size = m_max_msg_size;
+        return;
+    }
+
+    _send_output();
+}
+
+// While running or in a multi-turn delay, messages are held back and sent
+// together at most every tile_web_flush_rate milliseconds. The webserver
+// has to announce that it can split several messages out of one datagram.
+bool TilesFramework::_coalescing() const
+{
+    return Options.tile_web_flush_rate > 0 && m_can_coalesce
+           && !m_recording_keyframe
+           && (you.running || you_are_delayed());
+}
+
+/* With -webtiles-record, everything sent to the webserver is also written
+   to a gzipped recording, one message per line, each prefixed with the
+   milliseconds since the recording started and a space. Every
+   RECORD_KEYFRAME_INTERVAL a keyframe -- the full game state, as sent to a
+   new spectator -- is written at the start of a new gzip member. The
+   recording's .idx file lists the time and file offset of each keyframe,
+   so a player can seek to one and decompress from there. */
+static const unsigned int RECORD_KEYFRAME_INTERVAL = 60 * 1000;
 
-        for (unsigned int i = 0; i < m_dest_addrs.size(); ++i)
+void TilesFramework::_open_recording()
+{
+    if (m_record_name.empty())
+        return;
+
+    m_record = gzopen(m_record_name.c_str(), "wb");
+    m_record_index = fopen_u((m_record_name + ".idx").c_str(), "w");
+    if (!m_record || !m_record_index)
+    {
+        dprf("Can't open the webtiles recording %s", m_record_name.c_str());
+        if (m_record)
+            gzclose(m_record);
+        if (m_record_index)
+            fclose(m_record_index);
+        m_record = nullptr;
+        m_record_index = nullptr;
+        return;
+    }
+
+    m_record_start = get_milliseconds();
+    // Ask for a keyframe with the first redraw.
+    m_last_keyframe = m_record_start - RECORD_KEYFRAME_INTERVAL;
+}
+
+void TilesFramework::_record_output(const string &chunk)
+{
+    const string stamp = make_stringf("%u ",
+                                      get_milliseconds() - m_record_start);
+    string out;
+    out.reserve(chunk.size() + stamp.size() * 4);
+
+    size_t pos = 0;
+    while (pos < chunk.size())
+    {
+        size_t eol = chunk.find('\n', pos);
+        eol = eol == string::npos ? chunk.size() : eol + 1;
+        out += stamp;
+        out.append(chunk, pos, eol - pos);
+        pos = eol;
+    }
+
+    if (gzwrite(m_record, out.data(), out.size()) != (int) out.size())
+    {
+        dprf("Error writing the webtiles recording; stopping it.");
+        gzclose(m_record);
+        m_record = nullptr;
+    }
+}
+
+// Only called right after a redraw, when the receivers have been sent
+// everything: the senders below then only update our copy of what the
+// client has to the same values.
+void TilesFramework::_record_keyframe()
+{
+    // Anything held back belongs before the keyframe.
+    _send_output();
+    if (!m_record)
+        return;
+
+    gzclose(m_record);
+    struct stat st;
+    const bool have_size = stat(m_record_name.c_str(), &st) == 0;
+    m_record = gzopen(m_record_name.c_str(), "ab");
+    if (!m_record || !have_size)
+    {
+        dprf("Can't reopen the webtiles recording; stopping it.");
+        if (m_record)
+            gzclose(m_record);
+        m_record = nullptr;
+        return;
+    }
+
+    const unsigned int now = get_milliseconds();
+    fprintf(m_record_index, "%u %lld\n", now - m_record_start,
+            (long long) st.st_size);
+    fflush(m_record_index);
+
+    m_recording_keyframe = true;
+    _send_everything();
+    finish_message();
+    m_recording_keyframe = false;
+
+    m_last_keyframe = now;
+}
+
+// Queue the finished output for every receiver, and write out as much as
+// each will currently take.
+void TilesFramework::_send_output()
+{
+    if (m_out_buf.empty())
+        return;
+
+    if (m_record)
+        _record_output(m_out_buf);
+
+    // A keyframe goes into the recording only; the receivers are up to date.
+    if (m_recording_keyframe)
+    {
+        m_out_buf.clear();
+        return;
+    }
+
+    for (unsigned int i = 0; i < m_dest_addrs.size(); ++i)
+    {
+        OutputQueue &queue = m_dest_queues[i];
+        queue.chunks.push_back(m_out_buf);
+        queue.bytes += m_out_buf.size();
+
+        if (!_drain_queue(i, false))
+        {
+            i--;
+            continue;
+        }
+
+        if (m_dest_queues[i].bytes > OUTPUT_QUEUE_LIMIT)
         {
-            int retries = 30;
-            ssize_t sent = 0;
-            while (sent < fragment_size)
+            _collapse_queue(i);
+            // Still too much: wait for the server as we used to.
+            if (m_dest_queues[i].bytes > OUTPUT_QUEUE_LIMIT
+                && !_drain_queue(i, true))
             {
-                ssize_t retval = sendto(m_sock, fragment_start + sent,
-                    fragment_size - sent, 0, (sockaddr*) &m_dest_addrs[i],
-                    sizeof(sockaddr_un));
-                if (retval <= 0)
-                {
-                    const char *errmsg = retval == 0 ? "No bytes sent"
-                                                     : strerror(errno);
-                    if (--retries <= 0)
-                        die("Socket write error: %s", errmsg);
+                i--;
+            }
+        }
+    }
 
-                    if (retval == 0 || errno == ENOBUFS || errno == EWOULDBLOCK
-                        || errno == EINTR || errno == EAGAIN)
-                    {
-                        // Wait for half a second at first (up to five), then
-                        // try again.
-                        usleep(retries <= 10 ? 5000 * 1000 : 500 * 1000);
-                    }
-                    else if (errno == ECONNREFUSED || errno == ENOENT)
-                    {
-                        // the other side is dead
-                        m_dest_addrs.erase(m_dest_addrs.begin() + i);
-                        i--;
-                        break;
-                    }
-                    else
-                        die("Socket write error: %s", errmsg);
-                }
-                else
-                    sent += retval;
+    m_out_buf.clear();
+    m_last_tick_flush = get_milliseconds();
+    m_need_flush = true;
+}
+
+// Write out queued output for receiver i. Without block, this stops as soon
+// as the socket would block. Returns false if the receiver has gone away
+// and was removed.
+bool TilesFramework::_drain_queue(unsigned int i, bool block)
+{
+    OutputQueue &queue = m_dest_queues[i];
+    int retries = 30;
+    while (!queue.chunks.empty())
+    {
+        const string &chunk = queue.chunks.front();
+        const size_t size = min(chunk.size() - queue.sent,
+                                (size_t) m_max_msg_size);
+        ssize_t retval = sendto(m_sock, chunk.data() + queue.sent, size,
+                                MSG_DONTWAIT, (sockaddr*) &m_dest_addrs[i],
+                                sizeof(sockaddr_un));
+        if (retval > 0)
+        {
+            queue.sent += retval;
+            queue.bytes -= retval;
+            if (queue.sent == chunk.size())
+            {
+                queue.chunks.pop_front();
+                queue.sent = 0;
             }
+            retries = 30;
+            continue;
         }
 
-        fragment_start += fragment_size;
+        const char *errmsg = retval == 0 ? "No bytes sent" : strerror(errno);
+        if (retval == 0 || errno == ENOBUFS || errno == EWOULDBLOCK
+            || errno == EINTR || errno == EAGAIN)
+        {
+            if (!block)
+                return true;
+
+            if (--retries <= 0)
+                die("Socket write error: %s", errmsg);
+
+            // Wait for half a second at first (up to five), then try again.
+            usleep(retries <= 10 ? 5000 * 1000 : 500 * 1000);
+        }
+        else if (errno == ECONNREFUSED || errno == ENOENT)
+        {
+            // the other side is dead
+            m_dest_addrs.erase(m_dest_addrs.begin() + i);
+            m_dest_queues.erase(m_dest_queues.begin() + i);
+            return false;
+        }
+        else
+            die("Socket write error: %s", errmsg);
     }
-    m_msg_buf.clear();
-    m_need_flush = true;
+    return true;
+}
+
+void TilesFramework::_drain_queues()
+{
+    for (unsigned int i = 0; i < m_dest_addrs.size(); ++i)
+        if (!_drain_queue(i, false))
+            i--;
+}
+
+bool TilesFramework::_output_pending() const
+{
+    for (const OutputQueue &queue : m_dest_queues)
+        if (!queue.chunks.empty())
+            return true;
+    return false;
+}
+
+// The server isn't keeping up with receiver i. Map updates make up most of
+// the traffic, and are the one thing that can be replaced wholesale, so drop
+// the queued ones and send a full map with the next redraw instead.
+void TilesFramework::_collapse_queue(unsigned int i)
+{
+    OutputQueue &queue = m_dest_queues[i];
+
+    // The server has already seen the start of a partly sent chunk.
+    auto first = queue.chunks.begin();
+    if (queue.sent)
+        ++first;
+
+    string kept;
+    for (auto it = first; it != queue.chunks.end(); ++it)
+    {
+        size_t pos = 0;
+        while (pos < it->size())
+        {
+            size_t eol = it->find('\n', pos);
+            eol = eol == string::npos ? it->size() : eol + 1;
+            if (it->compare(pos, 12, "{\"msg\":\"map\"") != 0)
+                kept.append(*it, pos, eol - pos);
+            pos = eol;
+        }
+    }
+    queue.chunks.erase(first, queue.chunks.end());
+
+    queue.bytes = 0;
+    for (const string &chunk : queue.chunks)
+        queue.bytes += chunk.size();
+    queue.bytes -= queue.sent;
+
+    if (!kept.empty())
+    {
+        queue.bytes += kept.size();
+        queue.chunks.push_back(move(kept));
+    }
+
+    dprf("Webtiles output backed up; resending the full map.");
+    m_need_full_map = true;
+    m_need_redraw = true;
 }
 
 void TilesFramework::send_message(const char *format, ...)
@@ -256,11 +520,19 @@ void TilesFramework::send_message(const char *format, ...)
     finish_message();
 }
 
-void TilesFramework::flush_messages()
+void TilesFramework::flush_messages(bool force)
 {
-    if (m_need_flush)
+    if (!force && _coalescing()
+        && get_milliseconds() - m_last_tick_flush
+           < (unsigned int) Options.tile_web_flush_rate)
+    {
+        return;
+    }
+
+    if (m_need_flush || !m_out_buf.empty())
     {
         send_message("*{\"msg\":\"flush_messages\"}");
+        _send_output();
         m_need_flush = false;
     }
 }
@@ -320,7 +592,13 @@ wint_t TilesFramework::_handle_control_message(sockaddr_un addr, string data)
         JsonWrapper primary = json_find_member(obj.node, "primary");
         primary.check(JSON_BOOL);
 
+        // Older webservers expect exactly one message per datagram.
+        JsonWrapper coalesce = json_find_member(obj.node, "coalesce");
+        if (!coalesce.node || coalesce->tag != JSON_BOOL || !coalesce->bool_)
+            m_can_coalesce = false;
+
         m_dest_addrs.push_back(addr);
+        m_dest_queues.emplace_back();
         m_controlled_from_web = primary->bool_;
     }
     else if (msgtype == "key")
@@ -332,9 +610,11 @@ wint_t TilesFramework::_handle_control_message(sockaddr_un addr, string data)
     }
     else if (msgtype == "spectator_joined")
     {
-        flush_messages();
+        flush_messages(true);
+        // Lets the server bring later spectators up to date by itself.
+        send_message("*{\"msg\":\"state_reset\"}");
         _send_everything();
-        flush_messages();
+        flush_messages(true);
     }
     else if (msgtype == "menu_scroll")
     {
@@ -405,11 +685,29 @@ bool TilesFramework::await_input(wint_t& c, bool block)
 
             if (block)
             {
-                tiles.flush_messages();
-                result = select(maxfd + 1, &fds, nullptr, nullptr, nullptr);
+                tiles.flush_messages(true);
+                _drain_queues();
+                if (_output_pending())
+                {
+                    // Come back to retry the queued output; the socket
+                    // can't tell us when the server has room again.
+                    timeval timeout;
+                    timeout.tv_sec = 0;
+                    timeout.tv_usec = 10 * 1000;
+
+                    result = select(maxfd + 1, &fds, nullptr, nullptr,
+                                    &timeout);
+                }
+                else
+                {
+                    result = select(maxfd + 1, &fds, nullptr, nullptr,
+                                    nullptr);
+                }
             }
             else
             {
+                _drain_queues();
+
                 timeval timeout;
                 timeout.tv_sec = 0;
                 timeout.tv_usec = 0;
@@ -420,7 +718,11 @@ bool TilesFramework::await_input(wint_t& c, bool block)
         while (result == -1 && errno == EINTR);
 
         if (result == 0)
+        {
+            if (block)
+                continue;
             return false;
+        }
         else if (result > 0)
         {
             if (!m_sock_name.empty() && FD_ISSET(m_sock, &fds))
@@ -485,6 +787,18 @@ void TilesFramework::send_dump_info(const string& type, const string& filename)
     finish_message();
 }
 
+void TilesFramework::send_game_event(const string& type,
+                                     const string& xlog_line)
+{
+    write_message("*");
+    write_message("{\"msg\":\"");
+    write_message_escaped(type);
+    write_message("\",\"data\":\"");
+    write_message_escaped(xlog_line);
+    write_message("\"}");
+    finish_message();
+}
+
 void TilesFramework::_send_version()
 {
 #ifdef WEB_DIR_PATH
@@ -707,6 +1021,7 @@ player_info::player_info()
  */
 void TilesFramework::_send_player(bool force_full)
 {
+    derived_stat_cache_scope stat_cache;
     player_info& c = m_current_player_info;
 
     json_open_object();
@@ -1085,9 +1400,14 @@ static inline void _write_tileidx(tileidx_t t)
     const int lo = t & 0xFFFFFFFF;
     const int hi = t >> 32;
     if (hi == 0)
-        tiles.write_message("%d", lo);
+        tiles.json_write_int(lo);
     else
-        tiles.write_message("[%d,%d]", lo, hi);
+    {
+        tiles.json_open_array();
+        tiles.json_write_int(lo);
+        tiles.json_write_int(hi);
+        tiles.json_close_array();
+    }
 }
 
 void TilesFramework::_send_cell(const coord_def &gc,
@@ -1330,26 +1650,27 @@ void TilesFramework::_send_cursor(cursor_type type)
     }
 }
 
+void TilesFramework::_mcache_ref_cell(const coord_def &gc, bool inc)
+{
+    int fg_idx = m_current_view(gc).tile.fg & TILE_FLAG_MASK;
+    if (fg_idx >= TILEP_MCACHE_START)
+    {
+        mcache_entry *entry = mcache.get(fg_idx);
+        if (entry)
+        {
+            if (inc)
+                entry->inc_ref();
+            else
+                entry->dec_ref();
+        }
+    }
+}
+
 void TilesFramework::_mcache_ref(bool inc)
 {
     for (int y = 0; y < GYM; y++)
         for (int x = 0; x < GXM; x++)
-        {
-            coord_def gc(x, y);
-
-            int fg_idx = m_current_view(gc).tile.fg & TILE_FLAG_MASK;
-            if (fg_idx >= TILEP_MCACHE_START)
-            {
-                mcache_entry *entry = mcache.get(fg_idx);
-                if (entry)
-                {
-                    if (inc)
-                        entry->inc_ref();
-                    else
-                        entry->dec_ref();
-                }
-            }
-        }
+            _mcache_ref_cell(coord_def(x, y), inc);
 }
 
 void TilesFramework::_send_map(bool force_full)
@@ -1392,56 +1713,77 @@ void TilesFramework::_send_map(bool force_full)
     coord_def last_gc(0, 0);
     bool send_gc = true;
 
+    // Only cells marked dirty since the last update need looking at,
+    // unless the whole map is being sent. Keep them in row order, so that
+    // runs of cells can leave out their coordinates.
+    vector<int> cells;
+    if (force_full)
+    {
+        cells.resize(GXM * GYM);
+        for (int i = 0; i < GXM * GYM; i++)
+            cells[i] = i;
+    }
+    else
+    {
+        cells.swap(m_dirty_cell_list);
+        sort(cells.begin(), cells.end());
+        cells.erase(unique(cells.begin(), cells.end()), cells.end());
+    }
+    m_dirty_cell_list.clear();
+
+    vector<coord_def> updated;
     json_open_array("cells");
-    for (int y = 0; y < GYM; y++)
-        for (int x = 0; x < GXM; x++)
-        {
-            coord_def gc(x, y);
+    for (int idx : cells)
+    {
+        const int x = idx % GXM;
+        const int y = idx / GXM;
+        coord_def gc(x, y);
 
-            if (!is_dirty(gc) && !force_full)
-                continue;
+        if (!is_dirty(gc) && !force_full)
+            continue;
+        updated.push_back(gc);
 
-            if (cell_needs_redraw(gc))
-            {
-                screen_cell_t *cell = &m_next_view(gc);
+        if (cell_needs_redraw(gc))
+        {
+            screen_cell_t *cell = &m_next_view(gc);
 
-                draw_cell(cell, gc, false, m_current_flash_colour);
-                cell->tile.flv = env.tile_flv(gc);
-                pack_cell_overlays(gc, &(cell->tile));
-            }
+            draw_cell(cell, gc, false, m_current_flash_colour);
+            cell->tile.flv = env.tile_flv(gc);
+            pack_cell_overlays(gc, &(cell->tile));
+        }
 
-            mark_clean(gc);
+        mark_clean(gc);
 
-            if (m_origin.equals(-1, -1))
-                m_origin = gc;
+        if (m_origin.equals(-1, -1))
+            m_origin = gc;
 
-            json_open_object();
-            if (send_gc
-                || last_gc.x + 1 != gc.x
-                || last_gc.y != gc.y)
-            {
-                json_write_int("x", x - m_origin.x);
-                json_write_int("y", y - m_origin.y);
-                json_treat_as_empty();
-            }
+        json_open_object();
+        if (send_gc
+            || last_gc.x + 1 != gc.x
+            || last_gc.y != gc.y)
+        {
+            json_write_int("x", x - m_origin.x);
+            json_write_int("y", y - m_origin.y);
+            json_treat_as_empty();
+        }
 
-            const screen_cell_t& sc = force_full ? default_cell
-                : m_current_view(gc);
-            const map_cell& mc = force_full ? default_map_cell
-                : m_current_map_knowledge(gc);
-            _send_cell(gc,
-                       sc,
-                       m_next_view(gc),
-                       mc, env.map_knowledge(gc),
-                       new_monster_locs, force_full);
-
-            if (!json_is_empty())
-            {
-                send_gc = false;
-                last_gc = gc;
-            }
-            json_close_object(true);
+        const screen_cell_t& sc = force_full ? default_cell
+            : m_current_view(gc);
+        const map_cell& mc = force_full ? default_map_cell
+            : m_current_map_knowledge(gc);
+        _send_cell(gc,
+                   sc,
+                   m_next_view(gc),
+                   mc, env.map_knowledge(gc),
+                   new_monster_locs, force_full);
+
+        if (!json_is_empty())
+        {
+            send_gc = false;
+            last_gc = gc;
         }
+        json_close_object(true);
+    }
     json_close_array(true);
 
     json_close_object(true);
@@ -1451,14 +1793,23 @@ void TilesFramework::_send_map(bool force_full)
     if (force_full)
         _send_cursor(CURSOR_MAP);
 
-    if (m_mcache_ref_done)
-        _mcache_ref(false);
-
-    m_current_map_knowledge = env.map_knowledge;
-    m_current_view = m_next_view;
+    // Everything else is unchanged since the last update, so only the
+    // cells just sent need copying.
+    for (const coord_def &gc : updated)
+    {
+        if (m_mcache_ref_done)
+            _mcache_ref_cell(gc, false);
+        m_current_map_knowledge(gc) = env.map_knowledge(gc);
+        m_current_view(gc) = m_next_view(gc);
+        if (m_mcache_ref_done)
+            _mcache_ref_cell(gc, true);
+    }
 
-    _mcache_ref(true);
-    m_mcache_ref_done = true;
+    if (!m_mcache_ref_done)
+    {
+        _mcache_ref(true);
+        m_mcache_ref_done = true;
+    }
 
     m_monster_locs = new_monster_locs;
 }
@@ -1707,6 +2058,7 @@ void TilesFramework::cgotoxy(int x, int y, GotoRegion region)
 
 void TilesFramework::redraw()
 {
+    alloc_tag_scope tag(ALLOC_TILES);
     if (!has_receivers())
     {
         if (m_mcache_ref_done)
@@ -1750,6 +2102,12 @@ void TilesFramework::redraw()
             m_current_flash_colour = m_next_flash_colour;
         }
         _send_map(false);
+
+        if (m_record
+            && get_milliseconds() - m_last_keyframe >= RECORD_KEYFRAME_INTERVAL)
+        {
+            _record_keyframe();
+        }
     }
 
     m_need_redraw = false;
@@ -1937,7 +2295,10 @@ void TilesFramework::mark_for_redraw(const coord_def& gc)
 
 void TilesFramework::mark_dirty(const coord_def& gc)
 {
-    m_dirty_cells[gc.y * GXM + gc.x] = true;
+    const int idx = gc.y * GXM + gc.x;
+    if (!m_dirty_cells[idx])
+        m_dirty_cell_list.push_back(idx);
+    m_dirty_cells[idx] = true;
 }
 
 void TilesFramework::mark_clean(const coord_def& gc)
@@ -1960,21 +2321,45 @@ void TilesFramework::write_message_escaped(const string& s)
 {
     m_msg_buf.reserve(m_msg_buf.size() + s.size());
 
-    for (unsigned char c : s)
+    // Copy runs of characters that need no escaping in one go.
+    size_t run = 0;
+    for (size_t i = 0; i < s.size(); ++i)
     {
+        const unsigned char c = s[i];
+        if (c != '"' && c != '\\' && c >= 0x20)
+            continue;
+
+        m_msg_buf.append(s, run, i - run);
+        run = i + 1;
         if (c == '"')
             m_msg_buf.append("\\\"");
         else if (c == '\\')
             m_msg_buf.append("\\\\");
-        else if (c < 0x20)
+        else
         {
             char buf[7];
             snprintf(buf, sizeof(buf), "\\u%04x", c);
             m_msg_buf.append(buf);
         }
-        else
-            m_msg_buf.append(1, c);
     }
+    m_msg_buf.append(s, run, string::npos);
+}
+
+// Append the decimal form of value, without going through printf.
+void TilesFramework::write_message_int(int value)
+{
+    char buf[12];
+    char *p = buf + sizeof(buf);
+    unsigned int u = value < 0 ? 0U - (unsigned int) value : value;
+    do
+    {
+        *--p = '0' + u % 10;
+        u /= 10;
+    }
+    while (u);
+    if (value < 0)
+        *--p = '-';
+    m_msg_buf.append(p, buf + sizeof(buf) - p);
 }
 
 void TilesFramework::json_open(const string& name, char opener, char type)
@@ -2054,23 +2439,23 @@ void TilesFramework::json_write_comma()
     if (m_msg_buf.empty()) return;
     char last = m_msg_buf[m_msg_buf.size() - 1];
     if (last == '{' || last == '[' || last == ',' || last == ':') return;
-    write_message(",");
+    m_msg_buf.push_back(',');
 }
 
 void TilesFramework::json_write_name(const string& name)
 {
     json_write_comma();
 
-    write_message("\"");
+    m_msg_buf.push_back('"');
     write_message_escaped(name);
-    write_message("\":");
+    m_msg_buf.append("\":");
 }
 
 void TilesFramework::json_write_int(int value)
 {
     json_write_comma();
 
-    write_message("%d", value);
+    write_message_int(value);
 }
 
 void TilesFramework::json_write_int(const string& name, int value)
@@ -2085,10 +2470,7 @@ void TilesFramework::json_write_bool(bool value)
 {
     json_write_comma();
 
-    if (value)
-        write_message("true");
-    else
-        write_message("false");
+    m_msg_buf.append(value ? "true" : "false");
 }
 
 void TilesFramework::json_write_bool(const string& name, bool value)
@@ -2103,7 +2485,7 @@ void TilesFramework::json_write_null()
 {
     json_write_comma();
 
-    write_message("null");
+    m_msg_buf.append("null");
 }
 
 void TilesFramework::json_write_null(const string& name)
@@ -2118,9 +2500,9 @@ void TilesFramework::json_write_string(const string& value)
 {
     json_write_comma();
 
-    write_message("\"");
+    m_msg_buf.push_back('"');
     write_message_escaped(value);
-    write_message("\"");
+    m_msg_buf.push_back('"');
 }
 
 void TilesFramework::json_write_string(const string& name, const string& value)
@@ -8,8 +8,10 @@
 #ifdef USE_TILE_WEB
 
 #include <bitset>
+#include <deque>
 #include <map>
 #include <sys/un.h>
+#include <zlib.h>
 
 #include "cursor-type.h"
 #include "equipment-type.h"
@@ -143,12 +145,15 @@ public:
 
     void send_exit_reason(const string& type, const string& message = "");
     void send_dump_info(const string& type, const string& filename);
+    // Passes a where or milestone xlog line to the webserver.
+    void send_game_event(const string& type, const string& xlog_line);
 
     string get_message();
     void write_message(PRINTF(1, ));
     void finish_message();
     void send_message(PRINTF(1, ));
-    void flush_messages();
+    // Unless forced, this may be put off while output is being coalesced.
+    void flush_messages(bool force = false);
 
     bool has_receivers() { return !m_dest_addrs.empty(); }
     bool is_controlled_from_web() { return m_controlled_from_web; }
@@ -174,6 +179,7 @@ public:
 
     // Helper functions for writing JSON
     void write_message_escaped(const string& s);
+    void write_message_int(int value);
     void json_open_object(const string& name = "");
     void json_close_object(bool erase_if_empty = false);
     void json_open_array(const string& name = "");
@@ -197,6 +203,7 @@ public:
 
     string m_sock_name;
     bool m_await_connection;
+    string m_record_name;
 
     WebtilesCRTMode m_crt_mode;
 
@@ -213,10 +220,43 @@ protected:
     int m_sock;
     int m_max_msg_size;
     string m_msg_buf;
+    // Finished messages not yet written to the socket.
+    string m_out_buf;
     vector<sockaddr_un> m_dest_addrs;
 
+    // Output not yet taken by a receiver, as whole chunks of messages.
+    struct OutputQueue
+    {
+        OutputQueue() : sent(0), bytes(0) {}
+
+        deque<string> chunks;
+        size_t sent;  // bytes of the first chunk already written
+        size_t bytes; // bytes left to write
+    };
+    // Parallel to m_dest_addrs.
+    vector<OutputQueue> m_dest_queues;
+    static const size_t OUTPUT_QUEUE_LIMIT = 256 * 1024;
+
     bool m_controlled_from_web;
     bool m_need_flush;
+    bool m_can_coalesce;
+    unsigned int m_last_tick_flush;
+
+    bool _coalescing() const;
+
+    gzFile m_record;
+    FILE *m_record_index;
+    unsigned int m_record_start;
+    unsigned int m_last_keyframe;
+    bool m_recording_keyframe;
+    void _open_recording();
+    void _record_output(const string &chunk);
+    void _record_keyframe();
+    void _send_output();
+    bool _drain_queue(unsigned int i, bool block);
+    void _drain_queues();
+    bool _output_pending() const;
+    void _collapse_queue(unsigned int i);
 
     void _await_connection();
     wint_t _handle_control_message(sockaddr_un addr, string data);
@@ -261,6 +301,9 @@ protected:
     coord_def m_next_view_br;
 
     bitset<GXM * GYM> m_dirty_cells;
+    // Indices of cells marked dirty since the last map update; may hold
+    // duplicates and cells cleaned since.
+    vector<int> m_dirty_cell_list;
     bitset<GXM * GYM> m_cells_needing_redraw;
     void mark_dirty(const coord_def& gc);
     void mark_clean(const coord_def& gc);
@@ -302,6 +345,7 @@ protected:
 
     bool m_mcache_ref_done;
     void _mcache_ref(bool inc);
+    void _mcache_ref_cell(const coord_def &gc, bool inc);
 
     void _send_cursor(cursor_type type);
     void _send_map(bool force_full = false);
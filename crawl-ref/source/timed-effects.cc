@@ -391,6 +391,173 @@ static bool _deadend_check_floor(const coord_def &p)
     return true;
 }
 
+// Turn the wall at c into floor, and block off a floor grid on the path
+// between its sides, within the shifted area c1..c2, to make up for it.
+static void _labyrinth_switch(const coord_def &c, const coord_def &c1,
+                              const coord_def &c2, bool msg)
+{
+    // Maybe not valid anymore...
+    if (!feat_is_wall(grd(c)) || !_feat_is_flanked_by_walls(c))
+        return;
+
+    // Use the adjacent floor grids as source and destination.
+    coord_def src(c.x-1,c.y);
+    coord_def dst(c.x+1,c.y);
+    if (!feat_has_solid_floor(grd(src)) || !feat_has_solid_floor(grd(dst)))
+    {
+        src = coord_def(c.x, c.y-1);
+        dst = coord_def(c.x, c.y+1);
+    }
+
+    // Pathfinding from src to dst...
+    monster_pathfind mp;
+    bool success = mp.init_pathfind(src, dst, false, msg);
+    if (!success)
+    {
+        if (msg)
+            mprf(MSGCH_DIAGNOSTICS, "Something went badly wrong - no path found!");
+        return;
+    }
+
+    // Get the actual path.
+    const vector<coord_def> path = mp.backtrack();
+
+    // Replace the wall with floor, but preserve the old grid in case
+    // we find no floor grid to swap with.
+    // It's better if the change is done now, so the grid can be
+    // treated as floor rather than a wall, and we don't need any
+    // special cases.
+    dungeon_feature_type old_grid = grd(c);
+    grd(c) = DNGN_FLOOR;
+    set_terrain_changed(c);
+
+    // Add all floor grids meeting a couple of conditions to a vector
+    // of potential switch points.
+    vector<coord_def> points;
+    for (const coord_def p : path)
+    {
+        // The point must be inside the changed area.
+        if (p.x < c1.x || p.x > c2.x || p.y < c1.y || p.y > c2.y)
+            continue;
+
+        // Only replace plain floor.
+        if (grd(p) != DNGN_FLOOR)
+            continue;
+
+        // Don't change any grids we remember.
+        if (env.map_knowledge(p).seen())
+            continue;
+
+        // We don't want to deal with monsters being shifted around.
+        if (monster_at(p))
+            continue;
+
+        // Do not pick a grid right next to the original wall.
+        if (abs(p.x-c.x) + abs(p.y-c.y) <= 1)
+            continue;
+
+        if (_feat_is_flanked_by_walls(p) && _deadend_check_wall(p))
+            points.push_back(p);
+    }
+
+    if (points.empty())
+    {
+        // Take back the previous change.
+        grd(c) = old_grid;
+        set_terrain_changed(c);
+        return;
+    }
+
+    // Randomly pick one floor grid from the vector and replace it
+    // with an adjacent wall type.
+    const int pick = random_range(0, (int) points.size() - 1);
+    const coord_def p(points[pick]);
+    if (msg)
+    {
+        mprf(MSGCH_DIAGNOSTICS, "Switch %d (%d, %d) with %d (%d, %d).",
+             (int) old_grid, c.x, c.y, (int) grd(p), p.x, p.y);
+    }
+#ifdef WIZARD
+    if (you.wizard)
+    {
+        // Highlight the switched grids.
+        env.pgrid(c) |= FPROP_HIGHLIGHT;
+        env.pgrid(p) |= FPROP_HIGHLIGHT;
+    }
+#endif
+
+    // Shift blood some of the time.
+    if (is_bloodcovered(c))
+    {
+        if (one_chance_in(4))
+        {
+            int wall_count = 0;
+            coord_def old_adj(c);
+            for (adjacent_iterator ai(c); ai; ++ai)
+                if (feat_is_wall(grd(*ai)) && one_chance_in(++wall_count))
+                    old_adj = *ai;
+
+            if (old_adj != c && maybe_bloodify_square(old_adj))
+                env.pgrid(c) &= (~FPROP_BLOODY);
+        }
+    }
+    else if (one_chance_in(500))
+    {
+        // Rarely add blood randomly, accumulating with time...
+        maybe_bloodify_square(c);
+    }
+
+    // Rather than use old_grid directly, replace with an adjacent
+    // wall type, preferably stone, rock, or metal.
+    old_grid = grd[p.x-1][p.y];
+    if (!feat_is_wall(old_grid))
+    {
+        old_grid = grd[p.x][p.y-1];
+        if (!feat_is_wall(old_grid))
+        {
+            if (msg)
+            {
+                mprf(MSGCH_DIAGNOSTICS,
+                     "No adjacent walls at pos (%d, %d)?", p.x, p.y);
+            }
+            old_grid = DNGN_STONE_WALL;
+        }
+        else if (old_grid != DNGN_ROCK_WALL && old_grid != DNGN_STONE_WALL
+                 && old_grid != DNGN_METAL_WALL && !one_chance_in(3))
+        {
+            old_grid = grd[p.x][p.y+1];
+        }
+    }
+    else if (old_grid != DNGN_ROCK_WALL && old_grid != DNGN_STONE_WALL
+             && old_grid != DNGN_METAL_WALL && !one_chance_in(3))
+    {
+        old_grid = grd[p.x+1][p.y];
+    }
+    grd(p) = old_grid;
+    set_terrain_changed(p);
+
+    // Shift blood some of the time.
+    if (is_bloodcovered(p))
+    {
+        if (one_chance_in(4))
+        {
+            int floor_count = 0;
+            coord_def new_adj(p);
+            for (adjacent_iterator ai(c); ai; ++ai)
+                if (feat_has_solid_floor(grd(*ai)) && one_chance_in(++floor_count))
+                    new_adj = *ai;
+
+            if (new_adj != p && maybe_bloodify_square(new_adj))
+                env.pgrid(p) &= (~FPROP_BLOODY);
+        }
+    }
+    else if (one_chance_in(100))
+    {
+        // Occasionally add blood randomly, accumulating with time...
+        maybe_bloodify_square(p);
+    }
+}
+
 // Changes a small portion of a labyrinth by exchanging wall against floor
 // grids in such a way that connectivity remains guaranteed.
 void change_labyrinth(bool msg)
@@ -476,169 +643,11 @@ void change_labyrinth(bool msg)
     // For each of the chosen wall grids, calculate the path connecting the
     // two floor grids to either side, and block off one floor grid on this
     // path to close the circle opened by turning the wall into floor.
-    for (int count = 0; count < max_targets; count++)
+    // Nothing looks at LOS until all the switches are done.
     {
-        const coord_def c(targets[count]);
-        // Maybe not valid anymore...
-        if (!feat_is_wall(grd(c)) || !_feat_is_flanked_by_walls(c))
-            continue;
-
-        // Use the adjacent floor grids as source and destination.
-        coord_def src(c.x-1,c.y);
-        coord_def dst(c.x+1,c.y);
-        if (!feat_has_solid_floor(grd(src)) || !feat_has_solid_floor(grd(dst)))
-        {
-            src = coord_def(c.x, c.y-1);
-            dst = coord_def(c.x, c.y+1);
-        }
-
-        // Pathfinding from src to dst...
-        monster_pathfind mp;
-        bool success = mp.init_pathfind(src, dst, false, msg);
-        if (!success)
-        {
-            if (msg)
-                mprf(MSGCH_DIAGNOSTICS, "Something went badly wrong - no path found!");
-            continue;
-        }
-
-        // Get the actual path.
-        const vector<coord_def> path = mp.backtrack();
-
-        // Replace the wall with floor, but preserve the old grid in case
-        // we find no floor grid to swap with.
-        // It's better if the change is done now, so the grid can be
-        // treated as floor rather than a wall, and we don't need any
-        // special cases.
-        dungeon_feature_type old_grid = grd(c);
-        grd(c) = DNGN_FLOOR;
-        set_terrain_changed(c);
-
-        // Add all floor grids meeting a couple of conditions to a vector
-        // of potential switch points.
-        vector<coord_def> points;
-        for (const coord_def p : path)
-        {
-            // The point must be inside the changed area.
-            if (p.x < c1.x || p.x > c2.x || p.y < c1.y || p.y > c2.y)
-                continue;
-
-            // Only replace plain floor.
-            if (grd(p) != DNGN_FLOOR)
-                continue;
-
-            // Don't change any grids we remember.
-            if (env.map_knowledge(p).seen())
-                continue;
-
-            // We don't want to deal with monsters being shifted around.
-            if (monster_at(p))
-                continue;
-
-            // Do not pick a grid right next to the original wall.
-            if (abs(p.x-c.x) + abs(p.y-c.y) <= 1)
-                continue;
-
-            if (_feat_is_flanked_by_walls(p) && _deadend_check_wall(p))
-                points.push_back(p);
-        }
-
-        if (points.empty())
-        {
-            // Take back the previous change.
-            grd(c) = old_grid;
-            set_terrain_changed(c);
-            continue;
-        }
-
-        // Randomly pick one floor grid from the vector and replace it
-        // with an adjacent wall type.
-        const int pick = random_range(0, (int) points.size() - 1);
-        const coord_def p(points[pick]);
-        if (msg)
-        {
-            mprf(MSGCH_DIAGNOSTICS, "Switch %d (%d, %d) with %d (%d, %d).",
-                 (int) old_grid, c.x, c.y, (int) grd(p), p.x, p.y);
-        }
-#ifdef WIZARD
-        if (you.wizard)
-        {
-            // Highlight the switched grids.
-            env.pgrid(c) |= FPROP_HIGHLIGHT;
-            env.pgrid(p) |= FPROP_HIGHLIGHT;
-        }
-#endif
-
-        // Shift blood some of the time.
-        if (is_bloodcovered(c))
-        {
-            if (one_chance_in(4))
-            {
-                int wall_count = 0;
-                coord_def old_adj(c);
-                for (adjacent_iterator ai(c); ai; ++ai)
-                    if (feat_is_wall(grd(*ai)) && one_chance_in(++wall_count))
-                        old_adj = *ai;
-
-                if (old_adj != c && maybe_bloodify_square(old_adj))
-                    env.pgrid(c) &= (~FPROP_BLOODY);
-            }
-        }
-        else if (one_chance_in(500))
-        {
-            // Rarely add blood randomly, accumulating with time...
-            maybe_bloodify_square(c);
-        }
-
-        // Rather than use old_grid directly, replace with an adjacent
-        // wall type, preferably stone, rock, or metal.
-        old_grid = grd[p.x-1][p.y];
-        if (!feat_is_wall(old_grid))
-        {
-            old_grid = grd[p.x][p.y-1];
-            if (!feat_is_wall(old_grid))
-            {
-                if (msg)
-                {
-                    mprf(MSGCH_DIAGNOSTICS,
-                         "No adjacent walls at pos (%d, %d)?", p.x, p.y);
-                }
-                old_grid = DNGN_STONE_WALL;
-            }
-            else if (old_grid != DNGN_ROCK_WALL && old_grid != DNGN_STONE_WALL
-                     && old_grid != DNGN_METAL_WALL && !one_chance_in(3))
-            {
-                old_grid = grd[p.x][p.y+1];
-            }
-        }
-        else if (old_grid != DNGN_ROCK_WALL && old_grid != DNGN_STONE_WALL
-                 && old_grid != DNGN_METAL_WALL && !one_chance_in(3))
-        {
-            old_grid = grd[p.x+1][p.y];
-        }
-        grd(p) = old_grid;
-        set_terrain_changed(p);
-
-        // Shift blood some of the time.
-        if (is_bloodcovered(p))
-        {
-            if (one_chance_in(4))
-            {
-                int floor_count = 0;
-                coord_def new_adj(p);
-                for (adjacent_iterator ai(c); ai; ++ai)
-                    if (feat_has_solid_floor(grd(*ai)) && one_chance_in(++floor_count))
-                        new_adj = *ai;
-
-                if (new_adj != p && maybe_bloodify_square(new_adj))
-                    env.pgrid(p) &= (~FPROP_BLOODY);
-            }
-        }
-        else if (one_chance_in(100))
-        {
-            // Occasionally add blood randomly, accumulating with time...
-            maybe_bloodify_square(p);
-        }
+        terrain_change_batch batch;
+        for (int count = 0; count < max_targets; count++)
+            _labyrinth_switch(targets[count], c1, c2, msg);
     }
 
     // The directions are used to randomly decide where to place items that
@@ -1100,6 +1109,9 @@ static void _monster_flee(monster *mon)
 static void _catchup_monster_move(monster* mon, int moves)
 {
     coord_def pos(mon->pos());
+    // Neither the monster's behaviour nor its target changes while we fake
+    // its movement, so only the step direction needs recomputing.
+    const bool retreating = mons_is_retreating(*mon);
 
     // Dirt simple movement.
     for (int i = 0; i < moves; ++i)
@@ -1107,7 +1119,7 @@ static void _catchup_monster_move(monster* mon, int moves)
         coord_def inc(mon->target - pos);
         inc = coord_def(sgn(inc.x), sgn(inc.y));
 
-        if (mons_is_retreating(*mon))
+        if (retreating)
             inc *= -1;
 
         // Bounds check: don't let shifting monsters try to run off the
@@ -18,6 +18,7 @@
 #include <set>
 #include <sstream>
 
+#include "alloc-tag.h"
 #include "branch.h"
 #include "cloud.h"
 #include "clua.h"
@@ -115,6 +116,11 @@ static string trans_travel_dest;
 // hostile terrain.
 travel_distance_grid_t travel_point_distance;
 
+#ifdef DEBUG_STATISTICS
+int travel_pathfind_calls = 0;
+int travel_cells_examined = 0;
+#endif
+
 // Apply slime wall checks when checking if squares are travelsafe.
 bool g_Slime_Wall_Check = true;
 
@@ -1036,8 +1042,8 @@ static void _fill_exclude_radius(const travel_exclude &exc)
 {
     const int radius = exc.radius;
     const coord_def &c = exc.pos;
-    for (int y = c.y - radius; y <= c.y + radius; ++y)
-        for (int x = c.x - radius; x <= c.x + radius; ++x)
+    for (int x = c.x - radius; x <= c.x + radius; ++x)
+        for (int y = c.y - radius; y <= c.y + radius; ++y)
         {
             const coord_def p(x, y);
             if (!map_bounds(x, y) || travel_point_distance[x][y])
@@ -1146,6 +1152,19 @@ const coord_def travel_pathfind::explore_target() const
     return coord_def(0, 0);
 }
 
+// True if a non-greedy explore flood can no longer find a nearer target
+// than the one it already has.
+bool travel_pathfind::explore_settled() const
+{
+    return (runmode == RMODE_EXPLORE || runmode == RMODE_EXPLORE_GREEDY)
+           && !need_for_greed
+           && !ignore_hostile
+           && !features
+           && !annotate_map
+           && unexplored_dist != UNFOUND_DIST
+           && unexplored_dist <= traveled_distance;
+}
+
 const coord_def travel_pathfind::greedy_square() const
 {
     return greedy_place;
@@ -1162,6 +1181,10 @@ coord_def travel_pathfind::pathfind(run_mode_type rmode, bool fallback_explore)
 {
     unwind_bool saved_ipt(ignore_player_traversability);
 
+#ifdef DEBUG_STATISTICS
+    ++travel_pathfind_calls;
+#endif
+
     if (rmode == RMODE_INTERLEVEL)
         rmode = RMODE_TRAVEL;
 
@@ -1216,6 +1239,9 @@ coord_def travel_pathfind::pathfind(run_mode_type rmode, bool fallback_explore)
     // point, i.e. the distance travelled to get there.
     memset(point_distance, 0, sizeof(travel_distance_grid_t));
 
+    for (int i = 0; i < 2; ++i)
+        safety_known[i].reset();
+
     if (!in_bounds(start))
         return coord_def();
 
@@ -1291,6 +1317,14 @@ coord_def travel_pathfind::pathfind(run_mode_type rmode, bool fallback_explore)
         if (next_iter_points == 0 && found_target)
             return explore_target();
 
+        // Without greed, explore only wants the nearest unexplored square,
+        // and every square found from the next round on is at least
+        // traveled_distance + 1 away (wall bias never makes a square look
+        // nearer than that). Once we've gone past the best one there is no
+        // point flooding the rest of the level.
+        if (floodout && explore_settled())
+            return explore_target();
+
         // If there are no more points to look at, we're done, but we did
         // not find a path to our target.
         if (next_iter_points == 0)
@@ -1381,7 +1415,7 @@ void travel_pathfind::get_features()
     }
 }
 
-const set<coord_def> travel_pathfind::get_unreachables() const
+const set<coord_def> &travel_pathfind::get_unreachables() const
 {
     return unreachables;
 }
@@ -1410,6 +1444,18 @@ bool travel_pathfind::square_slows_movement(const coord_def &c)
     return false;
 }
 
+bool travel_pathfind::is_travelsafe(const coord_def &c)
+{
+    if (!safety_known[ignore_hostile](c))
+    {
+        safety[ignore_hostile].set(c, _is_travelsafe_square(c, ignore_hostile,
+                                                            ignore_danger,
+                                                            try_fallback));
+        safety_known[ignore_hostile].set(c);
+    }
+    return safety[ignore_hostile](c);
+}
+
 void travel_pathfind::check_square_greed(const coord_def &c)
 {
     if (greedy_dist == UNFOUND_DIST
@@ -1542,7 +1588,7 @@ bool travel_pathfind::path_flood(const coord_def &c, const coord_def &dc)
 
         return true;
     }
-    else if (!_is_travelsafe_square(dc, ignore_hostile, ignore_danger, try_fallback))
+    else if (!is_travelsafe(dc))
     {
         // This point is not okay to travel on, but if this is a
         // trap, we'll want to put it on the feature vector anyway.
@@ -1649,6 +1695,10 @@ bool travel_pathfind::path_examine_point(const coord_def &c)
     if (!in_bounds(c))
         return false;
 
+#ifdef DEBUG_STATISTICS
+    ++travel_cells_examined;
+#endif
+
     if (point_traverse_delay(c))
         return false;
 
@@ -2599,9 +2649,9 @@ static int _target_distance_from(const coord_def &pos)
  * travel-safe path between the player's current level and the target level OR
  * the player's current level *is* the target level.
  *
- * This function relies on the travel_point_distance array being correctly
- * populated with a floodout call to find_travel_pos starting from the player's
- * location.
+ * Unless the player is standing on a stair in the travel cache, this function
+ * relies on the travel_point_distance array being correctly populated with a
+ * floodout call to find_travel_pos starting from the player's location.
  *
  * This function has undefined behavior when the target position is not
  * traversable.
@@ -2637,7 +2687,7 @@ static int _find_transtravel_stair(const level_id &cur,
         // from it.
         int deltadist = _target_distance_from(stair);
 
-        if (deltadist == -1 && cur == player_level)
+        if (deltadist == -1 && cur == player_level && !li.get_stair(stair))
         {
             // Okay, we don't seem to have a distance available to us, which
             // means we're either (a) not standing on stairs or (b) whoever
@@ -2800,9 +2850,30 @@ static int _find_transtravel_stair(const level_id &cur,
 
 static bool _loadlev_populate_stair_distances(const level_pos &target)
 {
-    level_excursion excursion;
-    excursion.go_to(target.id);
-    _populate_stair_distances(target);
+    // Loading another level to flood it is slow, and nothing the flood
+    // depends on can change until the player goes back there, so reuse the
+    // last result for the same target.
+    static level_pos cached_target;
+    static unsigned int cached_revision = 0;
+    static vector<stair_info> cached_stairs;
+
+    if (target == cached_target
+        && travel_cache.get_level_info(target.id).get_revision()
+           == cached_revision)
+    {
+        curr_stairs = cached_stairs;
+        return true;
+    }
+
+    {
+        level_excursion excursion;
+        excursion.go_to(target.id);
+        _populate_stair_distances(target);
+    }
+
+    cached_target   = target;
+    cached_revision = travel_cache.get_level_info(target.id).get_revision();
+    cached_stairs   = curr_stairs;
     return true;
 }
 
@@ -2836,7 +2907,11 @@ static bool _find_transtravel_square(const level_pos &target, bool verbose)
     int best_level_distance = -1;
     travel_cache.clear_distances();
 
-    find_travel_pos(you.pos(), nullptr, nullptr, nullptr);
+    // Standing on a known stair (as we are after every stair taken during
+    // interlevel travel), the saved stair distances are all the stair search
+    // needs, so only flood out from the player when they're elsewhere.
+    if (!travel_cache.get_level_info(current).get_stair(you.pos()))
+        find_travel_pos(you.pos(), nullptr, nullptr, nullptr);
 
     // either off-level, or traversable and on-level
     // TODO: actually check this when the square is off-level? The current
@@ -3177,10 +3252,21 @@ bool LevelInfo::empty() const
 void LevelInfo::update_excludes()
 {
     excludes = curr_excludes;
+    touch();
+}
+
+void LevelInfo::touch()
+{
+    // Revisions are unique across all levels, so a LevelInfo that is dropped
+    // and recreated never looks unchanged.
+    static unsigned int last_revision = 0;
+    revision = ++last_revision;
 }
 
 void LevelInfo::update()
 {
+    touch();
+
     // First, set excludes, so that stair distances will be correctly populated.
     excludes = curr_excludes;
 
@@ -3257,6 +3343,7 @@ void LevelInfo::update_transporter(const coord_def& transpos,
 void LevelInfo::update_stair(const coord_def& stairpos, const level_pos &p,
                              bool guess)
 {
+    touch();
     stair_info *si = get_stair(stairpos);
 
     // What 'guess' signifies: whenever you take a stair from A to B, the
@@ -3619,6 +3706,7 @@ void LevelInfo::save(writer& outf) const
 
 void LevelInfo::load(reader& inf, int minorVersion)
 {
+    touch();
     stairs.clear();
     int stair_count = unmarshallShort(inf);
     for (int i = 0; i < stair_count; ++i)
@@ -4008,6 +4096,7 @@ void TravelCache::update_excludes()
 
 void TravelCache::update()
 {
+    alloc_tag_scope tag(ALLOC_TRAVEL);
     get_level_info(level_id::current()).update();
 }
 
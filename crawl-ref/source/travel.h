@@ -146,6 +146,12 @@ const int PD_CLOUD = -20101;
  * *********************************************************************** */
 extern travel_distance_grid_t travel_point_distance;
 
+#ifdef DEBUG_STATISTICS
+// Work done by travel_pathfind, counted for -travel-bench.
+extern int travel_pathfind_calls;
+extern int travel_cells_examined;
+#endif
+
 enum explore_stop_type
 {
     ES_NONE                      = 0x00000,
@@ -322,6 +328,7 @@ struct LevelInfo
     LevelInfo() : stairs(), excludes(), stair_distances(), id()
     {
         daction_counters.init(0);
+        touch();
     }
 
     void save(writer&) const;
@@ -373,6 +380,13 @@ struct LevelInfo
     // current level.
     bool is_known_branch(uint8_t branch) const;
 
+    // Changes whenever anything travel distances depend on may have changed,
+    // so that callers can cache results computed from this level.
+    unsigned int get_revision() const
+    {
+        return revision;
+    }
+
     FixedVector<int, NUM_DACTION_COUNTERS> daction_counters;
 
 private:
@@ -388,6 +402,7 @@ private:
     void sync_branch_stairs(const stair_info *si);
     void set_distance_between_stairs(int a, int b, int dist);
     void fixup();
+    void touch();
 
 private:
     vector<stair_info> stairs;
@@ -398,6 +413,7 @@ private:
 
     vector<short> stair_distances;  // Dist between stairs
     level_id id;
+    unsigned int revision;          // Not saved.
 
     friend class TravelCache;
 
@@ -513,7 +529,7 @@ public:
     // Extract features without pathfinding
     void get_features();
 
-    const set<coord_def> get_unreachables() const;
+    const set<coord_def> &get_unreachables() const;
 
     // The next square to go to to move towards the travel destination. Return
     // value is undefined if pathfind was not called with RMODE_TRAVEL.
@@ -543,8 +559,10 @@ protected:
     virtual bool point_traverse_delay(const coord_def &c);
     virtual bool path_flood(const coord_def &c, const coord_def &dc);
     bool square_slows_movement(const coord_def &c);
+    bool is_travelsafe(const coord_def &c);
     void check_square_greed(const coord_def &c);
     void good_square(const coord_def &c);
+    bool explore_settled() const;
 
 protected:
     static const int UNFOUND_DIST  = -30000;
@@ -604,6 +622,11 @@ protected:
     // List of unexplored and unreachable points.
     set<coord_def> unreachables;
 
+    // Travel safety of the squares path_flood has already looked at in this
+    // pathfind, indexed by ignore_hostile. Each square is reached from up to
+    // eight neighbours, and the answer can't change during one flood.
+    map_bitmask safety_known[2], safety[2];
+
     travel_distance_col *point_distance;
 
     // How many points are we currently considering? We start off with just one
@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @brief Time spent in each phase of a game turn.
+ *
+ * Each phase's time is kept in a histogram with eight buckets per power of
+ * two microseconds, so percentiles are within about 12% however long the
+ * game runs, in a fixed amount of memory.
+**/
+
+#include "AppHdr.h"
+
+#include "turn-profile.h"
+
+#include <cmath>
+
+#include "message.h"
+#include "stringutil.h"
+#include "syscalls.h"
+
+static const int TURN_HIST_BUCKETS = 256;
+
+struct turn_phase_stats
+{
+    uint64_t count = 0;
+    int64_t total_us = 0;
+    int64_t max_us = 0;
+    uint64_t hist[TURN_HIST_BUCKETS] = {};
+
+    void add(int64_t us);
+    int64_t percentile(double fraction) const;
+};
+
+static const char *phase_names[] =
+{
+    "view", "gods", "environment", "player", "noise", "monsters", "time",
+    "clouds", "lua",
+};
+COMPILE_CHECK(ARRAYSZ(phase_names) == NUM_TURN_PHASES);
+
+static bool _profiling = false;
+static int64_t _this_turn[NUM_TURN_PHASES];
+static turn_phase_stats _phase_stats[NUM_TURN_PHASES];
+static turn_phase_stats _turn_stats;
+
+static int64_t _us_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration_cast<chrono::microseconds>(
+               chrono::steady_clock::now() - start).count();
+}
+
+static int _hist_bucket(int64_t us)
+{
+    if (us < 8)
+        return max<int64_t>(us, 0);
+    int exp = 0;
+    while ((us >> exp) >= 16)
+        ++exp;
+    return min(8 * exp + static_cast<int>(us >> exp), TURN_HIST_BUCKETS - 1);
+}
+
+// The largest time that falls in the given bucket.
+static int64_t _hist_bucket_top(int bucket)
+{
+    if (bucket < 8)
+        return bucket;
+    const int exp = bucket / 8 - 1;
+    return ((static_cast<int64_t>(bucket % 8 + 9)) << exp) - 1;
+}
+
+void turn_phase_stats::add(int64_t us)
+{
+    ++count;
+    total_us += us;
+    max_us = max(max_us, us);
+    ++hist[_hist_bucket(us)];
+}
+
+int64_t turn_phase_stats::percentile(double fraction) const
+{
+    if (!count)
+        return 0;
+    const uint64_t wanted = max<uint64_t>(1, ceil(fraction * count));
+    uint64_t seen = 0;
+    for (int i = 0; i < TURN_HIST_BUCKETS; ++i)
+    {
+        seen += hist[i];
+        if (seen >= wanted)
+            return min(_hist_bucket_top(i), max_us);
+    }
+    return max_us;
+}
+
+turn_phase_timer::turn_phase_timer(turn_phase_type _phase)
+    : phase(_phase), active(_profiling)
+{
+    if (active)
+        start = chrono::steady_clock::now();
+}
+
+turn_phase_timer::~turn_phase_timer()
+{
+    if (active)
+        _this_turn[phase] += _us_since(start);
+}
+
+turn_profile_scope::turn_profile_scope()
+    : active(_profiling)
+{
+    if (active)
+        start = chrono::steady_clock::now();
+}
+
+turn_profile_scope::~turn_profile_scope()
+{
+    if (!active)
+        return;
+
+    _turn_stats.add(_us_since(start));
+    for (int i = 0; i < NUM_TURN_PHASES; ++i)
+    {
+        _phase_stats[i].add(_this_turn[i]);
+        _this_turn[i] = 0;
+    }
+}
+
+bool turn_profile_active()
+{
+    return _profiling;
+}
+
+void turn_profile_start()
+{
+    _profiling = true;
+}
+
+static string _phase_summary(const char *name, const turn_phase_stats &stats)
+{
+    return make_stringf("%s: mean %" PRId64 "us, p50 %" PRId64 "us, "
+                        "p99 %" PRId64 "us, max %" PRId64 "us",
+                        name, stats.total_us / (int64_t)stats.count,
+                        stats.percentile(0.5), stats.percentile(0.99),
+                        stats.max_us);
+}
+
+/// Print where turns have gone since profiling started, slowest phase first.
+void turn_profile_report()
+{
+    if (!_turn_stats.count)
+    {
+        mprf(MSGCH_DIAGNOSTICS, "No turns profiled yet.");
+        return;
+    }
+
+    mprf(MSGCH_DIAGNOSTICS, "%" PRIu64 " turns. %s", _turn_stats.count,
+         _phase_summary("whole turn", _turn_stats).c_str());
+
+    vector<pair<int64_t, int>> by_time;
+    for (int i = 0; i < NUM_TURN_PHASES; ++i)
+        by_time.emplace_back(_phase_stats[i].total_us, i);
+    sort(by_time.rbegin(), by_time.rend());
+
+    for (const auto &entry : by_time)
+    {
+        mprf(MSGCH_DIAGNOSTICS, "%s",
+             _phase_summary(phase_names[entry.second],
+                            _phase_stats[entry.second]).c_str());
+    }
+}
+
+static void _write_phase_line(FILE *outf, const char *name,
+                              const turn_phase_stats &stats)
+{
+    fprintf(outf, "%s,%" PRIu64 ",%.3f,%.1f,%" PRId64 ",%" PRId64 ",%" PRId64
+                  ",%" PRId64 ",%" PRId64 "\n",
+            name, stats.count, stats.total_us / 1000.0,
+            stats.count ? (double)stats.total_us / stats.count : 0.0,
+            stats.percentile(0.5), stats.percentile(0.9),
+            stats.percentile(0.99), stats.percentile(0.999), stats.max_us);
+}
+
+/**
+ * Write one CSV line for the whole turn and one per phase. Times are in
+ * microseconds, except the total, which is in milliseconds.
+ *
+ * @returns whether the file could be written.
+ */
+bool turn_profile_write(const string &filename)
+{
+    FILE *outf = fopen_u(filename.c_str(), "w");
+    if (!outf)
+        return false;
+
+    fprintf(outf, "phase,turns,total_ms,mean_us,p50_us,p90_us,p99_us,"
+                  "p999_us,max_us\n");
+    _write_phase_line(outf, "turn", _turn_stats);
+    for (int i = 0; i < NUM_TURN_PHASES; ++i)
+        _write_phase_line(outf, phase_names[i], _phase_stats[i]);
+
+    fclose(outf);
+    return true;
+}
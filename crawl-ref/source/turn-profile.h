@@ -0,0 +1,58 @@
+/**
+ * @file
+ * @brief Time spent in each phase of a game turn.
+**/
+
+#pragma once
+
+#include <chrono>
+
+enum turn_phase_type
+{
+    TURN_PHASE_VIEW,         // viewwindow() and monsters coming into view
+    TURN_PHASE_GODS,         // religion_turn_end() and Wu Jian's turn end
+    TURN_PHASE_ENVIRONMENT,  // run_environment_effects()
+    TURN_PHASE_PLAYER,       // player_reacts() and player_reacts_to_monsters()
+    TURN_PHASE_NOISE,        // apply_noises()
+    TURN_PHASE_MONSTERS,     // handle_monsters()
+    TURN_PHASE_TIME,         // handle_time()
+    TURN_PHASE_CLOUDS,       // manage_clouds()
+    TURN_PHASE_LUA,          // the clua ready() hook before each command
+    NUM_TURN_PHASES
+};
+
+// Adds the time until it is destroyed to one phase of the current turn.
+// Unless profiling is on, this doesn't even read the clock.
+class turn_phase_timer
+{
+public:
+    explicit turn_phase_timer(turn_phase_type _phase);
+    ~turn_phase_timer();
+
+    turn_phase_timer(const turn_phase_timer&) = delete;
+    turn_phase_timer& operator=(const turn_phase_timer&) = delete;
+private:
+    turn_phase_type phase;
+    bool active;
+    chrono::steady_clock::time_point start;
+};
+
+// Held over a whole world_reacts(): times the turn, and when it ends files
+// it and every phase timed since the last one in the histograms.
+class turn_profile_scope
+{
+public:
+    turn_profile_scope();
+    ~turn_profile_scope();
+
+    turn_profile_scope(const turn_profile_scope&) = delete;
+    turn_profile_scope& operator=(const turn_profile_scope&) = delete;
+private:
+    bool active;
+    chrono::steady_clock::time_point start;
+};
+
+bool turn_profile_active();
+void turn_profile_start();
+void turn_profile_report();
+bool turn_profile_write(const string &filename);
@@ -471,13 +471,26 @@ string UTF8FileLineInput::get_line()
     return utf8_validate(out.c_str());
 }
 
+// Printable ASCII is one column wide in any locale, and is most of what
+// gets measured, so it can skip decoding and wcwidth().
+static inline bool _is_printable_ascii(char c)
+{
+    return c >= 0x20 && c < 0x7f;
+}
+
 int strwidth(const char *s)
 {
     char32_t c;
     int w = 0;
 
-    while (int l = utf8towc(&c, s))
+    while (true)
     {
+        for (; _is_printable_ascii(*s); ++s)
+            ++w;
+
+        const int l = utf8towc(&c, s);
+        if (!l)
+            break;
         s += l;
         int cw = wcwidth(c);
         if (cw != -1) // shouldn't ever happen
@@ -536,8 +549,14 @@ string chop_string(const char *s, int width, bool spaces)
     const char *s0 = s;
     char32_t c;
 
-    while (int clen = utf8towc(&c, s))
+    while (true)
     {
+        for (; width > 0 && _is_printable_ascii(*s); ++s)
+            --width;
+
+        const int clen = utf8towc(&c, s);
+        if (!clen)
+            break;
         int cw = wcwidth(c);
         // Due to combining chars, we can't stop at merely reaching the
         // target width, the next character needs to exceed it.
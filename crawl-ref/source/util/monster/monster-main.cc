@@ -25,6 +25,7 @@
 #include "libutil.h"
 #include "item-name.h"
 #include "item-prop.h"
+#include "items.h"
 #include "act-iter.h"
 #include "mon-death.h"
 #include "random.h"
@@ -34,6 +35,7 @@
 #include "stringutil.h"
 #include "syscalls.h"
 #include "artefact.h"
+#include <iostream>
 #include <sstream>
 #include <set>
 #include <unistd.h>
@@ -686,39 +688,11 @@ static string canned_reports[][2] = {
                  " | Res: sanity | XP: ∞ | Int: god | Sz: !!!"))},
 };
 
-int main(int argc, char* argv[])
+// Prints the one-line report for a query: a monster name or spec, or
+// "spec:" and the name of a vault monster to look up its spec.
+static int _report_monster(string target)
 {
-    alarm(5);
-    crawl_state.test = true;
-    if (argc < 2)
-    {
-        printf("Usage: @? <monster name>\n");
-        return 0;
-    }
-
-    if (!strcmp(argv[1], "-version") || !strcmp(argv[1], "--version"))
-    {
-        printf("Monster stats Crawl version: %s\n", Version::Long);
-        return 0;
-    }
-    else if (!strcmp(argv[1], "-name") || !strcmp(argv[1], "--name"))
-    {
-        seed_rng();
-        printf("%s\n", make_name().c_str());
-        return 0;
-    }
-
-    initialize_crawl();
-
     mons_list mons;
-    string target = argv[1];
-
-    if (argc > 2)
-        for (int x = 2; x < argc; x++)
-        {
-            target.append(" ");
-            target.append(argv[x]);
-        }
 
     trim_string(target);
 
@@ -1293,6 +1267,74 @@ int main(int argc, char* argv[])
     return 1;
 }
 
+// Get rid of the monsters and items left by the last report, so that the
+// next one starts from the same empty level.
+static void _reset_level()
+{
+    for (monster_iterator mi; mi; ++mi)
+        mi->reset();
+    for (int i = 0; i < MAX_ITEMS; ++i)
+        if (mitm[i].defined())
+            destroy_item(i, true);
+    you.unique_creatures.reset();
+}
+
+// Answer one query per line of stdin, so that a bot can keep a single
+// process around instead of paying for the initialisation on every lookup.
+static int _batch_mode()
+{
+    alarm(0);
+    string query;
+    while (getline(cin, query))
+    {
+        if (trimmed_string(query).empty())
+            continue;
+        alarm(5);
+        _report_monster(query);
+        fflush(stdout);
+        alarm(0);
+        _reset_level();
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    alarm(5);
+    crawl_state.test = true;
+    if (argc < 2)
+    {
+        printf("Usage: @? <monster name>\n");
+        return 0;
+    }
+
+    if (!strcmp(argv[1], "-version") || !strcmp(argv[1], "--version"))
+    {
+        printf("Monster stats Crawl version: %s\n", Version::Long);
+        return 0;
+    }
+    else if (!strcmp(argv[1], "-name") || !strcmp(argv[1], "--name"))
+    {
+        seed_rng();
+        printf("%s\n", make_name().c_str());
+        return 0;
+    }
+
+    initialize_crawl();
+
+    if (!strcmp(argv[1], "-batch") || !strcmp(argv[1], "--batch"))
+        return _batch_mode();
+
+    string target = argv[1];
+    for (int x = 2; x < argc; x++)
+    {
+        target.append(" ");
+        target.append(argv[x]);
+    }
+
+    return _report_monster(target);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // main.cc stuff
 
@@ -1305,5 +1347,8 @@ game_state crawl_state;
 void process_command(command_type);
 void process_command(command_type) {}
 
+void replay_input();
+void replay_input() {}
+
 void world_reacts();
 void world_reacts() {}
@@ -372,7 +372,7 @@ static void _secular_headsup(const vector<monster*> &monsters,
  * @param monsters      A list of monsters that just became visible.
  */
 static void _handle_comes_into_view(const vector<string> &msgs,
-                                    const vector<monster*> monsters)
+                                    const vector<monster*> &monsters)
 {
     const unsigned int max_msgs = 4;
 
@@ -401,7 +401,7 @@ static void _handle_comes_into_view(const vector<string> &msgs,
 }
 
 /// If the player has the shout mutation, maybe shout at newly-seen monsters.
-static void _maybe_trigger_shoutitis(const vector<monster*> monsters)
+static void _maybe_trigger_shoutitis(const vector<monster*> &monsters)
 {
     if (!you.get_mutation_level(MUT_SCREAM))
         return;
@@ -419,7 +419,7 @@ static void _maybe_trigger_shoutitis(const vector<monster*> monsters)
 }
 
 /// Let Gozag's wrath buff newly-seen hostile monsters, maybe.
-static void _maybe_gozag_incite(vector<monster*> monsters)
+static void _maybe_gozag_incite(const vector<monster*> &monsters)
 {
     if (!player_under_penance(GOD_GOZAG))
         return;
@@ -586,8 +586,10 @@ static const FixedArray<uint8_t, GXM, GYM>& _tile_difficulties(bool random)
 
     cache_seed = seed;
 
-    for (int y = Y_BOUND_1; y <= Y_BOUND_2; ++y)
-        for (int x = X_BOUND_1; x <= X_BOUND_2; ++x)
+    // Each cell's value depends only on its own index, so walk the array in
+    // memory order.
+    for (int x = X_BOUND_1; x <= X_BOUND_2; ++x)
+        for (int y = Y_BOUND_1; y <= Y_BOUND_2; ++y)
             cache[x][y] = hash_rand(100, seed, y * GXM + x);
 
     return cache;
@@ -1374,6 +1376,10 @@ void viewwindow(bool show_updates, bool tiles_only, animation *a)
     if (!cell)
         return;
 
+    // Nothing about the monsters or items changes while they are drawn.
+    monster_info_cache_scope moninfo_cache;
+    item_name_cache_scope item_names;
+
     // Update the animation of cells only once per turn.
     const bool anim_updates = (you.last_view_update != you.num_turns);
     // Except for elemental colours, which should be updated every refresh.
@@ -1403,8 +1409,13 @@ void viewwindow(bool show_updates, bool tiles_only, animation *a)
     if (show_updates)
         player_view_update();
 
-    bool run_dont_draw = you.running && Options.travel_delay < 0
-                && (!you.running.is_explore() || Options.explore_delay < 0);
+    // rest_delay = -1 is documented to stop the display updating while
+    // resting, which otherwise redraws the whole view every turn of a rest.
+    bool run_dont_draw = you.running
+        && (Options.travel_delay < 0
+            && (!you.running.is_explore() || Options.explore_delay < 0)
+            || you.running.is_rest() && Options.rest_delay < 0)
+        || delay_hides_view();
 
     if (run_dont_draw || you.asleep())
     {
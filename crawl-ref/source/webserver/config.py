@@ -42,6 +42,7 @@ watch_socket_dirs = False
 # Game configs
 # %n in paths and urls is replaced by the current username
 # morgue_url is for a publicly available URL to access morgue_path
+# webrec_path, if set, is where crawl writes webtiles recordings
 games = OrderedDict([
     ("dcss-web-trunk", dict(
         name = "DCSS trunk",
@@ -90,6 +91,10 @@ milestone_file = "./milestones"
 
 status_file_update_rate = 5
 
+# Log each connection's traffic, by message type, this often (in seconds),
+# and once more when it closes. Set to None to disable.
+telemetry_log_rate = None
+
 recording_term_size = (80, 24)
 
 max_connections = 100
@@ -146,6 +151,13 @@ umask = None # e.g. 0077
 chroot = None
 
 pidfile = None
+
+# Set to more than 1 to run that many worker processes sharing the listening
+# sockets, under a supervisor that restarts any that die. A game is run by
+# the worker its player connected to. Every worker watches the socket dirs,
+# so its lobby lists all games and its spectators can watch any of them.
+# Needs dgl_mode.
+worker_processes = 1
 daemon = False # If true, the server will detach from the session after startup
 
 # Set to a URL with %s where lowercased player name should go in order to
@@ -53,7 +53,8 @@ class WebtilesSocketConnection(object):
 
         msg = json_encode({
                 "msg": "attach",
-                "primary": primary
+                "primary": primary,
+                "coalesce": True
                 })
 
         self.open = True
@@ -82,7 +83,11 @@ class WebtilesSocketConnection(object):
             self.msg_buffer = None
 
             if self.message_callback:
-                self.message_callback(data)
+                # crawl may send several messages at once, each on its
+                # own line.
+                for msg in data.split("\n"):
+                    if msg:
+                        self.message_callback(msg + "\n")
 
     def send_message(self, data):
         start = datetime.now()
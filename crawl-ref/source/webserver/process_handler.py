@@ -14,11 +14,14 @@ from terminal import TerminalRecorder
 from connection import WebtilesSocketConnection
 from util import DynamicTemplateLoader, dgl_format_str, parse_where_data
 from game_data_handler import GameDataHandler
-from ws_handler import update_all_lobbys, remove_in_lobbys
+from ws_handler import update_all_lobbys, remove_in_lobbys, BroadcastStream
 from inotify import DirectoryWatcher
 
 last_game_id = 0
 
+# How much of crawl's output to keep for bringing new watchers up to date
+STATE_LOG_LIMIT = 2 * 1024 * 1024
+
 processes = dict()
 unowned_process_logger = logging.LoggerAdapter(logging.getLogger(), {})
 
@@ -85,6 +88,7 @@ class CrawlProcessHandlerBase(object):
         self.logger.process = self._process_log_msg
         self.io_loop = io_loop or IOLoop.instance()
         self.queue_messages = False
+        self._broadcast = BroadcastStream()
 
         self.process = None
         self.client_path = self.config_path("client_path")
@@ -92,6 +96,10 @@ class CrawlProcessHandlerBase(object):
         self.where = {}
         self.wheretime = 0
         self.last_milestone = None
+        # Set once crawl sends us where/milestone events itself; we then
+        # stop reading its files.
+        self.pushes_where = False
+        self.pushes_milestones = False
         self.kill_timeout = None
 
         now = datetime.datetime.utcnow()
@@ -134,16 +142,14 @@ class CrawlProcessHandlerBase(object):
                 update_all_lobbys(self)
 
     def flush_messages_to_all(self):
-        for receiver in self._receivers:
-            receiver.flush_messages()
+        self._broadcast.flush(self._receivers)
 
     def write_to_all(self, msg, send):
-        for receiver in self._receivers:
-            receiver.write_message(msg, send)
+        self._broadcast.write_message(msg, self._receivers, send)
 
     def send_to_all(self, msg, **data):
-        for receiver in self._receivers:
-            receiver.send_message(msg, **data)
+        data["msg"] = msg
+        self.write_to_all(json_encode(data), True)
 
     def handle_chat_message(self, username, text):
         chat_msg = ("<span class='chat_sender'>%s</span>: <span class='chat_msg'>%s</span>" %
@@ -272,6 +278,7 @@ class CrawlProcessHandlerBase(object):
             update_all_lobbys(self)
 
     def check_where(self):
+        if self.pushes_where: return
         morgue_path = self.config_path("morgue_path")
         wherefile = os.path.join(morgue_path, self.username + ".where")
         try:
@@ -369,6 +376,13 @@ class CrawlProcessHandler(CrawlProcessHandlerBase):
         self._purging_timer = None
         self._process_hup_timeout = None
 
+        # Every message crawl has broadcast since it last sent its full
+        # state, or None if we don't have that (yet).
+        self._state_log = None
+        self._state_log_size = 0
+        self._state_requested = False
+        self._sends_state_reset = False
+
     def start(self):
         self._purge_locks_and_start(True)
 
@@ -505,6 +519,12 @@ class CrawlProcessHandler(CrawlProcessHandlerBase):
         if ttyrec_path:
             self.ttyrec_filename = os.path.join(ttyrec_path, self.lock_basename)
 
+        webrec_path = self.config_path("webrec_path")
+        if webrec_path:
+            call += ["-webtiles-record",
+                     os.path.join(webrec_path,
+                                  self.formatted_time + ".webrec.gz")]
+
         processes[os.path.abspath(self.socketpath)] = self
 
         if config.dgl_mode:
@@ -611,10 +631,39 @@ class CrawlProcessHandler(CrawlProcessHandlerBase):
 
 
     def add_watcher(self, watcher):
+        if self._state_log is not None:
+            # Anything still queued is in the log already.
+            self.flush_messages_to_all()
+
         super(CrawlProcessHandler, self).add_watcher(watcher)
 
-        if self.conn and self.conn.open:
+        if self._state_log is not None:
+            # Bring the new watcher up to date ourselves, without
+            # bothering the game.
+            for msg in self._state_log:
+                watcher.write_message(msg, False)
+            watcher.flush_messages()
+        elif self._state_requested:
+            # The full state is already on its way to all receivers.
+            pass
+        elif self.conn and self.conn.open:
             self.conn.send_message('{"msg":"spectator_joined"}')
+            # Only crawl versions that send state_reset tell us when it
+            # arrives.
+            self._state_requested = self._sends_state_reset
+
+    def _log_state_message(self, msg):
+        if self._state_log is None:
+            return
+        # Replaying animation delays would only hold up the new watcher.
+        if msg.startswith('{"msg":"delay"'):
+            return
+        self._state_log_size += len(msg)
+        if self._state_log_size > STATE_LOG_LIMIT:
+            # Cheaper to have crawl resend everything next time.
+            self._state_log = None
+            return
+        self._state_log.append(msg)
 
     def handle_input(self, msg):
         obj = json_decode(msg)
@@ -703,6 +752,21 @@ class CrawlProcessHandler(CrawlProcessHandlerBase):
                         self.crawl_version = msgobj["version"]
                         self.logger.info("Crawl version: %s.", self.crawl_version)
                     self.send_client_to_all()
+            elif msgobj["msg"] == "where":
+                self.pushes_where = True
+                newwhere = parse_where_data(msgobj["data"])
+                if (newwhere.get("status") == "active" or
+                    newwhere.get("status") == "saved"):
+                    self.set_where_info(newwhere)
+            elif msgobj["msg"] == "milestone":
+                self.pushes_milestones = True
+                self.log_milestone(parse_where_data(msgobj["data"]))
+            elif msgobj["msg"] == "state_reset":
+                # What follows is crawl's full state.
+                self._state_log = []
+                self._state_log_size = 0
+                self._state_requested = False
+                self._sends_state_reset = True
             elif msgobj["msg"] == "flush_messages":
                 # only queue, once we know the crawl process asks for flushes
                 self.queue_messages = True;
@@ -733,6 +797,7 @@ class CrawlProcessHandler(CrawlProcessHandlerBase):
                 # want that to reset idle time.
                 self.note_activity()
 
+            self._log_state_message(msg)
             self.write_to_all(msg, not self.queue_messages)
 
 
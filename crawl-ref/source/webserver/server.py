@@ -3,6 +3,7 @@ import os, os.path, errno, sys
 
 import tornado.httpserver
 import tornado.ioloop
+import tornado.netutil
 import tornado.web
 import tornado.template
 
@@ -107,7 +108,36 @@ def signal_handler(signum, frame):
     if len(sockets) == 0:
         ioloop.stop()
 
-def bind_server():
+def bind_sockets():
+    """Binds the listening sockets, before privileges are shed and before
+    any worker processes are forked. Returns (ssl, sockets) pairs."""
+    bound = []
+
+    if bind_nonsecure:
+        try:
+            listens = bind_pairs
+        except NameError:
+            listens = ( (bind_address, bind_port), )
+        socks = []
+        for (addr, port) in listens:
+            logging.info("Listening on %s:%d" % (addr, port))
+            socks += tornado.netutil.bind_sockets(port, addr)
+        bound.append((False, socks))
+    if ssl_options:
+        # TODO: allow different ssl_options per bind pair
+        try:
+            listens = ssl_bind_pairs
+        except NameError:
+            listens = ( (ssl_address, ssl_port), )
+        socks = []
+        for (addr, port) in listens:
+            logging.info("Listening on %s:%d" % (addr, port))
+            socks += tornado.netutil.bind_sockets(port, addr)
+        bound.append((True, socks))
+
+    return bound
+
+def bind_server(bound):
     settings = {
         "static_path": static_path,
         "template_loader": DynamicTemplateLoader.get(template_path)
@@ -128,31 +158,67 @@ def bind_server():
 
     servers = []
 
-    if bind_nonsecure:
-        server = tornado.httpserver.HTTPServer(application, **kwargs)
-        try:
-            listens = bind_pairs
-        except NameError:
-            listens = ( (bind_address, bind_port), )
-        for (addr, port) in listens:
-            logging.info("Listening on %s:%d" % (addr, port))
-            server.listen(port, addr)
-        servers.append(server)
-    if ssl_options:
-        # TODO: allow different ssl_options per bind pair
-        server = tornado.httpserver.HTTPServer(application,
-                                               ssl_options = ssl_options, **kwargs)
-        try:
-            listens = ssl_bind_pairs
-        except NameError:
-            listens = ( (ssl_address, ssl_port), )
-        for (addr, port) in listens:
-            logging.info("Listening on %s:%d" % (addr, port))
-            server.listen(port, addr)
+    for (secure, socks) in bound:
+        if secure:
+            server = tornado.httpserver.HTTPServer(application,
+                                                   ssl_options = ssl_options, **kwargs)
+        else:
+            server = tornado.httpserver.HTTPServer(application, **kwargs)
+        server.add_sockets(socks)
         servers.append(server)
 
     return servers
 
+def run_workers(count):
+    """Forks count worker processes and restarts any that die, until told to
+    shut down. Returns the worker's number in each worker, and None in the
+    supervisor once all workers have exited."""
+    children = {}
+    state = { "stopping": False }
+
+    def forward_signal(signum, frame):
+        logging.info("Received signal %i, stopping the workers.", signum)
+        state["stopping"] = True
+        for pid in children:
+            try:
+                os.kill(pid, signum)
+            except OSError:
+                pass
+
+    def start_worker(n):
+        pid = os.fork()
+        if pid == 0:
+            return True
+        children[pid] = n
+        logging.info("Started worker %d (PID: %d)." % (n, pid))
+        return False
+
+    signal.signal(signal.SIGTERM, forward_signal)
+    signal.signal(signal.SIGHUP, forward_signal)
+
+    for n in xrange(count):
+        if start_worker(n):
+            return n
+
+    while children:
+        try:
+            pid, status = os.wait()
+        except OSError, e:
+            if e.errno == errno.EINTR: continue
+            raise
+        except KeyboardInterrupt:
+            state["stopping"] = True
+            continue
+        if pid not in children: continue
+        n = children.pop(pid)
+        if state["stopping"]: continue
+        logging.warning("Worker %d (PID: %d) exited with status %d, restarting it."
+                        % (n, pid, status))
+        if start_worker(n):
+            return n
+
+    return None
+
 def init_logging(logging_config):
     filename = logging_config.get("filename")
     if filename:
@@ -201,33 +267,50 @@ if __name__ == "__main__":
     if daemon:
         daemonize()
 
-    signal.signal(signal.SIGTERM, signal_handler)
-    signal.signal(signal.SIGHUP, signal_handler)
-
     if umask is not None:
         os.umask(umask)
 
     write_pidfile()
 
-    servers = bind_server()
+    bound = bind_sockets()
 
     shed_privileges()
 
     if dgl_mode:
         ensure_user_db_exists()
 
+    worker = None
+    if getattr(config, "worker_processes", 1) > 1:
+        if not dgl_mode:
+            err_exit("worker_processes needs dgl_mode.")
+        # The IOLoop has to be created after this, in each worker.
+        worker = run_workers(config.worker_processes)
+        if worker is None:
+            remove_pidfile()
+            sys.exit(0)
+
+    signal.signal(signal.SIGTERM, signal_handler)
+    signal.signal(signal.SIGHUP, signal_handler)
+
+    servers = bind_server(bound)
+
     ioloop = tornado.ioloop.IOLoop.instance()
     ioloop.set_blocking_log_threshold(0.5)
 
+    telemetry_timeout()
+
     if dgl_mode:
         status_file_timeout()
         purge_login_tokens_timeout()
         start_reading_milestones()
 
-        if watch_socket_dirs:
+        if watch_socket_dirs or worker is not None:
             process_handler.watch_socket_dirs()
 
-    logging.info("Webtiles server started! (PID: %s)" % os.getpid())
+    if worker is not None:
+        logging.info("Webtiles worker %d started! (PID: %s)" % (worker, os.getpid()))
+    else:
+        logging.info("Webtiles server started! (PID: %s)" % os.getpid())
 
     try:
         ioloop.start()
@@ -239,4 +322,5 @@ if __name__ == "__main__":
         if len(sockets) > 0:
             ioloop.start() # We'll wait until all crawl processes have ended.
 
-    remove_pidfile()
+    if worker is None:
+        remove_pidfile()
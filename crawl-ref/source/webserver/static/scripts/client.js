@@ -848,6 +848,34 @@ function (exports, $, key_conversion, chat, comm) {
         });
     }
 
+    var lobby_version = null;
+    function lobby_update(data)
+    {
+        if (lobby_version === null || data.version != lobby_version + 1)
+        {
+            // We missed something; start over from a full list.
+            lobby_version = null;
+            send_message("lobby_resync");
+            return;
+        }
+        lobby_version = data.version;
+
+        if (data.entries.length == 1 && data.removed.length == 0)
+        {
+            lobby_entry(data.entries[0]);
+            return;
+        }
+
+        new_list = $("#player_list").clone();
+        $.each(data.entries, function (i, entry) {
+            lobby_entry(entry);
+        });
+        $.each(data.removed, function (i, id) {
+            new_list.find("#game-" + id).remove();
+        });
+        lobby_complete();
+    }
+
     function lobby_remove(data)
     {
         $("#game-" + data.id).remove();
@@ -860,8 +888,10 @@ function (exports, $, key_conversion, chat, comm) {
         new_list = $("#player_list").clone();
         new_list.find("tbody").html("");
     }
-    function lobby_complete()
+    function lobby_complete(data)
     {
+        if (data && data.version !== undefined)
+            lobby_version = data.version;
         var old_list = $("#player_list");
         var sortlist;
         if (new_list.find("tbody tr").length > 0)
@@ -1150,6 +1180,7 @@ function (exports, $, key_conversion, chat, comm) {
         "lobby_entry": lobby_entry,
         "lobby_remove": lobby_remove,
         "lobby_complete": lobby_complete,
+        "lobby_update": lobby_update,
 
         "go_lobby": go_lobby,
         "login_required": login_required,
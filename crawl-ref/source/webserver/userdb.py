@@ -30,17 +30,62 @@ def user_passwd_match(username, passwd): # Returns the correctly cased username.
         if conn: conn.close()
 
 def ensure_user_db_exists():
-    if os.path.exists(password_db): return
-    logging.warn("User database didn't exist; creating it now.")
+    exists = os.path.exists(password_db)
+    if not exists:
+        logging.warn("User database didn't exist; creating it now.")
     c = None
     conn = None
     try:
         conn = sqlite3.connect(password_db)
         c = conn.cursor()
-        schema = ("CREATE TABLE dglusers (id integer primary key," +
-                  " username text, email text, env text," +
-                  " password text, flags integer);")
-        c.execute(schema)
+        if not exists:
+            schema = ("CREATE TABLE dglusers (id integer primary key," +
+                      " username text, email text, env text," +
+                      " password text, flags integer);")
+            c.execute(schema)
+        # Login tokens live here too, so that every worker process sees them.
+        c.execute("CREATE TABLE IF NOT EXISTS login_tokens (token text," +
+                  " username text, expires integer," +
+                  " PRIMARY KEY (token, username));")
+        conn.commit()
+    finally:
+        if c: c.close()
+        if conn: conn.close()
+
+def add_login_token(token, username, expires):
+    c = None
+    conn = None
+    try:
+        conn = sqlite3.connect(password_db)
+        c = conn.cursor()
+        c.execute("insert or replace into login_tokens(token, username, expires) values (?,?,?)",
+                  (token, username, int(expires)))
+        conn.commit()
+    finally:
+        if c: c.close()
+        if conn: conn.close()
+
+def take_login_token(token, username): # Returns whether the token was valid.
+    c = None
+    conn = None
+    try:
+        conn = sqlite3.connect(password_db)
+        c = conn.cursor()
+        c.execute("delete from login_tokens where token=? and username=?",
+                  (token, username))
+        conn.commit()
+        return c.rowcount > 0
+    finally:
+        if c: c.close()
+        if conn: conn.close()
+
+def purge_expired_login_tokens(now):
+    c = None
+    conn = None
+    try:
+        conn = sqlite3.connect(password_db)
+        c = conn.cursor()
+        c.execute("delete from login_tokens where expires < ?", (int(now),))
         conn.commit()
     finally:
         if c: c.close()
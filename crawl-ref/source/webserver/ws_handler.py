@@ -10,6 +10,7 @@ import signal
 import time, datetime
 import codecs
 import random
+import re
 import zlib
 
 import config
@@ -20,9 +21,72 @@ from util import *
 sockets = set()
 current_id = 0
 shutting_down = False
-login_tokens = {}
 rand = random.SystemRandom()
 
+def new_compressobj():
+    return zlib.compressobj(zlib.Z_DEFAULT_COMPRESSION, zlib.DEFLATED,
+                            -zlib.MAX_WBITS)
+
+def deflate_frame(compressobj, msg):
+    # Compress like in deflate-frame extension:
+    # Apply deflate, flush, then remove the 00 00 FF FF
+    # at the end
+    compressed = compressobj.compress(msg)
+    compressed += compressobj.flush(zlib.Z_SYNC_FLUSH)
+    return compressed[:-4]
+
+class BroadcastStream(object):
+    """Batches messages sent to all receivers of a game, and deflates each
+    batch once for all of them.
+
+    A client's inflater only understands a frame whose back references
+    point at data it has itself seen, so the shared compressor is
+    restarted whenever some receiver has been sent anything else since
+    the last frame (e.g. it just joined)."""
+    def __init__(self):
+        self.message_queue = []
+        self._compressobj = None
+
+    def write_message(self, msg, receivers, send=True):
+        msg = utf8(msg)
+        self.message_queue.append(msg)
+        msg_type = message_type(msg)
+        for receiver in receivers:
+            receiver.count_message(msg_type, len(msg))
+        if send:
+            self.flush(receivers)
+
+    def flush(self, receivers):
+        if len(self.message_queue) == 0:
+            return
+        msg = "{\"msgs\":[" + ",".join(self.message_queue) + "]}"
+        self.message_queue = []
+
+        receivers = [r for r in receivers if not r.client_closed]
+        # Anything queued privately goes out first, and may touch the
+        # receiver's inflater.
+        for receiver in receivers:
+            receiver.flush_messages()
+
+        compressed = None
+        deflating = [r for r in receivers if r.deflate]
+        if deflating:
+            if (self._compressobj is None or
+                any(r.inflater_source is not self for r in deflating)):
+                self._compressobj = new_compressobj()
+            compressed = deflate_frame(self._compressobj, msg)
+
+        for receiver in receivers:
+            receiver.send_frame(self, msg, compressed)
+
+_msg_type_re = re.compile(r'"msg"\s*:\s*"(\w+)"')
+
+def message_type(msg):
+    """The type of a JSON message, going by the "msg" field near its
+    start, for telemetry."""
+    m = _msg_type_re.search(msg, 0, 64)
+    return m.group(1) if m else "other"
+
 def shutdown():
     global shutting_down
     shutting_down = True
@@ -32,18 +96,65 @@ def shutdown():
 def update_global_status():
     write_dgl_status_file()
 
+# Lobby changes are collected for a short while and then sent to all lobby
+# sockets as one versioned lobby_update message, encoded once. A client that
+# sees a gap in the versions asks for the whole lobby again.
+LOBBY_UPDATE_DELAY = 0.25
+lobby_version = 0
+_lobby_changes = {} # game id -> process, or None if it has ended
+_lobby_entries = {} # game id -> the entry last sent in an update
+_lobby_update_timeout = None
+
 def update_all_lobbys(game):
-    lobby_entry = game.lobby_entry()
-    for socket in list(sockets):
-        if socket.is_in_lobby():
-            socket.send_message("lobby_entry", **lobby_entry)
+    _lobby_changes[game.id] = game
+    _schedule_lobby_update()
+
 def remove_in_lobbys(process):
+    _lobby_changes[process.id] = None
+    _schedule_lobby_update()
+
+def _schedule_lobby_update():
+    global _lobby_update_timeout
+    if _lobby_update_timeout is None:
+        _lobby_update_timeout = tornado.ioloop.IOLoop.instance().add_timeout(
+            time.time() + LOBBY_UPDATE_DELAY, _send_lobby_update)
+
+def _send_lobby_update():
+    global _lobby_update_timeout, lobby_version
+    _lobby_update_timeout = None
+
+    entries = []
+    removed = []
+    for game_id, game in _lobby_changes.items():
+        if game is None:
+            _lobby_entries.pop(game_id, None)
+            removed.append(game_id)
+        else:
+            entry = game.lobby_entry()
+            if _lobby_entries.get(game_id) != entry:
+                _lobby_entries[game_id] = entry
+                entries.append(entry)
+    _lobby_changes.clear()
+
+    if not entries and not removed:
+        return
+
+    lobby_version += 1
+    msg = json_encode({
+            "msg": "lobby_update",
+            "version": lobby_version,
+            "entries": entries,
+            "removed": removed,
+            })
     for socket in list(sockets):
         if socket.is_in_lobby():
-            socket.send_message("lobby_remove", id=process.id)
+            socket.write_message(msg)
 
 
 def write_dgl_status_file():
+    if getattr(config, "worker_processes", 1) > 1:
+        write_shared_dgl_status_file()
+        return
     f = None
     try:
         f = open(config.dgl_status_file, "w")
@@ -59,10 +170,31 @@ def write_dgl_status_file():
     finally:
         if f: f.close()
 
+def write_shared_dgl_status_file():
+    # With several workers, each one knows about every game through the
+    # socket dirs, so each writes the whole list -- atomically, since they
+    # all write the same file.
+    from process_handler import processes
+    tmpname = "%s.%d" % (config.dgl_status_file, os.getpid())
+    f = None
+    try:
+        f = open(tmpname, "w")
+        for process in processes.values():
+            f.write("%s#%s#%s#0x0#%s#%s#\n" %
+                    (process.username, process.game_params["id"],
+                     process.human_readable_where(),
+                     str(process.idle_time()),
+                     str(process.watcher_count())))
+        f.close()
+        f = None
+        os.rename(tmpname, config.dgl_status_file)
+    except (OSError, IOError) as e:
+        logging.warning("Could not write dgl status file: %s", e)
+    finally:
+        if f: f.close()
+
 def purge_login_tokens():
-    for token in list(login_tokens):
-        if datetime.datetime.now() > login_tokens[token]:
-            del login_tokens[token]
+    purge_expired_login_tokens(time.time())
 
 def purge_login_tokens_timeout():
     purge_login_tokens()
@@ -76,6 +208,19 @@ def status_file_timeout():
     ioloop.add_timeout(time.time() + config.status_file_update_rate,
                        status_file_timeout)
 
+def log_telemetry():
+    for socket in list(sockets):
+        if socket.total_message_bytes:
+            socket.logger.info("Telemetry: %s", socket.telemetry_summary())
+
+def telemetry_timeout():
+    rate = getattr(config, "telemetry_log_rate", None)
+    if not rate:
+        return
+    log_telemetry()
+    ioloop = tornado.ioloop.IOLoop.instance()
+    ioloop.add_timeout(time.time() + rate, telemetry_timeout)
+
 def find_user_sockets(username):
     for socket in list(sockets):
         if socket.username and socket.username.lower() == username.lower():
@@ -105,7 +250,7 @@ def handle_new_milestone(line):
     data = parse_where_data(line)
     if "name" not in data: return
     game = find_running_game(data.get("name"), data.get("start"))
-    if game: game.log_milestone(data)
+    if game and not game.pushes_milestones: game.log_milestone(data)
 
 class CrawlWebSocket(tornado.websocket.WebSocketHandler):
     def __init__(self, app, req, **kwargs):
@@ -124,12 +269,15 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
         current_id += 1
 
         self.deflate = True
-        self._compressobj = zlib.compressobj(zlib.Z_DEFAULT_COMPRESSION,
-                                             zlib.DEFLATED,
-                                             -zlib.MAX_WBITS)
+        self._compressobj = new_compressobj()
+        # The compressor that produced the last frame the client inflated.
+        self.inflater_source = None
         self.total_message_bytes = 0
         self.compressed_bytes_sent = 0
         self.uncompressed_bytes_sent = 0
+        self.frames_sent = 0
+        # Uncompressed bytes queued for this socket, by message type.
+        self.bytes_by_type = {}
         self.message_queue = []
 
         self.subprotocol = None
@@ -148,6 +296,7 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
             "chat_msg": self.post_chat_message,
             "register": self.register,
             "go_lobby": self.go_lobby,
+            "lobby_resync": self.lobby_resync,
             "get_rc": self.get_rc,
             "set_rc": self.set_rc,
             }
@@ -225,7 +374,11 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
         from process_handler import processes
         for process in processes.values():
             self.queue_message("lobby_entry", **process.lobby_entry())
-        self.send_message("lobby_complete")
+        self.send_message("lobby_complete", version=lobby_version)
+
+    def lobby_resync(self):
+        if self.is_in_lobby():
+            self.send_lobby()
 
     def send_game_links(self):
         # Rerender Banner
@@ -396,8 +549,7 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
             token = long(token)
         except ValueError:
             token = None
-        if (token, username) in login_tokens:
-            del login_tokens[(token, username)]
+        if token is not None and take_login_token(str(token), username):
             self.logger.info("User %s logged in (via token).", username)
             self.do_login(username)
         else:
@@ -407,8 +559,8 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
     def set_login_cookie(self):
         if self.username is None: return
         token = rand.getrandbits(128)
-        expires = datetime.datetime.now() + datetime.timedelta(config.login_token_lifetime)
-        login_tokens[(token, self.username)] = expires
+        expires = time.time() + config.login_token_lifetime * 24 * 60 * 60
+        add_login_token(str(token), self.username, expires)
         cookie = self.username + " " + str(token)
         self.send_message("login_cookie", cookie = cookie,
                           expires = config.login_token_lifetime)
@@ -420,8 +572,8 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
                 token = long(token)
             except ValueError:
                 token = None
-            if (token, username) in login_tokens:
-                del login_tokens[(token, username)]
+            if token is not None:
+                take_login_token(str(token), username)
         except ValueError:
             return
 
@@ -560,15 +712,25 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
         msg = "{\"msgs\":[" + ",".join(self.message_queue) + "]}"
         self.message_queue = []
 
+        compressed = None
+        if self.deflate:
+            if self.inflater_source is not self:
+                # Frames from a shared stream went in between; our own
+                # history is no longer what the client has.
+                self._compressobj = new_compressobj()
+            compressed = deflate_frame(self._compressobj, msg)
+        self.send_frame(self, msg, compressed)
+
+    def send_frame(self, source, msg, compressed):
+        """Sends a batch of messages, already compressed by source if this
+        socket uses compression."""
+        if self.client_closed:
+            return
         try:
             self.total_message_bytes += len(msg)
+            self.frames_sent += 1
             if self.deflate:
-                # Compress like in deflate-frame extension:
-                # Apply deflate, flush, then remove the 00 00 FF FF
-                # at the end
-                compressed = self._compressobj.compress(msg)
-                compressed += self._compressobj.flush(zlib.Z_SYNC_FLUSH)
-                compressed = compressed[:-4]
+                self.inflater_source = source
                 self.compressed_bytes_sent += len(compressed)
                 super(CrawlWebSocket, self).write_message(compressed, binary=True)
             else:
@@ -579,9 +741,29 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
             if self.ws_connection != None:
                 self.ws_connection._abort()
 
+    def count_message(self, msg_type, length):
+        self.bytes_by_type[msg_type] = (self.bytes_by_type.get(msg_type, 0)
+                                        + length)
+
+    def telemetry_summary(self):
+        if self.is_running():
+            activity = "playing"
+        elif self.watched_game:
+            activity = "watching %s" % self.watched_game.username
+        else:
+            activity = "in lobby"
+        by_type = sorted(self.bytes_by_type.items(), key=lambda t: -t[1])
+        return "%s, %s; %s bytes in %s frames, %s on the wire; %s" % (
+            self.username or "anonymous", activity,
+            self.total_message_bytes, self.frames_sent,
+            self.compressed_bytes_sent + self.uncompressed_bytes_sent,
+            " ".join("%s=%s" % t for t in by_type))
+
     def write_message(self, msg, send=True):
         if self.client_closed: return
-        self.message_queue.append(utf8(msg))
+        msg = utf8(msg)
+        self.message_queue.append(msg)
+        self.count_message(message_type(msg), len(msg))
         if send:
             self.flush_messages()
 
@@ -618,3 +800,5 @@ class CrawlWebSocket(tornado.websocket.WebSocketHandler):
 
         self.logger.info("Socket closed. (%s bytes sent, compression ratio %s%%)",
                          self.total_message_bytes, comp_ratio)
+        if getattr(config, "telemetry_log_rate", None):
+            self.logger.info("Telemetry: %s", self.telemetry_summary())
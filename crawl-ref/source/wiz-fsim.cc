@@ -8,6 +8,10 @@
 #include "wiz-fsim.h"
 
 #include <cerrno>
+#ifndef TARGET_OS_WINDOWS
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
 
 #include "beam.h"
 #include "bitary.h"
@@ -33,6 +37,7 @@
 #include "output.h"
 #include "player-equip.h"
 #include "player.h"
+#include "random.h"
 #include "ranged-attack.h"
 #include "skills.h"
 #include "species.h"
@@ -326,14 +331,24 @@ static void _uninit_fsim(monster *mon)
     reset_training();
 }
 
-static fight_data _get_fight_data(monster &mon, int iter_limit, bool defend)
+// Running sums over a batch of fight rounds. Batches run apart are added up
+// before any averages are taken, so they report what one long run would.
+struct fight_totals
+{
+    unsigned int cumulative_damage;
+    unsigned int time_taken;
+    int hits;
+    int max_dam;
+};
+
+static fight_totals _run_fight_rounds(monster &mon, int iter_limit,
+                                      bool defend)
 {
     const monster orig = mon;
     unsigned int cumulative_damage = 0;
     unsigned int time_taken = 0;
     int hits = 0;
-    fight_data fdata;
-    fdata.max_dam = 0;
+    int max_dam = 0;
 
     const int weapon = you.equip[EQ_WEAPON];
     const item_def *iweap = weapon != -1 ? &you.inv[weapon] : nullptr;
@@ -399,8 +414,8 @@ static fight_data _get_fight_data(monster &mon, int iter_limit, bool defend)
 
             int damage = (mon.max_hit_points - mon.hit_points);
             cumulative_damage += damage;
-            if (damage > fdata.max_dam)
-                fdata.max_dam = damage;
+            if (damage > max_dam)
+                max_dam = damage;
         }
     }
     else // you're defending
@@ -419,8 +434,8 @@ static fight_data _get_fight_data(monster &mon, int iter_limit, bool defend)
             if (did_hit)
                 hits++;
             cumulative_damage += damage;
-            if (damage > fdata.max_dam)
-                fdata.max_dam = damage;
+            if (damage > max_dam)
+                max_dam = damage;
 
             // Re-place the combatants if they e.g. blinked away or were
             // trampled.
@@ -431,11 +446,113 @@ static fight_data _get_fight_data(monster &mon, int iter_limit, bool defend)
         you.hp_max = ymhp;
     }
 
-    fdata.av_hit_dam = hits ? double(cumulative_damage) / hits : 0.0;
-    fdata.accuracy = 100 * hits / iter_limit;
-    fdata.av_dam = double(cumulative_damage) / iter_limit;
-    fdata.av_time = double(time_taken) / iter_limit + 0.5; // round to nearest
-    fdata.av_speed = double(iter_limit) * 100 / time_taken;
+    fight_totals totals = { cumulative_damage, time_taken, hits, max_dam };
+    return totals;
+}
+
+#ifndef TARGET_OS_WINDOWS
+/**
+ * Share the rounds between Options.fsim_jobs forked workers and add up what
+ * they report.
+ *
+ * Combat reads and writes a great deal of global state, so each worker is a
+ * full copy of this process with the combatants already in place. Their
+ * random streams are seeded from the game's, so a run is as repeatable as
+ * a single-process one. Returns false if any worker failed to report.
+ */
+static bool _run_fight_rounds_parallel(monster &mon, int iter_limit,
+                                       bool defend, fight_totals &totals)
+{
+    const int jobs = min(Options.fsim_jobs, iter_limit);
+    vector<pid_t> workers;
+    vector<int> pipes;
+    bool ok = true;
+
+    for (int job = 0; job < jobs; ++job)
+    {
+        const int rounds = iter_limit * (job + 1) / jobs
+                           - iter_limit * job / jobs;
+        uint64_t seed[2] = { get_uint64(), get_uint64() };
+
+        int fds[2];
+        if (pipe(fds) == -1)
+        {
+            fprintf(stderr, "Couldn't make a pipe: %s\n", strerror(errno));
+            ok = false;
+            break;
+        }
+
+        // Don't let the workers inherit and re-flush our pending output.
+        fflush(stdout);
+        fflush(stderr);
+        const pid_t pid = fork();
+        if (pid == -1)
+        {
+            fprintf(stderr, "Couldn't fork: %s\n", strerror(errno));
+            close(fds[0]);
+            close(fds[1]);
+            ok = false;
+            break;
+        }
+        if (pid == 0)
+        {
+            close(fds[0]);
+            rng_override rng(seed, ARRAYSZ(seed));
+            const fight_totals part = _run_fight_rounds(mon, rounds, defend);
+            const bool sent = write(fds[1], &part, sizeof(part))
+                              == (ssize_t) sizeof(part);
+            _exit(sent ? 0 : 1);
+        }
+        close(fds[1]);
+        workers.push_back(pid);
+        pipes.push_back(fds[0]);
+    }
+
+    totals = { 0, 0, 0, 0 };
+    for (unsigned int i = 0; i < workers.size(); ++i)
+    {
+        fight_totals part;
+        if (read(pipes[i], &part, sizeof(part)) == (ssize_t) sizeof(part))
+        {
+            totals.cumulative_damage += part.cumulative_damage;
+            totals.time_taken += part.time_taken;
+            totals.hits += part.hits;
+            totals.max_dam = max(totals.max_dam, part.max_dam);
+        }
+        else
+            ok = false;
+        close(pipes[i]);
+
+        int status = 0;
+        if (waitpid(workers[i], &status, 0) == -1
+            || !WIFEXITED(status) || WEXITSTATUS(status))
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+#endif
+
+static fight_data _get_fight_data(monster &mon, int iter_limit, bool defend)
+{
+    fight_totals totals;
+#ifndef TARGET_OS_WINDOWS
+    // If the workers let us down, run the whole lot here instead.
+    if (Options.fsim_jobs <= 1
+        || !_run_fight_rounds_parallel(mon, iter_limit, defend, totals))
+#endif
+    totals = _run_fight_rounds(mon, iter_limit, defend);
+
+    fight_data fdata;
+    fdata.max_dam = totals.max_dam;
+    fdata.av_hit_dam = totals.hits
+                       ? double(totals.cumulative_damage) / totals.hits : 0.0;
+    fdata.accuracy = 100 * totals.hits / iter_limit;
+    fdata.av_dam = double(totals.cumulative_damage) / iter_limit;
+    // round to nearest
+    fdata.av_time = double(totals.time_taken) / iter_limit + 0.5;
+    fdata.av_speed = double(iter_limit) * 100 / totals.time_taken;
     fdata.av_eff_dam = fdata.av_dam * 100 / fdata.av_time;
 
     return fdata;
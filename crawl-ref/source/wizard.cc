@@ -9,6 +9,7 @@
 
 #include "abyss.h" // banished
 #include "acquire.h"
+#include "alloc-tag.h"
 #include "cio.h" // cursor_control
 #include "clua.h"
 #include "command.h" // show_keyhelp_menu
@@ -33,6 +34,7 @@
 #include "stairs.h" // down_stairs
 #include "state.h"
 #include "timed-effects.h" // change_labyrinth
+#include "turn-profile.h"
 #include "wizard-option-type.h"
 #include "wiz-dgn.h"
 #include "wiz-dump.h"
@@ -140,7 +142,6 @@ static void _do_wizard_command(int wiz_command)
     case CONTROL('P'): wizard_list_props(); break;
 
     // case 'q': break;
-    // case 'Q': break;
     case CONTROL('Q'): wizard_toggle_dprf(); break;
 
     case 'r': wizard_change_species(); break;
@@ -156,7 +157,6 @@ static void _do_wizard_command(int wiz_command)
     case CONTROL('T'): debug_terp_dlua(); break;
 
     case 'u': wizard_level_travel(false); break;
-    // case 'U': break;
     case CONTROL('U'): debug_terp_dlua(clua); break;
 
     case 'v': wizard_recharge_evokers(); break;
@@ -231,7 +231,17 @@ static void _do_wizard_command(int wiz_command)
     case '.': wizard_place_stairs(true); break;
     // case '>': break; // XXX do not use, menu command
 
-    // case '/': break;
+    case '/': debug_list_cache_stats(); break;
+    case 'Q':
+        if (turn_profile_active())
+            turn_profile_report();
+        else
+        {
+            turn_profile_start();
+            mprf(MSGCH_DIAGNOSTICS, "Started timing turns.");
+        }
+        break;
+    case 'U': alloc_tag_report(); break;
 
     case ' ':
     case '\r':
@@ -508,6 +518,9 @@ int list_wizard_commands(bool do_redraw_screen)
                        "<w>Ctrl-Y</w> temporarily suppress wizmode\n"
                        "<w>Ctrl-C</w> force a crash\n"
                        "<w>`</w>      list unassigned command keys\n"
+                       "<w>/</w>      show cache statistics\n"
+                       "<w>Q</w>      start timing turns, or show timings\n"
+                       "<w>U</w>      show heap use per subsystem\n"
                        "\n"
                        "<yellow>Other wizard commands</yellow>\n"
                        "(not prefixed with <w>&</w>!)\n"
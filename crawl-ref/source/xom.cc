@@ -1450,6 +1450,7 @@ static void _xom_give_mutations(bool good)
     mpr("Your body is suffused with distortional energy.");
 
     bool failMsg = true;
+    mutation_batch batch;
 
     for (int i = num_tries; i > 0; --i)
     {